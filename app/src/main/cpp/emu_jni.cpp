@@ -79,7 +79,10 @@ extern "C" JNIEXPORT void Java_org_stratoemu_strato_EmulationActivity_executeApp
 
     skyline::JniString publicAppFilesPath(env, publicAppFilesPathJstring);
 
-    skyline::AsyncLogger::Initialize(*settings->logLevel, publicAppFilesPath + "logs/emulation.log");
+    if (*settings->binaryLogging)
+        skyline::AsyncLogger::Initialize(*settings->logLevel, publicAppFilesPath + "logs/emulation.bin", true);
+    else
+        skyline::AsyncLogger::Initialize(*settings->logLevel, publicAppFilesPath + "logs/emulation.log");
 
     auto start{std::chrono::steady_clock::now()};
 
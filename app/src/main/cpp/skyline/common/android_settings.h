@@ -37,22 +37,30 @@ namespace skyline {
             systemLanguage = ktSettings.GetInt<skyline::language::SystemLanguage>("systemLanguage");
             systemRegion = ktSettings.GetInt<skyline::region::RegionCode>("systemRegion");
             isInternetEnabled = ktSettings.GetBool("isInternetEnabled");
+            romFsCacheSize = ktSettings.GetInt<u32>("romFsCacheSize");
             forceTripleBuffering = ktSettings.GetBool("forceTripleBuffering");
             disableFrameThrottling = ktSettings.GetBool("disableFrameThrottling");
             gpuDriver = ktSettings.GetString("gpuDriver");
             gpuDriverLibraryName = ktSettings.GetString("gpuDriverLibraryName");
             executorSlotCountScale = ktSettings.GetInt<u32>("executorSlotCountScale");
             executorFlushThreshold = ktSettings.GetInt<u32>("executorFlushThreshold");
+            executorRecordThreadCount = ktSettings.GetInt<u32>("executorRecordThreadCount");
+            megaBufferMaxSize = ktSettings.GetInt<u32>("megaBufferMaxSize");
             useDirectMemoryImport = ktSettings.GetBool("useDirectMemoryImport");
             forceMaxGpuClocks = ktSettings.GetBool("forceMaxGpuClocks");
             disableShaderCache = ktSettings.GetBool("disableShaderCache");
             freeGuestTextureMemory = ktSettings.GetBool("freeGuestTextureMemory");
+            pipelineCacheThreadCount = ktSettings.GetInt<u32>("pipelineCacheThreadCount");
+            asyncPipelineCompilation = ktSettings.GetBool("asyncPipelineCompilation");
             enableFastGpuReadbackHack = ktSettings.GetBool("enableFastGpuReadbackHack");
             enableFastReadbackWrites = ktSettings.GetBool("enableFastReadbackWrites");
             disableSubgroupShuffle = ktSettings.GetBool("disableSubgroupShuffle");
+            enableLibcHooks = ktSettings.GetBool("enableLibcHooks");
             isAudioOutputDisabled = ktSettings.GetBool("isAudioOutputDisabled");
             logLevel = ktSettings.GetInt<skyline::AsyncLogger::LogLevel>("logLevel");
+            binaryLogging = ktSettings.GetBool("binaryLogging");
             validationLayer = ktSettings.GetBool("validationLayer");
+            gpfifoCapture = ktSettings.GetBool("gpfifoCapture");
         };
     };
 }
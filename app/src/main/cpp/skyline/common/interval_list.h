@@ -28,6 +28,7 @@ namespace skyline {
 
       private:
         std::vector<Interval> intervals; //!< A list of intervals sorted by their end offset
+        size_t generation{}; //!< Incremented on every modification of the list, this allows callers to cache query results
 
       public:
         struct QueryResult {
@@ -40,12 +41,22 @@ namespace skyline {
          */
         void Clear() {
             intervals.clear();
+            generation++;
+        }
+
+        /**
+         * @return A value that changes whenever the list is modified
+         */
+        size_t GetGeneration() const {
+            return generation;
         }
 
         /**
          * @brief Forces future accesses to the given interval to use the shadow copy
         */
         void Insert(Interval entry) {
+            generation++;
+
             auto firstIt{std::lower_bound(intervals.begin(), intervals.end(), entry, [](const auto &lhs, const auto &rhs) {
                 return lhs.end < rhs.offset;
             })}; // Lowest offset entry that (maybe) overlaps with the new entry
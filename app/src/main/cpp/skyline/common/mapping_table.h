@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2023 Strato Team and Contributors (https://github.com/strato-emu/)
+
+#pragma once
+
+#include <unordered_map>
+#include <boost/container/small_vector.hpp>
+#include "span.h"
+
+namespace skyline {
+    /**
+     * @brief A hashed page table of possibly overlapping mappings, this allows finding all mappings which contain a range by only checking the mappings overlapping the page it starts in
+     * @tparam MappingType The type of the mappings, this must be derived from span<u8> and must not be moved while it's in the table
+     * @tparam GranularityBits The size of a page in the table as a power of 2, this should be close to the size of the smallest mappings as every page a mapping overlaps holds a pointer to it
+     * @note This class is **NOT** thread-safe, any access to the table must be protected by the owner's lock
+     */
+    template<typename MappingType, size_t GranularityBits>
+    class MappingTable {
+      private:
+        std::unordered_map<u64, boost::container::small_vector<MappingType *, 4>> table; //!< A map from the index of a page in the AS to all mappings overlapping it
+
+        static u64 FirstPage(span<u8> range) {
+            return reinterpret_cast<u64>(range.data()) >> GranularityBits;
+        }
+
+        static u64 LastPage(span<u8> range) {
+            return reinterpret_cast<u64>(range.data() + std::max<size_t>(range.size(), 1) - 1) >> GranularityBits;
+        }
+
+      public:
+        void Insert(MappingType *mapping) {
+            for (auto page{FirstPage(*mapping)}, lastPage{LastPage(*mapping)}; page <= lastPage; page++)
+                table[page].push_back(mapping);
+        }
+
+        /**
+         * @brief Appends all mappings which entirely contain the supplied range to the output container, they are in insertion order
+         */
+        template<typename Container>
+        void FindContaining(span<u8> range, Container &output) const {
+            auto it{table.find(FirstPage(range))};
+            if (it != table.end())
+                for (auto *mapping : it->second)
+                    if (mapping->contains(range))
+                        output.push_back(mapping);
+        }
+    };
+}
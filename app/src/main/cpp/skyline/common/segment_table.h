@@ -14,7 +14,7 @@ namespace skyline {
      * @tparam L1Bits The size of an L1 segment as a power of 2, this should be lower than L2 and will determine the minimum granularity of the table
      * @tparam L2Bits The size of an L2 segment as a power of 2, this should be higher than L2 and will determine the maximum granularity of the table
      * @tparam EnablePointerAccess Whether or not to enable pointer access to the table, this is useful when host addresses are used as the key for the table
-     * @note This class is **NOT** thread-safe, any access to the table must be protected by a mutex
+     * @note This class is **NOT** thread-safe, any access to the table must be protected by a mutex or reads must be validated against concurrent writes (such as with a sequence counter)
      */
     template<typename SegmentType, size_t Size, size_t L1Bits, size_t L2Bits, bool EnablePointerAccess = false> requires std::is_trivial_v<SegmentType>
     class SegmentTable {
@@ -30,7 +30,7 @@ namespace skyline {
             SegmentType segment; //!< The segment associated with the entry, this is 0'd out if the entry is unset
         };
 
-        static constexpr size_t L2Size{1 << L2Bits}, L2Entries{util::DivideCeil(Size, L2Size)}, L1inL2Count{L1Size / L2Size};
+        static constexpr size_t L2Size{1 << L2Bits}, L2Entries{util::DivideCeil(Size, L2Size)}, L1inL2Count{L2Size / L1Size};
         span<RangeEntry, L2Entries> level2Table; //!< The second level of the segment table, this is the lowest granularity of the table
 
         template<typename Type, size_t Amount>
@@ -164,7 +164,7 @@ namespace skyline {
         }
 
         void Set(span<u8> span, SegmentType segment) {
-            Set(reinterpret_cast<size_t>(span.begin().base()), reinterpret_cast<size_t>(span.end().base()));
+            Set(reinterpret_cast<size_t>(span.begin().base()), reinterpret_cast<size_t>(span.end().base()), segment);
         }
     };
 }
@@ -67,6 +67,7 @@ namespace skyline {
         Setting<language::SystemLanguage> systemLanguage; //!< The system language
         Setting<region::RegionCode> systemRegion; //!< The system region
         Setting<bool> isInternetEnabled; //!< If emulator uses internet
+        Setting<u32> romFsCacheSize; //!< The size of the cache for decrypted RomFS data in MiB, 0 disables the cache
 
         // Display
         Setting<bool> forceTripleBuffering; //!< If the presentation engine should always triple buffer even if the swapchain supports double buffering
@@ -78,21 +79,28 @@ namespace skyline {
         Setting<std::string> gpuDriverLibraryName; //!< The name of the GPU driver library to use
         Setting<u32> executorSlotCountScale; //!< Number of GPU executor slots that can be used concurrently
         Setting<u32> executorFlushThreshold; //!< Number of commands that need to accumulate before they're flushed to the GPU
+        Setting<u32> executorRecordThreadCount; //!< Number of threads that command buffers of different GPU executions are recorded on in parallel
+        Setting<u32> megaBufferMaxSize; //!< The maximum amount of memory in MiB that megabuffer chunks can use before allocations wait on the GPU
         Setting<bool> useDirectMemoryImport; //!< If buffer emulation should be done by importing guest buffer mappings
         Setting<bool> forceMaxGpuClocks; //!< If the GPU should be forced to run at maximum clocks
         Setting<bool> freeGuestTextureMemory; //!< If guest textrue memory should be freed when the owning texture is GPU dirty
+        Setting<u32> pipelineCacheThreadCount; //!< The maximum amount of threads used to compile shaders when loading the pipeline cache, 0 uses every available core
+        Setting<bool> asyncPipelineCompilation; //!< If new pipelines should be compiled in the background, draws are skipped or use a similar pipeline until compilation finishes
 
         // Hacks
         Setting<bool> enableFastGpuReadbackHack; //!< If the CPU texture readback skipping hack should be used
         Setting<bool> enableFastReadbackWrites; //!< If buffers should be treated as CPU dirty when written with the readback hack
         Setting<bool> disableSubgroupShuffle; //!< If shader subgroup suffle operations should be ignored
+        Setting<bool> enableLibcHooks; //!< If hot guest libc routines should be replaced with their host equivalents
 
         // Audio
         Setting<bool> isAudioOutputDisabled; //!< Disables audio output
 
         // Debug
         Setting<AsyncLogger::LogLevel> logLevel; //!< The log level
+        Setting<bool> binaryLogging; //!< If logs should be written in the binary log format which defers all formatting to the offline log decoder
         Setting<bool> validationLayer; //!< If the vulkan validation layer is enabled
+        Setting<bool> gpfifoCapture; //!< If all pushbuffers submitted to the GPU should be captured to a file for offline replay
 
         Settings() = default;
 
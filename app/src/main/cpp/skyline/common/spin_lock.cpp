@@ -14,8 +14,10 @@ namespace skyline {
     template<typename Func>
     void FalloffLock(Func &&func) {
         for (size_t i{1}; !func(i); i++) {
+            #ifdef __ANDROID__
             asm volatile("DMB ISHST;"
                          "YIELD;");
+            #endif
 
             if (i % LockAttemptsPerYield == 0)
                 std::this_thread::yield();
@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2023 Strato Team and Contributors (https://github.com/strato-emu/)
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include "base.h"
+
+namespace skyline {
+    /**
+     * @brief A fair lock which is handed to waiters in the order they started waiting, waiters sleep on a condition variable rather than spinning
+     * @note This is intended for coarse locks which are held for long durations and contended by a handful of threads, every waiter is woken on unlock so it scales poorly with many waiters
+     */
+    class TicketLock {
+      private:
+        std::mutex mutex;
+        std::condition_variable condition;
+        u64 nextTicket{}; //!< The ticket that will be handed to the next thread trying to acquire the lock
+        u64 servingTicket{}; //!< The ticket of the thread that currently owns the lock or will own it next
+        std::atomic<u32> waiters{}; //!< The amount of threads that are blocked on acquiring the lock
+
+      public:
+        void lock() {
+            std::unique_lock lock{mutex};
+            u64 ticket{nextTicket++};
+            if (ticket != servingTicket) {
+                waiters.fetch_add(1, std::memory_order_relaxed);
+                condition.wait(lock, [&] { return ticket == servingTicket; });
+                waiters.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+
+        bool try_lock() {
+            std::scoped_lock lock{mutex};
+            if (nextTicket != servingTicket)
+                return false;
+
+            nextTicket++;
+            return true;
+        }
+
+        void unlock() {
+            {
+                std::scoped_lock lock{mutex};
+                servingTicket++;
+            }
+            condition.notify_all();
+        }
+
+        /**
+         * @return The amount of threads that are currently blocked on acquiring the lock
+         * @note This is only a snapshot and may be outdated by the time it's returned
+         */
+        u32 GetWaiterCount() const {
+            return waiters.load(std::memory_order_relaxed);
+        }
+    };
+}
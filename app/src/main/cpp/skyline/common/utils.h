@@ -4,11 +4,14 @@
 #pragma once
 
 #include <algorithm>
+#include <chrono>
 #include <random>
 #include <span>
 #include <frozen/unordered_map.h>
 #include <frozen/string.h>
+#ifdef __ANDROID__
 #include <sys/system_properties.h>
+#endif
 #include <type_traits>
 #include <xxhash.h>
 #include "base.h"
@@ -27,6 +30,7 @@ namespace skyline::util {
          * @note Some devices report an incorrect value so they need special handling
          */
         inline u64 InitFrequency() {
+            #ifdef __ANDROID__
             char buffer[PROP_VALUE_MAX];
             int len{__system_property_get("ro.product.board", buffer)};
             std::string_view board{buffer, static_cast<size_t>(len)};
@@ -44,6 +48,10 @@ namespace skyline::util {
                 asm volatile("MRS %0, CNTFRQ_EL0" : "=r"(frequency));
 
             return frequency;
+            #else
+            // Host builds of the tools use the steady clock rather than the system counter, it counts in nanoseconds
+            return constant::NsInSecond;
+            #endif
         }
     }
 
@@ -53,7 +61,11 @@ namespace skyline::util {
     inline i64 GetTimeScaled() {
         u64 frequency{ClockFrequency};
         u64 ticks;
+        #ifdef __ANDROID__
         asm volatile("MRS %0, CNTVCT_EL0" : "=r"(ticks));
+        #else
+        ticks = static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+        #endif
         return static_cast<i64>(((ticks / frequency) * TargetFrequency) + (((ticks % frequency) * TargetFrequency + (frequency / 2)) / frequency));
     }
     /**
@@ -260,6 +272,15 @@ namespace skyline::util {
         }
     };
 
+    /**
+     * @brief Hashes the raw bytes of an object using the supplied hash as a seed, this allows building up a hash of several objects incrementally
+     * @note The object must not contain any padding as its contents would be undefined
+     */
+    template<typename T> requires std::is_trivially_copyable_v<T>
+    u64 HashCombine(u64 seed, const T &object) {
+        return XXH64(&object, sizeof(object), seed);
+    }
+
     /**
      * @brief Selects the largest possible integer type for representing an object alongside providing the size of the object in terms of the underlying type
      */
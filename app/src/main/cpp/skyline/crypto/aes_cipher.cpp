@@ -1,9 +1,61 @@
 // SPDX-License-Identifier: MPL-2.0
 // Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
 
+#if defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO)
+#include <arm_neon.h>
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#define AES_CIPHER_ARM_CE
+#endif
 #include "aes_cipher.h"
 
 namespace skyline::crypto {
+    constexpr size_t AesBlockSize{0x10};
+    constexpr size_t CtrBatchBlocks{4}; //!< The amount of counter blocks which are encrypted together, this allows the AES pipeline to be kept full
+
+    #ifdef AES_CIPHER_ARM_CE
+    /**
+     * @return If the host CPU supports the ARMv8 Crypto Extension AES instructions
+     */
+    static bool HasHardwareAes() {
+        static const bool hasAes{(getauxval(AT_HWCAP) & HWCAP_AES) != 0};
+        return hasAes;
+    }
+
+    /**
+     * @brief Expands an AES-128 key into all round keys using the AESE instruction for SubWord
+     * @note AESE performs ShiftRows after SubBytes but this has no effect as the word is broadcast to all columns
+     */
+    static void ExpandKey128(const u8 *key, std::array<u8, 0xB0> &roundKeys) {
+        constexpr std::array<u8, 10> RoundConstants{0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1B, 0x36};
+
+        std::array<u32, 44> words;
+        std::memcpy(words.data(), key, 0x10);
+        for (size_t i{4}; i < words.size(); i++) {
+            u32 word{words[i - 1]};
+            if (i % 4 == 0) {
+                word = (word >> 8) | (word << 24); // RotWord
+                word = vgetq_lane_u32(vreinterpretq_u32_u8(vaeseq_u8(vreinterpretq_u8_u32(vdupq_n_u32(word)), vdupq_n_u8(0))), 0); // SubWord
+                word ^= RoundConstants[(i / 4) - 1];
+            }
+            words[i] = words[i - 4] ^ word;
+        }
+        std::memcpy(roundKeys.data(), words.data(), roundKeys.size());
+    }
+
+    /**
+     * @brief Encrypts CtrBatchBlocks blocks with interleaved rounds, so that the latency of every round is hidden by the other blocks
+     */
+    static void EncryptBlocks(uint8x16_t (&blocks)[CtrBatchBlocks], const uint8x16_t (&keys)[11]) {
+        for (size_t round{}; round < 9; round++)
+            for (auto &block : blocks)
+                block = vaesmcq_u8(vaeseq_u8(block, keys[round]));
+
+        for (auto &block : blocks)
+            block = veorq_u8(vaeseq_u8(block, keys[9]), keys[10]);
+    }
+    #endif
+
     AesCipher::AesCipher(span<u8> key, mbedtls_cipher_type_t type) {
         mbedtls_cipher_init(&decryptContext);
         if (mbedtls_cipher_setup(&decryptContext, mbedtls_cipher_info_from_type(type)) != 0)
@@ -11,9 +63,25 @@ namespace skyline::crypto {
 
         if (mbedtls_cipher_setkey(&decryptContext, key.data(), static_cast<int>(key.size() * 8), MBEDTLS_DECRYPT) != 0)
             throw exception("Failed to set key for decryption context");
+
+        mbedtls_aes_init(&ctrContext);
+        if (type == MBEDTLS_CIPHER_AES_128_CTR) {
+            // CTR mode only ever uses the encryption direction of the block cipher, so the key schedules are for encryption
+            if (mbedtls_aes_setkey_enc(&ctrContext, key.data(), static_cast<unsigned int>(key.size() * 8)) != 0)
+                throw exception("Failed to set key for AES-CTR context");
+            hasCtrKey = true;
+
+            #ifdef AES_CIPHER_ARM_CE
+            if (HasHardwareAes() && key.size() == 0x10) {
+                ExpandKey128(key.data(), roundKeys);
+                hasHardwareAes = true;
+            }
+            #endif
+        }
     }
 
     AesCipher::~AesCipher() {
+        mbedtls_aes_free(&ctrContext);
         mbedtls_cipher_free(&decryptContext);
     }
 
@@ -69,4 +137,56 @@ namespace skyline::crypto {
             Decrypt(destination + i, source + i, sectorSize);
         }
     }
+
+    void AesCipher::CtrDecrypt(u8 *destination, const u8 *source, size_t size, const std::array<u8, 0x10> &ctr, size_t offset) const {
+        if (!hasCtrKey) [[unlikely]]
+            throw exception("Cannot perform stateless AES-CTR decryption on a non-CTR cipher");
+
+        u64 ctrHigh, ctrLow;
+        std::memcpy(&ctrHigh, ctr.data(), sizeof(u64));
+        std::memcpy(&ctrLow, ctr.data() + sizeof(u64), sizeof(u64));
+        u64 counter{util::SwapEndianness(ctrLow) + (offset / AesBlockSize)}; //!< The counter of the block containing the current position
+        size_t blockOffset{offset % AesBlockSize}; //!< The offset into the first block's keystream, only the first block may be unaligned
+
+        std::array<u8, AesBlockSize * CtrBatchBlocks> keystream;
+        while (size) {
+            // Generate the keystream for a batch of blocks, each block is the upper half of the IV followed by the big-endian counter
+            for (size_t block{}; block < CtrBatchBlocks; block++) {
+                u64 counterBe{util::SwapEndianness(counter + block)};
+                std::memcpy(keystream.data() + (block * AesBlockSize), &ctrHigh, sizeof(u64));
+                std::memcpy(keystream.data() + (block * AesBlockSize) + sizeof(u64), &counterBe, sizeof(u64));
+            }
+
+            #ifdef AES_CIPHER_ARM_CE
+            if (hasHardwareAes) {
+                uint8x16_t keys[11];
+                for (size_t round{}; round < 11; round++)
+                    keys[round] = vld1q_u8(roundKeys.data() + (round * AesBlockSize));
+
+                uint8x16_t blocks[CtrBatchBlocks];
+                for (size_t block{}; block < CtrBatchBlocks; block++)
+                    blocks[block] = vld1q_u8(keystream.data() + (block * AesBlockSize));
+                EncryptBlocks(blocks, keys);
+                for (size_t block{}; block < CtrBatchBlocks; block++)
+                    vst1q_u8(keystream.data() + (block * AesBlockSize), blocks[block]);
+            } else
+            #endif
+            {
+                for (size_t block{}; block < CtrBatchBlocks; block++) {
+                    u8 *keystreamBlock{keystream.data() + (block * AesBlockSize)};
+                    mbedtls_aes_crypt_ecb(&ctrContext, MBEDTLS_AES_ENCRYPT, keystreamBlock, keystreamBlock);
+                }
+            }
+
+            size_t length{std::min(size, keystream.size() - blockOffset)};
+            for (size_t index{}; index < length; index++)
+                destination[index] = static_cast<u8>(source[index] ^ keystream[blockOffset + index]);
+
+            destination += length;
+            source += length;
+            size -= length;
+            counter += CtrBatchBlocks;
+            blockOffset = 0;
+        }
+    }
 }
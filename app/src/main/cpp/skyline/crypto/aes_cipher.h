@@ -4,18 +4,24 @@
 #pragma once
 
 #include <mbedtls/cipher.h>
+#include <mbedtls/aes.h>
 #include <common.h>
 
 namespace skyline::crypto {
     /**
      * @brief Wrapper for mbedtls for AES decryption using a cipher
-     * @note The IV state must be appropriately locked during multi-threaded usage
+     * @note The IV state must be appropriately locked during multi-threaded usage, CtrDecrypt is an exception to this as it is stateless
      */
     class AesCipher {
       private:
         mbedtls_cipher_context_t decryptContext;
         std::vector<u8> buffer; //!< A buffer used to avoid constant memory allocation
 
+        bool hasCtrKey{}; //!< If the key schedules for stateless AES-CTR have been set up, this is only done for AES-CTR ciphers
+        bool hasHardwareAes{}; //!< If the host CPU supports the AES instructions and `roundKeys` is valid
+        std::array<u8, 0xB0> roundKeys{}; //!< The expanded AES-128 encryption round keys for the hardware AES-CTR implementation
+        mutable mbedtls_aes_context ctrContext; //!< An encryption key schedule for the software AES-CTR fallback, mbedtls requires this to be mutable but ECB encryption never modifies it
+
         /**
          * @brief Calculates IV for XTS, basically just big to little endian conversion
          */
@@ -60,5 +66,21 @@ namespace skyline::crypto {
         void XtsDecrypt(span<u8> data, size_t sector, size_t sectorSize) {
             XtsDecrypt(data.data(), data.data(), data.size(), sector, sectorSize);
         }
+
+        /**
+         * @brief Decrypts data with AES-CTR without using or modifying any cipher state, this can be called concurrently from multiple threads
+         * @param ctr The initial counter, the lower 8 bytes are treated as a big-endian block counter
+         * @param offset The offset of the supplied data in bytes relative to the initial counter, this doesn't need to be aligned to the block size
+         * @note This is only valid on ciphers constructed with MBEDTLS_CIPHER_AES_128_CTR
+         * @note The destination and source buffers can be the same
+         */
+        void CtrDecrypt(u8 *destination, const u8 *source, size_t size, const std::array<u8, 0x10> &ctr, size_t offset) const;
+
+        /**
+         * @brief Decrypts data with AES-CTR in-place without using or modifying any cipher state
+         */
+        void CtrDecrypt(span<u8> data, const std::array<u8, 0x10> &ctr, size_t offset) const {
+            CtrDecrypt(data.data(), data.data(), data.size(), ctr, offset);
+        }
     };
 }
@@ -412,10 +412,15 @@ namespace skyline::gpu {
         graphicsPipelineAssembler.emplace(*this, state.os->publicAppFilesPath + "vk_graphics_pipeline_cache/" + titleId);
         shader.emplace(state, *this,
                        state.os->publicAppFilesPath + "shader_replacements/" + titleId,
-                       state.os->publicAppFilesPath + "shader_dumps/" + titleId);
-        if (!*state.settings->disableShaderCache)
+                       state.os->publicAppFilesPath + "shader_dumps/" + titleId,
+                       *state.settings->disableShaderCache ? "" : state.os->publicAppFilesPath + "spirv_cache/" + titleId);
+        if (!*state.settings->disableShaderCache) {
             graphicsPipelineCacheManager.emplace(state,
                                                  state.os->publicAppFilesPath + "graphics_pipeline_cache/" + titleId);
-        graphicsPipelineManager.emplace(*this, *state.jvm);
+            computePipelineCacheManager.emplace(state,
+                                                state.os->publicAppFilesPath + "compute_pipeline_cache/" + titleId);
+        }
+        computePipelineManager.emplace(*this);
+        graphicsPipelineManager.emplace(*this, *state.jvm, *state.settings->pipelineCacheThreadCount, *state.settings->asyncPipelineCompilation);
     }
 }
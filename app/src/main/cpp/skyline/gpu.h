@@ -4,6 +4,7 @@
 #pragma once
 
 #include <adrenotools/driver.h>
+#include <common/ticket_lock.h>
 #include "gpu/trait_manager.h"
 #include "gpu/memory_manager.h"
 #include "gpu/command_scheduler.h"
@@ -42,6 +43,7 @@ namespace skyline::gpu {
         vk::raii::PhysicalDevice vkPhysicalDevice;
         u32 vkQueueFamilyIndex{};
         TraitManager traits;
+        BS::thread_pool workerPool; //!< A general-purpose pool of worker threads for splitting up CPU-heavy work such as texture decoding
         vk::raii::Device vkDevice;
         std::mutex queueMutex; //!< Synchronizes access to the queue as it is externally synchronized
         vk::raii::Queue vkQueue; //!< A Vulkan Queue supporting graphics and compute operations
@@ -63,10 +65,11 @@ namespace skyline::gpu {
         cache::RenderPassCache renderPassCache;
         cache::FramebufferCache framebufferCache;
 
-        std::mutex channelLock;
+        TicketLock channelLock; //!< Synchronizes all channel accesses to GPU state that is shared between channels, channels only hold this while they're touching that state
         std::optional<PipelineCacheManager> graphicsPipelineCacheManager;
         std::optional<interconnect::maxwell3d::PipelineManager> graphicsPipelineManager;
-        interconnect::kepler_compute::PipelineManager computePipelineManager;
+        std::optional<PipelineCacheManager> computePipelineCacheManager;
+        std::optional<interconnect::kepler_compute::PipelineManager> computePipelineManager;
 
         static constexpr size_t DebugTracingBufferSize{0x80000}; //!< 512KiB
         memory::Buffer debugTracingBuffer; //!< General use buffer for debug tracing, first 4 bytes are allocated for checkpoints
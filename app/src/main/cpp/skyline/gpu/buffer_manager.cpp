@@ -8,10 +8,6 @@
 namespace skyline::gpu {
     BufferManager::BufferManager(GPU &gpu) : gpu{gpu} {}
 
-    bool BufferManager::BufferLessThan(const std::shared_ptr<Buffer> &it, u8 *pointer) {
-        return it->guest->begin().base() < pointer;
-    }
-
     BufferManager::LockedBuffer::LockedBuffer(std::shared_ptr<Buffer> pBuffer, ContextTag tag) : buffer{std::move(pBuffer)}, lock{tag, *buffer}, stateLock(buffer->stateMutex) {}
 
     Buffer *BufferManager::LockedBuffer::operator->() const {
@@ -32,11 +28,10 @@ namespace skyline::gpu {
             return overlaps;
         }
 
-        // If we cannot find the buffer quickly, do a binary search to find all overlapping buffers
-        auto entryIt{std::lower_bound(bufferMappings.begin(), bufferMappings.end(), range.end().base(), BufferLessThan)};
-        while (entryIt != bufferMappings.begin() && (*--entryIt)->guest->begin() <= range.end())
-            if ((*entryIt)->guest->end() > range.begin())
-                overlaps.emplace_back(*entryIt, tag);
+        // If we cannot find the buffer quickly, walk backwards from the first buffer starting after the range, as buffers never overlap we can stop at the first one which ends before the range
+        auto entryIt{bufferMappings.lower_bound(range.end().base())};
+        while (entryIt != bufferMappings.begin() && (--entryIt)->second->guest->end() > range.begin())
+            overlaps.emplace_back(entryIt->second, tag);
 
         return overlaps;
     }
@@ -44,12 +39,12 @@ namespace skyline::gpu {
     void BufferManager::InsertBuffer(std::shared_ptr<Buffer> buffer) {
         auto bufferStart{buffer->guest->begin().base()}, bufferEnd{buffer->guest->end().base()};
         bufferTable.Set(bufferStart, bufferEnd, buffer.get());
-        bufferMappings.insert(std::lower_bound(bufferMappings.begin(), bufferMappings.end(), bufferEnd, BufferLessThan), std::move(buffer));
+        bufferMappings.emplace(bufferStart, std::move(buffer));
     }
 
     void BufferManager::DeleteBuffer(const std::shared_ptr<Buffer> &buffer) {
         bufferTable.Set(buffer->guest->begin().base(), buffer->guest->end().base(), nullptr);
-        bufferMappings.erase(std::find(bufferMappings.begin(), bufferMappings.end(), buffer));
+        bufferMappings.erase(buffer->guest->begin().base());
     }
 
     BufferManager::LockedBuffer BufferManager::CoalesceBuffers(span<u8> range, const LockedBuffers &srcBuffers, ContextTag tag) {
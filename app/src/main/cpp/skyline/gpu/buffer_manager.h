@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <map>
 #include <common/trace.h>
 #include <common/linear_allocator.h>
 #include <common/segment_table.h>
@@ -16,7 +17,7 @@ namespace skyline::gpu {
     class BufferManager {
       private:
         GPU &gpu;
-        std::vector<std::shared_ptr<Buffer>> bufferMappings; //!< A sorted vector of all buffer mappings
+        std::map<u8 *, std::shared_ptr<Buffer>> bufferMappings; //!< A map of all buffers keyed by the start of their guest mapping, buffers in the map never overlap
         LinearAllocatorState<> delegateAllocatorState; //!< Linear allocator used to allocate buffer delegates
         size_t nextBufferId{}; //!< The next unique buffer id to be assigned
 
@@ -64,11 +65,6 @@ namespace skyline::gpu {
          */
         LockedBuffer CoalesceBuffers(span<u8> range, const LockedBuffers &srcBuffers, ContextTag tag);
 
-        /**
-         * @return If the end of the supplied buffer is less than the supplied pointer
-         */
-        static bool BufferLessThan(const std::shared_ptr<Buffer> &it, u8 *pointer);
-
       public:
         SpinLock recreationMutex;
 
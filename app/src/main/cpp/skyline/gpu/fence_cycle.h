@@ -98,6 +98,14 @@ namespace skyline::gpu {
             return semaphoreUnsignalCycle;
         }
 
+        /**
+         * @return If the command buffer associated with this cycle has been submitted to the GPU, waiting on a cycle that hasn't been submitted yet may block indefinitely
+         */
+        bool IsSubmitted() {
+            std::unique_lock lock{mutex};
+            return submitted;
+        }
+
         /**
          * @brief Waits for submission of the command buffer associated with this cycle to the GPU
          */
@@ -151,6 +151,15 @@ namespace skyline::gpu {
          */
         CompiledPipeline AssemblePipelineAsync(const PipelineState &state, span<const vk::DescriptorSetLayoutBinding> layoutBindings, span<const vk::PushConstantRange> pushConstantRanges = {}, bool noPushDescriptors = false);
 
+        /**
+         * @brief Queues an arbitrary task on the pipeline compilation thread pool
+         * @note The task must not wait on any other task in the pool as it may only have a single thread
+         */
+        template<typename F>
+        auto SubmitTask(F &&task) {
+            return pool.submit(std::forward<F>(task));
+        }
+
         /**
          * @brief Waits until the pipeline compilation thread pool is idle and all pipelines have been compiled
          */
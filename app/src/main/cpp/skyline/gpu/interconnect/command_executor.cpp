@@ -27,6 +27,7 @@ namespace skyline::gpu::interconnect {
         : state{state},
           incoming{1U << *state.settings->executorSlotCountScale},
           outgoing{1U << *state.settings->executorSlotCountScale},
+          recordPool{*state.settings->executorRecordThreadCount > 1 ? std::optional<BS::thread_pool>{*state.settings->executorRecordThreadCount} : std::nullopt},
           thread{&CommandRecordThread::Run, this} {}
 
     CommandRecordThread::Slot::ScopedBegin::ScopedBegin(CommandRecordThread::Slot &slot) : slot{slot} {}
@@ -99,8 +100,8 @@ namespace skyline::gpu::interconnect {
         beginCondition.notify_all();
     }
 
-    void CommandRecordThread::ProcessSlot(Slot *slot) {
-        TRACE_EVENT_FMT("gpu", "ProcessSlot: {}, execution: {}", fmt::ptr(slot), u64{slot->executionTag});
+    void CommandRecordThread::RecordSlot(Slot *slot) {
+        TRACE_EVENT_FMT("gpu", "RecordSlot: {}, execution: {}", fmt::ptr(slot), u64{slot->executionTag});
         auto &gpu{*state.gpu};
 
         vk::RenderPass lRenderPass;
@@ -164,11 +165,58 @@ namespace skyline::gpu::interconnect {
 
         slot->commandBuffer.end();
         slot->ready = false;
+    }
+
+    void CommandRecordThread::SubmitSlot(Slot *slot, u64 sequence) {
+        TRACE_EVENT_FMT("gpu", "SubmitSlot: {}, execution: {}", fmt::ptr(slot), u64{slot->executionTag});
+        auto &gpu{*state.gpu};
+
+        std::unique_lock lock{submitMutex};
+        submitCondition.wait(lock, [&] { return nextSubmitSequence == sequence || submitAborted; });
+        if (submitAborted)
+            return; // A slot before this one failed, so this slot can never be submitted in order
 
         gpu.scheduler.SubmitCommandBuffer(slot->commandBuffer, slot->cycle);
 
         slot->nodes.clear();
         slot->allocator.Reset();
+
+        if (slot->didWait && (slots.size() + 1) < (1U << *state.settings->executorSlotCountScale)) {
+            outgoing.Push(&slots.emplace_back(gpu));
+            outgoing.Push(&slots.emplace_back(gpu));
+            slot->didWait = false;
+        }
+
+        outgoing.Push(slot);
+
+        nextSubmitSequence++;
+        submitCondition.notify_all();
+    }
+
+    void CommandRecordThread::AbortSubmission() {
+        {
+            std::scoped_lock lock{submitMutex};
+            submitAborted = true;
+        }
+        submitCondition.notify_all();
+    }
+
+    void CommandRecordThread::HandleException() {
+        try {
+            std::rethrow_exception(std::current_exception());
+        } catch (const signal::SignalException &e) {
+            LOGE("{}\nStack Trace:{}", e.what(), state.loader->GetStackTrace(e.frames));
+            if (state.process)
+                state.process->Kill(false);
+            else
+                std::rethrow_exception(std::current_exception());
+        } catch (const std::exception &e) {
+            LOGE("{}", e.what());
+            if (state.process)
+                state.process->Kill(false);
+            else
+                std::rethrow_exception(std::current_exception());
+        }
     }
 
     void CommandRecordThread::Run() {
@@ -189,45 +237,56 @@ namespace skyline::gpu::interconnect {
 
         try {
             incoming.Process([this, renderDocApi, &gpu](Slot *slot) {
-                idle = false;
-                VkInstance instance{*gpu.vkInstance};
-                if (renderDocApi && slot->capture)
-                    renderDocApi->StartFrameCapture(RENDERDOC_DEVICEPOINTER_FROM_VKINSTANCE(instance), nullptr);
+                {
+                    std::scoped_lock lock{submitMutex};
+                    if (recordException)
+                        std::rethrow_exception(recordException);
+                }
 
-                ProcessSlot(slot);
+                auto sequence{nextRecordSequence++};
 
-                if (renderDocApi && slot->capture)
-                    renderDocApi->EndFrameCapture(RENDERDOC_DEVICEPOINTER_FROM_VKINSTANCE(instance), nullptr);
+                bool capture{renderDocApi && slot->capture};
                 slot->capture = false;
 
-                if (slot->didWait && (slots.size() + 1) < (1U << *state.settings->executorSlotCountScale)) {
-                    outgoing.Push(&slots.emplace_back(gpu));
-                    outgoing.Push(&slots.emplace_back(gpu));
-                    slot->didWait = false;
+                if (recordPool && !capture) {
+                    std::ignore = recordPool->submit([this, slot, sequence]() {
+                        try {
+                            RecordSlot(slot);
+                            SubmitSlot(slot, sequence);
+                        } catch (...) {
+                            AbortSubmission();
+                            try {
+                                HandleException();
+                            } catch (...) {
+                                // The future of the task is discarded, so forward the exception to the record thread rather than losing it
+                                std::scoped_lock lock{submitMutex};
+                                recordException = std::current_exception();
+                            }
+                        }
+                    });
+                    return;
                 }
 
-                outgoing.Push(slot);
-                idle = true;
+                // Captures must only contain the commands of a single slot, so any slots being recorded in parallel need to be submitted first
+                if (recordPool)
+                    recordPool->wait_for_tasks();
+
+                VkInstance instance{*gpu.vkInstance};
+                if (capture)
+                    renderDocApi->StartFrameCapture(RENDERDOC_DEVICEPOINTER_FROM_VKINSTANCE(instance), nullptr);
+
+                RecordSlot(slot);
+                SubmitSlot(slot, sequence);
+
+                if (capture)
+                    renderDocApi->EndFrameCapture(RENDERDOC_DEVICEPOINTER_FROM_VKINSTANCE(instance), nullptr);
             }, [] {});
-        } catch (const signal::SignalException &e) {
-            LOGE("{}\nStack Trace:{}", e.what(), state.loader->GetStackTrace(e.frames));
-            if (state.process)
-                state.process->Kill(false);
-            else
-                std::rethrow_exception(std::current_exception());
-        } catch (const std::exception &e) {
-            LOGE("{}", e.what());
-            if (state.process)
-                state.process->Kill(false);
-            else
-                std::rethrow_exception(std::current_exception());
+        } catch (...) {
+            AbortSubmission();
+            HandleException();
         }
     }
 
-    bool CommandRecordThread::IsIdle() const {
-        return idle;
-    }
-
     CommandRecordThread::Slot *CommandRecordThread::AcquireSlot() {
         auto startTime{util::GetTimeNs()};
         auto slot{outgoing.Pop()};
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <boost/container/stable_vector.hpp>
+#include <BS_thread_pool.hpp>
 #include <renderdoc_app.h>
 #include <common/linear_allocator.h>
 #include <gpu/usage_tracker.h>
@@ -16,6 +17,7 @@ namespace skyline::gpu::interconnect {
 
     /*
      * @brief Thread responsible for recording Vulkan commands from the execution nodes and submitting them
+     * @note Slots may be recorded in parallel on a pool of worker threads, this is possible as every execution starts with all state dirty and doesn't depend on prior executions during recording, they are always submitted in the order they were released in however
      */
     class CommandRecordThread {
       public:
@@ -73,19 +75,43 @@ namespace skyline::gpu::interconnect {
         CircularQueue<Slot *> incoming; //!< Slots pending recording
         CircularQueue<Slot *> outgoing; //!< Slots that have been submitted, may still be active on the GPU
         std::list<Slot> slots;
-        std::atomic<bool> idle;
+
+        std::optional<BS::thread_pool> recordPool; //!< A pool of threads that slots are recorded on in parallel, this is only used when more than a single record thread is requested
+        std::mutex submitMutex; //!< Synchronizes submission of slots and the slot list
+        std::condition_variable submitCondition; //!< Signalled after a slot has been submitted so the following slot can be submitted
+        u64 nextRecordSequence{}; //!< The sequence number that'll be assigned to the next slot that starts recording, this is only accessed by the record thread
+        u64 nextSubmitSequence{}; //!< The sequence number of the next slot to be submitted
+        bool submitAborted{}; //!< If a slot failed to be recorded or submitted, any slots waiting on its sequence number will never be submitted and must bail out
+        std::exception_ptr recordException; //!< An exception from a pool task that couldn't be handled on the pool thread, it's rethrown on the record thread
 
         std::thread thread;
 
-        void ProcessSlot(Slot *slot);
+        /**
+         * @brief Records all nodes of the slot into its command buffer and ends it
+         */
+        void RecordSlot(Slot *slot);
+
+        /**
+         * @brief Submits a recorded slot once all slots released before it have been submitted and returns it to the outgoing queue
+         */
+        void SubmitSlot(Slot *slot, u64 sequence);
+
+        /**
+         * @brief Stops all pending and future slot submissions and wakes any slots waiting to be submitted, this is used after a slot failed to record or submit
+         */
+        void AbortSubmission();
+
+        /**
+         * @brief Logs the exception that is currently being handled and kills the guest process
+         * @note This must be called from inside a catch block
+         */
+        void HandleException();
 
         void Run();
 
       public:
         CommandRecordThread(const DeviceState &state);
 
-        bool IsIdle() const;
-
         /**
          * @return A free slot, `Reset` needs to be called before accessing it
          */
@@ -355,6 +381,13 @@ namespace skyline::gpu::interconnect {
 
         std::optional<u32> GetRenderPassIndex();
 
+        /**
+         * @return If any commands have been recorded since the last submission
+         */
+        bool HasPendingNodes() const {
+            return !slot->nodes.empty();
+        }
+
         /**
          * @brief Records a checkpoint into the GPU command stream at the current
          * @param annotation A string annotation to display in perfetto for this checkpoint
@@ -3,7 +3,7 @@
 
 #include "file_pipeline_state_accessor.h"
 
-namespace skyline::gpu::interconnect::maxwell3d {
+namespace skyline::gpu::interconnect {
     FilePipelineStateAccessor::FilePipelineStateAccessor(PipelineStateBundle &bundle) : bundle{bundle} {}
 
     Shader::TextureType FilePipelineStateAccessor::GetTextureType(u32 index) const {
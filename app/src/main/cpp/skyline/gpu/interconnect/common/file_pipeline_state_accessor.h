@@ -6,7 +6,7 @@
 #include "pipeline_state_accessor.h"
 #include "pipeline_state_bundle.h"
 
-namespace skyline::gpu::interconnect::maxwell3d {
+namespace skyline::gpu::interconnect {
     /**
      * @brief Implements the PipelineStateAccessor interface for pipelines loaded from a file
      */
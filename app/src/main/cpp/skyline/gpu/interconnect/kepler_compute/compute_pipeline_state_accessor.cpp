@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2023 Strato Team and Contributors (https://github.com/strato-emu/)
+
+#include <gpu.h>
+#include <gpu/pipeline_cache_manager.h>
+#include "compute_pipeline_state_accessor.h"
+
+namespace skyline::gpu::interconnect::kepler_compute {
+    RuntimeComputePipelineStateAccessor::RuntimeComputePipelineStateAccessor(std::unique_ptr<PipelineStateBundle> bundle,
+                                                                             InterconnectContext &ctx,
+                                                                             Textures &textures, ConstantBufferSet &constantBuffers,
+                                                                             const ShaderBinary &shaderBinary)
+        : bundle{std::move(bundle)}, ctx{ctx}, textures{textures}, constantBuffers{constantBuffers}, shaderBinary{shaderBinary} {}
+
+    Shader::TextureType RuntimeComputePipelineStateAccessor::GetTextureType(u32 index) const {
+        Shader::TextureType type{textures.GetTextureType(ctx, index)};
+        bundle->AddTextureType(index, type);
+        return type;
+    }
+
+    u32 RuntimeComputePipelineStateAccessor::GetConstantBufferValue(u32 shaderStage, u32 index, u32 offset) const {
+        u32 value{constantBuffers[index].Read<u32>(ctx.executor, offset)};
+        bundle->AddConstantBufferValue(0, index, offset, value);
+        return value;
+    }
+
+    ShaderBinary RuntimeComputePipelineStateAccessor::GetShaderBinary(u32 pipelineStage) const {
+        bundle->SetShaderBinary(0, shaderBinary);
+        return shaderBinary;
+    }
+
+    void RuntimeComputePipelineStateAccessor::MarkComplete() {
+        if (ctx.gpu.computePipelineCacheManager)
+            ctx.gpu.computePipelineCacheManager->QueueWrite(std::move(bundle));
+    }
+}
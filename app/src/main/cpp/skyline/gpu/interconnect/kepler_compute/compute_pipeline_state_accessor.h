@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2023 Strato Team and Contributors (https://github.com/strato-emu/)
+
+#pragma once
+
+#include <gpu/interconnect/common/pipeline_state_accessor.h>
+#include <gpu/interconnect/common/pipeline_state_bundle.h>
+#include <gpu/interconnect/common/textures.h>
+#include "constant_buffers.h"
+
+namespace skyline::gpu::interconnect::kepler_compute {
+    /**
+     * @brief Implements the PipelineStateAccessor interface for compute pipelines created at emulator runtime
+     */
+    class RuntimeComputePipelineStateAccessor : public PipelineStateAccessor {
+      private:
+        std::unique_ptr<PipelineStateBundle> bundle;
+        InterconnectContext &ctx;
+        Textures &textures;
+        ConstantBufferSet &constantBuffers;
+        ShaderBinary shaderBinary;
+
+      public:
+        RuntimeComputePipelineStateAccessor(std::unique_ptr<PipelineStateBundle> bundle,
+                                            InterconnectContext &ctx,
+                                            Textures &textures, ConstantBufferSet &constantBuffers,
+                                            const ShaderBinary &shaderBinary);
+
+        Shader::TextureType GetTextureType(u32 index) const override;
+
+        /**
+         * @note Compute pipelines only have a single shader stage so `shaderStage` is ignored
+         */
+        u32 GetConstantBufferValue(u32 shaderStage, u32 index, u32 offset) const override;
+
+        ShaderBinary GetShaderBinary(u32 pipelineStage) const override;
+
+        void MarkComplete() override;
+    };
+}
@@ -4,28 +4,38 @@
 #include <gpu/texture/texture.h>
 #include <gpu/interconnect/command_executor.h>
 #include <gpu/interconnect/common/pipeline.inc>
+#include <gpu/interconnect/common/file_pipeline_state_accessor.h>
 #include <gpu/shader_manager.h>
 #include <gpu.h>
+#include "compute_pipeline_state_accessor.h"
 #include "pipeline_manager.h"
 
 namespace skyline::gpu::interconnect::kepler_compute {
-    static Pipeline::ShaderStage MakePipelineShader(InterconnectContext &ctx, Textures &textures, ConstantBufferSet &constantBuffers, const PackedPipelineState &packedState, const ShaderBinary &shaderBinary) {
-        ctx.gpu.shader->ResetPools();
+    static Pipeline::ShaderStage MakePipelineShader(GPU &gpu, const PipelineStateAccessor &accessor, const PackedPipelineState &packedState) {
+        gpu.shader->ResetPools();
 
-        auto program{ctx.gpu.shader->ParseComputeShader(
-            packedState.shaderHash, shaderBinary.binary, shaderBinary.baseOffset,
+        auto binary{accessor.GetShaderBinary(0)};
+        u64 sourceHash{util::HashCombine(util::HashCombine(0, packedState), binary.baseOffset)};
+
+        // Any state read by the shader compiler while parsing is also hashed, as it can change the resulting program
+        auto program{gpu.shader->ParseComputeShader(
+            packedState.shaderHash, binary.binary, binary.baseOffset,
             packedState.bindlessTextureConstantBufferSlotSelect,
             packedState.localMemorySize, packedState.sharedMemorySize,
             packedState.dimensions,
             [&](u32 index, u32 offset) {
-                return constantBuffers[index].Read<int>(ctx.executor, offset);
+                u32 value{accessor.GetConstantBufferValue(0, index, offset)};
+                sourceHash = util::HashCombine(sourceHash, std::array<u32, 3>{index, offset, value});
+                return value;
             }, [&](u32 index) {
-                return textures.GetTextureType(ctx, BindlessHandle{ .raw = index }.textureIndex);
+                auto type{accessor.GetTextureType(BindlessHandle{ .raw = index }.textureIndex)};
+                sourceHash = util::HashCombine(util::HashCombine(sourceHash, index), type);
+                return type;
             })};
 
         Shader::Backend::Bindings bindings{};
 
-        return {ctx.gpu.shader->CompileShader({}, program, bindings, packedState.shaderHash), program.info};
+        return {gpu.shader->CompileShader({}, program, bindings, packedState.shaderHash, sourceHash), program.info};
     }
 
     static Pipeline::DescriptorInfo MakePipelineDescriptorInfo(const Pipeline::ShaderStage &stage) {
@@ -64,17 +74,17 @@ namespace skyline::gpu::interconnect::kepler_compute {
         return descriptorInfo;
     }
 
-    static Pipeline::CompiledPipeline MakeCompiledPipeline(InterconnectContext &ctx,
+    static Pipeline::CompiledPipeline MakeCompiledPipeline(GPU &gpu,
                                                                                const PackedPipelineState &packedState,
                                                                                const Pipeline::ShaderStage &shaderStage,
                                                                                span<vk::DescriptorSetLayoutBinding> layoutBindings) {
-        vk::raii::DescriptorSetLayout descriptorSetLayout{ctx.gpu.vkDevice, vk::DescriptorSetLayoutCreateInfo{
-            .flags = vk::DescriptorSetLayoutCreateFlags{ctx.gpu.traits.supportsPushDescriptors ? vk::DescriptorSetLayoutCreateFlagBits::ePushDescriptorKHR : vk::DescriptorSetLayoutCreateFlags{}},
+        vk::raii::DescriptorSetLayout descriptorSetLayout{gpu.vkDevice, vk::DescriptorSetLayoutCreateInfo{
+            .flags = vk::DescriptorSetLayoutCreateFlags{gpu.traits.supportsPushDescriptors ? vk::DescriptorSetLayoutCreateFlagBits::ePushDescriptorKHR : vk::DescriptorSetLayoutCreateFlags{}},
             .pBindings = layoutBindings.data(),
             .bindingCount = static_cast<u32>(layoutBindings.size()),
         }};
 
-        vk::raii::PipelineLayout pipelineLayout{ctx.gpu.vkDevice, vk::PipelineLayoutCreateInfo{
+        vk::raii::PipelineLayout pipelineLayout{gpu.vkDevice, vk::PipelineLayoutCreateInfo{
             .pSetLayouts = &*descriptorSetLayout,
             .setLayoutCount = 1,
         }};
@@ -91,10 +101,10 @@ namespace skyline::gpu::interconnect::kepler_compute {
         };
 
 
-        if (ctx.gpu.traits.quirks.brokenMultithreadedPipelineCompilation)
-            ctx.gpu.graphicsPipelineAssembler->WaitIdle();
+        if (gpu.traits.quirks.brokenMultithreadedPipelineCompilation)
+            gpu.graphicsPipelineAssembler->WaitIdle();
 
-        vk::raii::Pipeline pipeline{ctx.gpu.vkDevice, nullptr, pipelineInfo};
+        vk::raii::Pipeline pipeline{gpu.vkDevice, nullptr, pipelineInfo};
 
         return Pipeline::CompiledPipeline{
             .pipeline = std::move(pipeline),
@@ -103,12 +113,13 @@ namespace skyline::gpu::interconnect::kepler_compute {
         };
     }
 
-    Pipeline::Pipeline(InterconnectContext &ctx, Textures &textures, ConstantBufferSet &constantBuffers, const PackedPipelineState &packedState, const ShaderBinary &shaderBinary)
-        : shaderStage{MakePipelineShader(ctx, textures, constantBuffers, packedState, shaderBinary)},
+    Pipeline::Pipeline(GPU &gpu, PipelineStateAccessor &accessor, const PackedPipelineState &packedState)
+        : shaderStage{MakePipelineShader(gpu, accessor, packedState)},
           descriptorInfo{MakePipelineDescriptorInfo(shaderStage)},
-          compiledPipeline{MakeCompiledPipeline(ctx, packedState, shaderStage, descriptorInfo.descriptorSetLayoutBindings)},
+          compiledPipeline{MakeCompiledPipeline(gpu, packedState, shaderStage, descriptorInfo.descriptorSetLayoutBindings)},
           sourcePackedState{packedState} {
         storageBufferViews.resize(shaderStage.info.storage_buffers_descriptors.size());
+        accessor.MarkComplete();
     }
 
     void Pipeline::SyncCachedStorageBufferViews(ContextTag executionTag) {
@@ -215,5 +226,41 @@ namespace skyline::gpu::interconnect::kepler_compute {
             .descriptorSetIndex = 0,
         });
     }
-}
 
+    PipelineManager::PipelineManager(GPU &gpu) {
+        if (!gpu.computePipelineCacheManager)
+            return;
+
+        auto [stream, totalPipelineCount]{gpu.computePipelineCacheManager->OpenReadStream()};
+        i64 lastKnownGoodOffset{stream.tellg()};
+        map.reserve(totalPipelineCount);
+
+        try {
+            auto startTime{util::GetTimeNs()};
+            PipelineStateBundle bundle;
+
+            while (bundle.Deserialise(stream)) {
+                lastKnownGoodOffset = stream.tellg();
+                auto accessor{FilePipelineStateAccessor{bundle}};
+                const auto &packedState{bundle.GetKey<PackedPipelineState>()};
+                map.emplace(packedState, std::make_unique<Pipeline>(gpu, accessor, packedState));
+            }
+
+            LOGI("Loaded {} compute pipelines in {}ms", map.size(), (util::GetTimeNs() - startTime) / constant::NsInMillisecond);
+        } catch (const exception &e) {
+            LOGW("Compute pipeline cache corrupted at: 0x{:X}, error: {}", lastKnownGoodOffset, e.what());
+            gpu.computePipelineCacheManager->InvalidateAllAfter(static_cast<u64>(lastKnownGoodOffset));
+        }
+    }
+
+    Pipeline *PipelineManager::FindOrCreate(InterconnectContext &ctx, Textures &textures, ConstantBufferSet &constantBuffers, const PackedPipelineState &packedState, const ShaderBinary &shaderBinary) {
+        auto it{map.find(packedState)};
+        if (it != map.end())
+            return it->second.get();
+
+        auto bundle{std::make_unique<PipelineStateBundle>()};
+        bundle->Reset(packedState);
+        auto accessor{RuntimeComputePipelineStateAccessor{std::move(bundle), ctx, textures, constantBuffers, shaderBinary}};
+        return map.emplace(packedState, std::make_unique<Pipeline>(ctx.gpu, accessor, packedState)).first->second.get();
+    }
+}
@@ -7,6 +7,7 @@
 #include <shader_compiler/frontend/ir/program.h>
 #include <gpu/interconnect/common/samplers.h>
 #include <gpu/interconnect/common/textures.h>
+#include <gpu/interconnect/common/pipeline_state_accessor.h>
 #include "packed_pipeline_state.h"
 #include "constant_buffers.h"
 
@@ -50,7 +51,7 @@ namespace skyline::gpu::interconnect::kepler_compute {
 
         PackedPipelineState sourcePackedState;
 
-        Pipeline(InterconnectContext &ctx, Textures &textures, ConstantBufferSet &constantBuffers, const PackedPipelineState &packedState, const ShaderBinary &shaderBinary);
+        Pipeline(GPU &gpu, PipelineStateAccessor &accessor, const PackedPipelineState &packedState);
 
         /**
          * @brief Creates a descriptor set update from the current GPU state
@@ -58,17 +59,19 @@ namespace skyline::gpu::interconnect::kepler_compute {
         DescriptorUpdateInfo *SyncDescriptors(InterconnectContext &ctx, ConstantBufferSet &constantBuffers, Samplers &samplers, Textures &textures, vk::PipelineStageFlags &srcStageMask, vk::PipelineStageFlags &dstStageMask);
     };
 
+    /**
+     * @brief Manages the caching and creation of compute pipelines
+     */
     class PipelineManager {
       private:
         tsl::robin_map<PackedPipelineState, std::unique_ptr<Pipeline>, util::ObjectHash<PackedPipelineState>> map;
 
       public:
-        Pipeline *FindOrCreate(InterconnectContext &ctx, Textures &textures, ConstantBufferSet &constantBuffers, const PackedPipelineState &packedState, const ShaderBinary &shaderBinary) {
-            auto it{map.find(packedState)};
-            if (it != map.end())
-                return it->second.get();
+        /**
+         * @brief Creates all pipelines in the compute pipeline cache, if it's enabled
+         */
+        PipelineManager(GPU &gpu);
 
-            return map.emplace(packedState, std::make_unique<Pipeline>(ctx, textures, constantBuffers, packedState, shaderBinary)).first->second.get();
-        }
+        Pipeline *FindOrCreate(InterconnectContext &ctx, Textures &textures, ConstantBufferSet &constantBuffers, const PackedPipelineState &packedState, const ShaderBinary &shaderBinary);
     };
 }
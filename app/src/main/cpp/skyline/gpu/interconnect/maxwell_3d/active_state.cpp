@@ -444,6 +444,10 @@ namespace skyline::gpu::interconnect::maxwell3d {
         auto updateFunc{[&](auto &stateElem, auto &&... args) { stateElem.Update(ctx, builder, args...); }};
         auto updateFuncBuffer{[&](auto &stateElem, auto &&... args) { stateElem.Update(ctx, builder, srcStageMask, dstStageMask, args...); }};
 
+        // Pipelines which are still being compiled asynchronously are looked up again for every draw so they're used as soon as they're ready
+        if (pipeline.Get().pipelinePending)
+            pipeline.MarkDirty(false);
+
         pipeline.Update(ctx, textures, constantBuffers, builder);
         ranges::for_each(vertexBuffers, updateFuncBuffer);
         if (indexed)
@@ -35,4 +35,8 @@ namespace skyline::gpu::interconnect::maxwell3d {
         if (ctx.gpu.graphicsPipelineCacheManager)
             ctx.gpu.graphicsPipelineCacheManager->QueueWrite(std::move(bundle));
     }
+
+    std::unique_ptr<PipelineStateBundle> RuntimeGraphicsPipelineStateAccessor::ReleaseBundle() {
+        return std::move(bundle);
+    }
 }
@@ -34,5 +34,10 @@ namespace skyline::gpu::interconnect::maxwell3d {
         ShaderBinary GetShaderBinary(u32 pipelineStage) const override;
 
         void MarkComplete() override;
+
+        /**
+         * @brief Releases ownership of the bundle without writing it to the pipeline cache, this is used when the pipeline is compiled from the bundle later on
+         */
+        std::unique_ptr<PipelineStateBundle> ReleaseBundle();
     };
 }
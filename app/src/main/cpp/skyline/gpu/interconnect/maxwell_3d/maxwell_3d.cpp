@@ -132,7 +132,7 @@ namespace skyline::gpu::interconnect::maxwell3d {
         return scissor;
     }
 
-     void Maxwell3D::PrepareDraw(StateUpdateBuilder &builder,
+     bool Maxwell3D::PrepareDraw(StateUpdateBuilder &builder,
                                  engine::DrawTopology topology, bool indexed, bool estimateIndexBufferSize, u32 firstIndex, u32 count,
                                  vk::PipelineStageFlags &srcStageMask, vk::PipelineStageFlags &dstStageMask) {
          Pipeline *oldPipeline{activeState.GetPipeline()};
@@ -142,6 +142,9 @@ namespace skyline::gpu::interconnect::maxwell3d {
                             indexed, topology, estimateIndexBufferSize, firstIndex, count,
                             srcStageMask, dstStageMask);
          Pipeline *pipeline{activeState.GetPipeline()};
+         if (!pipeline)
+             return false;
+
          activeDescriptorSetSampledImages.resize(pipeline->GetTotalSampledImageCount());
 
 
@@ -186,6 +189,17 @@ namespace skyline::gpu::interconnect::maxwell3d {
                  }
              }
          }
+
+         return true;
+    }
+
+    void Maxwell3D::SkipDraw(StateUpdateBuilder &builder, vk::PipelineStageFlags srcStageMask, vk::PipelineStageFlags dstStageMask) {
+        auto *stateUpdater{ctx.executor.allocator->EmplaceUntracked<StateUpdater>(builder.Build())};
+
+        constantBuffers.ResetQuickBind();
+        ctx.executor.AddSubpass([stateUpdater](vk::raii::CommandBuffer &commandBuffer, const std::shared_ptr<FenceCycle> &, GPU &gpu, vk::RenderPass, u32) {
+            stateUpdater->RecordAll(gpu, commandBuffer);
+        }, GetDrawScissor(), {}, {}, activeState.GetColorAttachments(), activeState.GetDepthAttachment(), !ctx.gpu.traits.quirks.relaxedRenderPassCompatibility, srcStageMask, dstStageMask);
     }
 
     void Maxwell3D::LoadConstantBuffer(span<u32> data, u32 offset) {
@@ -300,7 +314,10 @@ namespace skyline::gpu::interconnect::maxwell3d {
         StateUpdateBuilder builder{*ctx.executor.allocator};
         vk::PipelineStageFlags srcStageMask{}, dstStageMask{};
 
-        PrepareDraw(builder, topology, indexed, false, first, count, srcStageMask, dstStageMask);
+        if (!PrepareDraw(builder, topology, indexed, false, first, count, srcStageMask, dstStageMask)) {
+            SkipDraw(builder, srcStageMask, dstStageMask);
+            return;
+        }
 
         if (directState.inputAssembly.NeedsQuadConversion()) {
             count = conversion::quads::GetIndexCount(count);
@@ -364,7 +381,10 @@ namespace skyline::gpu::interconnect::maxwell3d {
         StateUpdateBuilder builder{*ctx.executor.allocator};
         vk::PipelineStageFlags srcStageMask{}, dstStageMask{};
 
-        PrepareDraw(builder, topology, indexed, true, 0, 0, srcStageMask, dstStageMask);
+        if (!PrepareDraw(builder, topology, indexed, true, 0, 0, srcStageMask, dstStageMask)) {
+            SkipDraw(builder, srcStageMask, dstStageMask);
+            return;
+        }
 
         if (directState.inputAssembly.NeedsQuadConversion())
             throw exception("Quad conversion is not supported for indirect draws!");
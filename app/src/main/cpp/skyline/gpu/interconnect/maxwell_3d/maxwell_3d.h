@@ -74,11 +74,18 @@ namespace skyline::gpu::interconnect::maxwell3d {
 
         /**
          * @brief Performs operations common across indirect and regular draws
+         * @return If the draw should be performed, this is false if there is no pipeline available for it as it's still being compiled
          */
-        void PrepareDraw(StateUpdateBuilder &builder,
+        bool PrepareDraw(StateUpdateBuilder &builder,
                          engine::DrawTopology topology, bool indexed, bool estimateIndexBufferSize, u32 firstIndex, u32 count,
                          vk::PipelineStageFlags &srcStageMask, vk::PipelineStageFlags &dstStageMask);
 
+        /**
+         * @brief Records the state updates from a draw which was skipped by PrepareDraw without performing the draw itself
+         * @note The state updates must still be recorded as they won't be repeated by subsequent draws
+         */
+        void SkipDraw(StateUpdateBuilder &builder, vk::PipelineStageFlags srcStageMask, vk::PipelineStageFlags dstStageMask);
+
       public:
         DirectPipelineState &directState;
 
@@ -17,11 +17,7 @@
 #include "soc/gm20b/engines/maxwell/types.h"
 
 namespace skyline::gpu::interconnect::maxwell3d {
-    struct ShaderStage {
-        vk::ShaderStageFlagBits stage;
-        vk::ShaderModule module;
-        Shader::Info info;
-    };
+    using ShaderStage = Pipeline::ShaderStage;
 
     static constexpr Shader::Stage ConvertCompilerShaderStage(engine::Pipeline::Shader::Type stage) {
         switch (stage) {
@@ -204,18 +200,30 @@ namespace skyline::gpu::interconnect::maxwell3d {
         auto stageIdx{[](PipelineStage stage) { return static_cast<u8>(stage); }};
 
         std::array<Shader::IR::Program, engine::PipelineCount> programs;
+        std::array<u64, engine::PipelineCount> sourceHashes{}; // A hash of all state each program was parsed from, used to look up its SPIR-V in the SPIR-V cache
         Shader::IR::Program *layerConversionSourceProgram{};
+        u64 layerConversionSourceHash{};
         bool ignoreVertexCullBeforeFetch{};
 
         for (u32 i{}; i < engine::PipelineCount; i++) {
             if (!packedState.shaderHashes[i]) {
-                if (i == stageIdx(PipelineStage::Geometry) && layerConversionSourceProgram)
-                    programs[i] = gpu.shader->GenerateGeometryPassthroughShader(*layerConversionSourceProgram, ConvertShaderOutputTopology(packedState.topology));
+                if (i == stageIdx(PipelineStage::Geometry) && layerConversionSourceProgram) {
+                    auto topology{ConvertShaderOutputTopology(packedState.topology)};
+                    programs[i] = gpu.shader->GenerateGeometryPassthroughShader(*layerConversionSourceProgram, topology);
+                    sourceHashes[i] = util::HashCombine(layerConversionSourceHash, topology);
+                }
 
                 continue;
             }
 
             auto binary{accessor.GetShaderBinary(i)};
+            u64 sourceHash{util::HashCombine(packedState.shaderHashes[i], i)};
+            sourceHash = util::HashCombine(sourceHash, binary.baseOffset);
+            sourceHash = util::HashCombine(sourceHash, packedState.postVtgShaderAttributeSkipMask);
+            sourceHash = util::HashCombine(sourceHash, static_cast<u8>(packedState.bindlessTextureConstantBufferSlotSelect));
+            sourceHash = util::HashCombine(sourceHash, static_cast<bool>(packedState.viewportTransformEnable));
+
+            // Any state read by the shader compiler while parsing is also hashed, as it can change the resulting program
             auto program{gpu.shader->ParseGraphicsShader(
                 packedState.postVtgShaderAttributeSkipMask,
                 ConvertCompilerShaderStage(static_cast<PipelineStage>(i)),
@@ -224,19 +232,27 @@ namespace skyline::gpu::interconnect::maxwell3d {
                 packedState.viewportTransformEnable,
                 [&](u32 index, u32 offset) {
                     u32 shaderStage{i > 0 ? (i - 1) : 0};
-                    return accessor.GetConstantBufferValue(shaderStage, index, offset);
+                    u32 value{accessor.GetConstantBufferValue(shaderStage, index, offset)};
+                    sourceHash = util::HashCombine(sourceHash, std::array<u32, 3>{index, offset, value});
+                    return value;
                 }, [&](u32 index) {
-                    return accessor.GetTextureType(BindlessHandle{ .raw = index }.textureIndex);
+                    auto type{accessor.GetTextureType(BindlessHandle{ .raw = index }.textureIndex)};
+                    sourceHash = util::HashCombine(util::HashCombine(sourceHash, index), type);
+                    return type;
                 })};
             if (i == stageIdx(PipelineStage::Vertex) && packedState.shaderHashes[stageIdx(PipelineStage::VertexCullBeforeFetch)]) {
                 ignoreVertexCullBeforeFetch = true;
                 programs[i] = gpu.shader->CombineVertexShaders(programs[stageIdx(PipelineStage::VertexCullBeforeFetch)], program, binary.binary);
+                sourceHashes[i] = util::HashCombine(sourceHash, sourceHashes[stageIdx(PipelineStage::VertexCullBeforeFetch)]);
             } else {
                 programs[i] = program;
+                sourceHashes[i] = sourceHash;
             }
 
-            if (programs[i].info.requires_layer_emulation)
+            if (programs[i].info.requires_layer_emulation) {
                 layerConversionSourceProgram = &programs[i];
+                layerConversionSourceHash = sourceHashes[i];
+            }
         }
 
         bool hasGeometry{packedState.shaderHashes[stageIdx(PipelineStage::Geometry)] && !programs[stageIdx(PipelineStage::Geometry)].is_geometry_passthrough};
@@ -251,7 +267,7 @@ namespace skyline::gpu::interconnect::maxwell3d {
 
             auto runtimeInfo{MakeRuntimeInfo(packedState, programs[i], lastProgram, hasGeometry)};
             shaderStages[i - (i >= 1 ? 1 : 0)] = {ConvertVkShaderStage(pipelineStage(i)),
-                                                  gpu.shader->CompileShader(runtimeInfo, programs[i], bindings, packedState.shaderHashes[i]),
+                                                  gpu.shader->CompileShader(runtimeInfo, programs[i], bindings, packedState.shaderHashes[i], sourceHashes[i]),
                                                   programs[i].info};
 
             lastProgram = &programs[i];
@@ -260,6 +276,32 @@ namespace skyline::gpu::interconnect::maxwell3d {
         return shaderStages;
     }
 
+    /**
+     * @brief Parses all shaders of a pipeline without compiling them, this records all guest state they depend on into the accessor's bundle
+     * @note Compiling the pipeline from the bundle afterwards will parse the shaders again, this is far cheaper than SPIR-V emission and linking which can then be done asynchronously
+     */
+    static void RecordPipelineShaderState(GPU &gpu, const PipelineStateAccessor &accessor, const PackedPipelineState &packedState) {
+        gpu.shader->ResetPools();
+
+        for (u32 i{}; i < engine::PipelineCount; i++) {
+            if (!packedState.shaderHashes[i])
+                continue;
+
+            auto binary{accessor.GetShaderBinary(i)};
+            gpu.shader->ParseGraphicsShader(
+                packedState.postVtgShaderAttributeSkipMask,
+                ConvertCompilerShaderStage(static_cast<engine::Pipeline::Shader::Type>(i)),
+                packedState.shaderHashes[i], binary.binary, binary.baseOffset,
+                packedState.bindlessTextureConstantBufferSlotSelect,
+                packedState.viewportTransformEnable,
+                [&](u32 index, u32 offset) {
+                    return accessor.GetConstantBufferValue(i > 0 ? (i - 1) : 0, index, offset);
+                }, [&](u32 index) {
+                    return accessor.GetTextureType(BindlessHandle{ .raw = index }.textureIndex);
+                });
+        }
+    }
+
     static vk::PipelineStageFlagBits ConvertShaderToPipelineStage(vk::ShaderStageFlagBits stage) {
         switch (stage) {
             case vk::ShaderStageFlagBits::eVertex:
@@ -485,6 +527,13 @@ namespace skyline::gpu::interconnect::maxwell3d {
         }
     }
 
+    /**
+     * @return The sample count pipelines are rasterized with for the supplied state
+     */
+    static vk::SampleCountFlagBits GetRasterizationSamples(const PackedPipelineState &) {
+        return vk::SampleCountFlagBits::e1; // TODO: Use the sample count of the render targets after MSAA support
+    }
+
     static GraphicsPipelineAssembler::CompiledPipeline MakeCompiledPipeline(GPU &gpu,
                                                                                  const PackedPipelineState &packedState,
                                                                                  const std::array<ShaderStage, engine::ShaderStageCount> &shaderStages,
@@ -574,8 +623,8 @@ namespace skyline::gpu::interconnect::maxwell3d {
             LOGW("Depth clamp used on guest without host support");
         rasterizationState.get<vk::PipelineRasterizationProvokingVertexStateCreateInfoEXT>().provokingVertexMode = ConvertProvokingVertex(packedState.provokingVertex);
 
-        constexpr vk::PipelineMultisampleStateCreateInfo multisampleState{
-            .rasterizationSamples = vk::SampleCountFlagBits::e1,
+        vk::PipelineMultisampleStateCreateInfo multisampleState{
+            .rasterizationSamples = GetRasterizationSamples(packedState),
         };
 
         vk::PipelineDepthStencilStateCreateInfo depthStencilState{
@@ -657,14 +706,16 @@ namespace skyline::gpu::interconnect::maxwell3d {
             .dynamicState = dynamicState,
             .colorFormats = colorAttachmentFormats,
             .depthStencilFormat = depthStencilFormat ? depthStencilFormat->vkFormat : vk::Format::eUndefined,
-            .sampleCount = vk::SampleCountFlagBits::e1, //TODO: fix after MSAA support
+            .sampleCount = GetRasterizationSamples(packedState),
             .destroyShaderModules = true
         }, layoutBindings);
     }
 
     Pipeline::Pipeline(GPU &gpu, PipelineStateAccessor &accessor, const PackedPipelineState &packedState)
+        : Pipeline{gpu, accessor, packedState, MakePipelineShaders(gpu, accessor, packedState)} {}
+
+    Pipeline::Pipeline(GPU &gpu, PipelineStateAccessor &accessor, const PackedPipelineState &packedState, const std::array<ShaderStage, engine::ShaderStageCount> &shaderStages)
         : sourcePackedState{packedState} {
-        auto shaderStages{MakePipelineShaders(gpu, accessor, sourcePackedState)};
         descriptorInfo = MakePipelineDescriptorInfo(shaderStages, gpu.traits.quirks.needsIndividualTextureBindingWrites);
         compiledPipeline = MakeCompiledPipeline(gpu, sourcePackedState, shaderStages, descriptorInfo.descriptorSetLayoutBindings);
 
@@ -944,7 +995,110 @@ namespace skyline::gpu::interconnect::maxwell3d {
         });
     }
 
-    PipelineManager::PipelineManager(GPU &gpu, JvmManager &jvm) {
+    void PipelineManager::AddSharedPipeline(Pipeline *pipeline) {
+        auto sharedIt{sharedPipelines.find(pipeline->sourcePackedState.shaderHashes)};
+        if (sharedIt == sharedPipelines.end())
+            sharedPipelines.emplace(pipeline->sourcePackedState.shaderHashes, std::list<Pipeline *>{pipeline});
+        else
+            sharedIt->second.push_back(pipeline);
+    }
+
+    /**
+     * @return If a pipeline created for one state can be used for a draw with the other without changing which primitives are rasterized, any other differences only affect the output of the draw
+     * @note Aside from render pass compatibility, this requires the exact same topology, vertex input and tessellation state as none of them are dynamic along with the same rasterization sample count
+     */
+    static bool IsFallbackCompatible(const PackedPipelineState &a, const PackedPipelineState &b) {
+        if (a.GetColorRenderTargetCount() != b.GetColorRenderTargetCount() || a.GetDepthRenderTargetFormat() != b.GetDepthRenderTargetFormat())
+            return false;
+
+        for (u32 i{}; i < a.GetColorRenderTargetCount(); i++)
+            if (a.GetColorRenderTargetFormat(a.ctSelect[i]) != b.GetColorRenderTargetFormat(b.ctSelect[i]))
+                return false;
+
+        if (a.topology != b.topology || a.primitiveRestartEnabled != b.primitiveRestartEnabled)
+            return false;
+
+        if (a.patchSize != b.patchSize || a.domainType != b.domainType || a.spacing != b.spacing || a.outputPrimitives != b.outputPrimitives)
+            return false;
+
+        for (u32 i{}; i < engine::VertexStreamCount; i++) {
+            const auto &aBinding{a.vertexBindings[i]}, &bBinding{b.vertexBindings[i]};
+            if (aBinding.enable != bBinding.enable || aBinding.inputRate != bBinding.inputRate || aBinding.divisor != bBinding.divisor)
+                return false;
+
+            // Strides are only set dynamically when the extended dynamic state is in use
+            if (!(a.dynamicStateActive && b.dynamicStateActive) && a.vertexStrides[i] != b.vertexStrides[i])
+                return false;
+        }
+
+        for (u32 i{}; i < engine::VertexAttributeCount; i++)
+            if (a.vertexAttributes[i].raw != b.vertexAttributes[i].raw)
+                return false;
+
+        return GetRasterizationSamples(a) == GetRasterizationSamples(b);
+    }
+
+    Pipeline *PipelineManager::FindFallback(const PackedPipelineState &packedState) {
+        auto sharedIt{sharedPipelines.find(packedState.shaderHashes)};
+        if (sharedIt == sharedPipelines.end())
+            return nullptr;
+
+        Pipeline *fallback{};
+        size_t fallbackDistance{std::numeric_limits<size_t>::max()};
+        for (auto *pipeline : sharedIt->second) {
+            if (!IsFallbackCompatible(pipeline->sourcePackedState, packedState) || !pipeline->compiledPipeline.pipeline.valid() || pipeline->compiledPipeline.pipeline.wait_for(std::chrono::seconds{}) != std::future_status::ready)
+                continue;
+
+            // The distance between two states is approximated by the amount of bytes that differ between them
+            auto lhs{reinterpret_cast<const u8 *>(&pipeline->sourcePackedState)}, rhs{reinterpret_cast<const u8 *>(&packedState)};
+            size_t distance{};
+            for (size_t i{}; i < sizeof(PackedPipelineState); i++)
+                distance += lhs[i] != rhs[i];
+
+            if (distance < fallbackDistance) {
+                fallback = pipeline;
+                fallbackDistance = distance;
+            }
+        }
+
+        return fallback;
+    }
+
+    void PipelineManager::QueuePipeline(InterconnectContext &ctx, Textures &textures, ConstantBufferSet &constantBuffers, const PackedPipelineState &packedState, const std::array<ShaderBinary, engine::PipelineCount> &shaderBinaries) {
+        TRACE_EVENT("gpu", "PipelineManager::QueuePipeline");
+
+        // All guest state the shaders depend on is recorded into the bundle on this thread, the pipeline can then be compiled from the bundle alone on the pipeline assembler's threads
+        auto bundle{std::make_unique<PipelineStateBundle>()};
+        bundle->Reset(packedState);
+        RuntimeGraphicsPipelineStateAccessor accessor{std::move(bundle), ctx, textures, constantBuffers, shaderBinaries};
+        RecordPipelineShaderState(ctx.gpu, accessor, packedState);
+        bundle = accessor.ReleaseBundle();
+
+        auto &gpu{ctx.gpu};
+        auto pipeline{gpu.graphicsPipelineAssembler->SubmitTask([&gpu, bundle = bundle.get()]() {
+            FilePipelineStateAccessor accessor{*bundle};
+            return std::make_unique<Pipeline>(gpu, accessor, bundle->GetKey<PackedPipelineState>());
+        })};
+
+        pendingPipelines.emplace(packedState, PendingPipeline{
+            .bundle = std::move(bundle),
+            .pipeline = std::move(pipeline),
+            .queueTime = util::GetTimeNs(),
+        });
+        asyncStatistics.queuedPipelines++;
+    }
+
+    void PipelineManager::TraceStatistics() {
+        TRACE_COUNTER("gpu", "Async Pipelines Queued", asyncStatistics.queuedPipelines);
+        TRACE_COUNTER("gpu", "Async Pipelines Pending", pendingPipelines.size());
+        TRACE_COUNTER("gpu", "Async Skipped Draws", asyncStatistics.skippedDraws);
+        TRACE_COUNTER("gpu", "Async Fallback Draws", asyncStatistics.fallbackDraws);
+        TRACE_COUNTER("gpu", "Async Pipelines Compiled", asyncStatistics.compiledPipelines);
+        TRACE_COUNTER("gpu", "Async Total Compile Latency", asyncStatistics.totalCompileLatency);
+        TRACE_COUNTER("gpu", "Async Max Compile Latency", asyncStatistics.maxCompileLatency);
+    }
+
+    PipelineManager::PipelineManager(GPU &gpu, JvmManager &jvm, u32 threadCount, bool asyncCompilation) : asyncCompilation{asyncCompilation} {
         if (!gpu.graphicsPipelineCacheManager)
             return;
 
@@ -957,27 +1111,78 @@ namespace skyline::gpu::interconnect::maxwell3d {
             jvm.UpdatePipelineLoadingProgress(++compiledCount);
         });
 
+        struct CachedPipeline {
+            std::unique_ptr<PipelineStateBundle> bundle;
+            i64 offset; //!< The offset of the bundle in the cache file
+            std::future<std::array<ShaderStage, engine::ShaderStageCount>> shaderStages;
+        };
+
+        std::vector<CachedPipeline> chunk;
+        chunk.reserve(CacheLoadChunkSize);
+
+        // Shader parsing and SPIR-V emission are independent for every pipeline so they're done across a dedicated pool, this is destroyed after loading to free the threads
+        BS::thread_pool compilePool{threadCount};
+
         try {
             auto startTime{util::GetTimeNs()};
-            PipelineStateBundle bundle;
-
-            while (bundle.Deserialise(stream)) {
-                lastKnownGoodOffset = stream.tellg();
-                auto accessor{FilePipelineStateAccessor{bundle}};
-                auto *pipeline{map.emplace(bundle.GetKey<PackedPipelineState>(), std::make_unique<Pipeline>(gpu, accessor, bundle.GetKey<PackedPipelineState>())).first.value().get()};
-                #ifdef PIPELINE_STATS
-                auto sharedIt{sharedPipelines.find(pipeline->sourcePackedState.shaderHashes)};
-                if (sharedIt == sharedPipelines.end())
-                    sharedPipelines.emplace(pipeline->sourcePackedState.shaderHashes, std::list<Pipeline *>{pipeline});
-                else
-                    sharedIt->second.push_back(pipeline);
-                #else
-                (void)pipeline;
-                #endif
+            i64 deserialiseTime{}, shaderTime{}, pipelineTime{};
+            bool endOfStream{};
+
+            while (!endOfStream) {
+                // Stage 1: Deserialise the next chunk of pipelines from the cache file
+                auto stageStartTime{util::GetTimeNs()};
+                chunk.clear();
+                while (chunk.size() < CacheLoadChunkSize) {
+                    auto bundle{std::make_unique<PipelineStateBundle>()};
+                    if (!bundle->Deserialise(stream)) {
+                        endOfStream = true;
+                        break;
+                    }
+
+                    chunk.push_back(CachedPipeline{std::move(bundle), lastKnownGoodOffset});
+                    lastKnownGoodOffset = stream.tellg();
+                }
+
+                auto deserialiseEndTime{util::GetTimeNs()};
+                deserialiseTime += deserialiseEndTime - stageStartTime;
+
+                // Stage 2: Parse and compile the shaders of every pipeline in the chunk concurrently
+                for (auto &pipeline : chunk)
+                    pipeline.shaderStages = compilePool.submit([&gpu, bundle = pipeline.bundle.get()]() {
+                        FilePipelineStateAccessor accessor{*bundle};
+                        return MakePipelineShaders(gpu, accessor, bundle->GetKey<PackedPipelineState>());
+                    });
+                compilePool.wait_for_tasks();
+
+                auto shaderEndTime{util::GetTimeNs()};
+                shaderTime += shaderEndTime - deserialiseEndTime;
+
+                // Stage 3: Create the Vulkan pipelines in cache order, these are linked asynchronously by the pipeline assembler
+                for (auto &cachedPipeline : chunk) {
+                    std::array<ShaderStage, engine::ShaderStageCount> shaderStages;
+                    try {
+                        shaderStages = cachedPipeline.shaderStages.get();
+                    } catch (...) {
+                        // Invalidate the pipeline that failed to compile alongside all pipelines after it
+                        lastKnownGoodOffset = cachedPipeline.offset;
+                        throw;
+                    }
+
+                    FilePipelineStateAccessor accessor{*cachedPipeline.bundle};
+                    const auto &key{cachedPipeline.bundle->GetKey<PackedPipelineState>()};
+                    AddSharedPipeline(map.emplace(key, std::make_unique<Pipeline>(gpu, accessor, key, shaderStages)).first.value().get());
+                }
+
+                pipelineTime += util::GetTimeNs() - shaderEndTime;
             }
 
+            auto waitStartTime{util::GetTimeNs()};
             gpu.graphicsPipelineAssembler->WaitIdle();
-            LOGI("Loaded {} graphics pipelines in {}ms", map.size(), (util::GetTimeNs() - startTime) / constant::NsInMillisecond);
+            pipelineTime += util::GetTimeNs() - waitStartTime;
+
+            LOGI("Loaded {} graphics pipelines in {}ms (Deserialisation: {}ms, Shader Compilation: {}ms on {} threads, Pipeline Creation: {}ms)",
+                 map.size(), (util::GetTimeNs() - startTime) / constant::NsInMillisecond,
+                 deserialiseTime / constant::NsInMillisecond, shaderTime / constant::NsInMillisecond, compilePool.get_thread_count(), pipelineTime / constant::NsInMillisecond);
 
             gpu.graphicsPipelineAssembler->SavePipelineCache();
 
@@ -1001,25 +1206,72 @@ namespace skyline::gpu::interconnect::maxwell3d {
         jvm.HidePipelineLoadingScreen();
     }
 
-    Pipeline *PipelineManager::FindOrCreate(InterconnectContext &ctx, Textures &textures, ConstantBufferSet &constantBuffers, const PackedPipelineState &packedState, const std::array<ShaderBinary, engine::PipelineCount> &shaderBinaries) {
+    PipelineManager::~PipelineManager() {
+        // Pending compilations reference bundles owned by the manager, so they must finish before it's destroyed
+        for (const auto &[packedState, pendingPipeline] : pendingPipelines)
+            if (pendingPipeline.pipeline.valid())
+                pendingPipeline.pipeline.wait();
+    }
+
+    Pipeline *PipelineManager::FindOrCreate(InterconnectContext &ctx, Textures &textures, ConstantBufferSet &constantBuffers, const PackedPipelineState &packedState, const std::array<ShaderBinary, engine::PipelineCount> &shaderBinaries, bool &pending) {
+        pending = false;
+
         auto it{map.find(packedState)};
         if (it != map.end())
             return it->second.get();
 
-        auto bundle{std::make_unique<PipelineStateBundle>()};
-        bundle->Reset(packedState);
-        auto accessor{RuntimeGraphicsPipelineStateAccessor{std::move(bundle), ctx, textures, constantBuffers, shaderBinaries}};
-        auto *pipeline{map.emplace(packedState, std::make_unique<Pipeline>(ctx.gpu, accessor, packedState)).first->second.get()};
+        if (!asyncCompilation) {
+            auto bundle{std::make_unique<PipelineStateBundle>()};
+            bundle->Reset(packedState);
+            auto accessor{RuntimeGraphicsPipelineStateAccessor{std::move(bundle), ctx, textures, constantBuffers, shaderBinaries}};
+            auto *pipeline{map.emplace(packedState, std::make_unique<Pipeline>(ctx.gpu, accessor, packedState)).first->second.get()};
+            AddSharedPipeline(pipeline);
+            return pipeline;
+        }
 
-        #ifdef PIPELINE_STATS
-        auto sharedIt{sharedPipelines.find(pipeline->sourcePackedState.shaderHashes)};
-        if (sharedIt == sharedPipelines.end())
-            sharedPipelines.emplace(pipeline->sourcePackedState.shaderHashes, std::list<Pipeline *>{pipeline});
+        auto pendingIt{pendingPipelines.find(packedState)};
+        if (pendingIt == pendingPipelines.end()) {
+            QueuePipeline(ctx, textures, constantBuffers, packedState, shaderBinaries);
+        } else {
+            auto &pendingPipeline{pendingIt.value()};
+            if (!pendingPipeline.result && pendingPipeline.pipeline.wait_for(std::chrono::seconds{}) == std::future_status::ready) {
+                try {
+                    pendingPipeline.result = pendingPipeline.pipeline.get(); // This will rethrow any exceptions from compilation
+                } catch (...) {
+                    // The future has been consumed by get(), the entry must be removed so it's never waited on again
+                    pendingPipelines.erase(pendingIt);
+                    throw;
+                }
+            }
+
+            // The Vulkan pipeline is linked in a separate task, it needs to be ready too as recording would otherwise block on it
+            if (pendingPipeline.result && pendingPipeline.result->compiledPipeline.pipeline.wait_for(std::chrono::seconds{}) == std::future_status::ready) {
+                auto latency{static_cast<u64>(util::GetTimeNs() - pendingPipeline.queueTime)};
+                asyncStatistics.compiledPipelines++;
+                asyncStatistics.totalCompileLatency += latency;
+                asyncStatistics.maxCompileLatency = std::max(asyncStatistics.maxCompileLatency, latency);
+
+                if (ctx.gpu.graphicsPipelineCacheManager)
+                    ctx.gpu.graphicsPipelineCacheManager->QueueWrite(std::move(pendingPipeline.bundle));
+
+                auto *pipeline{map.emplace(packedState, std::move(pendingPipeline.result)).first->second.get()};
+                AddSharedPipeline(pipeline);
+                pendingPipelines.erase(pendingIt);
+
+                TraceStatistics();
+                return pipeline;
+            }
+        }
+
+        pending = true;
+        auto *fallback{FindFallback(packedState)};
+        if (fallback)
+            asyncStatistics.fallbackDraws++;
         else
-            sharedIt->second.push_back(pipeline);
-        #endif
+            asyncStatistics.skippedDraws++;
 
-        return pipeline;
+        TraceStatistics();
+        return fallback;
     }
 }
 
@@ -11,6 +11,7 @@
 #include <gpu/interconnect/common/samplers.h>
 #include <gpu/interconnect/common/textures.h>
 #include <gpu/interconnect/common/pipeline_state_accessor.h>
+#include <gpu/interconnect/common/pipeline_state_bundle.h>
 #include "common.h"
 #include "packed_pipeline_state.h"
 #include "constant_buffers.h"
@@ -22,6 +23,12 @@ namespace skyline::gpu {
 namespace skyline::gpu::interconnect::maxwell3d {
     class Pipeline {
       public:
+        struct ShaderStage {
+            vk::ShaderStageFlagBits stage;
+            vk::ShaderModule module;
+            Shader::Info info;
+        };
+
         /**
          * @brief A monolithic struct containing all the descriptor state of the pipeline
          */
@@ -232,6 +239,11 @@ namespace skyline::gpu::interconnect::maxwell3d {
 
         Pipeline(GPU &gpu, PipelineStateAccessor &accessor, const PackedPipelineState &packedState);
 
+        /**
+         * @brief Creates a pipeline from shader stages which were already compiled from the supplied state
+         */
+        Pipeline(GPU &gpu, PipelineStateAccessor &accessor, const PackedPipelineState &packedState, const std::array<ShaderStage, engine::ShaderStageCount> &shaderStages);
+
         /**
          * @brief Returns the pipeline in the transition cache (if present) that matches the given state
          */
@@ -263,17 +275,81 @@ namespace skyline::gpu::interconnect::maxwell3d {
      * @brief Manages the caching and creation of pipelines
      */
     class PipelineManager {
+      public:
+        /**
+         * @brief Counters for asynchronous pipeline compilation, these are only modified on the GPFIFO thread
+         */
+        struct AsyncCompilationStatistics {
+            u64 queuedPipelines; //!< The amount of pipelines that were queued for asynchronous compilation
+            u64 compiledPipelines; //!< The amount of asynchronously compiled pipelines that have been used for a draw
+            u64 skippedDraws; //!< The amount of draws that were skipped as no compatible pipeline was available
+            u64 fallbackDraws; //!< The amount of draws that used a different variant of the same shaders as their pipeline was still compiling
+            u64 totalCompileLatency; //!< The total time in nanoseconds between pipelines being queued and first being used, this divided by `compiledPipelines` is the average latency
+            u64 maxCompileLatency; //!< The highest time in nanoseconds between a pipeline being queued and first being used
+        };
+
       private:
+        /**
+         * @brief A pipeline which is being compiled asynchronously
+         */
+        struct PendingPipeline {
+            std::unique_ptr<PipelineStateBundle> bundle; //!< The state the pipeline is compiled from, this is written to the pipeline cache once compilation has finished
+            std::future<std::unique_ptr<Pipeline>> pipeline;
+            std::unique_ptr<Pipeline> result; //!< The compiled pipeline retrieved from `pipeline`, this is held until the Vulkan pipeline has finished linking
+            i64 queueTime; //!< The time at which the pipeline was queued for compilation
+        };
+
         tsl::robin_map<PackedPipelineState, std::unique_ptr<Pipeline>, PackedPipelineStateHash> map;
+        std::unordered_map<std::array<u64, engine::PipelineCount>, std::list<Pipeline*>, util::ObjectHash<std::array<u64, engine::PipelineCount>>> sharedPipelines; //!< Maps a shader set to all pipelines sharing that same set
 
         #ifdef PIPELINE_STATS
-        std::unordered_map<std::array<u64, engine::PipelineCount>, std::list<Pipeline*>, util::ObjectHash<std::array<u64, engine::PipelineCount>>> sharedPipelines; //!< Maps a shader set to all pipelines sharing that same set
         std::vector<std::list<Pipeline*>*> sortedSharedPipelines; //!< Sorted list of shared pipelines
         #endif
 
+        bool asyncCompilation; //!< If pipelines are compiled on the pipeline assembler's thread pool rather than blocking the GPFIFO thread
+        tsl::robin_map<PackedPipelineState, PendingPipeline, PackedPipelineStateHash> pendingPipelines; //!< Pipelines which are still being compiled asynchronously
+        AsyncCompilationStatistics asyncStatistics{};
+
+        static constexpr size_t CacheLoadChunkSize{512}; //!< The amount of pipelines that are deserialised from the cache and compiled at once when loading it
+
+        /**
+         * @brief Inserts a fully created pipeline into the map of pipelines sharing the same shaders
+         */
+        void AddSharedPipeline(Pipeline *pipeline);
+
+        /**
+         * @return The pipeline that's most similar to the supplied state out of all ready pipelines with the same shaders and compatible attachments, or nullptr if there are none
+         */
+        Pipeline *FindFallback(const PackedPipelineState &packedState);
+
+        /**
+         * @brief Queues the compilation of a pipeline on the pipeline assembler's thread pool
+         */
+        void QueuePipeline(InterconnectContext &ctx, Textures &textures, ConstantBufferSet &constantBuffers, const PackedPipelineState &packedState, const std::array<ShaderBinary, engine::PipelineCount> &shaderBinaries);
+
+        /**
+         * @brief Emits the current asynchronous compilation statistics as trace counters
+         */
+        void TraceStatistics();
+
       public:
-        PipelineManager(GPU &gpu, JvmManager &jvm);
+        /**
+         * @param threadCount The amount of threads used to compile shaders from the pipeline cache, 0 uses every available core
+         * @param asyncCompilation If pipelines that aren't cached should be compiled asynchronously
+         */
+        PipelineManager(GPU &gpu, JvmManager &jvm, u32 threadCount, bool asyncCompilation);
+
+        ~PipelineManager();
+
+        /**
+         * @param[out] pending Set to true if the returned pipeline isn't the one for the supplied state as it's still being compiled, the lookup should be repeated for subsequent draws in this case
+         * @return The pipeline for the supplied state, a fallback pipeline or nullptr if the draw should be skipped as no pipeline is available yet
+         * @note Fallback pipelines and nullptr are only returned when asynchronous compilation is enabled
+         */
+        Pipeline *FindOrCreate(InterconnectContext &ctx, Textures &textures, ConstantBufferSet &constantBuffers, const PackedPipelineState &packedState, const std::array<ShaderBinary, engine::PipelineCount> &shaderBinaries, bool &pending);
 
-        Pipeline *FindOrCreate(InterconnectContext &ctx, Textures &textures, ConstantBufferSet &constantBuffers, const PackedPipelineState &packedState, const std::array<ShaderBinary, engine::PipelineCount> &shaderBinaries);
+        const AsyncCompilationStatistics &GetAsyncStatistics() const {
+            return asyncStatistics;
+        }
     };
 }
@@ -427,21 +427,25 @@ namespace skyline::gpu::interconnect::maxwell3d {
         transformFeedback.Update(packedState);
         globalShaderConfig.Update(packedState);
 
-        if (pipeline) {
+        if (pipeline && !pipelinePending) {
             if (auto newPipeline{pipeline->LookupNext(packedState)}) {
                 pipeline = newPipeline;
                 return;
             }
         }
 
-        auto newPipeline{ctx.gpu.graphicsPipelineManager->FindOrCreate(ctx, textures, constantBuffers, packedState, shaderBinaries)};
-        if (pipeline)
+        bool newPipelinePending{};
+        auto newPipeline{ctx.gpu.graphicsPipelineManager->FindOrCreate(ctx, textures, constantBuffers, packedState, shaderBinaries, newPipelinePending)};
+        // Transitions are only recorded between pipelines that exactly match their state, fallback pipelines are never cached
+        if (pipeline && !pipelinePending && !newPipelinePending)
             pipeline->AddTransition(newPipeline);
         pipeline = newPipeline;
+        pipelinePending = newPipelinePending;
     }
 
     void PipelineState::PurgeCaches() {
         pipeline = nullptr;
+        pipelinePending = false;
         for (auto &stage : pipelineStages)
             stage.MarkDirty(true);
     }
@@ -321,7 +321,8 @@ namespace skyline::gpu::interconnect::maxwell3d {
 
       public:
         DirectPipelineState directState;
-        Pipeline *pipeline{};
+        Pipeline *pipeline{}; //!< The pipeline for the current state, this may be a fallback or nullptr if `pipelinePending` is set
+        bool pipelinePending{}; //!< If the pipeline for the current state is still being compiled asynchronously, the state must be flushed again for every draw until it's ready
         boost::container::static_vector<TextureView *, engine::ColorTargetCount> colorAttachments;
         TextureView *depthAttachment{};
 
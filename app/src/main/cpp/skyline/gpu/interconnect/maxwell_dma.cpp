@@ -2,6 +2,7 @@
 // Copyright © 2022 Ryujinx Team and Contributors (https://github.com/ryujinx/)
 // Copyright © 2022 Skyline Team and Contributors (https://github.com/skyline-emu/)
 
+#include <gpu.h>
 #include <gpu/buffer_manager.h>
 #include <soc/gm20b/gmmu.h>
 #include <soc/gm20b/channel.h>
@@ -80,4 +81,35 @@ namespace skyline::gpu::interconnect {
             }, {}, {});
         });
     }
+
+    void MaxwellDma::CopyBlockLinear(span<u8> dstMapping, span<u8> srcMapping, const BlockLinearCopyHelperShader::CopyParameters &parameters, bool blockLinearToPitch) {
+        auto srcBuf{gpu.buffer.FindOrCreate(srcMapping, executor.tag, [this](std::shared_ptr<Buffer> buffer, ContextLock<Buffer> &&lock) {
+            executor.AttachLockedBuffer(buffer, std::move(lock));
+        })};
+        executor.AttachBuffer(srcBuf);
+
+        auto dstBuf{gpu.buffer.FindOrCreate(dstMapping, executor.tag, [this](std::shared_ptr<Buffer> buffer, ContextLock<Buffer> &&lock) {
+            executor.AttachLockedBuffer(buffer, std::move(lock));
+        })};
+        executor.AttachBuffer(dstBuf);
+
+        // The source only needs to be protected from CPU writes for the duration of the usage while the destination is written to on the GPU
+        srcBuf.GetBuffer()->BlockAllCpuBackingWrites();
+        dstBuf.GetBuffer()->BlockSequencedCpuBackingWrites();
+        dstBuf.GetBuffer()->MarkGpuDirty(executor.usageTracker);
+
+        executor.AddOutsideRpCommand([srcBuf, dstBuf, parameters, blockLinearToPitch](vk::raii::CommandBuffer &commandBuffer, const std::shared_ptr<FenceCycle> &cycle, GPU &gpu) {
+            commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands, vk::PipelineStageFlagBits::eComputeShader, {}, vk::MemoryBarrier{
+                .srcAccessMask = vk::AccessFlagBits::eMemoryWrite,
+                .dstAccessMask = vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite
+            }, {}, {});
+
+            gpu.helperShaders.blockLinearCopyHelperShader.Copy(gpu, commandBuffer, cycle, srcBuf.GetBinding(gpu), dstBuf.GetBinding(gpu), parameters, blockLinearToPitch);
+
+            commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader, vk::PipelineStageFlagBits::eAllCommands, {}, vk::MemoryBarrier{
+                .srcAccessMask = vk::AccessFlagBits::eShaderWrite,
+                .dstAccessMask = vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite,
+            }, {}, {});
+        });
+    }
 }
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <soc/gm20b/gmmu.h>
+#include <gpu/shaders/helper_shaders.h>
 
 namespace skyline::gpu {
     class GPU;
@@ -32,5 +33,11 @@ namespace skyline::gpu::interconnect {
         void Copy(span<u8> dstMapping, span<u8> srcMapping);
 
         void Clear(span<u8> mapping, u32 value);
+
+        /**
+         * @brief Records a copy between a block-linear and a pitch-linear mapping which is (de)swizzled on the GPU
+         * @param blockLinearToPitch If the source mapping is block-linear and the destination is pitch-linear, the inverse is true otherwise
+         */
+        void CopyBlockLinear(span<u8> dstMapping, span<u8> srcMapping, const BlockLinearCopyHelperShader::CopyParameters &parameters, bool blockLinearToPitch);
     };
 }
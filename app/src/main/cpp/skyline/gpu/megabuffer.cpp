@@ -2,63 +2,88 @@
 // Copyright © 2021 Skyline Team and Contributors (https://github.com/skyline-emu/)
 
 #include <gpu.h>
+#include <common/settings.h>
+#include <common/trace.h>
 #include "megabuffer.h"
 
 namespace skyline::gpu {
-    MegaBufferChunk::MegaBufferChunk(GPU &gpu) : backing{gpu.memory.AllocateBuffer(MegaBufferChunkSize)}, freeRegion{backing.subspan(PAGE_SIZE)} {}
-
-    bool MegaBufferChunk::TryReset() {
-        if (cycle && cycle->Poll(true)) {
-            freeRegion = backing.subspan(PAGE_SIZE);
-            cycle = nullptr;
-            return true;
-        }
-
-        return cycle == nullptr;
-    }
+    MegaBufferChunk::MegaBufferChunk(GPU &gpu) : MegaBufferRing{MegaBufferChunkSize}, backing{gpu.memory.AllocateBuffer(MegaBufferChunkSize)} {}
 
     vk::Buffer MegaBufferChunk::GetBacking() const {
         return backing.vkBuffer;
     }
 
-    std::pair<vk::DeviceSize, span<u8>> MegaBufferChunk::Allocate(const std::shared_ptr<FenceCycle> &newCycle, vk::DeviceSize size, bool pageAlign) {
-        if (pageAlign) {
-            // If page aligned data was requested then align the free
-            auto alignedFreeBase{util::AlignUp(static_cast<size_t>(freeRegion.data() - backing.data()), PAGE_SIZE)};
-            freeRegion = backing.subspan(alignedFreeBase);
-        }
-
-        if (size > freeRegion.size())
+    std::pair<vk::DeviceSize, span<u8>> MegaBufferChunk::Allocate(const std::shared_ptr<FenceCycle> &cycle, u64 sequence, vk::DeviceSize size, bool pageAlign) {
+        auto offset{Reserve(cycle, sequence, size, pageAlign)};
+        if (!offset)
             return {0, {}};
 
-        if (cycle != newCycle) {
-            newCycle->ChainCycle(cycle);
-            cycle = newCycle;
-        }
-
-        // Allocate space for data from the free region
-        auto resultSpan{freeRegion.subspan(0, size)};
+        return {offset, backing.subspan(offset, size)};
+    }
 
-        // Move the free region along
-        freeRegion = freeRegion.subspan(size);
+    MegaBufferAllocator::MegaBufferAllocator(GPU &gpu)
+        : gpu{gpu},
+          activeChunk{chunks.emplace(chunks.end(), gpu)},
+          maxSize{std::max<vk::DeviceSize>(static_cast<vk::DeviceSize>(*gpu.state.settings->megaBufferMaxSize) * 1024 * 1024, MegaBufferChunkSize)} {
+        statistics.totalSize = MegaBufferChunkSize;
+    }
 
-        return {static_cast<vk::DeviceSize>(resultSpan.data() - backing.data()), resultSpan};
+    std::pair<vk::DeviceSize, span<u8>> MegaBufferAllocator::TryAllocate(decltype(chunks)::iterator chunk, const std::shared_ptr<FenceCycle> &cycle, vk::DeviceSize size, bool pageAlign) {
+        auto allocation{chunk->Allocate(cycle, allocationSequence, size, pageAlign)};
+        if (allocation.first)
+            activeChunk = chunk;
+        return allocation;
     }
 
-    MegaBufferAllocator::MegaBufferAllocator(GPU &gpu) : gpu{gpu}, activeChunk{chunks.emplace(chunks.end(), gpu)} {}
+    void MegaBufferAllocator::Free(vk::DeviceSize size) {
+        statistics.usedSize.fetch_sub(size, std::memory_order_relaxed);
+    }
 
     MegaBufferAllocator::Allocation MegaBufferAllocator::Allocate(const std::shared_ptr<FenceCycle> &cycle, vk::DeviceSize size, bool pageAlign) {
-        if (auto allocation{activeChunk->Allocate(cycle, size, pageAlign)}; allocation.first)
-            return {activeChunk->GetBacking(), allocation.first, allocation.second};
+        if (size > MegaBufferChunkSize - PAGE_SIZE)
+            throw exception("Failed to to allocate megabuffer space for size: 0x{:X}", size);
+
+        auto allocation{TryAllocate(activeChunk, cycle, size, pageAlign)};
+        if (!allocation.first) {
+            // Reclaim any space that was freed up by retired cycles and find the first chunk that can fit the allocation
+            for (auto chunk{chunks.begin()}; chunk != chunks.end(); chunk++) {
+                Free(chunk->Reclaim());
+                if (!allocation.first)
+                    allocation = TryAllocate(chunk, cycle, size, pageAlign);
+            }
+        }
 
-        activeChunk = ranges::find_if(chunks, [&](auto &chunk) { return chunk.TryReset(); });
-        if (activeChunk == chunks.end()) // If there are no chunks available, allocate a new one
-            activeChunk = chunks.emplace(chunks.end(), gpu);
+        if (!allocation.first && chunks.size() * MegaBufferChunkSize >= maxSize) {
+            // If we're at the size limit, wait on the GPU to free up space starting from the oldest region in any chunk
+            bool stalled{};
+            while (!allocation.first) {
+                auto chunk{FindOldestWaitableRing(chunks.begin(), chunks.end(), cycle)};
+                if (chunk == chunks.end())
+                    break; // All remaining space is used by the current cycle or cycles that haven't been submitted yet, we have no choice but to exceed the limit
+
+                stalled = true;
+                Free(chunk->ReclaimOldest(cycle));
+                allocation = TryAllocate(chunk, cycle, size, pageAlign);
+            }
+
+            if (stalled)
+                statistics.stalls.fetch_add(1, std::memory_order_relaxed);
+        }
 
-        if (auto allocation{activeChunk->Allocate(cycle, size, pageAlign)}; allocation.first)
-            return {activeChunk->GetBacking(), allocation.first, allocation.second};
-        else
-            throw exception("Failed to to allocate megabuffer space for size: 0x{:X}", size);
+        if (!allocation.first) {
+            allocation = TryAllocate(chunks.emplace(chunks.end(), gpu), cycle, size, pageAlign);
+            statistics.totalSize.fetch_add(MegaBufferChunkSize, std::memory_order_relaxed);
+            if (chunks.size() * MegaBufferChunkSize > maxSize)
+                LOGW("Exceeded megabuffer size limit with {} chunks", chunks.size());
+        }
+
+        auto usedSize{statistics.usedSize.fetch_add(size, std::memory_order_relaxed) + size};
+        if (usedSize > statistics.highWaterMark.load(std::memory_order_relaxed))
+            statistics.highWaterMark.store(usedSize, std::memory_order_relaxed);
+        statistics.frameAllocations.fetch_add(1, std::memory_order_relaxed);
+        allocationSequence++;
+
+        return {activeChunk->GetBacking(), allocation.first, allocation.second};
     }
 
     MegaBufferAllocator::Allocation MegaBufferAllocator::Push(const std::shared_ptr<FenceCycle> &cycle, span<u8> data, bool pageAlign) {
@@ -66,4 +91,12 @@ namespace skyline::gpu {
         allocation.region.copy_from(data);
         return allocation;
     }
+
+    void MegaBufferAllocator::TraceFrameStatistics() {
+        TRACE_COUNTER("gpu", "MegaBuffer Total Size", statistics.totalSize.load(std::memory_order_relaxed));
+        TRACE_COUNTER("gpu", "MegaBuffer Used Size", statistics.usedSize.load(std::memory_order_relaxed));
+        TRACE_COUNTER("gpu", "MegaBuffer High-Water Mark", statistics.highWaterMark.load(std::memory_order_relaxed));
+        TRACE_COUNTER("gpu", "MegaBuffer Frame Allocations", statistics.frameAllocations.exchange(0, std::memory_order_relaxed));
+        TRACE_COUNTER("gpu", "MegaBuffer Stalls", statistics.stalls.load(std::memory_order_relaxed));
+    }
 }
@@ -4,35 +4,32 @@
 #pragma once
 
 #include "memory_manager.h"
+#include "megabuffer_ring.h"
 
 namespace skyline::gpu {
     constexpr static vk::DeviceSize MegaBufferChunkSize{25 * 1024 * 1024}; //!< Size in bytes of a single megabuffer chunk (25MiB)
 
     /**
-      * @brief A simple linearly allocated GPU-side buffer used to temporarily store buffer modifications allowing them to be replayed in-sequence on the GPU
+      * @brief A GPU-side ring buffer used to temporarily store buffer modifications allowing them to be replayed in-sequence on the GPU
       * @note This class is **not** thread-safe and any calls must be externally synchronized
       */
-    class MegaBufferChunk {
+    class MegaBufferChunk : public MegaBufferRing<FenceCycle> {
       private:
-        std::shared_ptr<FenceCycle> cycle; //!< Latest cycle this chunk has had allocations in
         memory::Buffer backing; //!< The GPU buffer as the backing storage for the chunk
-        span<u8> freeRegion; //!< The unallocated space in the chunk
 
       public:
         MegaBufferChunk(GPU &gpu);
 
-        /**
-         * @brief If the chunk's cycle is is signalled, resets the free region of the megabuffer to its initial state, if it's not signalled the chunk must not be used
-         * @returns True if the chunk can be reused, false otherwise
-         */
-        bool TryReset();
-
         /**
          * @brief Returns the underlying Vulkan buffer for the chunk
          */
         vk::Buffer GetBacking() const;
 
-        std::pair<vk::DeviceSize, span<u8>> Allocate(const std::shared_ptr<FenceCycle> &newCycle, vk::DeviceSize size, bool pageAlign = false);
+        /**
+         * @param sequence The sequence number of the allocation in the allocator, see MegaBufferRing::Reserve
+         * @return The offset and CPU mapping of the allocation, or an offset of 0 if there wasn't enough contiguous free space
+         */
+        std::pair<vk::DeviceSize, span<u8>> Allocate(const std::shared_ptr<FenceCycle> &cycle, u64 sequence, vk::DeviceSize size, bool pageAlign = false);
     };
 
     /**
@@ -40,10 +37,35 @@ namespace skyline::gpu {
      * @note This class is not thread-safe and any calls must be externally synchronized
      */
     class MegaBufferAllocator {
+      public:
+        /**
+         * @brief Counters for the memory usage of the allocator, these are atomic so they can be read from any thread
+         */
+        struct Statistics {
+            std::atomic<u64> totalSize; //!< The total size of all allocated chunks
+            std::atomic<u64> usedSize; //!< The sum of the sizes of all allocations that may still be in use by the GPU
+            std::atomic<u64> highWaterMark; //!< The highest value of `usedSize` observed
+            std::atomic<u64> frameAllocations; //!< The amount of allocations since the last call to TraceFrameStatistics
+            std::atomic<u64> stalls; //!< The amount of allocations which had to wait on the GPU due to the size limit being reached
+        };
+
       private:
         GPU &gpu;
         std::list<MegaBufferChunk> chunks; //!< A pool of all allocated megabuffer chunks, these are dynamically utilized
         decltype(chunks)::iterator activeChunk; //!< Currently active chunk of the megabuffer which is being allocated into
+        vk::DeviceSize maxSize; //!< The size that the total size of all chunks should not exceed, this is only exceeded when the current cycle and unsubmitted cycles fill up every chunk by themselves
+        u64 allocationSequence{}; //!< The sequence number of the next allocation, this is used to find the oldest region across all chunks
+        Statistics statistics{};
+
+        /**
+         * @brief Tries to allocate in the supplied chunk and makes it the active chunk on success
+         */
+        std::pair<vk::DeviceSize, span<u8>> TryAllocate(decltype(chunks)::iterator chunk, const std::shared_ptr<FenceCycle> &cycle, vk::DeviceSize size, bool pageAlign);
+
+        /**
+         * @brief Records the freeing of allocations with the supplied total size in the statistics
+         */
+        void Free(vk::DeviceSize size);
 
       public:
         /**
@@ -74,5 +96,15 @@ namespace skyline::gpu {
          * @note The allocator *MUST* be locked before calling this function
          */
         Allocation Push(const std::shared_ptr<FenceCycle> &cycle, span<u8> data, bool pageAlign = false);
+
+        /**
+         * @brief Emits the current statistics as trace counters and resets the per-frame counters
+         * @note This is thread-safe and is intended to be called once per presented frame
+         */
+        void TraceFrameStatistics();
+
+        const Statistics &GetStatistics() const {
+            return statistics;
+        }
     };
 }
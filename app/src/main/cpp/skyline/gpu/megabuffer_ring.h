@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2023 Strato Team and Contributors (https://github.com/strato-emu/)
+
+#pragma once
+
+#include <deque>
+#include <optional>
+#include <common.h>
+
+namespace skyline::gpu {
+    /**
+     * @brief The space management of a megabuffer chunk, allocations are grouped into regions by the cycle they're used in and space is reclaimed from the tail of the ring as soon as the cycle of the oldest region is signalled
+     * @tparam CycleType The type of cycle that allocations are used by, this must implement Poll, IsSubmitted and Wait with the same semantics as FenceCycle
+     * @note This is separate from MegaBufferChunk so it doesn't depend on any GPU resources
+     * @note This class is **not** thread-safe and any calls must be externally synchronized
+     */
+    template<typename CycleType>
+    class MegaBufferRing {
+      private:
+        /**
+         * @brief A contiguous range of allocations in the ring that are all used by the same cycle
+         */
+        struct Region {
+            std::shared_ptr<CycleType> cycle;
+            u64 sequence; //!< The sequence number of the first allocation in the region, this orders regions across all rings of an allocator
+            u64 offset; //!< The offset of the first allocation in the region
+            u64 end; //!< The offset directly after the last allocation in the region
+            u64 allocatedSize{}; //!< The sum of the sizes of all allocations in the region, this excludes any alignment padding
+        };
+
+        u64 size; //!< The size of the ring in bytes
+        std::deque<Region> regions; //!< All regions that may still be in use by the GPU, ordered from oldest to newest
+        u64 head{PAGE_SIZE}; //!< The offset at which the next allocation will be made, the first page is never allocated as an offset of 0 denotes an invalid allocation
+
+      public:
+        MegaBufferRing(u64 size) : size{size} {}
+
+        /**
+         * @brief Frees all regions at the tail of the ring whose cycles have been signalled
+         * @return The sum of the sizes of all allocations that were freed
+         */
+        u64 Reclaim() {
+            u64 freedSize{};
+            while (!regions.empty() && regions.front().cycle->Poll(true)) {
+                freedSize += regions.front().allocatedSize;
+                regions.pop_front();
+            }
+
+            if (regions.empty())
+                head = PAGE_SIZE;
+
+            return freedSize;
+        }
+
+        /**
+         * @return The sequence number of the oldest region in the ring if it can be waited on while recording the supplied cycle, the current cycle and cycles that haven't been submitted can't be waited on
+         */
+        std::optional<u64> GetOldestWaitableSequence(const std::shared_ptr<CycleType> &cycle) const {
+            if (regions.empty() || regions.front().cycle == cycle || !regions.front().cycle->IsSubmitted())
+                return std::nullopt;
+            return regions.front().sequence;
+        }
+
+        /**
+         * @brief Waits on the cycle of the oldest region in the ring and frees it
+         * @param cycle The cycle that is currently being recorded, this can't be waited on as it hasn't been submitted yet
+         * @return The sum of the sizes of all allocations that were freed, or 0 if there was no region that could be waited on
+         */
+        u64 ReclaimOldest(const std::shared_ptr<CycleType> &cycle) {
+            if (!GetOldestWaitableSequence(cycle))
+                return 0;
+
+            regions.front().cycle->Wait();
+            return Reclaim();
+        }
+
+        /**
+         * @brief Reserves space in the ring for an allocation used by the supplied cycle
+         * @param sequence The sequence number of the allocation, this must be higher than that of any prior allocation from the same allocator
+         * @return The offset of the allocation, or 0 if there wasn't enough contiguous free space
+         */
+        u64 Reserve(const std::shared_ptr<CycleType> &cycle, u64 sequence, u64 allocationSize, bool pageAlign = false) {
+            if (!allocationSize)
+                return PAGE_SIZE; // Empty allocations don't need any backing so they don't occupy space in the ring
+
+            u64 offset{pageAlign ? util::AlignUp(head, PAGE_SIZE) : head};
+            bool wrapped{};
+            if (regions.empty()) {
+                if (offset + allocationSize > size)
+                    return 0;
+            } else {
+                u64 tail{regions.front().offset};
+                if (regions.back().offset >= tail) {
+                    // The used space is contiguous, allocate after it or wrap around to the start of the ring if there's not enough space at the end
+                    if (offset + allocationSize > size) {
+                        offset = PAGE_SIZE;
+                        wrapped = true;
+                        if (offset + allocationSize > tail)
+                            return 0;
+                    }
+                } else if (offset + allocationSize > tail) {
+                    return 0; // The used space has wrapped around already, we can only allocate up to the tail
+                }
+            }
+
+            if (wrapped || regions.empty() || regions.back().cycle != cycle)
+                regions.push_back(Region{cycle, sequence, offset, offset + allocationSize});
+            else
+                regions.back().end = offset + allocationSize;
+
+            regions.back().allocatedSize += allocationSize;
+
+            head = offset + allocationSize;
+            return offset;
+        }
+    };
+
+    /**
+     * @return The ring out of the supplied ones which has the oldest region that can be waited on while recording the supplied cycle, or the end iterator if there is no such ring
+     */
+    template<typename Iterator, typename CycleType>
+    Iterator FindOldestWaitableRing(Iterator begin, Iterator end, const std::shared_ptr<CycleType> &cycle) {
+        Iterator oldest{end};
+        u64 oldestSequence{};
+        for (auto it{begin}; it != end; it++) {
+            auto sequence{it->GetOldestWaitableSequence(cycle)};
+            if (sequence && (oldest == end || *sequence < oldestSequence)) {
+                oldest = it;
+                oldestSequence = *sequence;
+            }
+        }
+        return oldest;
+    }
+}
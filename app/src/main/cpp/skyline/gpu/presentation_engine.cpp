@@ -221,6 +221,7 @@ namespace skyline::gpu {
             Fps = static_cast<jint>(std::round(static_cast<float>(constant::NsInSecond) / static_cast<float>(averageFrametimeNs)));
 
             TRACE_EVENT_INSTANT("gpu", "Present", presentationTrack, "FrameTimeNs", timestamp - frameTimestamp, "Fps", Fps);
+            gpu.megaBufferAllocator.TraceFrameStatistics();
 
             frameTimestamp = timestamp;
         } else {
@@ -72,7 +72,9 @@ namespace skyline::gpu {
         return binary;
     }
 
-    ShaderManager::ShaderManager(const DeviceState &state, GPU &gpu, std::string_view replacementDir, std::string_view dumpDir) : gpu{gpu}, dumpPath{dumpDir} {
+    thread_local ShaderManager::Pools ShaderManager::pools{};
+
+    ShaderManager::ShaderManager(const DeviceState &state, GPU &gpu, std::string_view replacementDir, std::string_view dumpDir, std::string_view spirvCachePath) : gpu{gpu}, dumpPath{dumpDir} {
         LoadShaderReplacements(replacementDir);
 
         if constexpr (DumpShaders) {
@@ -143,6 +145,18 @@ namespace skyline::gpu {
                 .active = false,
             },
         };
+
+        if (!spirvCachePath.empty()) {
+            // The profile is derived from the host GPU, its driver and the settings, any change to these could change the emitted SPIR-V
+            auto properties{gpu.vkPhysicalDevice.getProperties()};
+            u64 hostHash{XXH64(properties.pipelineCacheUUID.data(), VK_UUID_SIZE, 0)};
+            hostHash = util::HashCombine(hostHash, properties.vendorID);
+            hostHash = util::HashCombine(hostHash, properties.deviceID);
+            hostHash = util::HashCombine(hostHash, properties.driverVersion);
+            hostHash = util::HashCombine(hostHash, profile.disable_subgroup_shuffle);
+            hostHash = util::HashCombine(hostHash, Shader::Settings::values.renderer_debug);
+            spirvCache.emplace(std::string{spirvCachePath}, hostHash);
+        }
     }
 
     /**
@@ -388,24 +402,18 @@ namespace skyline::gpu {
                                                            const ConstantBufferRead &constantBufferRead, const GetTextureType &getTextureType) {
         binary = ProcessShaderBinary(false, hash, binary);
 
-        std::scoped_lock lock{poolMutex};
-
         GraphicsEnvironment environment{postVtgShaderAttributeSkipMask, stage, binary, baseOffset, textureConstantBufferIndex, viewportTransformEnabled, constantBufferRead, getTextureType};
-        Shader::Maxwell::Flow::CFG cfg{environment, flowBlockPool, Shader::Maxwell::Location{static_cast<u32>(baseOffset + sizeof(Shader::ProgramHeader))}};
-        return  Shader::Maxwell::TranslateProgram(instructionPool, blockPool, environment, cfg, hostTranslateInfo);
+        Shader::Maxwell::Flow::CFG cfg{environment, pools.flowBlock, Shader::Maxwell::Location{static_cast<u32>(baseOffset + sizeof(Shader::ProgramHeader))}};
+        return  Shader::Maxwell::TranslateProgram(pools.instruction, pools.block, environment, cfg, hostTranslateInfo);
     }
 
     Shader::IR::Program ShaderManager::CombineVertexShaders(Shader::IR::Program &vertexA, Shader::IR::Program &vertexB, span<u8> vertexBBinary) {
-        std::scoped_lock lock{poolMutex};
-
         VertexBEnvironment env{vertexBBinary};
         return Shader::Maxwell::MergeDualVertexPrograms(vertexA, vertexB, env);
     }
 
     Shader::IR::Program ShaderManager::GenerateGeometryPassthroughShader(Shader::IR::Program &layerSource, Shader::OutputTopology topology) {
-        std::scoped_lock lock{poolMutex};
-
-        return Shader::Maxwell::GenerateGeometryPassthrough(instructionPool, blockPool, hostTranslateInfo, layerSource, topology);
+        return Shader::Maxwell::GenerateGeometryPassthrough(pools.instruction, pools.block, hostTranslateInfo, layerSource, topology);
     }
 
     Shader::IR::Program ShaderManager::ParseComputeShader(u64 hash, span<u8> binary, u32 baseOffset,
@@ -415,20 +423,50 @@ namespace skyline::gpu {
                                                           const ConstantBufferRead &constantBufferRead, const GetTextureType &getTextureType) {
         binary = ProcessShaderBinary(false, hash, binary);
 
-        std::scoped_lock lock{poolMutex};
-
         ComputeEnvironment environment{binary, baseOffset, textureConstantBufferIndex, localMemorySize, sharedMemorySize, workgroupDimensions, constantBufferRead, getTextureType};
-        Shader::Maxwell::Flow::CFG cfg{environment, flowBlockPool, Shader::Maxwell::Location{static_cast<u32>(baseOffset)}};
-        return Shader::Maxwell::TranslateProgram(instructionPool, blockPool, environment, cfg, hostTranslateInfo);
+        Shader::Maxwell::Flow::CFG cfg{environment, pools.flowBlock, Shader::Maxwell::Location{static_cast<u32>(baseOffset)}};
+        return Shader::Maxwell::TranslateProgram(pools.instruction, pools.block, environment, cfg, hostTranslateInfo);
     }
 
-    vk::ShaderModule ShaderManager::CompileShader(const Shader::RuntimeInfo &runtimeInfo, Shader::IR::Program &program, Shader::Backend::Bindings &bindings, u64 hash) {
-        std::scoped_lock lock{poolMutex};
+    /**
+     * @return A hash of the source of a program alongside all other state which affects the SPIR-V emitted for it
+     */
+    static u64 HashCompileState(u64 sourceHash, const Shader::RuntimeInfo &runtimeInfo, const Shader::Backend::Bindings &bindings) {
+        u64 hash{util::HashCombine(sourceHash, bindings)};
+        hash = util::HashCombine(hash, runtimeInfo.previous_stage_stores);
+        hash = util::HashCombine(hash, runtimeInfo.generic_input_types);
+        hash = util::HashCombine(hash, runtimeInfo.convert_depth_mode);
+        hash = util::HashCombine(hash, runtimeInfo.force_early_z);
+        hash = util::HashCombine(hash, runtimeInfo.y_negate);
+        hash = util::HashCombine(hash, runtimeInfo.input_topology);
+        hash = util::HashCombine(hash, runtimeInfo.tess_primitive);
+        hash = util::HashCombine(hash, runtimeInfo.tess_spacing);
+        hash = util::HashCombine(hash, runtimeInfo.tess_clockwise);
+        // Optionals are hashed by their members as they contain padding
+        hash = util::HashCombine(hash, runtimeInfo.fixed_state_point_size.has_value());
+        hash = util::HashCombine(hash, runtimeInfo.fixed_state_point_size.value_or(0.0f));
+        hash = util::HashCombine(hash, runtimeInfo.alpha_test_func.has_value());
+        hash = util::HashCombine(hash, runtimeInfo.alpha_test_func.value_or(Shader::CompareFunction{}));
+        hash = util::HashCombine(hash, runtimeInfo.alpha_test_reference);
+        return XXH64(runtimeInfo.xfb_varyings.data(), runtimeInfo.xfb_varyings.size() * sizeof(Shader::TransformFeedbackVarying), hash);
+    }
 
+    vk::ShaderModule ShaderManager::CompileShader(const Shader::RuntimeInfo &runtimeInfo, Shader::IR::Program &program, Shader::Backend::Bindings &bindings, u64 hash, u64 sourceHash) {
+        // This is done even when the SPIR-V is cached as the pipeline relies on the program info being updated
         if (program.info.loads.Legacy() || program.info.stores.Legacy())
             Shader::Maxwell::ConvertLegacyToGeneric(program, runtimeInfo);
 
-        auto spirvEmitted{Shader::Backend::SPIRV::EmitSPIRV(profile, runtimeInfo, program, bindings)};
+        u64 cacheKey{spirvCache && sourceHash ? HashCompileState(sourceHash, runtimeInfo, bindings) : 0};
+        std::vector<u32> spirvEmitted;
+        if (auto entry{cacheKey ? spirvCache->Lookup(cacheKey) : std::nullopt}) {
+            spirvEmitted = std::move(entry->spirv);
+            bindings = entry->bindings;
+        } else {
+            spirvEmitted = Shader::Backend::SPIRV::EmitSPIRV(profile, runtimeInfo, program, bindings);
+            if (cacheKey)
+                spirvCache->Insert(cacheKey, spirvEmitted, bindings);
+        }
+
         auto spirv{ProcessShaderBinary(true, hash, span<u32>{spirvEmitted}.cast<u8>()).cast<u32>()};
 
         vk::ShaderModuleCreateInfo createInfo{
@@ -440,10 +478,8 @@ namespace skyline::gpu {
     }
 
     void ShaderManager::ResetPools() {
-        std::scoped_lock lock{poolMutex};
-
-        instructionPool.ReleaseContents();
-        blockPool.ReleaseContents();
-        flowBlockPool.ReleaseContents();
+        pools.instruction.ReleaseContents();
+        pools.block.ReleaseContents();
+        pools.flowBlock.ReleaseContents();
     }
 }
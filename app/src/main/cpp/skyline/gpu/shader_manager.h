@@ -15,6 +15,7 @@
 #include <shader_compiler/runtime_info.h>
 #include <shader_compiler/backend/bindings.h>
 #include <common.h>
+#include "spirv_cache_manager.h"
 
 namespace skyline::gpu {
     /**
@@ -25,15 +26,24 @@ namespace skyline::gpu {
         GPU &gpu;
         Shader::HostTranslateInfo hostTranslateInfo;
         Shader::Profile profile;
-        Shader::ObjectPool<Shader::Maxwell::Flow::Block> flowBlockPool;
-        Shader::ObjectPool<Shader::IR::Inst> instructionPool;
-        Shader::ObjectPool<Shader::IR::Block> blockPool;
+
+        /**
+         * @brief The object pools backing the IR of shader programs, these are thread-local so that shaders can be parsed and compiled on multiple threads concurrently
+         */
+        struct Pools {
+            Shader::ObjectPool<Shader::Maxwell::Flow::Block> flowBlock;
+            Shader::ObjectPool<Shader::IR::Inst> instruction;
+            Shader::ObjectPool<Shader::IR::Block> block;
+        };
+
+        static thread_local Pools pools;
+
         std::unordered_map<u64, std::vector<u8>> guestShaderReplacements; //!< Map of guest shader hash -> replacement guest shader binary, populated at init time and must not be modified after
         std::unordered_map<u64, std::vector<u8>> hostShaderReplacements; //!< ^^ same as above but for host
 
-        std::mutex poolMutex;
         std::filesystem::path dumpPath;
         std::mutex dumpMutex;
+        std::optional<SpirvCacheManager> spirvCache; //!< The persistent cache of compiled SPIR-V, this is only present when the shader cache is enabled
 
         /**
          * @brief Called at init time to populate the shader replacements map from the input directory
@@ -50,7 +60,10 @@ namespace skyline::gpu {
         using ConstantBufferRead = std::function<u32(u32 index, u32 offset)>; //!< A function which reads a constant buffer at the specified offset and returns the value
         using GetTextureType = std::function<Shader::TextureType(u32 handle)>; //!< A function which determines the type of a texture from its handle by checking the corresponding TIC
 
-        ShaderManager(const DeviceState &state, GPU &gpu, std::string_view replacementDir, std::string_view dumpDir);
+        /**
+         * @param spirvCachePath The path to the SPIR-V cache file, the cache is disabled if this is empty
+         */
+        ShaderManager(const DeviceState &state, GPU &gpu, std::string_view replacementDir, std::string_view dumpDir, std::string_view spirvCachePath);
 
         /**
          * @return A shader program that corresponds to all the supplied state including the current state of the constant buffers
@@ -70,8 +83,15 @@ namespace skyline::gpu {
 
         Shader::IR::Program ParseComputeShader(u64 hash, span<u8> binary, u32 baseOffset, u32 textureConstantBufferIndex, u32 localMemorySize, u32 sharedMemorySize, std::array<u32, 3> workgroupDimensions, const ConstantBufferRead &constantBufferRead, const GetTextureType &getTextureType);
 
-        vk::ShaderModule CompileShader(const Shader::RuntimeInfo &runtimeInfo, Shader::IR::Program &program, Shader::Backend::Bindings &bindings, u64 hash = 0);
+        /**
+         * @param hash The hash of the guest shader binary, this is used for shader replacement and dumping
+         * @param sourceHash A hash of all inputs the program was parsed from, if this is non-zero the SPIR-V cache is used to skip emitting SPIR-V for programs which were compiled with identical state before
+         */
+        vk::ShaderModule CompileShader(const Shader::RuntimeInfo &runtimeInfo, Shader::IR::Program &program, Shader::Backend::Bindings &bindings, u64 hash = 0, u64 sourceHash = 0);
 
+        /**
+         * @brief Releases all IR objects allocated by the calling thread, any programs previously parsed on it must not be used after this
+         */
         void ResetPools();
     };
 }
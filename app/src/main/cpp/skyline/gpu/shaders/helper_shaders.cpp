@@ -4,6 +4,7 @@
 #include <gpu.h>
 #include <gpu/descriptor_allocator.h>
 #include <gpu/texture/texture.h>
+#include <gpu/buffer.h>
 #include <gpu/graphics_pipeline_assembler.h>
 #include <vfs/filesystem.h>
 #include "helper_shaders.h"
@@ -389,8 +390,141 @@ namespace skyline::gpu {
         });
     }
 
+    namespace block_linear_copy {
+        struct PushConstantLayout {
+            u32 srcOffset;
+            u32 dstOffset;
+            u32 dstSize;
+            glsl::Bool blockLinearToPitch;
+            u32 pitch;
+            u32 lineLength;
+            u32 lineCount;
+            u32 depth;
+            u32 blockLinearWidth;
+            u32 blockLinearHeight;
+            u32 gobBlockHeight;
+            u32 gobBlockDepth;
+            u32 originX;
+            u32 originY;
+        };
+
+        constexpr static vk::PushConstantRange PushConstantRange{
+            .stageFlags = vk::ShaderStageFlagBits::eCompute,
+            .size = sizeof(PushConstantLayout),
+            .offset = 0
+        };
+
+        constexpr static std::array<vk::DescriptorSetLayoutBinding, 2> LayoutBindings{
+            vk::DescriptorSetLayoutBinding{
+                .binding = 0,
+                .descriptorType = vk::DescriptorType::eStorageBuffer,
+                .descriptorCount = 1,
+                .stageFlags = vk::ShaderStageFlagBits::eCompute
+            }, vk::DescriptorSetLayoutBinding{
+                .binding = 1,
+                .descriptorType = vk::DescriptorType::eStorageBuffer,
+                .descriptorCount = 1,
+                .stageFlags = vk::ShaderStageFlagBits::eCompute
+            }
+        };
+
+        constexpr static u32 WorkgroupSize{64}; //!< The local size of the compute shader, each invocation writes a single word
+    }
+
+    BlockLinearCopyHelperShader::BlockLinearCopyHelperShader(GPU &gpu, std::shared_ptr<vfs::FileSystem> shaderFileSystem)
+        : shaderModule{CreateShaderModule(gpu, *shaderFileSystem->OpenFile("shaders/block_linear_copy.comp.spv"))},
+          descriptorSetLayout{gpu.vkDevice, vk::DescriptorSetLayoutCreateInfo{
+              .pBindings = block_linear_copy::LayoutBindings.data(),
+              .bindingCount = static_cast<u32>(block_linear_copy::LayoutBindings.size())
+          }},
+          pipelineLayout{gpu.vkDevice, vk::PipelineLayoutCreateInfo{
+              .pSetLayouts = &*descriptorSetLayout,
+              .setLayoutCount = 1,
+              .pPushConstantRanges = &block_linear_copy::PushConstantRange,
+              .pushConstantRangeCount = 1
+          }},
+          pipeline{gpu.vkDevice, nullptr, vk::ComputePipelineCreateInfo{
+              .stage = {
+                  .stage = vk::ShaderStageFlagBits::eCompute,
+                  .module = *shaderModule,
+                  .pName = "main"
+              },
+              .layout = *pipelineLayout
+          }} {}
+
+    void BlockLinearCopyHelperShader::Copy(GPU &gpu, vk::raii::CommandBuffer &commandBuffer, const std::shared_ptr<FenceCycle> &cycle,
+                                           BufferBinding src, BufferBinding dst,
+                                           const CopyParameters &parameters, bool blockLinearToPitch) {
+        // Storage buffer bindings must be aligned so the remainder is passed to the shader, the bindings extend to the end of the buffers to cover any words the copy partially overlaps
+        vk::DeviceSize srcAlignedOffset{util::AlignDown(src.offset, gpu.traits.minimumStorageBufferAlignment)};
+        vk::DeviceSize dstAlignedOffset{util::AlignDown(dst.offset, gpu.traits.minimumStorageBufferAlignment)};
+
+        block_linear_copy::PushConstantLayout pushConstants{
+            .srcOffset = static_cast<u32>(src.offset - srcAlignedOffset),
+            .dstOffset = static_cast<u32>(dst.offset - dstAlignedOffset),
+            .dstSize = static_cast<u32>(dst.size),
+            .blockLinearToPitch = blockLinearToPitch,
+            .pitch = parameters.pitch,
+            .lineLength = parameters.lineLength,
+            .lineCount = parameters.lineCount,
+            .depth = parameters.depth,
+            .blockLinearWidth = parameters.blockLinearWidth,
+            .blockLinearHeight = parameters.blockLinearHeight,
+            .gobBlockHeight = parameters.gobBlockHeight,
+            .gobBlockDepth = parameters.gobBlockDepth,
+            .originX = parameters.originX,
+            .originY = parameters.originY
+        };
+
+        auto descriptorSet{std::make_shared<DescriptorAllocator::ActiveDescriptorSet>(gpu.descriptor.AllocateSet(*descriptorSetLayout))};
+        cycle->AttachObject(descriptorSet);
+
+        std::array<vk::DescriptorBufferInfo, 2> bufferInfos{
+            vk::DescriptorBufferInfo{
+                .buffer = src.buffer,
+                .offset = srcAlignedOffset,
+                .range = VK_WHOLE_SIZE
+            }, vk::DescriptorBufferInfo{
+                .buffer = dst.buffer,
+                .offset = dstAlignedOffset,
+                .range = VK_WHOLE_SIZE
+            }
+        };
+
+        std::array<vk::WriteDescriptorSet, 2> writes{
+            vk::WriteDescriptorSet{
+                .dstSet = **descriptorSet,
+                .dstBinding = 0,
+                .descriptorCount = 1,
+                .descriptorType = vk::DescriptorType::eStorageBuffer,
+                .pBufferInfo = &bufferInfos[0]
+            }, vk::WriteDescriptorSet{
+                .dstSet = **descriptorSet,
+                .dstBinding = 1,
+                .descriptorCount = 1,
+                .descriptorType = vk::DescriptorType::eStorageBuffer,
+                .pBufferInfo = &bufferInfos[1]
+            }
+        };
+
+        gpu.vkDevice.updateDescriptorSets(writes, nullptr);
+
+        u32 dstWordCount{static_cast<u32>(util::DivideCeil<vk::DeviceSize>(pushConstants.dstOffset % 4 + dst.size, 4))};
+
+        commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, *pipeline);
+        commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute, *pipelineLayout, 0, **descriptorSet, nullptr);
+        commandBuffer.pushConstants(*pipelineLayout, vk::ShaderStageFlagBits::eCompute, 0,
+                                    vk::ArrayProxy<const block_linear_copy::PushConstantLayout>{pushConstants});
+        // Vulkan only guarantees 65535 workgroups in each dimension, which a 1D dispatch exceeds for destinations larger than 16MiB
+        constexpr u32 MaxWorkgroupCountX{0xFFFF};
+        u32 workgroupCount{util::DivideCeil(dstWordCount, block_linear_copy::WorkgroupSize)};
+        u32 workgroupCountX{std::min(workgroupCount, MaxWorkgroupCountX)};
+        commandBuffer.dispatch(workgroupCountX, workgroupCountX ? util::DivideCeil(workgroupCount, workgroupCountX) : 0, 1);
+    }
+
     HelperShaders::HelperShaders(GPU &gpu, std::shared_ptr<vfs::FileSystem> shaderFileSystem)
         : blitHelperShader(gpu, shaderFileSystem),
-          clearHelperShader(gpu, shaderFileSystem) {}
+          clearHelperShader(gpu, shaderFileSystem),
+          blockLinearCopyHelperShader(gpu, shaderFileSystem) {}
 
 }
\ No newline at end of file
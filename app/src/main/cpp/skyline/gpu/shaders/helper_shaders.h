@@ -13,6 +13,7 @@ namespace skyline::vfs {
 
 namespace skyline::gpu {
     class TextureView;
+    struct BufferBinding;
     class GPU;
 
     /**
@@ -108,12 +109,52 @@ namespace skyline::gpu {
                   std::function<void(std::function<void(vk::raii::CommandBuffer &, const std::shared_ptr<FenceCycle> &, GPU &, vk::RenderPass, u32)> &&)> &&recordCb);
     };
 
+    /**
+     * @brief Compute helper shader for copying between block-linear and pitch-linear buffers with one byte per pixel
+     */
+    class BlockLinearCopyHelperShader {
+      private:
+        vk::raii::ShaderModule shaderModule;
+        vk::raii::DescriptorSetLayout descriptorSetLayout;
+        vk::raii::PipelineLayout pipelineLayout;
+        vk::raii::Pipeline pipeline;
+
+      public:
+        /**
+         * @brief The layout of the copy, all sizes are in bytes
+         */
+        struct CopyParameters {
+            u32 pitch; //!< The pitch of the pitch-linear surface
+            u32 lineLength; //!< The width of the copied rect
+            u32 lineCount; //!< The height of the copied rect
+            u32 depth;
+            u32 blockLinearWidth; //!< The width of the block-linear surface
+            u32 blockLinearHeight; //!< The height of the block-linear surface
+            u32 gobBlockHeight;
+            u32 gobBlockDepth;
+            u32 originX; //!< The X offset of the copied rect inside the block-linear surface
+            u32 originY; //!< The Y offset of the copied rect inside the block-linear surface
+        };
+
+        BlockLinearCopyHelperShader(GPU &gpu, std::shared_ptr<vfs::FileSystem> shaderFileSystem);
+
+        /**
+         * @brief Records a compute dispatch that copies the supplied rect from the source buffer into the destination buffer
+         * @param blockLinearToPitch If the source buffer is block-linear and the destination is pitch-linear, the inverse is true otherwise
+         * @note This must be called while recording an outside render pass command, any required barriers must be recorded by the caller
+         */
+        void Copy(GPU &gpu, vk::raii::CommandBuffer &commandBuffer, const std::shared_ptr<FenceCycle> &cycle,
+                  BufferBinding src, BufferBinding dst,
+                  const CopyParameters &parameters, bool blockLinearToPitch);
+    };
+
     /**
      * @brief Holds all helper shaders to avoid redundantly recreating them on each usage
      */
     struct HelperShaders {
         BlitHelperShader blitHelperShader;
         ClearHelperShader clearHelperShader;
+        BlockLinearCopyHelperShader blockLinearCopyHelperShader;
 
         HelperShaders(GPU &gpu, std::shared_ptr<vfs::FileSystem> shaderFileSystem);
     };
@@ -0,0 +1,149 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2023 Strato Team and Contributors (https://github.com/strato-emu/)
+
+#include <fstream>
+#include "spirv_cache_manager.h"
+
+namespace skyline::gpu {
+    struct SpirvCacheFileHeader {
+        static constexpr u32 Magic{util::MakeMagic<u32>("SPVC")}; //!< The magic value used to identify a SPIR-V cache file
+        static constexpr u32 Version{1}; //!< The version of the SPIR-V cache file format, MUST be incremented for any format changes or changes to the shader compiler that affect its output
+
+        u32 magic{Magic};
+        u32 version{Version};
+        u64 hostHash; //!< The hash of the host state the cache was created with
+
+        /**
+         * @brief Checks if the header is valid
+         */
+        bool IsValid(u64 expectedHostHash) {
+            return magic == Magic && version == Version && hostHash == expectedHostHash;
+        }
+    };
+
+    struct SpirvCacheEntryHeader {
+        static constexpr u32 MaxWordCount{0x100000}; //!< The maximum amount of words in a single entry, this is far larger than any real shader and is used to reject corrupted entries
+
+        u64 key;
+        u64 hash; //!< The hash of the SPIR-V words of the entry
+        u32 wordCount; //!< The amount of SPIR-V words following the header
+        Shader::Backend::Bindings bindings;
+    };
+    static_assert(std::is_trivially_copyable_v<SpirvCacheEntryHeader>);
+
+    void SpirvCacheManager::Run() {
+        std::ofstream stream{path, std::ios::binary | std::ios::app};
+
+        while (true) {
+            std::unique_lock lock(writeMutex);
+            if (writeQueue.empty())
+                stream.flush();
+
+            writeCondition.wait(lock, [this] { return !writeQueue.empty() || exiting; });
+            if (writeQueue.empty())
+                return;
+
+            auto [key, entry]{std::move(writeQueue.front())};
+            writeQueue.pop();
+            lock.unlock();
+
+            SpirvCacheEntryHeader header{
+                .key = key,
+                .hash = XXH64(entry.spirv.data(), entry.spirv.size() * sizeof(u32), 0),
+                .wordCount = static_cast<u32>(entry.spirv.size()),
+                .bindings = entry.bindings,
+            };
+            stream.write(reinterpret_cast<const char *>(&header), sizeof(SpirvCacheEntryHeader));
+            stream.write(reinterpret_cast<const char *>(entry.spirv.data()), static_cast<std::streamsize>(entry.spirv.size() * sizeof(u32)));
+        }
+    }
+
+    bool SpirvCacheManager::Load(u64 hostHash) {
+        std::ifstream stream{path, std::ios::binary};
+        if (stream.fail())
+            return false;
+
+        SpirvCacheFileHeader fileHeader{};
+        stream.read(reinterpret_cast<char *>(&fileHeader), sizeof(SpirvCacheFileHeader));
+        if (stream.fail() || !fileHeader.IsValid(hostHash))
+            return false;
+
+        i64 lastKnownGoodOffset{stream.tellg()};
+        bool corrupted{};
+        while (stream.peek() != EOF) {
+            SpirvCacheEntryHeader header{};
+            stream.read(reinterpret_cast<char *>(&header), sizeof(SpirvCacheEntryHeader));
+            if (stream.fail() || header.wordCount > SpirvCacheEntryHeader::MaxWordCount) {
+                corrupted = true;
+                break;
+            }
+
+            std::vector<u32> spirv(header.wordCount);
+            stream.read(reinterpret_cast<char *>(spirv.data()), static_cast<std::streamsize>(spirv.size() * sizeof(u32)));
+            if (stream.fail() || XXH64(spirv.data(), spirv.size() * sizeof(u32), 0) != header.hash) {
+                corrupted = true;
+                break;
+            }
+
+            entries.try_emplace(header.key, Entry{std::move(spirv), header.bindings});
+            lastKnownGoodOffset = stream.tellg();
+        }
+
+        if (corrupted) {
+            LOGW("SPIR-V cache corrupted at: 0x{:X}", lastKnownGoodOffset);
+            stream.close();
+            std::filesystem::resize_file(path, static_cast<u64>(lastKnownGoodOffset));
+        }
+
+        return true;
+    }
+
+    SpirvCacheManager::SpirvCacheManager(const std::string &path, u64 hostHash) : path{path} {
+        auto startTime{util::GetTimeNs()};
+        if (Load(hostHash)) {
+            LOGI("Loaded {} SPIR-V cache entries in {}ms", entries.size(), (util::GetTimeNs() - startTime) / constant::NsInMillisecond);
+        } else {
+            // Force a recreation of the file if it's missing, invalid or was created with different host state
+            if (std::filesystem::exists(path))
+                LOGW("Discarding invalid SPIR-V cache file");
+
+            std::filesystem::create_directories(std::filesystem::path{path}.parent_path());
+            std::ofstream stream{path, std::ios::binary | std::ios::trunc};
+            SpirvCacheFileHeader header{.hostHash = hostHash};
+            stream.write(reinterpret_cast<const char *>(&header), sizeof(SpirvCacheFileHeader));
+        }
+
+        writerThread = std::thread(&SpirvCacheManager::Run, this);
+    }
+
+    SpirvCacheManager::~SpirvCacheManager() {
+        {
+            std::scoped_lock lock{writeMutex};
+            exiting = true;
+        }
+        writeCondition.notify_one();
+        writerThread.join();
+    }
+
+    std::optional<SpirvCacheManager::Entry> SpirvCacheManager::Lookup(u64 key) {
+        std::shared_lock lock{entryMutex};
+        auto it{entries.find(key)};
+        if (it == entries.end())
+            return std::nullopt;
+
+        return it->second;
+    }
+
+    void SpirvCacheManager::Insert(u64 key, span<u32> spirv, const Shader::Backend::Bindings &bindings) {
+        Entry entry{std::vector<u32>{spirv.begin(), spirv.end()}, bindings};
+        {
+            std::unique_lock lock{entryMutex};
+            if (!entries.try_emplace(key, entry).second)
+                return;
+        }
+
+        std::scoped_lock lock{writeMutex};
+        writeQueue.emplace(key, std::move(entry));
+        writeCondition.notify_one();
+    }
+}
@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2023 Strato Team and Contributors (https://github.com/strato-emu/)
+
+#pragma once
+
+#include <queue>
+#include <shared_mutex>
+#include <shader_compiler/backend/bindings.h>
+#include <common.h>
+
+namespace skyline::gpu {
+    /**
+     * @brief Manages a persistent cache of SPIR-V emitted by the shader compiler, this is keyed by a hash of all the inputs to the compiler so identical shaders can be shared across pipelines
+     * @note The cache file is only appended to at runtime, entries are individually validated when loading so any partially written entries at the end are discarded
+     */
+    class SpirvCacheManager {
+      public:
+        /**
+         * @brief The output of compiling a single shader
+         */
+        struct Entry {
+            std::vector<u32> spirv;
+            Shader::Backend::Bindings bindings; //!< The state of the bindings after the shader was compiled
+        };
+
+      private:
+        std::string path;
+        std::shared_mutex entryMutex; //!< Synchronizes access to `entries`
+        std::unordered_map<u64, Entry> entries; //!< A map from the key of a shader to its compiled SPIR-V
+
+        std::thread writerThread;
+        std::queue<std::pair<u64, Entry>> writeQueue; //!< The queue of entries to be appended to the cache file
+        std::mutex writeMutex; //!< Protects access to the write queue
+        std::condition_variable writeCondition; //!< Notifies the writer thread when the write queue is not empty or it should exit
+        bool exiting{}; //!< If the writer thread should exit, this is protected by `writeMutex`
+
+        void Run();
+
+        /**
+         * @brief Reads all valid entries from the cache file and truncates it after the last valid entry
+         * @return If the cache file was valid and created with the same host state
+         */
+        bool Load(u64 hostHash);
+
+      public:
+        /**
+         * @param hostHash A hash of all host state which affects the compiled SPIR-V, a cache file created with a different hash will be discarded
+         */
+        SpirvCacheManager(const std::string &path, u64 hostHash);
+
+        ~SpirvCacheManager();
+
+        /**
+         * @return A copy of the entry with the given key, if it exists
+         */
+        std::optional<Entry> Lookup(u64 key);
+
+        /**
+         * @brief Inserts an entry into the cache and queues it to be written to the cache file if it wasn't present already
+         */
+        void Insert(u64 key, span<u32> spirv, const Shader::Backend::Bindings &bindings);
+    };
+}
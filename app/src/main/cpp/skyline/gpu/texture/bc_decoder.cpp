@@ -6,8 +6,11 @@
 // This file does not follow the Skyline code conventions but has certain Skyline specific code
 // There are a lot of implicit and narrowing conversions in this file due to this (Warnings are disabled as a result)
 
+#include <algorithm>
+#include <cstring>
 #include <fmt/printf.h>
 #include <common.h>
+#include "bc_decoder.h"
 
 #ifdef NDEBUG
 #define ASSERT(condition)
@@ -26,7 +29,35 @@ namespace {
     constexpr int BlockWidth = 4;
     constexpr int BlockHeight = 4;
 
+    // Vector types for the full-block kernels, these are lowered to NEON on AArch64 and SSE on x86-64 by the compiler
+    typedef int32_t Int4 __attribute__((vector_size(16)));
+
     struct BC_color {
+        /**
+         * @brief Decodes a block which is entirely contained within the destination image into 32-bit pixels
+         * @note This is bit-exact with decode() but computes and packs the palette once per block, writing entire rows at a time
+         */
+        void decodeBlock(uint8_t *dst, size_t dstPitch, bool hasAlphaChannel, bool hasSeparateAlpha) const {
+            const Int4 e0{static_cast<int32_t>(((c0 & 0x1F) << 3) | ((c0 & 0x1C) >> 2)), static_cast<int32_t>(((c0 & 0x7E0) >> 3) | ((c0 & 0x600) >> 9)), static_cast<int32_t>(((c0 & 0xF800) >> 8) | ((c0 & 0xE000) >> 13)), static_cast<int32_t>(0xFF000000)};
+            const Int4 e1{static_cast<int32_t>(((c1 & 0x1F) << 3) | ((c1 & 0x1C) >> 2)), static_cast<int32_t>(((c1 & 0x7E0) >> 3) | ((c1 & 0x600) >> 9)), static_cast<int32_t>(((c1 & 0xF800) >> 8) | ((c1 & 0xE000) >> 13)), static_cast<int32_t>(0xFF000000)};
+
+            Int4 e2, e3;
+            if (hasSeparateAlpha || (c0 > c1)) {
+                e2 = ((e0 * 2) + e1) / 3;
+                e3 = ((e1 * 2) + e0) / 3;
+            } else {
+                e2 = (e0 + e1) >> 1;
+                e3 = Int4{0, 0, 0, hasAlphaChannel ? 0 : static_cast<int32_t>(0xFF000000)};
+            }
+
+            const uint32_t palette[4]{pack8888(e0), pack8888(e1), pack8888(e2), pack8888(e3)};
+            uint32_t indices{idx};
+            for (int j = 0; j < BlockHeight; j++, dst += dstPitch, indices >>= 8) {
+                const uint32_t row[BlockWidth]{palette[indices & 0x3], palette[(indices >> 2) & 0x3], palette[(indices >> 4) & 0x3], palette[(indices >> 6) & 0x3]};
+                std::memcpy(dst, row, sizeof(row));
+            }
+        }
+
         void decode(uint8_t *dst, size_t x, size_t y, size_t dstW, size_t dstH, size_t dstPitch, size_t dstBpp, bool hasAlphaChannel, bool hasSeparateAlpha) const {
             Color c[4];
             c[0].extract565(c0);
@@ -112,6 +143,10 @@ namespace {
             return (idx & (0x3 << offset)) >> offset;
         }
 
+        static uint32_t pack8888(Int4 c) {
+            return ((c[0] & 0xFF) << 16) | ((c[1] & 0xFF) << 8) | (c[2] & 0xFF) | c[3];
+        }
+
         unsigned short c0;
         unsigned short c1;
         unsigned int idx;
@@ -119,6 +154,41 @@ namespace {
     static_assert(sizeof(BC_color) == 8, "BC_color must be 8 bytes");
 
     struct BC_channel {
+        /**
+         * @brief Decodes a block which is entirely contained within the destination image into a single 8-bit channel
+         * @note This is bit-exact with decode() but shifts the indices out sequentially rather than extracting each of them from the block
+         */
+        void decodeBlock(uint8_t *dst, size_t dstPitch, size_t dstBpp, size_t channel, bool isSigned) const {
+            int32_t e0, e1;
+            if (isSigned) {
+                e0 = static_cast<signed char>(data & 0xFF);
+                e1 = static_cast<signed char>((data & 0xFF00) >> 8);
+            } else {
+                e0 = static_cast<uint8_t>(data & 0xFF);
+                e1 = static_cast<uint8_t>((data & 0xFF00) >> 8);
+            }
+
+            // The palette is interpolated with scalar operations as there's too few entries for a vector to pay off, see decode()
+            uint8_t palette[8]{static_cast<uint8_t>(e0), static_cast<uint8_t>(e1)};
+            if (e0 > e1) {
+                for (int i = 2; i < 8; ++i)
+                    palette[i] = static_cast<uint8_t>(((8 - i) * e0 + (i - 1) * e1) / 7);
+            } else {
+                for (int i = 2; i < 6; ++i)
+                    palette[i] = static_cast<uint8_t>(((6 - i) * e0 + (i - 1) * e1) / 5);
+                palette[6] = static_cast<uint8_t>(isSigned ? -128 : 0);
+                palette[7] = static_cast<uint8_t>(isSigned ? 127 : 255);
+            }
+
+            uint64_t indices{data >> 16};
+            dst += channel;
+            for (int j = 0; j < BlockHeight; j++, dst += dstPitch) {
+                uint8_t *dstRow = dst;
+                for (int i = 0; i < BlockWidth; i++, dstRow += dstBpp, indices >>= 3)
+                    *dstRow = palette[indices & 0x7];
+            }
+        }
+
         void decode(uint8_t *dst, size_t x, size_t y, size_t dstW, size_t dstH, size_t dstPitch, size_t dstBpp, size_t channel, bool isSigned) const {
             int c[8] = {0};
 
@@ -160,6 +230,19 @@ namespace {
     static_assert(sizeof(BC_channel) == 8, "BC_channel must be 8 bytes");
 
     struct BC_alpha {
+        /**
+         * @brief Decodes the alpha of a block which is entirely contained within the destination image
+         */
+        void decodeBlock(uint8_t *dst, size_t dstPitch, size_t dstBpp) const {
+            uint64_t alpha{data};
+            dst += 3;  // Write only to alpha (channel 3)
+            for (int j = 0; j < BlockHeight; j++, dst += dstPitch) {
+                uint8_t *dstRow = dst;
+                for (int i = 0; i < BlockWidth; i++, dstRow += dstBpp, alpha >>= 4)
+                    *dstRow = static_cast<uint8_t>((alpha & 0xF) * 0x11);
+            }
+        }
+
         void decode(uint8_t *dst, size_t x, size_t y, size_t dstW, size_t dstH, size_t dstPitch, size_t dstBpp) const {
             dst += 3;  // Write only to alpha (channel 3)
             for (size_t j = 0; j < BlockHeight && (y + j) < dstH; j++, dst += dstPitch) {
@@ -808,11 +891,12 @@ namespace {
             uint64_t low64;
             uint64_t high64;
 
-            void decode(uint8_t *dst, size_t dstX, size_t dstY, size_t dstWidth, size_t dstHeight, size_t dstPitch, size_t dstBpp, bool isSigned) const {
+            /**
+             * @brief Reads the mode, partition and endpoints of the block and unquantizes the endpoints, only the indices are left in the data afterwards
+             * @return If the block has a legal mode, illegal or reserved modes decode to black
+             */
+            bool decodeEndpoints(Data &data, RGBf (&e)[4], ModeDesc &modeDesc, int &partition, bool isSigned) const {
                 uint8_t mode = 0;
-                Data data(low64, high64);
-                ASSERT(dstBpp == sizeof(Color));
-
                 if ((data.low64 & 0x2) == 0) {
                     mode = data.consumeBits(1, 0);
                 } else {
@@ -820,23 +904,13 @@ namespace {
                 }
 
                 int blockIndex = modeToIndex(mode);
-                // Handle illegal or reserved mode
                 if (blockIndex == -1) {
-                    for (int y = 0; y < 4 && y + dstY < dstHeight; y++) {
-                        for (int x = 0; x < 4 && x + dstX < dstWidth; x++) {
-                            auto out = reinterpret_cast<Color *>(dst + sizeof(Color) * x + dstPitch * y);
-                            out->rgba = {0, 0, 0};
-                        }
-                    }
-                    return;
+                    return false;
                 }
                 const BlockDesc *blockDesc = blockDescs[blockIndex];
 
-                RGBf e[4];
                 e[0].isSigned = e[1].isSigned = e[2].isSigned = e[3].isSigned = isSigned;
 
-                int partition = 0;
-                ModeDesc modeDesc;
                 for (int index = 0; blockDesc[index].type != End; index++) {
                     const BlockDesc desc = blockDesc[index];
 
@@ -865,7 +939,7 @@ namespace {
                             break;
                         default:
                             ASSERT_MSG(false, "Unexpected enum value: %d", (int) desc.type);
-                            return;
+                            return false;
                     }
                 }
 
@@ -892,6 +966,95 @@ namespace {
                     e[ep].unquantize();
                 }
 
+                return true;
+            }
+
+            /**
+             * @brief Decodes a block which is entirely contained within the destination image
+             * @note This is bit-exact with decode() but interpolates and scales the palette of each subset once with vector operations rather than for every texel
+             */
+            void decodeBlock(uint8_t *dst, size_t dstPitch, bool isSigned) const {
+                Data data(low64, high64);
+
+                RGBf e[4];
+                ModeDesc modeDesc;
+                int partition = 0;
+                if (!decodeEndpoints(data, e, modeDesc, partition, isSigned)) {
+                    const uint64_t black[BlockWidth] = {uint64_t(halfFloat1) << 48, uint64_t(halfFloat1) << 48, uint64_t(halfFloat1) << 48, uint64_t(halfFloat1) << 48};
+                    for (int y = 0; y < BlockHeight; y++, dst += dstPitch)
+                        std::memcpy(dst, black, sizeof(black));
+                    return;
+                }
+
+                static constexpr int32_t weights3[] = {0, 9, 18, 27, 37, 46, 55, 64};
+                static constexpr int32_t weights4[] = {0, 4, 9, 13, 17, 21, 26, 30,
+                                                       34, 38, 43, 47, 51, 55, 60, 64};
+
+                bool singleSubset = modeDesc.partitionCount == 1;
+                int numBits = singleSubset ? 4 : 3;
+                auto weights = singleSubset ? weights4 : weights3;
+
+                // Each entry holds an entire R16G16B16A16 texel, see interpolate() for the scalar equivalent of this
+                uint64_t palette[2][16];
+                for (int subset = 0; subset < modeDesc.partitionCount; subset++) {
+                    const RGBf &rgb0 = e[subset * 2], &rgb1 = e[subset * 2 + 1];
+                    Int4 e0{rgb0.channel[0], rgb0.channel[1], rgb0.channel[2], 0};
+                    Int4 e1{rgb1.channel[0], rgb1.channel[1], rgb1.channel[2], 0};
+                    if (isSigned) {
+                        e0 = (e0 << 16) >> 16;
+                        e1 = (e1 << 16) >> 16;
+                    }
+
+                    for (int i = 0; i < (1 << numBits); i++) {
+                        Int4 value = ((e0 * (64 - weights[i])) + (e1 * weights[i]) + 32) >> 6;
+                        if (isSigned) {
+                            Int4 sign = value >> 31;
+                            Int4 magnitude = (value ^ sign) - sign;
+                            value = ((magnitude * 31) >> 5) | (sign & 0x8000);
+                            value &= ~(value == 0x8000); // Don't return -0.0f, just normalize it to 0.0f
+                        } else {
+                            value = (value * 31) >> 6;
+                        }
+
+                        palette[subset][i] = uint64_t(uint16_t(value[0])) | (uint64_t(uint16_t(value[1])) << 16) | (uint64_t(uint16_t(value[2])) << 32) | (uint64_t(halfFloat1) << 48);
+                    }
+                }
+
+                for (int y = 0; y < BlockHeight; y++, dst += dstPitch) {
+                    uint64_t row[BlockWidth];
+                    for (int x = 0; x < BlockWidth; x++) {
+                        int pixelNum = x + y * 4;
+                        int isAnchor = pixelNum == 0;
+                        int subset = 0;
+                        if (!singleSubset) {
+                            isAnchor |= pixelNum == AnchorTable2[partition];
+                            subset = PartitionTable2[partition][pixelNum];
+                        }
+
+                        row[x] = palette[subset][data.consumeBits(numBits - isAnchor - 1, 0)];
+                    }
+                    std::memcpy(dst, row, sizeof(row));
+                }
+            }
+
+            void decode(uint8_t *dst, size_t dstX, size_t dstY, size_t dstWidth, size_t dstHeight, size_t dstPitch, size_t dstBpp, bool isSigned) const {
+                Data data(low64, high64);
+                ASSERT(dstBpp == sizeof(Color));
+
+                RGBf e[4];
+                ModeDesc modeDesc;
+                int partition = 0;
+                // Handle illegal or reserved mode
+                if (!decodeEndpoints(data, e, modeDesc, partition, isSigned)) {
+                    for (int y = 0; y < 4 && y + dstY < dstHeight; y++) {
+                        for (int x = 0; x < 4 && x + dstX < dstWidth; x++) {
+                            auto out = reinterpret_cast<Color *>(dst + sizeof(Color) * x + dstPitch * y);
+                            out->rgba = {0, 0, 0};
+                        }
+                    }
+                    return;
+                }
+
                 // Get the indices, calculate final colors, and output
                 for (int y = 0; y < 4; y++) {
                     for (int x = 0; x < 4; x++) {
@@ -1296,22 +1459,12 @@ namespace {
                 return (uint8_t) (((64 - weights[index.value]) * uint16_t(e0) + weights[index.value] * uint16_t(e1) + 32) >> 6);
             }
 
-            void decode(uint8_t *dst, size_t dstX, size_t dstY, size_t dstWidth, size_t dstHeight, size_t dstPitch) const {
-                auto const &mode = this->mode();
+            using Endpoint = std::array<Color, 2>;
 
-                if (mode.IDX < 0)  // Invalid mode:
-                {
-                    for (size_t y = 0; y < 4 && y + dstY < dstHeight; y++) {
-                        for (size_t x = 0; x < 4 && x + dstX < dstWidth; x++) {
-                            auto out = reinterpret_cast<Color *>(dst + sizeof(Color) * x + dstPitch * y);
-                            out->rgb = {0, 0, 0};
-                            out->a = 0;
-                        }
-                    }
-                    return;
-                }
-
-                using Endpoint = std::array<Color, 2>;
+            /**
+             * @return The endpoints of every subset in the block expanded to 8 bits per channel
+             */
+            std::array<Endpoint, MaxSubsets> endpoints(const Mode &mode) const {
                 std::array<Endpoint, MaxSubsets> subsets;
 
                 for (size_t i = 0; i < mode.NS; i++) {
@@ -1368,6 +1521,112 @@ namespace {
                     }
                 }
 
+                return subsets;
+            }
+
+            /**
+             * @brief Decodes a block which is entirely contained within the destination image
+             * @note This is bit-exact with decode() but interpolates the palettes of each subset once with vector operations and reads the indices sequentially rather than deriving their bitfields for every texel
+             */
+            void decodeBlock(uint8_t *dst, size_t dstPitch) const {
+                auto const &mode = this->mode();
+
+                if (mode.IDX < 0) {
+                    for (int y = 0; y < BlockHeight; y++, dst += dstPitch)
+                        std::memset(dst, 0, BlockWidth * sizeof(Color));
+                    return;
+                }
+
+                static constexpr int32_t weights2[] = {0, 21, 43, 64};
+                static constexpr int32_t weights3[] = {0, 9, 18, 27, 37, 46, 55, 64};
+                static constexpr int32_t weights4[] = {0, 4, 9, 13, 17, 21, 26, 30,
+                                                       34, 38, 43, 47, 51, 55, 60, 64};
+                static constexpr int32_t const *weightsN[] = {
+                    nullptr, nullptr, weights2, weights3, weights4
+                };
+
+                auto subsets = endpoints(mode);
+                auto partitionIdx = Get(mode.Partition());
+                auto rotation = Get(mode.Rotation());
+
+                // See colorIndex() and alphaIndex(), modes with a secondary index use it for either the color or alpha based on the index selection bit
+                bool colorSecondary = Get(mode.IndexSelection()) == 1;
+                bool alphaSecondary = (mode.IB2 != 0) && !colorSecondary;
+                int colorBits = colorSecondary ? mode.IB2 : mode.IB;
+                int alphaBits = alphaSecondary ? mode.IB2 : mode.IB;
+                int colorIndexBitOffset = (colorSecondary ? mode.SecondaryIndex(0, 0) : mode.PrimaryIndex(0, 0)).offset;
+                int alphaIndexBitOffset = (alphaSecondary ? mode.SecondaryIndex(0, 0) : mode.PrimaryIndex(0, 0)).offset;
+
+                // The rotation swaps the alpha channel with one of the color channels, this is folded into the byte each palette writes its channels to
+                // Note: The output is RGBA while the color storage is BGR, see decode()
+                int colorShifts[3] = {0, 8, 16};
+                int alphaShift = 24;
+                if (rotation != 0) {
+                    colorShifts[rotation - 1] = 24;
+                    alphaShift = (rotation - 1) * 8;
+                }
+
+                uint32_t colorPalette[MaxSubsets][16];
+                uint32_t alphaPalette[MaxSubsets][16];
+                for (int i = 0; i < mode.NS; i++) {
+                    auto const &subset = subsets[i];
+                    const Int4 e0{subset[0].rgb.r, subset[0].rgb.g, subset[0].rgb.b, subset[0].a};
+                    const Int4 e1{subset[1].rgb.r, subset[1].rgb.g, subset[1].rgb.b, subset[1].a};
+
+                    auto weights = weightsN[colorBits];
+                    for (int j = 0; j < (1 << colorBits); j++) {
+                        Int4 c = (((64 - weights[j]) * e0) + (weights[j] * e1) + 32) >> 6;
+                        colorPalette[i][j] = (uint32_t(c[0]) << colorShifts[0]) | (uint32_t(c[1]) << colorShifts[1]) | (uint32_t(c[2]) << colorShifts[2]);
+                        alphaPalette[i][j] = uint32_t(c[3]) << alphaShift;
+                    }
+
+                    if (alphaBits != colorBits) {
+                        weights = weightsN[alphaBits];
+                        for (int j = 0; j < (1 << alphaBits); j++)
+                            alphaPalette[i][j] = uint32_t(((64 - weights[j]) * e0[3] + weights[j] * e1[3] + 32) >> 6) << alphaShift;
+                    }
+                }
+
+                for (int y = 0; y < BlockHeight; y++, dst += dstPitch) {
+                    uint32_t row[BlockWidth];
+                    for (int x = 0; x < BlockWidth; x++) {
+                        auto texelIdx = y * 4 + x;
+                        auto subsetIdx = subsetIndex(mode, partitionIdx, texelIdx);
+                        int isAnchor = anchorIndex(mode, partitionIdx, subsetIdx) == texelIdx;
+
+                        auto colorIdx = Get({colorIndexBitOffset, colorBits - isAnchor});
+                        colorIndexBitOffset += colorBits - isAnchor;
+
+                        // Without a secondary index the alpha index is read from the same bits as the color index
+                        auto alphaIdx = colorIdx;
+                        if (mode.IB2 != 0) {
+                            alphaIdx = Get({alphaIndexBitOffset, alphaBits - isAnchor});
+                            alphaIndexBitOffset += alphaBits - isAnchor;
+                        }
+
+                        row[x] = colorPalette[subsetIdx][colorIdx] | alphaPalette[subsetIdx][alphaIdx];
+                    }
+                    std::memcpy(dst, row, sizeof(row));
+                }
+            }
+
+            void decode(uint8_t *dst, size_t dstX, size_t dstY, size_t dstWidth, size_t dstHeight, size_t dstPitch) const {
+                auto const &mode = this->mode();
+
+                if (mode.IDX < 0)  // Invalid mode:
+                {
+                    for (size_t y = 0; y < 4 && y + dstY < dstHeight; y++) {
+                        for (size_t x = 0; x < 4 && x + dstX < dstWidth; x++) {
+                            auto out = reinterpret_cast<Color *>(dst + sizeof(Color) * x + dstPitch * y);
+                            out->rgb = {0, 0, 0};
+                            out->a = 0;
+                        }
+                    }
+                    return;
+                }
+
+                auto subsets = endpoints(mode);
+
                 int colorIndexBitOffset = 0;
                 int alphaIndexBitOffset = 0;
                 for (int y = 0; y < 4; y++) {
@@ -1497,82 +1756,205 @@ namespace bcn {
     constexpr size_t R8g8b8a8Bpp{4}; //!< The amount of bytes per pixel in R8G8B8A8
     constexpr size_t R16g16b16a16Bpp{8}; //!< The amount of bytes per pixel in R16G16B16
 
-    void DecodeBc1(const uint8_t *src, uint8_t *dst, size_t width, size_t height, bool hasAlphaChannel) {
+    /**
+     * @return If the block at the supplied coordinates is entirely contained within the image
+     */
+    static bool IsFullBlock(size_t x, size_t y, size_t width, size_t height) {
+        return (x + BlockWidth) <= width && (y + BlockHeight) <= height;
+    }
+
+    template<bool UseBlockKernels>
+    static void DecodeBc1Impl(const uint8_t *src, uint8_t *dst, size_t width, size_t height, bool hasAlphaChannel) {
         const auto *color{reinterpret_cast<const BC_color *>(src)};
         size_t pitch{R8g8b8a8Bpp * width};
         for (size_t y{}; y < height; y += BlockHeight, dst += BlockHeight * pitch) {
             uint8_t *dstRow{dst};
-            for (size_t x{}; x < width; x += BlockWidth, ++color, dstRow += BlockWidth * R8g8b8a8Bpp)
-                [[clang::always_inline]] color->decode(dstRow, x, y, width, height, pitch, R8g8b8a8Bpp, hasAlphaChannel, false);
+            for (size_t x{}; x < width; x += BlockWidth, ++color, dstRow += BlockWidth * R8g8b8a8Bpp) {
+                if (UseBlockKernels && IsFullBlock(x, y, width, height)) [[likely]]
+                    color->decodeBlock(dstRow, pitch, hasAlphaChannel, false);
+                else
+                    [[clang::always_inline]] color->decode(dstRow, x, y, width, height, pitch, R8g8b8a8Bpp, hasAlphaChannel, false);
+            }
         }
     }
 
-    void DecodeBc2(const uint8_t *src, uint8_t *dst, size_t width, size_t height) {
+    template<bool UseBlockKernels>
+    static void DecodeBc2Impl(const uint8_t *src, uint8_t *dst, size_t width, size_t height) {
         const auto *alpha{reinterpret_cast<const BC_alpha *>(src)};
         const auto *color{reinterpret_cast<const BC_color *>(src + 8)};
         size_t pitch{R8g8b8a8Bpp * width};
         for (size_t y{}; y < height; y += BlockHeight, dst += BlockHeight * pitch) {
             uint8_t *dstRow{dst};
             for (size_t x{}; x < width; x += BlockWidth, alpha += 2, color += 2, dstRow += BlockWidth * R8g8b8a8Bpp) {
-                [[clang::always_inline]] color->decode(dstRow, x, y, width, height, pitch, R8g8b8a8Bpp, false, true);
-                [[clang::always_inline]] alpha->decode(dstRow, x, y, width, height, pitch, R8g8b8a8Bpp);
+                if (UseBlockKernels && IsFullBlock(x, y, width, height)) [[likely]] {
+                    color->decodeBlock(dstRow, pitch, false, true);
+                    alpha->decodeBlock(dstRow, pitch, R8g8b8a8Bpp);
+                } else {
+                    [[clang::always_inline]] color->decode(dstRow, x, y, width, height, pitch, R8g8b8a8Bpp, false, true);
+                    [[clang::always_inline]] alpha->decode(dstRow, x, y, width, height, pitch, R8g8b8a8Bpp);
+                }
             }
         }
     }
 
-    void DecodeBc3(const uint8_t *src, uint8_t *dst, size_t width, size_t height) {
+    template<bool UseBlockKernels>
+    static void DecodeBc3Impl(const uint8_t *src, uint8_t *dst, size_t width, size_t height) {
         const auto *alpha{reinterpret_cast<const BC_channel *>(src)};
         const auto *color{reinterpret_cast<const BC_color *>(src + 8)};
         size_t pitch{R8g8b8a8Bpp * width};
         for (size_t y{}; y < height; y += BlockHeight, dst += BlockHeight * pitch) {
             uint8_t *dstRow{dst};
             for (size_t x{}; x < width; x += BlockWidth, alpha += 2, color += 2, dstRow += BlockWidth * R8g8b8a8Bpp) {
-                [[clang::always_inline]] color->decode(dstRow, x, y, width, height, pitch, R8g8b8a8Bpp, false, true);
-                [[clang::always_inline]] alpha->decode(dstRow, x, y, width, height, pitch, R8g8b8a8Bpp, 3, false);
+                if (UseBlockKernels && IsFullBlock(x, y, width, height)) [[likely]] {
+                    color->decodeBlock(dstRow, pitch, false, true);
+                    alpha->decodeBlock(dstRow, pitch, R8g8b8a8Bpp, 3, false);
+                } else {
+                    [[clang::always_inline]] color->decode(dstRow, x, y, width, height, pitch, R8g8b8a8Bpp, false, true);
+                    [[clang::always_inline]] alpha->decode(dstRow, x, y, width, height, pitch, R8g8b8a8Bpp, 3, false);
+                }
             }
         }
     }
 
-    void DecodeBc4(const uint8_t *src, uint8_t *dst, size_t width, size_t height, bool isSigned) {
+    template<bool UseBlockKernels>
+    static void DecodeBc4Impl(const uint8_t *src, uint8_t *dst, size_t width, size_t height, bool isSigned) {
         const auto *red{reinterpret_cast<const BC_channel *>(src)};
         size_t pitch{R8Bpp * width};
         for (size_t y{}; y < height; y += BlockHeight, dst += BlockHeight * pitch) {
             uint8_t *dstRow{dst};
-            for (size_t x{}; x < width; x += BlockWidth, ++red, dstRow += BlockWidth * R8Bpp)
-                [[clang::always_inline]] red->decode(dstRow, x, y, width, height, pitch, R8Bpp, 0, isSigned);
+            for (size_t x{}; x < width; x += BlockWidth, ++red, dstRow += BlockWidth * R8Bpp) {
+                if (UseBlockKernels && IsFullBlock(x, y, width, height)) [[likely]]
+                    red->decodeBlock(dstRow, pitch, R8Bpp, 0, isSigned);
+                else
+                    [[clang::always_inline]] red->decode(dstRow, x, y, width, height, pitch, R8Bpp, 0, isSigned);
+            }
         }
     }
 
-    void DecodeBc5(const uint8_t *src, uint8_t *dst, size_t width, size_t height, bool isSigned) {
+    template<bool UseBlockKernels>
+    static void DecodeBc5Impl(const uint8_t *src, uint8_t *dst, size_t width, size_t height, bool isSigned) {
         const auto *red{reinterpret_cast<const BC_channel *>(src)};
         const auto *green{reinterpret_cast<const BC_channel *>(src + 8)};
         size_t pitch{R8g8Bpp * width};
         for (size_t y{}; y < height; y += BlockHeight, dst += BlockHeight * pitch) {
             uint8_t *dstRow{dst};
             for (size_t x{}; x < width; x += BlockWidth, red += 2, green += 2, dstRow += BlockWidth * R8g8Bpp) {
-                [[clang::always_inline]] red->decode(dstRow, x, y, width, height, pitch, R8g8Bpp, 0, isSigned);
-                [[clang::always_inline]] green->decode(dstRow, x, y, width, height, pitch, R8g8Bpp, 1, isSigned);
+                if (UseBlockKernels && IsFullBlock(x, y, width, height)) [[likely]] {
+                    red->decodeBlock(dstRow, pitch, R8g8Bpp, 0, isSigned);
+                    green->decodeBlock(dstRow, pitch, R8g8Bpp, 1, isSigned);
+                } else {
+                    [[clang::always_inline]] red->decode(dstRow, x, y, width, height, pitch, R8g8Bpp, 0, isSigned);
+                    [[clang::always_inline]] green->decode(dstRow, x, y, width, height, pitch, R8g8Bpp, 1, isSigned);
+                }
             }
         }
     }
 
-    void DecodeBc6(const uint8_t *src, uint8_t *dst, size_t width, size_t height, bool isSigned) {
+    template<bool UseBlockKernels>
+    static void DecodeBc6Impl(const uint8_t *src, uint8_t *dst, size_t width, size_t height, bool isSigned) {
         const auto *block{reinterpret_cast<const BC6H::Block *>(src)};
         size_t pitch{R16g16b16a16Bpp * width};
         for (size_t y{}; y < height; y += BlockHeight, dst += BlockHeight * pitch) {
             uint8_t *dstRow{dst};
-            for (size_t x{}; x < width; x += BlockWidth, ++block, dstRow += BlockWidth * R16g16b16a16Bpp)
-                [[clang::always_inline]] block->decode(dstRow, x, y, width, height, pitch, R16g16b16a16Bpp, isSigned);
+            for (size_t x{}; x < width; x += BlockWidth, ++block, dstRow += BlockWidth * R16g16b16a16Bpp) {
+                if (UseBlockKernels && IsFullBlock(x, y, width, height)) [[likely]]
+                    block->decodeBlock(dstRow, pitch, isSigned);
+                else
+                    [[clang::always_inline]] block->decode(dstRow, x, y, width, height, pitch, R16g16b16a16Bpp, isSigned);
+            }
         }
     }
 
-    void DecodeBc7(const uint8_t *src, uint8_t *dst, size_t width, size_t height) {
+    template<bool UseBlockKernels>
+    static void DecodeBc7Impl(const uint8_t *src, uint8_t *dst, size_t width, size_t height) {
         const auto *block{reinterpret_cast<const BC7::Block *>(src)};
         size_t pitch{R8g8b8a8Bpp * width};
         for (size_t y{}; y < height; y += BlockHeight, dst += BlockHeight * pitch) {
             uint8_t *dstRow{dst};
-            for (size_t x{}; x < width; x += BlockWidth, ++block, dstRow += BlockWidth * R8g8b8a8Bpp)
-                [[clang::always_inline]] block->decode(dstRow, x, y, width, height, pitch);
+            for (size_t x{}; x < width; x += BlockWidth, ++block, dstRow += BlockWidth * R8g8b8a8Bpp) {
+                if (UseBlockKernels && IsFullBlock(x, y, width, height)) [[likely]]
+                    block->decodeBlock(dstRow, pitch);
+                else
+                    [[clang::always_inline]] block->decode(dstRow, x, y, width, height, pitch);
+            }
         }
     }
+
+    void DecodeBc1(const uint8_t *src, uint8_t *dst, size_t width, size_t height, bool hasAlphaChannel) {
+        DecodeBc1Impl<true>(src, dst, width, height, hasAlphaChannel);
+    }
+
+    void DecodeBc2(const uint8_t *src, uint8_t *dst, size_t width, size_t height) {
+        DecodeBc2Impl<true>(src, dst, width, height);
+    }
+
+    void DecodeBc3(const uint8_t *src, uint8_t *dst, size_t width, size_t height) {
+        DecodeBc3Impl<true>(src, dst, width, height);
+    }
+
+    void DecodeBc4(const uint8_t *src, uint8_t *dst, size_t width, size_t height, bool isSigned) {
+        DecodeBc4Impl<true>(src, dst, width, height, isSigned);
+    }
+
+    void DecodeBc5(const uint8_t *src, uint8_t *dst, size_t width, size_t height, bool isSigned) {
+        DecodeBc5Impl<true>(src, dst, width, height, isSigned);
+    }
+
+    void DecodeBc6(const uint8_t *src, uint8_t *dst, size_t width, size_t height, bool isSigned) {
+        DecodeBc6Impl<true>(src, dst, width, height, isSigned);
+    }
+
+    void DecodeBc7(const uint8_t *src, uint8_t *dst, size_t width, size_t height) {
+        DecodeBc7Impl<true>(src, dst, width, height);
+    }
+
+    namespace reference {
+        void DecodeBc1(const uint8_t *src, uint8_t *dst, size_t width, size_t height, bool hasAlphaChannel) {
+            DecodeBc1Impl<false>(src, dst, width, height, hasAlphaChannel);
+        }
+
+        void DecodeBc2(const uint8_t *src, uint8_t *dst, size_t width, size_t height) {
+            DecodeBc2Impl<false>(src, dst, width, height);
+        }
+
+        void DecodeBc3(const uint8_t *src, uint8_t *dst, size_t width, size_t height) {
+            DecodeBc3Impl<false>(src, dst, width, height);
+        }
+
+        void DecodeBc4(const uint8_t *src, uint8_t *dst, size_t width, size_t height, bool isSigned) {
+            DecodeBc4Impl<false>(src, dst, width, height, isSigned);
+        }
+
+        void DecodeBc5(const uint8_t *src, uint8_t *dst, size_t width, size_t height, bool isSigned) {
+            DecodeBc5Impl<false>(src, dst, width, height, isSigned);
+        }
+
+        void DecodeBc6(const uint8_t *src, uint8_t *dst, size_t width, size_t height, bool isSigned) {
+            DecodeBc6Impl<false>(src, dst, width, height, isSigned);
+        }
+
+        void DecodeBc7(const uint8_t *src, uint8_t *dst, size_t width, size_t height) {
+            DecodeBc7Impl<false>(src, dst, width, height);
+        }
+    }
+
+    std::vector<DecodeJob> SplitIntoJobs(const uint8_t *src, uint8_t *dst, size_t width, size_t height, size_t blockSize, size_t dstBpp, size_t maxJobs) {
+        size_t blockRows{(height + BlockHeight - 1) / BlockHeight};
+        size_t blockRowSize{((width + BlockWidth - 1) / BlockWidth) * blockSize};
+        size_t jobCount{std::max<size_t>(std::min({(blockRows * blockRowSize) / MinDecodeJobSize, maxJobs, blockRows}), 1)};
+        size_t rowsPerJob{(blockRows + jobCount - 1) / jobCount};
+
+        std::vector<DecodeJob> jobs;
+        jobs.reserve(jobCount);
+        for (size_t row{}; row < blockRows; row += rowsPerJob) {
+            size_t y{row * BlockHeight};
+            jobs.push_back(DecodeJob{
+                .src = src + (row * blockRowSize),
+                .dst = dst + (y * width * dstBpp),
+                .height = std::min(rowsPerJob * BlockHeight, height - y),
+            });
+        }
+
+        return jobs;
+    }
 }
@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <vector>
 
 namespace bcn {
     /**
@@ -40,4 +42,43 @@ namespace bcn {
      * @brief Decodes a BC7 encoded image to R8G8B8A8
      */
     void DecodeBc7(const uint8_t *src, uint8_t *dst, size_t width, size_t height);
+
+    /**
+     * @brief Decoders which decode every texel individually rather than using the whole-block kernels, their output is bit-exact with the above functions
+     * @note These are far slower and only exist to validate and benchmark the block kernels against
+     */
+    namespace reference {
+        void DecodeBc1(const uint8_t *src, uint8_t *dst, size_t width, size_t height, bool hasAlphaChannel);
+
+        void DecodeBc2(const uint8_t *src, uint8_t *dst, size_t width, size_t height);
+
+        void DecodeBc3(const uint8_t *src, uint8_t *dst, size_t width, size_t height);
+
+        void DecodeBc4(const uint8_t *src, uint8_t *dst, size_t width, size_t height, bool isSigned);
+
+        void DecodeBc5(const uint8_t *src, uint8_t *dst, size_t width, size_t height, bool isSigned);
+
+        void DecodeBc6(const uint8_t *src, uint8_t *dst, size_t width, size_t height, bool isSigned);
+
+        void DecodeBc7(const uint8_t *src, uint8_t *dst, size_t width, size_t height);
+    }
+
+    /**
+     * @brief A contiguous range of block rows in an image which can be decoded independently of the rest of the image
+     */
+    struct DecodeJob {
+        const uint8_t *src;
+        uint8_t *dst;
+        size_t height; //!< The height of the range in pixels, this is a multiple of the block height for all but the last job
+    };
+
+    constexpr size_t MinDecodeJobSize{0x10000}; //!< The minimum amount of encoded data in a single job, splitting smaller images isn't worth the dispatch overhead
+
+    /**
+     * @brief Splits an image into jobs of block rows which can be decoded in parallel with any of the above functions
+     * @param blockSize The size of a single encoded block in bytes
+     * @param dstBpp The amount of bytes per pixel in the decoded image
+     * @param maxJobs The maximum amount of jobs to split the image into
+     */
+    std::vector<DecodeJob> SplitIntoJobs(const uint8_t *src, uint8_t *dst, size_t width, size_t height, size_t blockSize, size_t dstBpp, size_t maxJobs);
 }
@@ -95,15 +95,42 @@ namespace skyline::gpu::texture {
         return mipLevels;
     }
 
+    constexpr size_t GobSize{GobWidth * GobHeight}; //!< The size of a GOB in bytes
+    constexpr size_t ParallelCopyThreshold{0x40000}; //!< The minimum size of a surface in bytes for its ROBs to be split across threads
+
+    /**
+     * @brief Copies an entire GOB between its blocklinear and pitch-linear representations
+     * @note Every line of a GOB is made up of 4 sectors at fixed offsets, so this is fully unrolled into 16-byte loads and stores
+     */
+    template<bool BlockLinearToPitch>
+    __attribute__((always_inline)) inline void CopyGob(u8 *gob, u8 *pitchGob, size_t pitchWidthBytes) {
+        #pragma clang loop unroll(full)
+        for (size_t line{}; line < GobHeight; line++, pitchGob += pitchWidthBytes) {
+            u8 *gobLine{gob + ((line & 0b110) << 5) + ((line & 0b1) << 4)}; // Morton-Swizzle on the Y-axis
+            if constexpr (BlockLinearToPitch) {
+                std::memcpy(pitchGob, gobLine, SectorWidth);
+                std::memcpy(pitchGob + SectorWidth, gobLine + 0x20, SectorWidth);
+                std::memcpy(pitchGob + (SectorWidth * 2), gobLine + 0x100, SectorWidth);
+                std::memcpy(pitchGob + (SectorWidth * 3), gobLine + 0x120, SectorWidth);
+            } else {
+                std::memcpy(gobLine, pitchGob, SectorWidth);
+                std::memcpy(gobLine + 0x20, pitchGob + SectorWidth, SectorWidth);
+                std::memcpy(gobLine + 0x100, pitchGob + (SectorWidth * 2), SectorWidth);
+                std::memcpy(gobLine + 0x120, pitchGob + (SectorWidth * 3), SectorWidth);
+            }
+        }
+    }
+
     /**
      * @brief Copies pixel data between a pitch-linear and blocklinear texture
      * @tparam BlockLinearToPitch Whether to copy from a blocklinear texture to a pitch-linear texture or a pitch-linear texture to a blocklinear texture
+     * @param pool An optional thread pool to split the ROBs of large surfaces across, the copy is done on the calling thread if this is nullptr
      */
     template<bool BlockLinearToPitch>
     void CopyBlockLinearInternal(Dimensions dimensions,
                                  size_t formatBlockWidth, size_t formatBlockHeight, size_t formatBpb, u32 pitchAmount,
                                  size_t gobBlockHeight, size_t gobBlockDepth,
-                                 u8 *blockLinear, u8 *pitch) {
+                                 u8 *blockLinear, u8 *pitch, BS::thread_pool *pool) {
         size_t robWidthUnalignedBytes{util::DivideCeil<size_t>(dimensions.width, formatBlockWidth) * formatBpb};
         size_t robWidthBytes{util::AlignUp(robWidthUnalignedBytes, GobWidth)};
         size_t robWidthBlocks{robWidthUnalignedBytes / GobWidth};
@@ -111,14 +138,14 @@ namespace skyline::gpu::texture {
         if (formatBpb == 12) [[unlikely]]
             formatBpb = 4;
 
-        size_t blockHeight{gobBlockHeight};
-        size_t robHeight{GobHeight * blockHeight};
+        size_t robHeight{GobHeight * gobBlockHeight};
         size_t surfaceHeightLines{util::DivideCeil<size_t>(dimensions.height, formatBlockHeight)};
         size_t surfaceHeightRobs{surfaceHeightLines / robHeight}; //!< The height of the surface in ROBs excluding padding ROBs
+        bool hasPaddingRob{surfaceHeightLines % robHeight != 0};
 
         size_t depthMobCount{util::DivideCeil<size_t>(dimensions.depth, gobBlockDepth)}; //!< The depth of the surface in MOBs (Matrix of Blocks)
         size_t blockDepth{util::AlignUp(dimensions.depth, gobBlockDepth) - dimensions.depth};
-        size_t blockPaddingZ{gobBlockDepth != 1 ? GobWidth * GobHeight * blockHeight * blockDepth : 0};
+        size_t blockPaddingZ{gobBlockDepth != 1 ? GobWidth * GobHeight * gobBlockHeight * blockDepth : 0};
 
         bool hasPaddingBlock{robWidthUnalignedBytes != robWidthBytes};
         size_t blockPaddingOffset{hasPaddingBlock ? (GobWidth - (robWidthBytes - robWidthUnalignedBytes)) : 0};
@@ -128,9 +155,12 @@ namespace skyline::gpu::texture {
         size_t gobYOffset{pitchWidthBytes * GobHeight};
         size_t gobZOffset{pitchWidthBytes * surfaceHeightLines};
 
-        u8 *sector{blockLinear};
+        // Every ROB has a fixed size in the blocklinear surface including any padding, this allows ROBs to be copied independently of each other
+        size_t blockSize{GobSize * gobBlockHeight * gobBlockDepth};
+        size_t robSize{(robWidthBytes / GobWidth) * blockSize};
+        size_t robCount{surfaceHeightRobs + (hasPaddingRob ? 1 : 0)};
 
-        auto deswizzleRob{[&](u8 *pitchRob, auto isLastRob, size_t depthSliceCount, size_t blockPaddingY = 0, size_t blockExtentY = 0) {
+        auto deswizzleRob{[&](u8 *sector, u8 *pitchRob, auto isLastRob, size_t depthSliceCount, size_t blockHeight, size_t blockPaddingY = 0, size_t blockExtentY = 0) {
             auto deswizzleBlock{[&](u8 *pitchBlock, auto copySector) __attribute__((always_inline)) {
                 for (size_t gobZ{}; gobZ < depthSliceCount; gobZ++) { // Every Block contains `depthSliceCount` slices, excluding padding
                     u8 *pitchGob{pitchBlock};
@@ -164,13 +194,28 @@ namespace skyline::gpu::texture {
             }};
 
             for (size_t block{}; block < robWidthBlocks; block++) { // Every ROB contains `surfaceWidthBlocks` blocks (excl. padding block)
-                deswizzleBlock(pitchRob, [&](u8 *linearSector, size_t) __attribute__((always_inline)) {
-                    if constexpr (BlockLinearToPitch)
-                        std::memcpy(linearSector, sector, SectorWidth);
-                    else
-                        std::memcpy(sector, linearSector, SectorWidth);
-                    sector += SectorWidth; // `sectorWidth` bytes are of sequential image data
-                });
+                if constexpr (!isLastRob) {
+                    // Blocks in all but the last ROB only consist of entire GOBs, these can use a specialised copy
+                    u8 *pitchBlock{pitchRob};
+                    for (size_t gobZ{}; gobZ < depthSliceCount; gobZ++, pitchBlock += gobZOffset) {
+                        u8 *pitchGob{pitchBlock};
+                        for (size_t gobY{}; gobY < blockHeight; gobY++, pitchGob += gobYOffset, sector += GobSize) {
+                            __builtin_prefetch(BlockLinearToPitch ? sector + GobSize : pitchGob + gobYOffset); // Prefetch the source of the next GOB
+                            CopyGob<BlockLinearToPitch>(sector, pitchGob, pitchWidthBytes);
+                        }
+                    }
+
+                    if (depthSliceCount != gobBlockDepth) [[unlikely]]
+                        sector += blockPaddingZ; // Skip over any padding Z-axis GOBs
+                } else {
+                    deswizzleBlock(pitchRob, [&](u8 *linearSector, size_t) __attribute__((always_inline)) {
+                        if constexpr (BlockLinearToPitch)
+                            std::memcpy(linearSector, sector, SectorWidth);
+                        else
+                            std::memcpy(sector, linearSector, SectorWidth);
+                        sector += SectorWidth; // `sectorWidth` bytes are of sequential image data
+                    });
+                }
 
                 pitchRob += GobWidth; // Increment the linear block to the next block (As Block Width = 1 GOB Width)
             }
@@ -189,27 +234,48 @@ namespace skyline::gpu::texture {
                 });
         }};
 
-        for (size_t currMob{}; currMob < depthMobCount; ++currMob, pitch += gobZOffset * gobBlockDepth) {
-            u8 *pitchRob{pitch};
-            size_t sliceCount{(currMob + 1) == depthMobCount ? gobBlockDepth - blockDepth : gobBlockDepth};
-            for (size_t rob{}; rob < surfaceHeightRobs; rob++) { // Every Surface contains `surfaceHeightRobs` ROBs (excl. padding ROB)
-                deswizzleRob(pitchRob, std::false_type{}, sliceCount);
-                pitchRob += robBytes; // Increment the linear ROB to the next ROB
-            }
-
-            if (surfaceHeightLines % robHeight != 0) {
-                blockHeight = (util::AlignUp(surfaceHeightLines, GobHeight) - (surfaceHeightRobs * robHeight)) / GobHeight; // Calculate the amount of Y GOBs which aren't padding
+        auto copyRob{[&](size_t index) {
+            size_t mob{index / robCount}, rob{index % robCount};
+            size_t sliceCount{(mob + 1) == depthMobCount ? gobBlockDepth - blockDepth : gobBlockDepth};
+            u8 *sector{blockLinear + (mob * robCount + rob) * robSize};
+            u8 *pitchRob{pitch + (mob * gobZOffset * gobBlockDepth) + (rob * robBytes)};
 
+            if (rob < surfaceHeightRobs) {
+                deswizzleRob(sector, pitchRob, std::false_type{}, sliceCount, gobBlockHeight);
+            } else {
                 deswizzleRob(
+                    sector,
                     pitchRob,
                     std::true_type{},
                     sliceCount,
-                    (gobBlockHeight - blockHeight) * (GobWidth * GobHeight), // Calculate padding at the end of a block to skip
+                    (util::AlignUp(surfaceHeightLines, GobHeight) - (surfaceHeightRobs * robHeight)) / GobHeight, // Calculate the amount of Y GOBs which aren't padding
+                    (gobBlockHeight - ((util::AlignUp(surfaceHeightLines, GobHeight) - (surfaceHeightRobs * robHeight)) / GobHeight)) * (GobWidth * GobHeight), // Calculate padding at the end of a block to skip
                     util::IsAligned(surfaceHeightLines, GobHeight) ? GobHeight : surfaceHeightLines - util::AlignDown(surfaceHeightLines, GobHeight) // Calculate the line relative to the start of the last GOB that is the cut-off point for the image
                 );
-
-                blockHeight = gobBlockHeight;
             }
+        }};
+
+        size_t totalRobs{depthMobCount * robCount};
+        if (pool && totalRobs > 1 && totalRobs * robSize >= ParallelCopyThreshold) {
+            // Split the ROBs into contiguous ranges for every worker thread with the calling thread copying the last range
+            size_t jobCount{std::min<size_t>(pool->get_thread_count() + 1, totalRobs)};
+            size_t robsPerJob{util::DivideCeil(totalRobs, jobCount)};
+
+            std::vector<std::future<void>> futures;
+            for (size_t start{}; start + robsPerJob < totalRobs; start += robsPerJob)
+                futures.emplace_back(pool->submit([&copyRob, start, end = start + robsPerJob] {
+                    for (size_t index{start}; index < end; index++)
+                        copyRob(index);
+                }));
+
+            for (size_t index{futures.size() * robsPerJob}; index < totalRobs; index++)
+                copyRob(index);
+
+            for (auto &future : futures)
+                future.get();
+        } else {
+            for (size_t index{}; index < totalRobs; index++)
+                copyRob(index);
         }
     }
 
@@ -331,12 +397,12 @@ namespace skyline::gpu::texture {
         }
     }
 
-    void CopyBlockLinearToLinear(Dimensions dimensions, size_t formatBlockWidth, size_t formatBlockHeight, size_t formatBpb, size_t gobBlockHeight, size_t gobBlockDepth, u8 *blockLinear, u8 *linear) {
+    void CopyBlockLinearToLinear(Dimensions dimensions, size_t formatBlockWidth, size_t formatBlockHeight, size_t formatBpb, size_t gobBlockHeight, size_t gobBlockDepth, u8 *blockLinear, u8 *linear, BS::thread_pool *pool) {
         CopyBlockLinearInternal<true>(
             dimensions,
             formatBlockWidth, formatBlockHeight, formatBpb, 0,
             gobBlockHeight, gobBlockDepth,
-            blockLinear, linear
+            blockLinear, linear, pool
         );
     }
 
@@ -348,7 +414,7 @@ namespace skyline::gpu::texture {
             dimensions,
             formatBlockWidth, formatBlockHeight, formatBpb, pitchAmount,
             gobBlockHeight, gobBlockDepth,
-            blockLinear, pitch
+            blockLinear, pitch, nullptr
         );
     }
 
@@ -365,23 +431,23 @@ namespace skyline::gpu::texture {
         );
     }
 
-    void CopyBlockLinearToLinear(const GuestTexture &guest, u8 *blockLinear, u8 *linear) {
+    void CopyBlockLinearToLinear(const GuestTexture &guest, u8 *blockLinear, u8 *linear, BS::thread_pool *pool) {
         CopyBlockLinearInternal<true>(
             guest.dimensions,
             guest.format->blockWidth, guest.format->blockHeight, guest.format->bpb, 0,
             guest.tileConfig.blockHeight, guest.tileConfig.blockDepth,
-            blockLinear, linear
+            blockLinear, linear, pool
         );
     }
 
     void CopyLinearToBlockLinear(Dimensions dimensions,
                                  size_t formatBlockWidth, size_t formatBlockHeight, size_t formatBpb,
                                  size_t gobBlockHeight, size_t gobBlockDepth,
-                                 u8 *linear, u8 *blockLinear) {
+                                 u8 *linear, u8 *blockLinear, BS::thread_pool *pool) {
         CopyBlockLinearInternal<false>(dimensions,
                                        formatBlockWidth, formatBlockHeight, formatBpb, 0,
                                        gobBlockHeight, gobBlockDepth,
-                                       blockLinear, linear
+                                       blockLinear, linear, pool
         );
     }
 
@@ -390,7 +456,7 @@ namespace skyline::gpu::texture {
             dimensions,
             formatBlockWidth, formatBlockHeight, formatBpb, pitchAmount,
             gobBlockHeight, gobBlockDepth,
-            blockLinear, pitch
+            blockLinear, pitch, nullptr
         );
     }
 
@@ -422,12 +488,12 @@ namespace skyline::gpu::texture {
         );
     }
 
-    void CopyLinearToBlockLinear(const GuestTexture &guest, u8 *linear, u8 *blockLinear) {
+    void CopyLinearToBlockLinear(const GuestTexture &guest, u8 *linear, u8 *blockLinear, BS::thread_pool *pool) {
         CopyBlockLinearInternal<false>(
             guest.dimensions,
             guest.format->blockWidth, guest.format->blockHeight, guest.format->bpb, 0,
             guest.tileConfig.blockHeight, guest.tileConfig.blockDepth,
-            blockLinear, linear
+            blockLinear, linear, pool
         );
     }
 
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <BS_thread_pool.hpp>
 #include "texture.h"
 
 namespace skyline::gpu::texture {
@@ -34,11 +35,12 @@ namespace skyline::gpu::texture {
 
     /**
      * @brief Copies the contents of a blocklinear texture to a linear output buffer
+     * @param pool An optional thread pool to split the copy of large surfaces across
      */
     void CopyBlockLinearToLinear(Dimensions dimensions,
                                  size_t formatBlockWidth, size_t formatBlockHeight, size_t formatBpb,
                                  size_t gobBlockHeight, size_t gobBlockDepth,
-                                 u8 *blockLinear, u8 *linear);
+                                 u8 *blockLinear, u8 *linear, BS::thread_pool *pool = nullptr);
 
     /**
      * @brief Copies the contents of a blocklinear texture to a pitch texture
@@ -59,16 +61,18 @@ namespace skyline::gpu::texture {
 
     /**
      * @brief Copies the contents of a blocklinear guest texture to a linear output buffer
+     * @param pool An optional thread pool to split the copy of large surfaces across
      */
-    void CopyBlockLinearToLinear(const GuestTexture &guest, u8 *blockLinear, u8 *linear);
+    void CopyBlockLinearToLinear(const GuestTexture &guest, u8 *blockLinear, u8 *linear, BS::thread_pool *pool = nullptr);
 
     /**
      * @brief Copies the contents of a linear buffer to a blocklinear texture
+     * @param pool An optional thread pool to split the copy of large surfaces across
      */
     void CopyLinearToBlockLinear(Dimensions dimensions,
                                 size_t formatBlockWidth, size_t formatBlockHeight, size_t formatBpb,
                                 size_t gobBlockHeight, size_t gobBlockDepth,
-                                u8 *linear, u8 *blockLinear);
+                                u8 *linear, u8 *blockLinear, BS::thread_pool *pool = nullptr);
 
     /**
      * @brief Copies the contents of a pitch texture to a blocklinear texture
@@ -99,7 +103,7 @@ namespace skyline::gpu::texture {
     /**
      * @brief Copies the contents of a linear guest texture to a blocklinear texture
      */
-    void CopyLinearToBlockLinear(const GuestTexture &guest, u8 *linear, u8 *blockLinear);
+    void CopyLinearToBlockLinear(const GuestTexture &guest, u8 *linear, u8 *blockLinear, BS::thread_pool *pool = nullptr);
 
     /**
      * @brief Copies the contents of a pitch-linear guest texture to a linear output buffer
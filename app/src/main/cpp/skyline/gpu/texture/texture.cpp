@@ -283,7 +283,7 @@ namespace skyline::gpu {
             auto outputLayer{deswizzleOutput};
             for (size_t layer{}; layer < layerCount; layer++) {
                 if (guest->tileConfig.mode == texture::TileMode::Block)
-                    texture::CopyBlockLinearToLinear(*guest, pointer, outputLayer);
+                    texture::CopyBlockLinearToLinear(*guest, pointer, outputLayer, &gpu.workerPool);
                 else if (guest->tileConfig.mode == texture::TileMode::Pitch)
                     texture::CopyPitchLinearToLinear(*guest, pointer, outputLayer);
                 else if (guest->tileConfig.mode == texture::TileMode::Linear)
@@ -300,7 +300,8 @@ namespace skyline::gpu {
                         level.dimensions,
                         guest->format->blockWidth, guest->format->blockHeight, guest->format->bpb,
                         level.blockHeight, level.blockDepth,
-                        inputLevel, outputLevel + (layer * level.linearSize) // Offset into the current layer relative to the start of the current mip level
+                        inputLevel, outputLevel + (layer * level.linearSize), // Offset into the current layer relative to the start of the current mip level
+                        &gpu.workerPool
                     );
 
                     inputLevel += level.blockLinearSize; // Skip over the current mip level as we've deswizzled it
@@ -316,46 +317,74 @@ namespace skyline::gpu {
         if (!deswizzleBuffer.empty()) {
             for (const auto &level : mipLayouts) {
                 size_t levelHeight{level.dimensions.height * layerCount}; //!< The height of an image representing all layers in the entire level
+
+                // Large levels are split into jobs of block rows which are decoded across the worker pool with the calling thread decoding the last job
+                auto decode{[&](auto &&decoder) {
+                    auto jobs{bcn::SplitIntoJobs(deswizzleOutput, bufferData, level.dimensions.width, levelHeight, guest->format->bpb, format->bpb, gpu.workerPool.get_thread_count() + 1)};
+                    if (jobs.empty())
+                        return;
+
+                    // The jobs reference the decoder and the staging buffers, so they must all be finished before we unwind if the decoder on this thread throws
+                    struct JobJoiner {
+                        std::vector<std::future<void>> futures;
+
+                        ~JobJoiner() {
+                            for (auto &future : futures)
+                                if (future.valid())
+                                    future.wait();
+                        }
+                    } joiner;
+                    joiner.futures.reserve(jobs.size() - 1);
+                    for (auto it{jobs.begin()}; it != std::prev(jobs.end()); it++)
+                        joiner.futures.emplace_back(gpu.workerPool.submit([&decoder, job = *it, width = level.dimensions.width]() {
+                            decoder(job.src, job.dst, width, job.height);
+                        }));
+
+                    decoder(jobs.back().src, jobs.back().dst, level.dimensions.width, jobs.back().height);
+                    for (auto &future : joiner.futures)
+                        future.get();
+                }};
+
                 switch (guest->format->vkFormat) {
                     case vk::Format::eBc1RgbaUnormBlock:
                     case vk::Format::eBc1RgbaSrgbBlock:
-                        bcn::DecodeBc1(deswizzleOutput, bufferData, level.dimensions.width, levelHeight, true);
+                        decode([](const u8 *src, u8 *dst, size_t width, size_t height) { bcn::DecodeBc1(src, dst, width, height, true); });
                         break;
 
                     case vk::Format::eBc2UnormBlock:
                     case vk::Format::eBc2SrgbBlock:
-                        bcn::DecodeBc2(deswizzleOutput, bufferData, level.dimensions.width, levelHeight);
+                        decode(bcn::DecodeBc2);
                         break;
 
                     case vk::Format::eBc3UnormBlock:
                     case vk::Format::eBc3SrgbBlock:
-                        bcn::DecodeBc3(deswizzleOutput, bufferData, level.dimensions.width, levelHeight);
+                        decode(bcn::DecodeBc3);
                         break;
 
                     case vk::Format::eBc4UnormBlock:
-                        bcn::DecodeBc4(deswizzleOutput, bufferData, level.dimensions.width, levelHeight, false);
+                        decode([](const u8 *src, u8 *dst, size_t width, size_t height) { bcn::DecodeBc4(src, dst, width, height, false); });
                         break;
                     case vk::Format::eBc4SnormBlock:
-                        bcn::DecodeBc4(deswizzleOutput, bufferData, level.dimensions.width, levelHeight, true);
+                        decode([](const u8 *src, u8 *dst, size_t width, size_t height) { bcn::DecodeBc4(src, dst, width, height, true); });
                         break;
 
                     case vk::Format::eBc5UnormBlock:
-                        bcn::DecodeBc5(deswizzleOutput, bufferData, level.dimensions.width, levelHeight, false);
+                        decode([](const u8 *src, u8 *dst, size_t width, size_t height) { bcn::DecodeBc5(src, dst, width, height, false); });
                         break;
                     case vk::Format::eBc5SnormBlock:
-                        bcn::DecodeBc5(deswizzleOutput, bufferData, level.dimensions.width, levelHeight, true);
+                        decode([](const u8 *src, u8 *dst, size_t width, size_t height) { bcn::DecodeBc5(src, dst, width, height, true); });
                         break;
 
                     case vk::Format::eBc6HUfloatBlock:
-                        bcn::DecodeBc6(deswizzleOutput, bufferData, level.dimensions.width, levelHeight, false);
+                        decode([](const u8 *src, u8 *dst, size_t width, size_t height) { bcn::DecodeBc6(src, dst, width, height, false); });
                         break;
                     case vk::Format::eBc6HSfloatBlock:
-                        bcn::DecodeBc6(deswizzleOutput, bufferData, level.dimensions.width, levelHeight, true);
+                        decode([](const u8 *src, u8 *dst, size_t width, size_t height) { bcn::DecodeBc6(src, dst, width, height, true); });
                         break;
 
                     case vk::Format::eBc7UnormBlock:
                     case vk::Format::eBc7SrgbBlock:
-                        bcn::DecodeBc7(deswizzleOutput, bufferData, level.dimensions.width, levelHeight);
+                        decode(bcn::DecodeBc7);
                         break;
 
                     default:
@@ -462,7 +491,7 @@ namespace skyline::gpu {
         if (levelCount == 1) {
             for (size_t layer{}; layer < layerCount; layer++) {
                 if (guest->tileConfig.mode == texture::TileMode::Block)
-                    texture::CopyLinearToBlockLinear(*guest, hostBuffer, guestOutput);
+                    texture::CopyLinearToBlockLinear(*guest, hostBuffer, guestOutput, &gpu.workerPool);
                 else if (guest->tileConfig.mode == texture::TileMode::Pitch)
                     texture::CopyLinearToPitchLinear(*guest, hostBuffer, guestOutput);
                 else if (guest->tileConfig.mode == texture::TileMode::Linear)
@@ -480,7 +509,8 @@ namespace skyline::gpu {
                         level.dimensions,
                         guest->format->blockWidth, guest->format->blockHeight, guest->format->bpb,
                         level.blockHeight, level.blockDepth,
-                        inputLevel + (layer * level.linearSize), outputLevel
+                        inputLevel + (layer * level.linearSize), outputLevel,
+                        &gpu.workerPool
                     );
 
                     outputLevel += level.blockLinearSize;
@@ -7,6 +7,10 @@
 namespace skyline::gpu {
     TextureManager::TextureManager(GPU &gpu) : gpu(gpu) {}
 
+    void TextureManager::InsertMapping(const std::shared_ptr<Texture> &texture, GuestTexture::Mappings::iterator iterator) {
+        mappingTable.Insert(&textures.emplace_back(texture, iterator, nextMappingSequence++, *iterator));
+    }
+
     std::shared_ptr<TextureView> TextureManager::FindOrCreate(const GuestTexture &guestTexture, ContextTag tag) {
         TRACE_EVENT("gpu", "TextureManager::FindOrCreate");
 
@@ -28,20 +32,24 @@ namespace skyline::gpu {
 
         std::shared_ptr<Texture> match{};
         boost::container::small_vector<std::shared_ptr<Texture>, 4> matches{};
-        auto mappingEnd{std::upper_bound(textures.begin(), textures.end(), guestMapping, [guestMapping](const auto &value, const auto &element) {
-            return guestMapping.end() < element.end();
-        })}, hostMapping{std::lower_bound(mappingEnd, textures.end(), guestMapping, [guestMapping](const auto &value, const auto &element) {
-            return guestMapping.begin() < element.end();
-        })};
+
+        // Any mapping containing the guest mapping must overlap with the region of the mapping table it starts in, so only mappings from that region need to be checked
+        boost::container::small_vector<TextureMapping *, 8> candidates{};
+        mappingTable.FindContaining(guestMapping, candidates);
+
+        // Candidates are checked from the highest end address downwards with the most recently inserted mapping first, later candidates take precedence
+        std::sort(candidates.begin(), candidates.end(), [](const TextureMapping *a, const TextureMapping *b) {
+            return a->end() == b->end() ? a->sequence > b->sequence : a->end() > b->end();
+        });
 
         std::shared_ptr<Texture> fullMatch{};
         std::shared_ptr<Texture> layerMipMatch{};
         u32 matchLevel{};
         u32 matchLayer{};
 
-        while (hostMapping != textures.begin() && (--hostMapping)->end() > guestMapping.begin()) {
+        for (auto *hostMapping : candidates) {
             auto &hostMappings{hostMapping->texture->guest->mappings};
-            if (!hostMapping->contains(guestMapping) || hostMapping->texture->replaced)
+            if (hostMapping->texture->replaced)
                 continue;
 
             // We need to check that all corresponding mappings in the candidate texture and the guest texture match up
@@ -137,14 +145,9 @@ namespace skyline::gpu {
         auto texture{std::make_shared<Texture>(gpu, guestTexture)};
         texture->SetupGuestMappings();
         texture->TransitionLayout(vk::ImageLayout::eGeneral);
-        auto it{texture->guest->mappings.begin()};
-        textures.emplace(mappingEnd, TextureMapping{texture, it, guestMapping});
-        while ((++it) != texture->guest->mappings.end()) {
-            guestMapping = *it;
-            auto mapping{std::upper_bound(textures.begin(), textures.end(), guestMapping)};
-            // TODO: Delete overlapping textures that aren't in texture pool
-            textures.emplace(mapping, TextureMapping{texture, it, guestMapping});
-        }
+        // TODO: Delete overlapping textures that aren't in texture pool
+        for (auto it{texture->guest->mappings.begin()}; it != texture->guest->mappings.end(); it++)
+            InsertMapping(texture, it);
 
         return texture->GetView(guestTexture.viewType, vk::ImageSubresourceRange{
             .aspectMask = guestTexture.aspect,
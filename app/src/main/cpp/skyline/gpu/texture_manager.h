@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <list>
+#include <common/mapping_table.h>
 #include "texture/texture.h"
 
 namespace skyline::gpu {
@@ -17,16 +19,27 @@ namespace skyline::gpu {
         struct TextureMapping : span<u8> {
             std::shared_ptr<Texture> texture;
             GuestTexture::Mappings::iterator iterator; //!< An iterator to the mapping in the texture's GuestTexture corresponding to this mapping
+            size_t sequence; //!< A monotonically increasing number assigned on insertion, this is used to consistently order lookups
 
             template<typename... Args>
-            TextureMapping(std::shared_ptr<Texture> texture, GuestTexture::Mappings::iterator iterator, Args &&... args)
+            TextureMapping(std::shared_ptr<Texture> texture, GuestTexture::Mappings::iterator iterator, size_t sequence, Args &&... args)
                 : span<u8>(std::forward<Args>(args)...),
                   texture(std::move(texture)),
-                  iterator(iterator) {}
+                  iterator(iterator),
+                  sequence(sequence) {}
         };
 
+        static constexpr size_t MappingTableGranularityBits{16}; //!< The amount of AS (in bytes) a single entry in the mapping table covers (64 KiB == 1 << 16)
+
         GPU &gpu;
-        std::vector<TextureMapping> textures; //!< A sorted vector of all texture mappings
+        std::list<TextureMapping> textures; //!< A list of all texture mappings, lookups are done using `mappingTable`
+        MappingTable<TextureMapping, MappingTableGranularityBits> mappingTable; //!< An index of all texture mappings by the regions of the AS they overlap, this allows lookups without walking all mappings
+        size_t nextMappingSequence{};
+
+        /**
+         * @brief Inserts a mapping of the supplied texture into the mapping table
+         */
+        void InsertMapping(const std::shared_ptr<Texture> &texture, GuestTexture::Mappings::iterator iterator);
 
       public:
         TextureManager(GPU &gpu);
@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2023 Strato Team and Contributors (https://github.com/strato-emu/)
+
+#include <common/trace.h>
+#include <kernel/types/KThread.h>
+#include "libc_hooks.h"
+
+namespace skyline::hle::libc {
+    /**
+     * @brief Aggregate statistics for a single hook which are emitted as perfetto counters
+     */
+    struct HookCounter {
+        const char *callCountName; //!< The name of the counter track for the amount of calls
+        const char *callTimeName; //!< The name of the counter track for the total time spent in the hook
+        std::atomic<u64> callCount{};
+        std::atomic<u64> callTime{}; //!< The total time spent in the hook in nanoseconds
+
+        constexpr HookCounter(const char *callCountName, const char *callTimeName) : callCountName{callCountName}, callTimeName{callTimeName} {}
+    };
+
+    static HookCounter MemcpyCounter{"memcpy Calls", "memcpy Time (ns)"};
+    static HookCounter MemmoveCounter{"memmove Calls", "memmove Time (ns)"};
+    static HookCounter MemsetCounter{"memset Calls", "memset Time (ns)"};
+    static HookCounter MemcmpCounter{"memcmp Calls", "memcmp Time (ns)"};
+    static HookCounter StrlenCounter{"strlen Calls", "strlen Time (ns)"};
+    static HookCounter StrcmpCounter{"strcmp Calls", "strcmp Time (ns)"};
+
+    /**
+     * @brief Runs the supplied function and accounts for it in the counter, this is skipped entirely when the hook category isn't being traced
+     */
+    template<typename Function>
+    void Measure(HookCounter &counter, Function function) {
+        if (!TRACE_EVENT_CATEGORY_ENABLED("hook")) [[likely]] {
+            function();
+            return;
+        }
+
+        auto startTime{util::GetTimeNs()};
+        function();
+        auto duration{static_cast<u64>(util::GetTimeNs() - startTime)};
+
+        TRACE_COUNTER("hook", counter.callCountName, counter.callCount.fetch_add(1, std::memory_order_relaxed) + 1);
+        TRACE_COUNTER("hook", counter.callTimeName, counter.callTime.fetch_add(duration, std::memory_order_relaxed) + duration);
+    }
+
+    void Memcpy(const DeviceState &state, const HookedSymbol &) {
+        auto &gpr{state.thread->ctx.gpr};
+        Measure(MemcpyCounter, [&] {
+            std::memcpy(reinterpret_cast<void *>(gpr.x0), reinterpret_cast<const void *>(gpr.x1), gpr.x2);
+        });
+    }
+
+    void Memmove(const DeviceState &state, const HookedSymbol &) {
+        auto &gpr{state.thread->ctx.gpr};
+        Measure(MemmoveCounter, [&] {
+            std::memmove(reinterpret_cast<void *>(gpr.x0), reinterpret_cast<const void *>(gpr.x1), gpr.x2);
+        });
+    }
+
+    void Memset(const DeviceState &state, const HookedSymbol &) {
+        auto &gpr{state.thread->ctx.gpr};
+        Measure(MemsetCounter, [&] {
+            std::memset(reinterpret_cast<void *>(gpr.x0), static_cast<u8>(gpr.x1), gpr.x2);
+        });
+    }
+
+    void Memcmp(const DeviceState &state, const HookedSymbol &) {
+        auto &gpr{state.thread->ctx.gpr};
+        Measure(MemcmpCounter, [&] {
+            gpr.x0 = static_cast<u32>(std::memcmp(reinterpret_cast<const void *>(gpr.x0), reinterpret_cast<const void *>(gpr.x1), gpr.x2));
+        });
+    }
+
+    void Strlen(const DeviceState &state, const HookedSymbol &) {
+        auto &gpr{state.thread->ctx.gpr};
+        Measure(StrlenCounter, [&] {
+            gpr.x0 = std::strlen(reinterpret_cast<const char *>(gpr.x0));
+        });
+    }
+
+    void Strcmp(const DeviceState &state, const HookedSymbol &) {
+        auto &gpr{state.thread->ctx.gpr};
+        Measure(StrcmpCounter, [&] {
+            gpr.x0 = static_cast<u32>(std::strcmp(reinterpret_cast<const char *>(gpr.x0), reinterpret_cast<const char *>(gpr.x1)));
+        });
+    }
+}
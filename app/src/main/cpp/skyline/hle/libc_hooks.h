@@ -0,0 +1,24 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2023 Strato Team and Contributors (https://github.com/strato-emu/)
+
+#pragma once
+
+#include "symbol_hooks.h"
+
+/**
+ * @brief HLE replacements for hot guest libc routines, these forward to the host's libc which is tuned for the host CPU
+ * @note Guest addresses are valid host addresses under NCE so arguments can be used directly, faults on trapped memory are handled by the host signal handler
+ */
+namespace skyline::hle::libc {
+    void Memcpy(const DeviceState &state, const HookedSymbol &symbol);
+
+    void Memmove(const DeviceState &state, const HookedSymbol &symbol);
+
+    void Memset(const DeviceState &state, const HookedSymbol &symbol);
+
+    void Memcmp(const DeviceState &state, const HookedSymbol &symbol);
+
+    void Strlen(const DeviceState &state, const HookedSymbol &symbol);
+
+    void Strcmp(const DeviceState &state, const HookedSymbol &symbol);
+}
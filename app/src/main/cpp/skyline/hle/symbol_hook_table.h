@@ -4,14 +4,23 @@
 #pragma once
 
 #include "symbol_hooks.h"
+#include "libc_hooks.h"
 
 namespace skyline::hle {
     struct HookTableEntry {
         std::string_view name; //!< The name of the symbol
         HookType hook; //!< The hook that the symbol should include
+        bool isLibcHook; //!< If the hook is an HLE replacement for a libc routine, these are only applied when enabled in the settings
 
-        HookTableEntry(std::string_view name, HookType hook) : name{name}, hook{std::move(hook)} {}
+        HookTableEntry(std::string_view name, HookType hook, bool isLibcHook = false) : name{name}, hook{std::move(hook)}, isLibcHook{isLibcHook} {}
     };
 
-    static std::array<HookTableEntry, 0> HookedSymbols{};
+    static std::array<HookTableEntry, 6> HookedSymbols{
+        HookTableEntry{"memcpy", OverrideHook{libc::Memcpy}, true},
+        HookTableEntry{"memmove", OverrideHook{libc::Memmove}, true},
+        HookTableEntry{"memset", OverrideHook{libc::Memset}, true},
+        HookTableEntry{"memcmp", OverrideHook{libc::Memcmp}, true},
+        HookTableEntry{"strlen", OverrideHook{libc::Strlen}, true},
+        HookTableEntry{"strcmp", OverrideHook{libc::Strcmp}, true},
+    };
 }
@@ -17,7 +17,7 @@ namespace skyline::hle {
 
     HookedSymbolEntry::HookedSymbolEntry(std::string name, const HookType &hook, Elf64_Addr *offset) : HookedSymbol{std::move(name), hook}, offset{offset} {}
 
-    std::vector<HookedSymbolEntry> GetExecutableSymbols(span<Elf64_Sym> dynsym, span<char> dynstr) {
+    std::vector<HookedSymbolEntry> GetExecutableSymbols(span<Elf64_Sym> dynsym, span<char> dynstr, bool enableLibcHooks) {
         std::vector<HookedSymbolEntry> executableSymbols{};
 
         if constexpr (HookedSymbols.empty())
@@ -32,8 +32,8 @@ namespace skyline::hle {
 
             std::string_view symbolName{dynstr.data() + symbol.st_name};
 
-            auto item{std::find_if(HookedSymbols.begin(), HookedSymbols.end(), [&symbolName](const auto &item) {
-                return item.name == symbolName;
+            auto item{std::find_if(HookedSymbols.begin(), HookedSymbols.end(), [&symbolName, enableLibcHooks](const auto &item) {
+                return item.name == symbolName && (enableLibcHooks || !item.isLibcHook);
             })};
             if (item != HookedSymbols.end()) {
                 executableSymbols.emplace_back(std::string{symbolName}, item->hook, &symbol.st_value);
@@ -41,7 +41,7 @@ namespace skyline::hle {
             }
 
             #ifdef PRINT_HOOK_ALL
-            if (symbolName == "memcpy" || symbolName == "memcmp" || symbolName == "memset" || symbolName == "strcmp" ||  symbolName == "strlen")
+            if (std::find_if(HookedSymbols.begin(), HookedSymbols.end(), [&symbolName](const auto &item) { return item.name == symbolName; }) != HookedSymbols.end())
                 // If symbol is from libc (such as memcpy, strcmp, strlen, etc), we don't need to hook it
                 continue;
 
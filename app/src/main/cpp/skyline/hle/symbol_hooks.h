@@ -38,7 +38,8 @@ namespace skyline::hle {
      * @brief Gets the hooked symbols information required for patching from the given executable's dynsym section
      * @param dynsym The dynsym section of the executable
      * @param dynstr The dynstr section of the executable
+     * @param enableLibcHooks If the HLE replacements for libc routines should be hooked
      * @return A vector of HookedSymbolEntry that contains an entry per hooked symbols
      */
-    std::vector<HookedSymbolEntry> GetExecutableSymbols(span<Elf64_Sym> dynsym, span<char> dynstr);
+    std::vector<HookedSymbolEntry> GetExecutableSymbols(span<Elf64_Sym> dynsym, span<char> dynstr, bool enableLibcHooks);
 }
@@ -2,6 +2,7 @@
 // Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
 
 #include "ipc.h"
+#include "results.h"
 #include "types/KProcess.h"
 
 namespace skyline::kernel::ipc {
@@ -135,14 +136,35 @@ namespace skyline::kernel::ipc {
 
     IpcResponse::IpcResponse(const DeviceState &state) : state(state) {}
 
+    size_t IpcResponse::GetResponseSize(bool isDomain, bool isTipc) const {
+        size_t responseSize{sizeof(CommandHeader)};
+        if (!copyHandles.empty() || !moveHandles.empty())
+            responseSize += sizeof(HandleDescriptor) + ((copyHandles.size() + moveHandles.size()) * sizeof(KHandle));
+        if (isTipc)
+            return responseSize + sizeof(Result) + payloadSize;
+        return util::AlignUp(responseSize, constant::IpcPaddingSum) + (isDomain ? sizeof(DomainHeaderResponse) : 0) + sizeof(PayloadHeader) + payloadSize + (isDomain ? (domainObjects.size() * sizeof(KHandle)) : 0);
+    }
+
     void IpcResponse::WriteResponse(bool isDomain, bool isTipc) {
+        // The payload is bounded by ReservePayload but the headers and handles surrounding it also need to fit, this must be checked before anything is written to TLS
+        if (size_t responseSize{GetResponseSize(isDomain, isTipc)}; responseSize > constant::TlsIpcSize) [[unlikely]] {
+            // This is a bug in the HLE implementation rather than something the guest did, the output is dropped and the guest gets an error which it may be able to recover from
+            LOGE("IPC response of {} doesn't fit into TLS: 0x{:X} bytes with a 0x{:X} byte payload, {} handles and {} domain objects", GetFunctionName(), responseSize, payloadSize, copyHandles.size() + moveHandles.size(), domainObjects.size());
+            payloadSize = 0;
+            domainObjects.clear();
+            errorCode = result::InvalidSize;
+
+            if (GetResponseSize(isDomain, isTipc) > constant::TlsIpcSize)
+                throw exception("IPC response of {} doesn't fit into TLS even without a payload: {} handles", GetFunctionName(), copyHandles.size() + moveHandles.size());
+        }
+
         auto tls{state.ctx->tpidrroEl0};
         u8 *pointer{tls};
 
         memset(tls, 0, constant::TlsIpcSize);
 
         auto header{reinterpret_cast<CommandHeader *>(pointer)};
-        size_t sizeBytes{isTipc ? (payload.size() + sizeof(Result)) : (sizeof(PayloadHeader) + constant::IpcPaddingSum + payload.size() + (domainObjects.size() * sizeof(KHandle)) + (isDomain ? sizeof(DomainHeaderRequest) : 0))};
+        size_t sizeBytes{isTipc ? (payloadSize + sizeof(Result)) : (sizeof(PayloadHeader) + constant::IpcPaddingSum + payloadSize + (domainObjects.size() * sizeof(KHandle)) + (isDomain ? sizeof(DomainHeaderRequest) : 0))};
         header->rawSize = static_cast<u32>(util::DivideCeil(sizeBytes, sizeof(u32))); // Size is in 32-bit units because Nintendo
         header->handleDesc = (!copyHandles.empty() || !moveHandles.empty());
         pointer += sizeof(CommandHeader);
@@ -167,7 +189,7 @@ namespace skyline::kernel::ipc {
         if (isTipc) {
             *reinterpret_cast<Result *>(pointer) = errorCode;
             pointer += sizeof(Result);
-            std::memcpy(pointer, payload.data(), payload.size());
+            std::memcpy(pointer, payload.data(), payloadSize);
         } else {
             size_t offset{static_cast<size_t>(pointer - tls)}; // We calculate the relative offset as the absolute one might differ
             auto padding{util::AlignUp(offset, constant::IpcPaddingSum) - offset}; // Calculate the amount of padding at the front
@@ -185,9 +207,8 @@ namespace skyline::kernel::ipc {
             payloadHeader->value = errorCode;
             pointer += sizeof(PayloadHeader);
 
-            if (!payload.empty())
-                std::memcpy(pointer, payload.data(), payload.size());
-            pointer += payload.size();
+            std::memcpy(pointer, payload.data(), payloadSize);
+            pointer += payloadSize;
 
             if (isDomain) {
                 for (auto &domainObject : domainObjects) {
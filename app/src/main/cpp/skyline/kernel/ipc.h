@@ -265,10 +265,37 @@ namespace skyline {
         class IpcResponse {
           private:
             const DeviceState &state;
-            std::vector<u8> payload; //!< The contents to be pushed to the data payload
+            static constexpr size_t MaxPayloadSize{constant::TlsIpcSize - sizeof(CommandHeader) - sizeof(Result)}; //!< The size of the largest payload that can fit into the TLS IPC buffer, this is for a TIPC response without any handles
+            std::array<u8, MaxPayloadSize> payload; //!< The contents to be pushed to the data payload, this is inline as it needs to fit into the TLS IPC buffer regardless and avoids a heap allocation on every request
+            size_t payloadSize{}; //!< The amount of bytes in `payload` that have been pushed
+
+            /**
+             * @return A pointer to the next `size` bytes in the payload after marking them as used
+             */
+            u8 *ReservePayload(size_t size) {
+                if (payloadSize + size > payload.size())
+                    throw exception("IPC response payload overflow in {}: 0x{:X} + 0x{:X} bytes", GetFunctionName(), payloadSize, size);
+
+                auto pointer{payload.data() + payloadSize};
+                payloadSize += size;
+                return pointer;
+            }
+
+            /**
+             * @return The name of the function that produced this response for use in errors
+             */
+            const char *GetFunctionName() const {
+                return functionName ? functionName : "an IPC control command";
+            }
+
+            /**
+             * @return The size of the response in TLS including all headers, handles and domain objects
+             */
+            size_t GetResponseSize(bool isDomain, bool isTipc) const;
 
           public:
             Result errorCode{}; //!< The error code to respond with, it's 0 (Success) by default
+            const char *functionName{}; //!< The name of the HLE service function that produced this response, this is nullptr for control commands
             boost::container::small_vector<KHandle, 2> copyHandles;
             boost::container::small_vector<KHandle, 2> moveHandles;
             boost::container::small_vector<KHandle, 2> domainObjects;
@@ -282,9 +309,7 @@ namespace skyline {
              */
             template<typename ValueType>
             void Push(const ValueType &value) {
-                auto size{payload.size()};
-                payload.resize(size + sizeof(ValueType));
-                std::memcpy(payload.data() + size, reinterpret_cast<const u8 *>(&value), sizeof(ValueType));
+                std::memcpy(ReservePayload(sizeof(ValueType)), reinterpret_cast<const u8 *>(&value), sizeof(ValueType));
             }
 
             /**
@@ -292,9 +317,7 @@ namespace skyline {
              * @param string The string to write to the payload
              */
             void Push(std::string_view string) {
-                auto size{payload.size()};
-                payload.resize(size + string.size());
-                std::memcpy(payload.data() + size, string.data(), string.size());
+                std::memcpy(ReservePayload(string.size()), string.data(), string.size());
             }
 
             /**
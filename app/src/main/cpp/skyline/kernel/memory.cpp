@@ -18,6 +18,17 @@ namespace skyline::kernel {
     }
 
     void MemoryManager::MapInternal(const std::pair<u8 *, ChunkDescriptor> &newDesc) {
+        // Merging or splitting chunks never changes the attributes of pages outside of the new chunk so only its own pages need to be updated
+        // Writers are serialized by the VMM mutex, the sequence counter only exists for readers in GetPageDescriptor to detect a concurrent write
+        pageTableSequence.store(pageTableSequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        pageTable.Set(newDesc.first, newDesc.first + newDesc.second.size, PageDescriptor{
+            .stateValue = newDesc.second.state.value,
+            .permissionValue = newDesc.second.permission.raw,
+            .attributesValue = newDesc.second.attributes.value,
+        });
+        pageTableSequence.store(pageTableSequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+
         // The chunk that contains / precedes the new chunk base address
         auto firstChunkBase{chunks.lower_bound(newDesc.first)};
         if (newDesc.first <= firstChunkBase->first && firstChunkBase != chunks.begin())
@@ -440,6 +451,22 @@ namespace skyline::kernel {
         return std::make_optional(*chunkBase);
     }
 
+    std::optional<PageDescriptor> MemoryManager::GetPageDescriptor(u8 *addr) {
+        if (!addressSpace.contains(addr)) [[unlikely]]
+            return std::nullopt;
+
+        // This is a seqlock read, the lookup is retried if a write to the page table began or finished while it was being read
+        PageDescriptor descriptor;
+        u32 sequence;
+        do {
+            sequence = pageTableSequence.load(std::memory_order_acquire);
+            descriptor = pageTable[addr];
+            std::atomic_thread_fence(std::memory_order_acquire);
+        } while ((sequence & 1) || sequence != pageTableSequence.load(std::memory_order_relaxed));
+
+        return descriptor;
+    }
+
     __attribute__((always_inline)) void MemoryManager::MapCodeMemory(span<u8> memory, memory::Permission permission) {
         std::unique_lock lock{mutex};
 
@@ -6,7 +6,9 @@
 #include <sys/mman.h>
 #include <common.h>
 #include <common/file_descriptor.h>
+#include <common/segment_table.h>
 #include <map>
+#include <atomic>
 
 namespace skyline {
     namespace kernel::type {
@@ -32,9 +34,9 @@ namespace skyline {
              */
             constexpr Permission(bool read, bool write, bool execute) : r{read}, w{write}, x{execute} {}
 
-            inline bool operator==(const Permission &rhs) const { return r == rhs.r && w == rhs.w && x == rhs.x; }
+            constexpr bool operator==(const Permission &rhs) const { return r == rhs.r && w == rhs.w && x == rhs.x; }
 
-            inline bool operator!=(const Permission &rhs) const { return !operator==(rhs); }
+            constexpr bool operator!=(const Permission &rhs) const { return !operator==(rhs); }
 
             /**
              * @return The value of the permission struct in Linux format
@@ -232,6 +234,28 @@ namespace skyline {
             }
         };
 
+        /**
+         * @brief A trivial version of the attributes of a chunk which is stored per-page in a segment table for O(1) lookups
+         * @note The base and size of the containing chunk aren't tracked as they'd require updating every page of a chunk when it's split or merged
+         */
+        struct PageDescriptor {
+            u32 stateValue;
+            u8 permissionValue;
+            u8 attributesValue;
+
+            constexpr memory::MemoryState GetState() const {
+                return memory::MemoryState{stateValue};
+            }
+
+            constexpr memory::Permission GetPermission() const {
+                return memory::Permission{permissionValue};
+            }
+
+            constexpr memory::MemoryAttribute GetAttributes() const {
+                return memory::MemoryAttribute{attributesValue};
+            }
+        };
+
         /**
          * @brief A memory region representing a guest region mapped in the host address space
          * @details This is used to keep track of the host mapping of a memory region, while also
@@ -256,7 +280,11 @@ namespace skyline {
         class MemoryManager {
           private:
             const DeviceState &state;
-            std::map<u8 *, ChunkDescriptor> chunks;
+            std::map<u8 *, ChunkDescriptor> chunks; //!< The chunks of the address space, this is used for any operations which need the extent of a chunk
+
+            static constexpr size_t L2EntryGranularity{21}; //!< The amount of AS (in bytes) a single L2 PTE covers (2 MiB == 1 << 21)
+            SegmentTable<PageDescriptor, constant::AddressSpaceSize, constant::PageSizeBits, L2EntryGranularity> pageTable; //!< A page table mirroring the attributes of all chunks for O(1) lookups, unset entries correspond to unmapped memory
+            std::atomic<u32> pageTableSequence{}; //!< A sequence counter for lock-free reads of the page table, it's odd while a write to the table is in progress
 
             std::vector<std::shared_ptr<type::KMemory>> memRefs;
 
@@ -329,6 +357,12 @@ namespace skyline {
              */
             std::optional<std::pair<u8 *, ChunkDescriptor>> GetChunk(u8 *addr);
 
+            /**
+             * @brief Gets the attributes of the chunk containing this address without walking the chunk map or locking the VMM
+             * @note This should be preferred over GetChunk when the extent of the chunk isn't required
+             */
+            std::optional<PageDescriptor> GetPageDescriptor(u8 *addr);
+
             // Various mapping functions for use by the guest, argument validity must be checked by the caller
             void MapCodeMemory(span<u8> memory, memory::Permission permission);
 
@@ -393,7 +427,7 @@ namespace skyline {
             /**
              * @return If the supplied guest region is contained withing the accessible guest address space
              */
-            constexpr bool AddressSpaceContains(span<u8> region) const {
+            bool AddressSpaceContains(span<u8> region) const {
                 region = GetHostSpan(region);
                 if (addressSpaceType == memory::AddressSpaceType::AddressSpace36Bit)
                     return codeBase36Bit.contains(region) || base.contains(region);
@@ -37,7 +37,7 @@ namespace skyline::kernel {
     Scheduler::CoreContext &Scheduler::GetOptimalCoreForThread(const std::shared_ptr<type::KThread> &thread) {
         auto *currentCore{&cores.at(thread->coreId)};
 
-        if (!currentCore->queue.empty() && thread->affinityMask.count() != 1) {
+        if (!currentCore->queue.Empty() && thread->affinityMask.count() != 1) {
             // Select core where the current thread will be scheduled the earliest based off average timeslice durations for resident threads
             // There's a preference for the current core as migration isn't free
             size_t minTimeslice{};
@@ -46,12 +46,11 @@ namespace skyline::kernel {
                 if (thread->affinityMask.test(candidateCore.id)) {
                     u64 timeslice{};
 
-                    if (!candidateCore.queue.empty()) {
+                    if (!candidateCore.queue.Empty()) {
                         std::scoped_lock coreLock{candidateCore.mutex};
 
-                        auto threadIterator{candidateCore.queue.cbegin()};
-                        if (threadIterator != candidateCore.queue.cend()) {
-                            const auto &runningThread{*threadIterator};
+                        auto runningThread{candidateCore.queue.Front()};
+                        if (runningThread) {
                             timeslice += [&]() {
                                 if (runningThread->averageTimeslice)
                                     return std::min(runningThread->averageTimeslice - (util::GetTimeTicks() - runningThread->timesliceStart), 1UL);
@@ -61,11 +60,10 @@ namespace skyline::kernel {
                                     return 1UL;
                             }();
 
-                            while (++threadIterator != candidateCore.queue.cend()) {
-                                const auto &residentThread{*threadIterator};
+                            // The queue is sorted by priority so we can stop at the first level with a lower priority than the supplied thread
+                            for (auto residentThread{candidateCore.queue.Next(runningThread)}; residentThread && residentThread->queueNode.priority <= thread->priority; residentThread = candidateCore.queue.Next(residentThread))
                                 if (residentThread->priority <= thread->priority)
                                     timeslice += residentThread->averageTimeslice ? residentThread->averageTimeslice : 1UL;
-                            }
                         }
                     }
 
@@ -89,8 +87,8 @@ namespace skyline::kernel {
         return *currentCore;
     }
 
-    void Scheduler::YieldThread(const std::shared_ptr<type::KThread> &thread) {
-        if (state.thread != thread) {
+    void Scheduler::YieldThread(type::KThread *thread) {
+        if (state.thread.get() != thread) {
             // If another thread is being yielded, we need to send it an OS signal to yield
             if (!thread->pendingYield) {
                 // We only want to yield the thread if it hasn't already been sent a signal to yield in the past
@@ -117,45 +115,42 @@ namespace skyline::kernel {
         }
 
         #ifndef NDEBUG
-        // Scan the queue for the same thread to prevent double insertion
-        for (auto &residentThread : core.queue) {
-            if (residentThread == thread) {
-                LOGE("T{} already exists in C{}", thread->id, core.id);
-            }
-        }
+        // Check the queue for the same thread to prevent double insertion
+        if (core.queue.Contains(thread.get()))
+            LOGE("T{} already exists in C{}", thread->id, core.id);
         #endif
 
-        auto nextThread{std::upper_bound(core.queue.begin(), core.queue.end(), thread->priority.load(), type::KThread::IsHigherPriority)};
-        if (nextThread == core.queue.begin()) {
-            if (nextThread != core.queue.end()) {
+        auto front{core.queue.Front()};
+        if (!front || thread->priority < front->priority) {
+            if (front) {
                 // If the inserted thread has a higher priority than the currently running thread (and the queue isn't empty)
                 // We can yield the thread which is currently scheduled on the core by sending it a signal
                 // It is optimized to avoid waiting for the thread to yield on receiving the signal which serializes the entire pipeline
-                auto front{core.queue.front()};
                 front->forceYield = true;
-                core.queue.splice(std::upper_bound(core.queue.begin(), core.queue.end(), front->priority.load(), type::KThread::IsHigherPriority), core.queue, core.queue.begin());
-                core.queue.push_front(thread);
+                core.queue.Remove(front);
+                core.queue.PushBack(front, front->priority);
+                core.queue.PushFront(thread.get(), thread->priority);
 
                 YieldThread(front);
             } else {
-                core.queue.push_front(thread);
+                core.queue.PushFront(thread.get(), thread->priority);
             }
             if (thread != state.thread)
                 thread->scheduleCondition.notify(); // We only want to trigger the conditional variable if the current thread isn't inserting itself
         } else {
-            core.queue.insert(nextThread, thread);
+            core.queue.PushBack(thread.get(), thread->priority);
         }
     }
 
     void Scheduler::MigrateToCore(const std::shared_ptr<type::KThread> &thread, CoreContext *&currentCore, CoreContext *targetCore, std::unique_lock<SpinLock> &lock) {
         // We need to check if the thread was in its resident core's queue
         // If it was, we need to remove it from the queue
-        auto it{std::find(currentCore->queue.begin(), currentCore->queue.end(), thread)};
-        bool wasInserted{it != currentCore->queue.end()};
+        bool wasInserted{currentCore->queue.Contains(thread.get())};
         if (wasInserted) {
-            it = currentCore->queue.erase(it);
-            if (it == currentCore->queue.begin() && it != currentCore->queue.end())
-                (*it)->scheduleCondition.notify();
+            bool wasFront{currentCore->queue.Front() == thread.get()};
+            currentCore->queue.Remove(thread.get());
+            if (wasFront && !currentCore->queue.Empty())
+                currentCore->queue.Front()->scheduleCondition.notify();
         }
         lock.unlock();
 
@@ -181,7 +176,7 @@ namespace skyline::kernel {
                 if (!thread->affinityMask.test(thread->coreId)) // We need to retest in case the thread was migrated while the core was unlocked
                     MigrateToCore(thread, core, &cores.at(thread->idealCore), lock);
             }
-            return !core->queue.empty() && core->queue.front() == thread;
+            return core->queue.Front() == thread.get();
         }};
 
         TRACE_EVENT("scheduler", "WaitSchedule");
@@ -219,7 +214,7 @@ namespace skyline::kernel {
                 std::scoped_lock migrationLock{thread->coreMigrationMutex};
                 MigrateToCore(thread, core, &cores.at(thread->idealCore), lock);
             }
-            return !core->queue.empty() && core->queue.front() == thread;
+            return core->queue.Front() == thread.get();
         })) {
             if (thread->priority == core->preemptionPriority)
                 thread->ArmPreemptionTimer(PreemptiveTimeslice);
@@ -238,14 +233,15 @@ namespace skyline::kernel {
 
         std::unique_lock lock(core.mutex);
 
-        if (core.queue.front() == thread) {
+        if (core.queue.Front() == thread.get()) {
             // If this thread is at the front of the thread queue then we need to rotate the thread
             // In the case where this thread was forcefully yielded, we don't need to do this as it's done by the thread which yielded to this thread
-            // Splice the linked element from the beginning of the queue to where its priority is present
-            core.queue.splice(std::upper_bound(core.queue.begin(), core.queue.end(), thread->priority.load(), type::KThread::IsHigherPriority), core.queue, core.queue.begin());
+            // Move the thread from the front of the queue to the back of the level corresponding to its current priority
+            core.queue.Remove(thread.get());
+            core.queue.PushBack(thread.get(), thread->priority);
 
-            auto &front{core.queue.front()};
-            if (front != thread)
+            auto front{core.queue.Front()};
+            if (front != thread.get())
                 front->scheduleCondition.notify(); // If we aren't at the front of the queue, only then should we wake the thread at the front up
         } else if (!thread->forceYield) {
             throw exception("T{} called Rotate while not being in C{}'s queue", thread->id, thread->coreId);
@@ -265,16 +261,16 @@ namespace skyline::kernel {
             std::unique_lock lock(core.mutex);
 
             if (!thread->isPaused) {
-                auto it{std::find(core.queue.begin(), core.queue.end(), thread)};
-                if (it != core.queue.end()) {
-                    it = core.queue.erase(it);
-                    if (it == core.queue.begin()) {
+                if (core.queue.Contains(thread.get())) {
+                    bool wasFront{core.queue.Front() == thread.get()};
+                    core.queue.Remove(thread.get());
+                    if (wasFront) {
                         // We need to update the averageTimeslice accordingly, if we've been unscheduled by this
                         if (thread->timesliceStart)
                             thread->averageTimeslice = (thread->averageTimeslice / 4) + (3 * (util::GetTimeTicks() - thread->timesliceStart / 4));
 
-                        if (it != core.queue.end())
-                            (*it)->scheduleCondition.notify(); // We need to wake the thread at the front of the queue, if we were at the front previously
+                        if (!core.queue.Empty())
+                            core.queue.Front()->scheduleCondition.notify(); // We need to wake the thread at the front of the queue, if we were at the front previously
                     }
                 } else {
                     LOGW("T{} was not in C{}'s queue", thread->id, thread->coreId);
@@ -295,38 +291,56 @@ namespace skyline::kernel {
         auto *core{&cores.at(thread->coreId)};
         std::unique_lock coreLock(core->mutex);
 
-        auto currentIt{std::find(core->queue.begin(), core->queue.end(), thread)}, nextIt{std::next(currentIt)};
-        if (currentIt == core->queue.end()) {
+        if (!core->queue.Contains(thread.get()))
             return;
-        } else if (currentIt == core->queue.begin()) {
+
+        auto front{core->queue.Front()};
+        if (front == thread.get()) {
             // Alternatively, if it's currently running then we'd just want to yield if there's a higher priority thread to run instead
-            if (nextIt != core->queue.end() && (*nextIt)->priority < thread->priority) {
-                YieldThread(thread);
-            } else if (!thread->isPreempted && thread->priority == core->preemptionPriority) {
+            // The thread is left at its previous level till it rotates so it stays at the front of the queue till then
+            auto next{core->queue.Next(thread.get())};
+            if (next && next->priority < thread->priority) {
+                YieldThread(thread.get());
+                return;
+            }
+
+            // The thread remains at the front of the queue, it just needs to be moved to the level corresponding to its new priority
+            core->queue.Remove(thread.get());
+            core->queue.PushFront(thread.get(), thread->priority);
+
+            if (!thread->isPreempted && thread->priority == core->preemptionPriority) {
                 // If the thread needs to be preempted due to its new priority then arm its preemption timer
                 thread->ArmPreemptionTimer(PreemptiveTimeslice);
             } else if (thread->isPreempted && thread->priority != core->preemptionPriority) {
                 // If the thread no longer needs to be preempted due to its new priority then disarm its preemption timer
                 thread->DisarmPreemptionTimer();
             }
-        } else if (thread->priority < (*std::prev(currentIt))->priority || (nextIt != core->queue.end() && thread->priority > (*nextIt)->priority)) {
-            // If the thread is in the queue and it's position is affected by the priority change then need to remove and re-insert the thread
-            core->queue.erase(currentIt);
-
-            auto targetIt{std::upper_bound(core->queue.begin(), core->queue.end(), thread->priority.load(), type::KThread::IsHigherPriority)};
-            if (targetIt == core->queue.begin() && targetIt != core->queue.end()) {
-                core->queue.insert(std::next(core->queue.begin()), thread);
-                YieldThread(core->queue.front());
+        } else if (thread->priority < front->priority) {
+            // If the thread now has a higher priority than the running thread then it should run directly after the running thread yields
+            // The boosted thread is placed at the level corresponding to its priority, ahead of any other threads at that level
+            // The running thread is moved up to that level if it's below it so it stays at the front, it's re-linked at its own level when it rotates
+            core->queue.Remove(thread.get());
+            if (front->queueNode.priority >= thread->priority) {
+                if (front->queueNode.priority != thread->priority) {
+                    core->queue.Remove(front);
+                    core->queue.PushFront(front, thread->priority);
+                }
+                core->queue.InsertAfter(front, thread.get());
             } else {
-                core->queue.insert(targetIt, thread);
+                core->queue.PushFront(thread.get(), thread->priority);
             }
+            YieldThread(front);
+        } else if (thread->queueNode.priority != thread->priority) {
+            // If the thread is in the queue and its level is affected by the priority change then we need to remove and re-insert the thread
+            core->queue.Remove(thread.get());
+            core->queue.PushBack(thread.get(), thread->priority);
         }
     }
 
     void Scheduler::UpdateCore(const std::shared_ptr<type::KThread> &thread) {
         auto *core{&cores.at(thread->coreId)};
         std::scoped_lock coreLock{core->mutex};
-        if (core->queue.front() == thread)
+        if (core->queue.Front() == thread.get())
             thread->SendSignal(YieldSignal);
         else
             thread->scheduleCondition.notify();
@@ -339,14 +353,17 @@ namespace skyline::kernel {
 
         auto originalCoreId{thread->coreId};
         thread->coreId = constant::ParkedCoreId;
-        for (auto &core : cores)
-            if (originalCoreId != core.id && thread->affinityMask.test(core.id) && (core.queue.empty() || core.queue.front()->priority > thread->priority))
+        for (auto &core : cores) {
+            auto front{core.queue.Front()};
+            if (originalCoreId != core.id && thread->affinityMask.test(core.id) && (!front || front->priority > thread->priority))
                 thread->coreId = core.id;
+        }
 
         if (thread->coreId == constant::ParkedCoreId) {
             std::unique_lock lock(parkedMutex);
-            parkedQueue.insert(std::upper_bound(parkedQueue.begin(), parkedQueue.end(), thread->priority.load(), type::KThread::IsHigherPriority), thread);
-            thread->scheduleCondition.wait(lock, [&]() { return parkedQueue.front() == thread && thread->coreId != constant::ParkedCoreId; });
+            parkedQueue.PushBack(thread.get(), thread->priority);
+            thread->scheduleCondition.wait(lock, [&]() { return parkedQueue.Front() == thread.get() && thread->coreId != constant::ParkedCoreId; });
+            parkedQueue.Remove(thread.get()); // The thread needs to leave the parked queue so the next parked thread can be woken
         }
 
         InsertThread(thread);
@@ -354,13 +371,14 @@ namespace skyline::kernel {
 
     void Scheduler::WakeParkedThread() {
         std::unique_lock parkedLock(parkedMutex);
-        if (!parkedQueue.empty()) {
+        auto parkedThread{parkedQueue.Front()};
+        if (parkedThread) {
             auto &thread{state.thread};
             auto &core{cores.at(thread->coreId)};
             std::unique_lock coreLock(core.mutex);
-            auto nextThread{core.queue.size() > 1 ? *std::next(core.queue.begin()) : nullptr};
-            nextThread = nextThread->priority == thread->priority ? nextThread : nullptr; // If the next thread doesn't have the same priority then it won't be scheduled next
-            auto parkedThread{parkedQueue.front()};
+            auto front{core.queue.Front()};
+            auto nextThread{front ? core.queue.Next(front) : nullptr};
+            nextThread = nextThread && nextThread->priority == thread->priority ? nextThread : nullptr; // If the next thread doesn't have the same priority then it won't be scheduled next
 
             // We need to be conservative about waking up a parked thread, it should only be done if its priority is higher than the current thread
             // Alternatively, it should be done if its priority is equivalent to the current thread's priority but the next thread had been scheduled prior or if there is no next thread (Current thread would be rescheduled)
@@ -378,17 +396,17 @@ namespace skyline::kernel {
 
         thread->isPaused = true;
 
-        auto it{std::find(core->queue.begin(), core->queue.end(), thread)};
-        if (it != core->queue.end()) {
+        if (core->queue.Contains(thread.get())) {
             thread->insertThreadOnResume = true; // If we're handling removing the thread then we need to be responsible for inserting it back inside ResumeThread
 
-            it = core->queue.erase(it);
-            if (it == core->queue.begin() && it != core->queue.end())
-                (*it)->scheduleCondition.notify();
+            bool wasFront{core->queue.Front() == thread.get()};
+            core->queue.Remove(thread.get());
+            if (wasFront) {
+                if (!core->queue.Empty())
+                    core->queue.Front()->scheduleCondition.notify();
 
-            if (it == core->queue.begin()) {
                 // We need to send a yield signal to the thread if it's currently running
-                YieldThread(thread);
+                YieldThread(thread.get());
                 thread->forceYield = true;
             }
         } else {
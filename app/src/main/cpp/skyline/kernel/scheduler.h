@@ -5,6 +5,7 @@
 
 #include "common/spin_lock.h"
 #include <common.h>
+#include "thread_queue.h"
 #include <condition_variable>
 
 namespace skyline {
@@ -48,15 +49,15 @@ namespace skyline {
                 u8 id;
                 i8 preemptionPriority; //!< The priority at which this core becomes preemptive as opposed to cooperative
                 SpinLock mutex; //!< Synchronizes all operations on the queue
-                std::list<std::shared_ptr<type::KThread>> queue; //!< A queue of threads which are running or to be run on this core
+                ThreadQueue<type::KThread> queue; //!< A queue of threads which are running or to be run on this core, the thread at the front is the one currently running
 
                 CoreContext(u8 id, i8 preemptionPriority);
             };
 
             std::array<CoreContext, constant::CoreCount> cores{CoreContext(0, 59), CoreContext(1, 59), CoreContext(2, 59), CoreContext(3, 63)};
 
-            std::mutex parkedMutex; //!< Synchronizes all operations on the queue of parked threads
-            std::list<std::shared_ptr<type::KThread>> parkedQueue; //!< A queue of threads which are parked and waiting on core migration
+            SpinLock parkedMutex; //!< Synchronizes all operations on the queue of parked threads
+            ThreadQueue<type::KThread> parkedQueue; //!< A queue of threads which are parked and waiting on core migration
 
             /**
              * @brief Migrate a thread from its resident core to the target core
@@ -68,7 +69,7 @@ namespace skyline {
             /**
              * @brief Trigger a thread to yield via a signal or on SVC exit if it is the current thread
              */
-            void YieldThread(const std::shared_ptr<type::KThread> &thread);
+            void YieldThread(type::KThread *thread);
 
           public:
             static constexpr std::chrono::milliseconds PreemptiveTimeslice{10}; //!< The duration of time a preemptive thread can run before yielding
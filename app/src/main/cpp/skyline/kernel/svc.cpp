@@ -71,10 +71,10 @@ namespace skyline::kernel::svc {
             return;
         }
 
-        auto chunk{state.process->memory.GetChunk(address).value()};
-        if (!chunk.second.state.permissionChangeAllowed) [[unlikely]] {
+        auto page{state.process->memory.GetPageDescriptor(address).value()};
+        if (!page.GetState().permissionChangeAllowed) [[unlikely]] {
             ctx.w0 = result::InvalidState;
-            LOGW("Permission change not allowed for chunk at: {}, state: 0x{:X}", chunk.first, chunk.second.state.value);
+            LOGW("Permission change not allowed for chunk at: {}, state: 0x{:X}", fmt::ptr(address), page.stateValue);
             return;
         }
 
@@ -115,12 +115,12 @@ namespace skyline::kernel::svc {
             return;
         }
 
-        auto chunk{state.process->memory.GetChunk(address).value()};
+        auto page{state.process->memory.GetPageDescriptor(address).value()};
 
         // We only check the first found chunk for whatever reason.
-        if (!chunk.second.state.attributeChangeAllowed) [[unlikely]] {
+        if (!page.GetState().attributeChangeAllowed) [[unlikely]] {
             ctx.w0 = result::InvalidState;
-            LOGW("Attribute change not allowed for chunk: {}", fmt::ptr(chunk.first));
+            LOGW("Attribute change not allowed for chunk at: {}", fmt::ptr(address));
             return;
         }
 
@@ -165,10 +165,10 @@ namespace skyline::kernel::svc {
             return;
         }
 
-        auto chunk{state.process->memory.GetChunk(source)};
-        if (!chunk->second.state.mapAllowed) [[unlikely]] {
+        auto page{state.process->memory.GetPageDescriptor(source).value()};
+        if (!page.GetState().mapAllowed) [[unlikely]] {
             ctx.w0 = result::InvalidState;
-            LOGW("Source doesn't allow usage of svcMapMemory: 'source': {}, 'size': {}, MemoryState: 0x{:X}", fmt::ptr(source), size, chunk->second.state.value);
+            LOGW("Source doesn't allow usage of svcMapMemory: 'source': {}, 'size': {}, MemoryState: 0x{:X}", fmt::ptr(source), size, page.stateValue);
             return;
         }
 
@@ -225,7 +225,7 @@ namespace skyline::kernel::svc {
                 .ipcRefCount = 0,
             };
 
-            fmt::format("Address: {}, Region Start: 0x{:X}, Size: 0x{:X}, Type: 0x{:X}, Attributes: 0x{:X}, Permissions: {}", fmt::ptr(address), memInfo.address, memInfo.size, memInfo.type, memInfo.attributes, chunk->second.permission);
+            LOGV("Address: {}, Region Start: 0x{:X}, Size: 0x{:X}, Type: 0x{:X}, Attributes: 0x{:X}, Permissions: {}", fmt::ptr(address), memInfo.address, memInfo.size, memInfo.type, memInfo.attributes, chunk->second.permission);
         } else {
             u64 addressSpaceEnd{reinterpret_cast<u64>(state.process->memory.addressSpace.end().base())};
 
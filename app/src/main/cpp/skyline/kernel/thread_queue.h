@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2023 Strato Team and Contributors (https://github.com/strato-emu/)
+
+#pragma once
+
+#include <common.h>
+
+namespace skyline::kernel {
+    template<typename ThreadType>
+    class ThreadQueue;
+
+    /**
+     * @brief The intrusive links of a thread in a ThreadQueue, this is embedded in every thread so queue operations don't require any allocations or reference counting
+     */
+    template<typename ThreadType>
+    struct ThreadQueueNode {
+        ThreadQueue<ThreadType> *queue; //!< The queue the thread is currently in or nullptr if it isn't in any queue
+        ThreadType *next; //!< The next thread in the same priority level
+        ThreadType *previous; //!< The previous thread in the same priority level
+        u8 priority; //!< The priority level the thread was inserted at, this may differ from the thread's current priority till it's reinserted
+    };
+
+    /**
+     * @brief A queue of threads ordered by priority and in FIFO order within a priority, with a bitmap of the occupied priority levels and an intrusive list per level
+     * @tparam ThreadType The type of the threads in the queue, this must have a ThreadQueueNode<ThreadType> named 'queueNode' and an 'id' member
+     * @note Inserting, removing and retrieving the front are all O(1) operations
+     * @note A thread can only be in a single queue at a time as the links are stored in the thread itself, this isn't thread-safe and must be protected by the owner's lock
+     */
+    template<typename ThreadType>
+    class ThreadQueue {
+      private:
+        static constexpr size_t PriorityLevels{std::numeric_limits<u64>::digits}; //!< The amount of priority levels, this must cover the entire range of HOS priorities
+
+        struct Level {
+            ThreadType *head;
+            ThreadType *tail;
+        };
+
+        u64 occupiedLevels{}; //!< A bitmap of all priority levels which contain at least a single thread
+        std::array<Level, PriorityLevels> levels{};
+
+        void Link(ThreadType *thread, u8 priority, ThreadType *previous, ThreadType *next) {
+            auto &level{levels[priority]};
+            thread->queueNode = {
+                .queue = this,
+                .next = next,
+                .previous = previous,
+                .priority = priority,
+            };
+
+            if (previous)
+                previous->queueNode.next = thread;
+            else
+                level.head = thread;
+
+            if (next)
+                next->queueNode.previous = thread;
+            else
+                level.tail = thread;
+
+            occupiedLevels |= 1ULL << priority;
+        }
+
+      public:
+        bool Empty() const {
+            return !occupiedLevels;
+        }
+
+        /**
+         * @return The first thread in the queue or nullptr if the queue is empty
+         */
+        ThreadType *Front() const {
+            return occupiedLevels ? levels[static_cast<size_t>(std::countr_zero(occupiedLevels))].head : nullptr;
+        }
+
+        /**
+         * @return The thread after the supplied thread in the queue or nullptr if it's the last one
+         */
+        ThreadType *Next(ThreadType *thread) const {
+            if (thread->queueNode.next)
+                return thread->queueNode.next;
+
+            // Find the first occupied level after the level of the supplied thread, the shift wraps around to 0 for the last level which clears the entire mask
+            u64 nextLevels{occupiedLevels & ~((2ULL << thread->queueNode.priority) - 1)};
+            return nextLevels ? levels[static_cast<size_t>(std::countr_zero(nextLevels))].head : nullptr;
+        }
+
+        /**
+         * @return If the supplied thread is in this queue
+         */
+        bool Contains(ThreadType *thread) const {
+            return thread->queueNode.queue == this;
+        }
+
+        /**
+         * @brief Inserts the thread after all other threads at the supplied priority
+         */
+        void PushBack(ThreadType *thread, i8 priority) {
+            if (static_cast<u8>(priority) >= PriorityLevels) [[unlikely]]
+                throw exception("Inserting T{} with invalid priority: {}", thread->id, priority);
+
+            Link(thread, static_cast<u8>(priority), levels[static_cast<u8>(priority)].tail, nullptr);
+        }
+
+        /**
+         * @brief Inserts the thread before all other threads at the supplied priority
+         */
+        void PushFront(ThreadType *thread, i8 priority) {
+            if (static_cast<u8>(priority) >= PriorityLevels) [[unlikely]]
+                throw exception("Inserting T{} with invalid priority: {}", thread->id, priority);
+
+            Link(thread, static_cast<u8>(priority), nullptr, levels[static_cast<u8>(priority)].head);
+        }
+
+        /**
+         * @brief Inserts the thread directly after the supplied thread which must be in the queue, at the same priority level regardless of the thread's priority
+         */
+        void InsertAfter(ThreadType *position, ThreadType *thread) {
+            Link(thread, position->queueNode.priority, position, position->queueNode.next);
+        }
+
+        void Remove(ThreadType *thread) {
+            auto &node{thread->queueNode};
+            auto &level{levels[node.priority]};
+
+            if (node.previous)
+                node.previous->queueNode.next = node.next;
+            else
+                level.head = node.next;
+
+            if (node.next)
+                node.next->queueNode.previous = node.previous;
+            else
+                level.tail = node.previous;
+
+            if (!level.head)
+                occupiedLevels &= ~(1ULL << node.priority);
+
+            node = {};
+        }
+    };
+}
@@ -61,6 +61,7 @@ namespace skyline {
             bool isPreempted{}; //!< If the preemption timer has been armed and will fire
             bool pendingYield{}; //!< If the thread has been yielded and hasn't been acted upon it yet
             bool forceYield{}; //!< If the thread has been forcefully yielded by another thread
+            ThreadQueueNode<KThread> queueNode{}; //!< The links of this thread in the scheduler queue it's in, this must only be accessed with the lock of that queue held
 
             RecursiveSpinLock waiterMutex; //!< Synchronizes operations on mutation of the waiter members
             u32 *waitMutex; //!< The key of the mutex which this thread is waiting on
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <common.h>
+#include <nce.h>
 
 namespace skyline::loader {
     /**
@@ -51,5 +52,7 @@ namespace skyline::loader {
 
         RelativeSegment dynsym; //!< The .dynsym segment relative to .rodata
         RelativeSegment dynstr; //!< The .dynstr segment relative to .rodata
+
+        std::optional<nce::NCE::PatchData> patch; //!< The NCE patch data for the unpatched .text segment, this is generated during loading if it isn't supplied
     };
 }
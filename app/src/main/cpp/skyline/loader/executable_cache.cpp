@@ -0,0 +1,164 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2023 Strato Team and Contributors (https://github.com/strato-emu/)
+
+#include <fstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "executable_cache.h"
+
+namespace skyline::loader {
+    struct ExecutableCacheFileHeader {
+        static constexpr u32 Magic{util::MakeMagic<u32>("XCHE")}; //!< The magic value used to identify an executable cache file
+        static constexpr u32 Version{1}; //!< The version of the executable cache file format, MUST be incremented for any format changes
+
+        u32 magic{Magic};
+        u32 version{Version};
+        u64 clockFrequency; //!< The host clock frequency the patch data was generated for, patches differ based on whether the clock needs to be rescaled
+        u64 keySize; //!< The size of the key following the header
+        u64 textOffset; //!< The offset of the .text segment in the file
+        u64 textSize;
+        u64 roOffset; //!< The offset of the .rodata segment in the file
+        u64 roSize;
+        u64 dataOffset; //!< The offset of the .data segment in the file
+        u64 dataSize;
+        u64 patchOffsetsOffset; //!< The offset of the array of patch offsets in the file
+        u64 patchOffsetCount;
+        u64 patchSize; //!< The size of the .patch section
+        u64 textLoadOffset; //!< The offset of the .text segment from the base address of the executable
+        u64 roLoadOffset; //!< The offset of the .rodata segment from the base address of the executable
+        u64 dataLoadOffset; //!< The offset of the .data segment from the base address of the executable
+        u64 bssSize;
+        Executable::RelativeSegment dynsym;
+        Executable::RelativeSegment dynstr;
+
+        bool IsValid() const {
+            return magic == Magic && version == Version && clockFrequency == util::ClockFrequency;
+        }
+    };
+
+    ExecutableCache::ExecutableCache(std::string pPath) : path(pPath.ends_with('/') ? std::move(pPath) : std::move(pPath) + '/') {}
+
+    std::string ExecutableCache::GetEntryPath(span<u8> buildId) {
+        return path + util::HexDump(buildId);
+    }
+
+    std::optional<Executable> ExecutableCache::Load(span<u8> buildId, span<const u8> key) {
+        int fd{open(GetEntryPath(buildId).c_str(), O_RDONLY | O_CLOEXEC)};
+        if (fd < 0)
+            return std::nullopt;
+
+        struct stat fileStat{};
+        if (fstat(fd, &fileStat) != 0 || static_cast<size_t>(fileStat.st_size) < sizeof(ExecutableCacheFileHeader)) {
+            close(fd);
+            return std::nullopt;
+        }
+
+        size_t fileSize{static_cast<size_t>(fileStat.st_size)};
+        auto file{static_cast<u8 *>(mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0))};
+        close(fd);
+        if (file == MAP_FAILED)
+            return std::nullopt;
+
+        std::optional<Executable> executable;
+        [&]() {
+            ExecutableCacheFileHeader header;
+            std::memcpy(&header, file, sizeof(ExecutableCacheFileHeader));
+            if (!header.IsValid() || header.keySize != key.size() || sizeof(ExecutableCacheFileHeader) + header.keySize > fileSize)
+                return;
+
+            if (std::memcmp(file + sizeof(ExecutableCacheFileHeader), key.data(), key.size()) != 0)
+                return;
+
+            auto inBounds{[&](u64 offset, u64 size) { return offset <= fileSize && size <= fileSize - offset; }};
+            if (!inBounds(header.textOffset, header.textSize) || !inBounds(header.roOffset, header.roSize) || !inBounds(header.dataOffset, header.dataSize) || header.patchOffsetCount > fileSize / sizeof(u64) || !inBounds(header.patchOffsetsOffset, header.patchOffsetCount * sizeof(u64)))
+                return;
+
+            auto &result{executable.emplace()};
+            result.text = {std::vector<u8>(file + header.textOffset, file + header.textOffset + header.textSize), header.textLoadOffset};
+            result.ro = {std::vector<u8>(file + header.roOffset, file + header.roOffset + header.roSize), header.roLoadOffset};
+            result.data = {std::vector<u8>(file + header.dataOffset, file + header.dataOffset + header.dataSize), header.dataLoadOffset};
+            result.bssSize = header.bssSize;
+            result.dynsym = header.dynsym;
+            result.dynstr = header.dynstr;
+
+            auto &patch{result.patch.emplace()};
+            patch.size = header.patchSize;
+            patch.offsets.resize(header.patchOffsetCount);
+            for (size_t index{}; index < header.patchOffsetCount; index++) {
+                u64 offset;
+                std::memcpy(&offset, file + header.patchOffsetsOffset + (index * sizeof(u64)), sizeof(u64));
+                patch.offsets[index] = offset;
+            }
+        }();
+
+        munmap(file, fileSize);
+        return executable;
+    }
+
+    void ExecutableCache::Store(span<u8> buildId, span<const u8> key, const Executable &executable) {
+        if (!executable.patch)
+            throw exception("Cannot cache an executable without patch data");
+
+        ExecutableCacheFileHeader header{
+            .clockFrequency = util::ClockFrequency,
+            .keySize = key.size(),
+            .textSize = executable.text.contents.size(),
+            .roSize = executable.ro.contents.size(),
+            .dataSize = executable.data.contents.size(),
+            .patchOffsetCount = executable.patch->offsets.size(),
+            .patchSize = executable.patch->size,
+            .textLoadOffset = executable.text.offset,
+            .roLoadOffset = executable.ro.offset,
+            .dataLoadOffset = executable.data.offset,
+            .bssSize = executable.bssSize,
+            .dynsym = executable.dynsym,
+            .dynstr = executable.dynstr,
+        };
+
+        // Every segment starts on a page boundary, this keeps the layout compatible with mapping segments directly from the file in the future
+        header.textOffset = util::AlignUp(sizeof(ExecutableCacheFileHeader) + key.size(), constant::PageSize);
+        header.roOffset = util::AlignUp(header.textOffset + header.textSize, constant::PageSize);
+        header.dataOffset = util::AlignUp(header.roOffset + header.roSize, constant::PageSize);
+        header.patchOffsetsOffset = util::AlignUp(header.dataOffset + header.dataSize, constant::PageSize);
+
+        std::error_code error;
+        std::filesystem::create_directories(path, error);
+        auto entryPath{GetEntryPath(buildId)};
+        auto stagingPath{fmt::format("{}.{}-{}.staging", entryPath, getpid(), gettid())}; // Executables may be stored concurrently by multiple threads or processes, each writer needs its own staging file
+        {
+            std::ofstream stream{stagingPath, std::ios::binary | std::ios::trunc};
+            if (stream.fail()) {
+                LOGW("Failed to open executable cache file for writing: {}", stagingPath);
+                return;
+            }
+
+            auto writeAt{[&](u64 offset, const void *data, size_t size) {
+                stream.seekp(static_cast<std::streamoff>(offset));
+                stream.write(reinterpret_cast<const char *>(data), static_cast<std::streamsize>(size));
+            }};
+
+            writeAt(0, &header, sizeof(ExecutableCacheFileHeader));
+            writeAt(sizeof(ExecutableCacheFileHeader), key.data(), key.size());
+            writeAt(header.textOffset, executable.text.contents.data(), header.textSize);
+            writeAt(header.roOffset, executable.ro.contents.data(), header.roSize);
+            writeAt(header.dataOffset, executable.data.contents.data(), header.dataSize);
+
+            std::vector<u64> patchOffsets(executable.patch->offsets.begin(), executable.patch->offsets.end());
+            writeAt(header.patchOffsetsOffset, patchOffsets.data(), patchOffsets.size() * sizeof(u64));
+
+            if (stream.fail()) {
+                LOGW("Failed to write executable cache file: {}", stagingPath);
+                stream.close();
+                std::filesystem::remove(stagingPath, error);
+                return;
+            }
+        }
+
+        // The entry is only replaced once it has been fully written, so a partially written entry is never loaded
+        std::filesystem::rename(stagingPath, entryPath, error);
+        if (error)
+            LOGW("Failed to replace executable cache file {}: {}", entryPath, error.message());
+    }
+}
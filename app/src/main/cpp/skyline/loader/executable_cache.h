@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2023 Strato Team and Contributors (https://github.com/strato-emu/)
+
+#pragma once
+
+#include "executable.h"
+
+namespace skyline::loader {
+    /**
+     * @brief A persistent on-disk cache of executables with their decompressed segments and NCE patch data
+     * @note Entries are keyed by the raw header of an executable which contains its build ID and segment hashes, any change to the executable results in a cache miss
+     * @note Every entry is a separate file with all segments aligned to the page size, the segments are currently copied out of a mapping of the file on load as executables own their contents
+     */
+    class ExecutableCache {
+      private:
+        std::string path; //!< The path to the directory containing all cache entries
+
+        /**
+         * @return The path to the cache entry for an executable with the supplied build ID
+         */
+        std::string GetEntryPath(span<u8> buildId);
+
+      public:
+        ExecutableCache(std::string path);
+
+        /**
+         * @brief Loads an executable from the cache
+         * @param buildId The build ID of the executable, this is used to locate the cache entry
+         * @param key The raw header of the executable, the entry is only valid if this matches exactly
+         * @return The cached executable or std::nullopt if there's no valid cache entry for it
+         */
+        std::optional<Executable> Load(span<u8> buildId, span<const u8> key);
+
+        /**
+         * @brief Stores an executable in the cache, replacing any existing entry for it
+         * @note The executable must contain patch data and its .text segment must not have been patched yet
+         */
+        void Store(span<u8> buildId, span<const u8> key, const Executable &executable);
+    };
+}
@@ -7,6 +7,7 @@
 #include <os.h>
 #include <kernel/types/KProcess.h>
 #include <kernel/memory.h>
+#include <common/settings.h>
 #include "loader.h"
 
 namespace skyline::loader {
@@ -35,7 +36,16 @@ namespace skyline::loader {
             throw exception("Section offsets are not aligned with page size: 0x{:X}, 0x{:X}, 0x{:X}", executable.text.offset, executable.ro.offset, executable.data.offset);
 
         // Use an empty PatchData if we don't need to patch
-        auto patch{needsNcePatching ? state.nce->GetPatchData(executable.text.contents) : nce::NCE::PatchData{}};
+        auto scanStart{util::GetTimeNs()};
+        nce::NCE::PatchData patch{};
+        if (needsNcePatching) {
+            if (executable.patch) {
+                patch = std::move(*executable.patch);
+            } else {
+                patch = state.nce->GetPatchData(executable.text.contents);
+                LOGD("Scanned .text of '{}' for {} patches in {}us", name, patch.offsets.size(), (util::GetTimeNs() - scanStart) / constant::NsInMicrosecond);
+            }
+        }
 
         span dynsym{reinterpret_cast<u8 *>(executable.ro.contents.data() + executable.dynsym.offset), executable.dynsym.size};
         span dynstr{reinterpret_cast<char *>(executable.ro.contents.data() + executable.dynstr.offset), executable.dynstr.size};
@@ -44,7 +54,7 @@ namespace skyline::loader {
         std::vector<hle::HookedSymbolEntry> executableSymbols;
         size_t hookSize{0};
         if (enableSymbolHooking && dynamicallyLinked) {
-            executableSymbols = hle::GetExecutableSymbols(dynsym.cast<Elf64_Sym>(), dynstr);
+            executableSymbols = hle::GetExecutableSymbols(dynsym.cast<Elf64_Sym>(), dynstr, *state.settings->enableLibcHooks);
             hookSize = util::AlignUp(state.nce->GetHookSectionSize(executableSymbols), PAGE_SIZE);
         }
 
@@ -1,6 +1,8 @@
 // SPDX-License-Identifier: MPL-2.0
 // Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
 
+#include <future>
+#include <os.h>
 #include <kernel/types/KProcess.h>
 #include <vfs/npdm.h>
 #include "nso.h"
@@ -19,27 +21,47 @@ namespace skyline::loader {
         if (!exeFs->FileExists("rtld"))
             throw exception("Cannot load an ExeFS that doesn't contain rtld");
 
-        auto nsoFile{exeFs->OpenFile("rtld")};
+        // All NSOs are read and decompressed concurrently before being loaded in order, loading can't be parallelized as every NSO is placed after the previous one
+        std::optional<ExecutableCache> cache;
+        if (loader->nacp)
+            cache.emplace(state.os->publicAppFilesPath + "executable_cache/" + loader->nacp->GetSaveDataOwnerId());
+
+        auto readStart{util::GetTimeNs()};
+        constexpr std::array<const char *, 10> NsoNames{"main", "subsdk0", "subsdk1", "subsdk2", "subsdk3", "subsdk4", "subsdk5", "subsdk6", "subsdk7", "sdk"};
+        std::array<std::future<Executable>, NsoNames.size()> nsoExecutables;
+        for (size_t index{}; index < NsoNames.size(); index++)
+            if (exeFs->FileExists(NsoNames[index]))
+                nsoExecutables[index] = std::async(std::launch::async, [nsoFile = exeFs->OpenFile(NsoNames[index]), &cache]() {
+                    return NsoLoader::ReadNso(nsoFile, cache ? &*cache : nullptr);
+                });
+
+        auto rtldExecutable{NsoLoader::ReadNso(exeFs->OpenFile("rtld"), cache ? &*cache : nullptr)};
+        for (auto &nsoExecutable : nsoExecutables)
+            if (nsoExecutable.valid())
+                nsoExecutable.wait();
+        LOGI("Read and decompressed all NSOs in {}ms", (util::GetTimeNs() - readStart) / constant::NsInMillisecond);
 
         state.process->memory.InitializeVmm(process->npdm.meta.flags.type);
 
-        auto loadInfo{NsoLoader::LoadNso(loader, nsoFile, process, state, 0, "rtld.nso")};
+        auto loadStart{util::GetTimeNs()};
+        auto loadInfo{NsoLoader::LoadNso(loader, rtldExecutable, process, state, 0, "rtld.nso")};
         u64 offset{loadInfo.size};
         u8 *base{loadInfo.base};
         void *entry{loadInfo.entry};
 
         LOGI("Loaded 'rtld.nso' at {} (.text @ {})", fmt::ptr(base), entry);
 
-        for (const auto &nso : {"main", "subsdk0", "subsdk1", "subsdk2", "subsdk3", "subsdk4", "subsdk5", "subsdk6", "subsdk7", "sdk"}) {
-            if (exeFs->FileExists(nso))
-                nsoFile = exeFs->OpenFile(nso);
-            else
+        for (size_t index{}; index < NsoNames.size(); index++) {
+            if (!nsoExecutables[index].valid())
                 continue;
 
-            loadInfo = NsoLoader::LoadNso(loader, nsoFile, process, state, offset, nso + std::string(".nso"), true);
+            auto nso{NsoNames[index]};
+            auto executable{nsoExecutables[index].get()};
+            loadInfo = NsoLoader::LoadNso(loader, executable, process, state, offset, nso + std::string(".nso"), true);
             LOGI("Loaded '{}.nso' at {} (.text @ {})", nso, fmt::ptr(base + offset), loadInfo.entry);
             offset += loadInfo.size;
         }
+        LOGI("Patched and loaded all NSOs in {}ms", (util::GetTimeNs() - loadStart) / constant::NsInMillisecond);
 
         state.process->memory.InitializeRegions(span<u8>{base, offset});
 
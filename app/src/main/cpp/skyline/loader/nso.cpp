@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: MPL-2.0
 // Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
 
+#include <future>
 #include <lz4.h>
 #include <nce.h>
 #include <kernel/types/KProcess.h>
@@ -30,25 +31,34 @@ namespace skyline::loader {
         return outputBuffer;
     }
 
-    Loader::ExecutableLoadInfo NsoLoader::LoadNso(Loader *loader, const std::shared_ptr<vfs::Backing> &backing, const std::shared_ptr<kernel::type::KProcess> &process, const DeviceState &state, size_t offset, const std::string &name, bool dynamicallyLinked) {
+    Executable NsoLoader::ReadNso(const std::shared_ptr<vfs::Backing> &backing, ExecutableCache *cache) {
         auto header{backing->Read<NsoHeader>()};
 
         if (header.magic != util::MakeMagic<u32>("NSO0"))
             throw exception("Invalid NSO magic! 0x{0:X}", header.magic);
 
+        auto buildId{span{header.buildId}.cast<u8>()};
+        auto key{span<NsoHeader>{&header, 1}.cast<u8>()}; // The entire header is used as the key as it contains the hashes of all segments
+        if (cache)
+            if (auto executable{cache->Load(buildId, key)})
+                return std::move(*executable);
+
         Executable executable{};
 
-        executable.text.contents = GetSegment(backing, header.text, header.flags.textCompressed ? header.textCompressedSize : 0);
+        // Every segment is read and decompressed independently, .data is done on the calling thread
+        auto text{std::async(std::launch::async, GetSegment, std::cref(backing), std::cref(header.text), header.flags.textCompressed ? header.textCompressedSize : 0)};
+        auto ro{std::async(std::launch::async, GetSegment, std::cref(backing), std::cref(header.ro), header.flags.roCompressed ? header.roCompressedSize : 0)};
+        executable.data.contents = GetSegment(backing, header.data, header.flags.dataCompressed ? header.dataCompressedSize : 0);
+        executable.data.offset = header.data.memoryOffset;
+
+        executable.text.contents = text.get();
         executable.text.contents.resize(util::AlignUp(executable.text.contents.size(), constant::PageSize));
         executable.text.offset = header.text.memoryOffset;
 
-        executable.ro.contents = GetSegment(backing, header.ro, header.flags.roCompressed ? header.roCompressedSize : 0);
+        executable.ro.contents = ro.get();
         executable.ro.contents.resize(util::AlignUp(executable.ro.contents.size(), constant::PageSize));
         executable.ro.offset = header.ro.memoryOffset;
 
-        executable.data.contents = GetSegment(backing, header.data, header.flags.dataCompressed ? header.dataCompressedSize : 0);
-        executable.data.offset = header.data.memoryOffset;
-
         // Data and BSS are aligned together
         executable.bssSize = util::AlignUp(executable.data.contents.size() + header.bssSize, constant::PageSize) - executable.data.contents.size();
 
@@ -57,6 +67,16 @@ namespace skyline::loader {
             executable.dynstr = {header.dynstr.offset, header.dynstr.size};
         }
 
+        if (cache) {
+            // The patch data is generated here rather than during loading, so that it can be stored alongside the decompressed segments
+            executable.patch = nce::NCE::GetPatchData(executable.text.contents);
+            cache->Store(buildId, key, executable);
+        }
+
+        return executable;
+    }
+
+    Loader::ExecutableLoadInfo NsoLoader::LoadNso(Loader *loader, Executable &executable, const std::shared_ptr<kernel::type::KProcess> &process, const DeviceState &state, size_t offset, const std::string &name, bool dynamicallyLinked) {
         PrintRoContentsInfo(executable.ro.contents);
 
         return loader->LoadExecutable(process, state, executable, offset, name, dynamicallyLinked);
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "loader.h"
+#include "executable_cache.h"
 
 namespace skyline::loader {
     /**
@@ -80,6 +81,23 @@ namespace skyline::loader {
       public:
         NsoLoader(std::shared_ptr<vfs::Backing> backing);
 
+        /**
+         * @brief Reads all segments of an NSO and decompresses them concurrently
+         * @param backing The backing that the NSO is contained within
+         * @param cache An optional cache to load the decompressed NSO and its patch data from, a missing entry will be generated and stored in it
+         * @return An executable with all segments of the NSO which can be loaded with LoadNso
+         * @note This doesn't depend on any process state, so multiple NSOs can be read concurrently
+         */
+        static Executable ReadNso(const std::shared_ptr<vfs::Backing> &backing, ExecutableCache *cache = nullptr);
+
+        /**
+         * @brief Loads an NSO that was read with ReadNso into memory, offset by the given amount
+         * @param offset The offset from the base address to place the NSO
+         * @param name An optional name for the NSO, used for symbol resolution
+         * @return An ExecutableLoadInfo struct containing the load base and size
+         */
+        static ExecutableLoadInfo LoadNso(Loader *loader, Executable &executable, const std::shared_ptr<kernel::type::KProcess> &process, const DeviceState &state, size_t offset = 0, const std::string &name = {}, bool dynamicallyLinked = false);
+
         /**
          * @brief Loads an NSO into memory, offset by the given amount
          * @param backing The backing that the NSO is contained within
@@ -87,7 +105,10 @@ namespace skyline::loader {
          * @param name An optional name for the NSO, used for symbol resolution
          * @return An ExecutableLoadInfo struct containing the load base and size
          */
-        static ExecutableLoadInfo LoadNso(Loader *loader, const std::shared_ptr<vfs::Backing> &backing, const std::shared_ptr<kernel::type::KProcess> &process, const DeviceState &state, size_t offset = 0, const std::string &name = {}, bool dynamicallyLinked = false);
+        static ExecutableLoadInfo LoadNso(Loader *loader, const std::shared_ptr<vfs::Backing> &backing, const std::shared_ptr<kernel::type::KProcess> &process, const DeviceState &state, size_t offset = 0, const std::string &name = {}, bool dynamicallyLinked = false) {
+            auto executable{ReadNso(backing)};
+            return LoadNso(loader, executable, process, state, offset, name, dynamicallyLinked);
+        }
 
         static void PrintRoContentsInfo(const std::vector<u8> &contents);
 
@@ -0,0 +1,262 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2023 Strato Team and Contributors (https://github.com/strato-emu/)
+
+#pragma once
+
+#include <array>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <fmt/args.h>
+#include <fmt/format.h>
+#include <common/base.h>
+
+/**
+ * @brief Serialization of deferred log records, this is shared between the logger and the offline binary log decoder so it must not depend on any Android APIs
+ */
+namespace skyline::logger {
+    enum class LogLevel {
+        Verbose,
+        Debug,
+        Info,
+        Warning,
+        Error,
+        Disabled, // A special log level that disables all logging, must be the last log level
+    };
+
+    constexpr std::array<const char *, 5> LogLevelTags{
+        "VERBOSE",
+        "DEBUG",
+        "INFO",
+        "WARNING",
+        "ERROR",
+    }; //!< The textual tag of each LogLevel in log files
+
+    /**
+     * @brief The type of a serialized log argument, this is encoded as a single byte preceding the data of each argument
+     */
+    enum class LogArgumentType : u8 {
+        Bool, //!< A u8 which is either 0 or 1
+        Char, //!< A single char
+        Signed, //!< An i64
+        Unsigned, //!< A u64
+        Double, //!< A double
+        Pointer, //!< A u64 holding an address which is formatted as a pointer
+        String, //!< A u32 length followed by the bytes of the string
+        Float, //!< A u64 holding the bits of a float in its lower 32 bits, floats are kept distinct from doubles as they format differently
+    };
+
+    namespace detail {
+        template<typename Type>
+        constexpr LogArgumentType GetScalarArgumentType() {
+            if constexpr (std::is_same_v<Type, bool>)
+                return LogArgumentType::Bool;
+            else if constexpr (std::is_same_v<Type, char>)
+                return LogArgumentType::Char;
+            else if constexpr (std::is_signed_v<Type>)
+                return LogArgumentType::Signed;
+            else
+                return LogArgumentType::Unsigned;
+        }
+
+        /**
+         * @return The type an argument of the supplied type is serialized as, std::nullopt if it cannot be serialized and the message must be formatted eagerly
+         * @note Enums are serialized as their underlying type as that's how they're formatted (see common/format.h)
+         */
+        template<typename Type>
+        constexpr std::optional<LogArgumentType> GetLogArgumentType() {
+            if constexpr (std::is_enum_v<Type>)
+                return GetLogArgumentType<std::underlying_type_t<Type>>();
+            else if constexpr (std::is_integral_v<Type> && sizeof(Type) <= sizeof(u64))
+                return GetScalarArgumentType<Type>();
+            else if constexpr (std::is_same_v<Type, float>)
+                return LogArgumentType::Float;
+            else if constexpr (std::is_same_v<Type, double>)
+                return LogArgumentType::Double;
+            else if constexpr (std::is_same_v<Type, void *> || std::is_same_v<Type, const void *>)
+                return LogArgumentType::Pointer;
+            else if constexpr (std::is_same_v<Type, char *> || std::is_same_v<Type, const char *> || std::is_same_v<Type, std::string> || std::is_same_v<Type, std::string_view>)
+                return LogArgumentType::String;
+            else
+                return std::nullopt;
+        }
+
+        inline std::string_view GetStringArgument(const char *value) {
+            return value ? std::string_view{value} : std::string_view{"(null)"};
+        }
+
+        inline std::string_view GetStringArgument(std::string_view value) {
+            return value;
+        }
+    }
+
+    /**
+     * @brief If an argument of the supplied type can be serialized into a log record rather than being formatted on the calling thread
+     */
+    template<typename Type>
+    constexpr bool IsDeferrableLogArgument{detail::GetLogArgumentType<std::decay_t<Type>>().has_value()};
+
+    /**
+     * @return The amount of bytes the supplied argument occupies when serialized
+     */
+    template<typename Type>
+    size_t GetLogArgumentSize(const Type &value) {
+        if constexpr (*detail::GetLogArgumentType<std::decay_t<Type>>() == LogArgumentType::String)
+            return sizeof(LogArgumentType) + sizeof(u32) + detail::GetStringArgument(value).size();
+        else
+            return sizeof(LogArgumentType) + sizeof(u64);
+    }
+
+    /**
+     * @brief Serializes the supplied argument at the supplied pointer, there must be at least GetLogArgumentSize(value) bytes available
+     * @return A pointer directly after the serialized argument
+     */
+    template<typename Type>
+    u8 *EncodeLogArgument(u8 *pointer, const Type &value) {
+        using DecayedType = std::decay_t<Type>;
+        constexpr LogArgumentType type{*detail::GetLogArgumentType<DecayedType>()};
+        *pointer++ = static_cast<u8>(type);
+
+        if constexpr (type == LogArgumentType::String) {
+            auto string{detail::GetStringArgument(value)};
+            u32 length{static_cast<u32>(string.size())};
+            std::memcpy(pointer, &length, sizeof(u32));
+            std::memcpy(pointer + sizeof(u32), string.data(), length);
+            return pointer + sizeof(u32) + length;
+        } else {
+            u64 raw{};
+            if constexpr (type == LogArgumentType::Float) {
+                float converted{value};
+                std::memcpy(&raw, &converted, sizeof(float));
+            } else if constexpr (type == LogArgumentType::Double) {
+                double converted{value};
+                std::memcpy(&raw, &converted, sizeof(double));
+            } else if constexpr (type == LogArgumentType::Pointer) {
+                raw = reinterpret_cast<uintptr_t>(value);
+            } else if constexpr (type == LogArgumentType::Signed) {
+                i64 converted{static_cast<i64>(value)};
+                std::memcpy(&raw, &converted, sizeof(i64));
+            } else {
+                raw = static_cast<u64>(value);
+            }
+
+            std::memcpy(pointer, &raw, sizeof(u64));
+            return pointer + sizeof(u64);
+        }
+    }
+
+    /**
+     * @brief Formats a message from its format string and serialized arguments
+     * @note Any malformed arguments or format errors are reported inline in the message rather than throwing as this is used while writing logs
+     */
+    inline std::string FormatLogMessage(std::string_view format, std::span<const u8> arguments) {
+        fmt::dynamic_format_arg_store<fmt::format_context> store;
+
+        auto pointer{arguments.data()}, end{arguments.data() + arguments.size()};
+        while (pointer != end) {
+            auto type{static_cast<LogArgumentType>(*pointer++)};
+
+            if (type == LogArgumentType::String) {
+                u32 length{};
+                if (end - pointer < static_cast<ptrdiff_t>(sizeof(u32)))
+                    return fmt::format("{} <truncated arguments>", format);
+                std::memcpy(&length, pointer, sizeof(u32));
+                pointer += sizeof(u32);
+
+                if (static_cast<size_t>(end - pointer) < length)
+                    return fmt::format("{} <truncated arguments>", format);
+                store.push_back(std::string_view{reinterpret_cast<const char *>(pointer), length});
+                pointer += length;
+                continue;
+            }
+
+            u64 raw{};
+            if (end - pointer < static_cast<ptrdiff_t>(sizeof(u64)))
+                return fmt::format("{} <truncated arguments>", format);
+            std::memcpy(&raw, pointer, sizeof(u64));
+            pointer += sizeof(u64);
+
+            switch (type) {
+                case LogArgumentType::Bool:
+                    store.push_back(raw != 0);
+                    break;
+                case LogArgumentType::Char:
+                    store.push_back(static_cast<char>(raw));
+                    break;
+                case LogArgumentType::Signed:
+                    store.push_back(static_cast<i64>(raw));
+                    break;
+                case LogArgumentType::Unsigned:
+                    store.push_back(raw);
+                    break;
+                case LogArgumentType::Double: {
+                    double value{};
+                    std::memcpy(&value, &raw, sizeof(double));
+                    store.push_back(value);
+                    break;
+                }
+                case LogArgumentType::Float: {
+                    float value{};
+                    std::memcpy(&value, &raw, sizeof(float));
+                    store.push_back(value);
+                    break;
+                }
+                case LogArgumentType::Pointer:
+                    store.push_back(reinterpret_cast<const void *>(static_cast<uintptr_t>(raw)));
+                    break;
+                default:
+                    return fmt::format("{} <invalid argument type 0x{:X}>", format, static_cast<u8>(type));
+            }
+        }
+
+        try {
+            return fmt::vformat(format, store);
+        } catch (const fmt::format_error &e) {
+            return fmt::format("{} <format error: {}>", format, e.what());
+        }
+    }
+
+    /**
+     * @brief Formats a single line of a text log file
+     * @param time The time at which the message was logged in microseconds since the logger was started
+     */
+    inline std::string FormatLogFileLine(LogLevel level, i64 time, std::string_view threadName, std::string_view message) {
+        // LEVEL__ | ______TIME | ____THREAD_____ | MESSAGE
+        return fmt::format("{:7} | {:>10} | {:^15} | {}\n", LogLevelTags[static_cast<u32>(level)], time, threadName, message);
+    }
+
+    /**
+     * @brief The header at the start of a binary log file, it's followed by a sequence of entries each starting with a BinaryLogEntryType
+     */
+    struct BinaryLogFileHeader {
+        static constexpr u32 Magic{0x474C4B53}; //!< "SKLG" in little-endian
+        static constexpr u32 Version{2}; //!< The version of the binary log format, this MUST be incremented for any changes to the format
+
+        u32 magic{Magic};
+        u32 version{Version};
+    };
+
+    enum class BinaryLogEntryType : u8 {
+        String, //!< A BinaryLogStringEntry followed by the bytes of the string, strings are referenced by their ID in later entries
+        Message, //!< A BinaryLogMessageEntry followed by the serialized arguments of the message
+    };
+
+    struct __attribute__((packed)) BinaryLogStringEntry {
+        static constexpr u32 NullId{~0U}; //!< An ID used in place of a string that isn't present
+
+        u32 id; //!< The ID of the string, these are sequentially assigned from 0
+        u32 length;
+    };
+
+    struct __attribute__((packed)) BinaryLogMessageEntry {
+        u8 level; //!< The LogLevel of the message
+        i64 time; //!< The time at which the message was logged in microseconds since the logger was started
+        u32 threadNameId;
+        u32 functionId; //!< The ID of the function name to prefix to the message or NullId if there is none
+        u32 formatId;
+        u32 argumentsSize; //!< The size of the serialized arguments following this entry in bytes
+    };
+}
@@ -1,14 +1,16 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 // Copyright © 2023 Strato Team and Contributors (https://github.com/strato-emu/)
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <mutex>
 #include <fstream>
 #include <pthread.h>
 #include <thread>
-#include <common/base.h>
-#include <common/circular_queue.h>
+#include <unordered_map>
+#include <common/utils.h>
 #include <android/log.h>
 #include <common/format.h>
 #include <fmt/compile.h>
@@ -18,55 +20,72 @@ namespace skyline {
     constexpr size_t PrefixLength{8}; //!< The length of the prefix "emu-cpp-"
     constexpr size_t MaxThreadNameLength{16}; //!< The maximum length of a thread name
 
-    /**
-     * @brief The logging context for the current thread
-     */
-    thread_local struct ThreadLogContext {
-        /**
-         * @brief The shared storage for the thread name and log tag
-         */
-        std::array<char, PrefixLength + MaxThreadNameLength> threadNameStorage{"emu-cpp-unk"};
-
-        /**
-         * @returns A span of the thread name
-         */
-        constexpr std::span<char> GetThreadName() {
-            return {threadNameStorage.begin() + PrefixLength, threadNameStorage.end()};
-        }
-
-        /**
-         * @return A span of the log tag
-         */
-        constexpr std::span<char> GetLogTag() {
-            return {threadNameStorage.begin(), threadNameStorage.end()};
-        }
-    } threadContext;
-
     using LogLevel = AsyncLogger::LogLevel;
 
     using clock = std::chrono::steady_clock;
     using microseconds = std::chrono::microseconds;
     using log_time_point = std::chrono::time_point<clock>;
 
-    struct LogMessage {
-        LogLevel level; //!< The level of the log message
-        const char *function; //!< The name of the function that pushed this message
-        std::string str; //!< The log message string
-        log_time_point time; //!< The time when the message was pushed
-        ThreadLogContext *threadContext; //!< The context for the thread that pushed this message
+    /**
+     * @brief A single-producer single-consumer ring of log records, every thread that logs has its own ring so pushing a record doesn't require any locking
+     * @note Positions in the ring increase monotonically and are wrapped to an offset in the buffer on access
+     */
+    struct LogRing {
+        /**
+         * @brief The header of a single record in the ring, it's directly followed by the serialized arguments of the record
+         * @note A record without a format string that doesn't rename the thread is padding up to the end of the buffer, if there's not enough space for a header at the end of the buffer it's implicitly padding
+         */
+        struct RecordHeader {
+            u32 size; //!< The size of the record including this header and the arguments
+            bool isThreadName; //!< If this record renames the owning thread for all following records, its arguments are the new name rather than serialized arguments
+            LogLevel level;
+            log_time_point time; //!< The time when the record was pushed
+            const char *function; //!< The name of the function that pushed this record
+            const char *format;
+            u32 formatLength;
+            u32 argumentsSize;
+        };
+
+        static constexpr size_t Mask{AsyncLogger::LogRingSize - 1};
+        static_assert((AsyncLogger::LogRingSize & Mask) == 0, "The log ring size must be a power of two");
+        static_assert(AsyncLogger::MaxDeferredArgumentsSize + sizeof(RecordHeader) <= AsyncLogger::LogRingSize / 4, "A maximum size record and its padding must always fit in the ring");
 
-        LogMessage(LogLevel level, const char *function, std::string &&str, log_time_point time, ThreadLogContext *threadContext)
-            : level(level), function(function), str(std::move(str)), time(time), threadContext(threadContext) {}
+        std::array<char, MaxThreadNameLength> threadName{"unk"}; //!< The name of the owning thread as of the last written record, this is only accessed by the writer thread once the ring is registered
+        std::string_view drainThreadName; //!< The name of the owning thread after the records currently being written, this is only accessed by the writer thread
+        std::vector<u8> buffer;
+        std::atomic<size_t> head{}; //!< The position of the oldest record which hasn't been written yet, this is only modified by the writer thread
+        std::atomic<size_t> tail{}; //!< The position after the newest committed record, this is only modified by the owning thread
+        size_t reservedTail{}; //!< The position after the currently reserved record, this is only accessed by the owning thread
+        size_t drainTail{}; //!< The position up to which the writer thread is currently writing records, this is only accessed by the writer thread
+        std::atomic<bool> orphaned{}; //!< If the owning thread has exited, the ring can be removed once it has been drained
 
-        // Disable copy constructor to prevent copying the string
-        LogMessage(const LogMessage &) = delete;
+        LogRing() : buffer(AsyncLogger::LogRingSize) {}
+    };
 
-        // Disable copy assignment to prevent copying the string
-        LogMessage &operator=(const LogMessage &) = delete;
+    /**
+     * @brief The logging context for the current thread
+     */
+    thread_local struct ThreadLogContext {
+        std::array<char, MaxThreadNameLength> threadName{"unk"}; //!< The name of the current thread, a record renaming the thread is pushed into the ring whenever it changes
+        std::shared_ptr<LogRing> ring; //!< The ring of the current thread, this is lazily created on the first log
+        size_t generation{}; //!< The generation of the logger the ring was registered with, a new ring is required if the logger was reinitialized
 
-        LogMessage(LogMessage &&) = default;
+        ~ThreadLogContext() {
+            if (ring)
+                ring->orphaned.store(true, std::memory_order_release);
+        }
+    } threadContext;
 
-        LogMessage &operator=(LogMessage &&) = default;
+    /**
+     * @brief A log message which is being written out, this doesn't own any of the data it points to
+     */
+    struct LogMessage {
+        LogLevel level;
+        log_time_point time; //!< The time when the message was pushed
+        const char *function; //!< The name of the function that pushed this message
+        std::string_view format;
+        std::span<const u8> arguments; //!< The serialized arguments of the message
+        std::string_view threadName; //!< The name of the thread that pushed this message at the time it was pushed
     };
 
     /**
@@ -75,16 +94,28 @@ namespace skyline {
     class AsyncLogger::Impl {
         std::mutex fileMutex; //!< Synchronizes write operations to the log file
         std::ofstream logFile; //!< An output stream to the log file
+        bool binary{}; //!< If the log file is written in the binary log format
+        std::unordered_map<const void *, u32> internedStrings; //!< A map from a static string to its ID in the binary log file
+        std::unordered_map<std::string, u32> internedThreadNames; //!< A map from a thread name to its ID in the binary log file, these are interned by value as they can change at runtime
+        u32 nextStringId{};
         log_time_point start; //!< A time point when the logger was started, used as the base for all log timestamps
-        std::atomic<log_time_point> stop; //!< A time point when the logger was stopped, used by the writer thread to know when to stop
 
         LogLevel currentLevel; //!< The minimum level of logs to write
-        CircularQueue<LogMessage> messageQueue{AsyncLogger::LogQueueSize}; //!< The queue where all log messages are sent
+
+        std::mutex ringMutex; //!< Synchronizes access to `rings`
+        std::vector<std::shared_ptr<LogRing>> rings; //!< The rings of all threads which have logged since the logger was started
+        std::vector<std::shared_ptr<LogRing>> drainRings; //!< A copy of `rings` used by the writer thread to avoid holding `ringMutex` while writing
+        std::vector<LogMessage> drainMessages; //!< The messages that are being written out by the writer thread
 
         std::atomic<bool> running{true}; //!< If the logger thread should continue running
+        std::atomic<bool> writerParked{}; //!< If the writer thread is waiting for records, a producer that commits a record while this is set must wake it
+        std::mutex wakeMutex; //!< Synchronizes parking and waking the writer thread
+        std::condition_variable wakeCondition; //!< Signalled when the writer thread is unparked or the logger is stopped
         std::thread thread; //!< The thread that handles writing log entries from the logger queue
 
       public:
+        static inline std::atomic<size_t> generation{}; //!< Incremented on every initialization of the logger so threads can detect stale rings
+
         /**
          * @brief Constructs an empty instance that does not write any logs
          */
@@ -93,10 +124,15 @@ namespace skyline {
         /**
          * @brief Constructs an instance that writes logs to the file at the given path
          */
-        Impl(AsyncLogger::LogLevel level, const std::filesystem::path &path) : currentLevel(level) {
+        Impl(AsyncLogger::LogLevel level, const std::filesystem::path &path, bool binary) : binary{binary}, currentLevel(level) {
             start = clock::now();
+            generation.fetch_add(1, std::memory_order_release);
             std::filesystem::create_directories(path.parent_path());
-            logFile.open(path, std::ios::trunc);
+            logFile.open(path, std::ios::trunc | (binary ? std::ios::binary : std::ios::openmode{}));
+            if (binary) {
+                logger::BinaryLogFileHeader header{};
+                logFile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            }
             thread = std::thread{&Impl::WriterThread, this};
         }
 
@@ -105,8 +141,12 @@ namespace skyline {
          * @param wait If the function should wait for the writer thread to exit
          */
         void Finalize(bool wait = false) {
-            stop.store(clock::now(), std::memory_order_release);
-            running.store(false, std::memory_order_release);
+            {
+                std::scoped_lock lock{wakeMutex};
+                running.store(false, std::memory_order_release);
+            }
+            wakeCondition.notify_one();
+
             if (wait)
                 thread.join();
 
@@ -115,32 +155,224 @@ namespace skyline {
         }
 
         /**
-         * @brief The function that runs on the writer thread, polls the queue for new messages and writes them out
+         * @return If any ring has committed records which haven't been written yet
+         */
+        bool HasPendingRecords() {
+            std::scoped_lock lock{ringMutex};
+            return std::any_of(rings.begin(), rings.end(), [](const auto &ring) {
+                return ring->head.load(std::memory_order_relaxed) != ring->tail.load(std::memory_order_acquire);
+            });
+        }
+
+        /**
+         * @brief Blocks the writer thread until a producer commits a record or the logger is stopped
+         */
+        void Park() {
+            writerParked.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst); // Pairs with the fence in WakeWriter, either this sees the committed record or the producer sees the writer parked
+
+            if (HasPendingRecords()) {
+                writerParked.store(false, std::memory_order_relaxed);
+                return;
+            }
+
+            std::unique_lock lock{wakeMutex};
+            wakeCondition.wait(lock, [this] { return !writerParked.load(std::memory_order_relaxed) || !running.load(std::memory_order_relaxed); });
+            writerParked.store(false, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Wakes the writer thread if it's parked, this must be called after committing a record
+         */
+        void WakeWriter() {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (writerParked.load(std::memory_order_relaxed) && writerParked.exchange(false, std::memory_order_relaxed)) [[unlikely]] {
+                std::scoped_lock lock{wakeMutex};
+                wakeCondition.notify_one();
+            }
+        }
+
+        /**
+         * @brief The function that runs on the writer thread, writes out records from the rings of all threads and parks while there are none
          */
         void WriterThread() {
             pthread_setname_np(pthread_self(), "Sky-Logger");
 
-            while (running.load(std::memory_order_acquire)) {
-                auto message{messageQueue.Pop()};
-                Write(message);
+            while (running.load(std::memory_order_acquire))
+                if (!Drain())
+                    Park();
+
+            // Write out any records that were committed before the logger was stopped
+            Drain();
+        }
+
+        /**
+         * @brief Writes out all committed records from every ring in the order they were pushed
+         * @return If any records were written
+         */
+        bool Drain() {
+            {
+                std::scoped_lock lock{ringMutex};
+                drainRings = rings;
             }
 
-            log_time_point stopTime = stop.load(std::memory_order_acquire);
-            // Write out remaining messages in the queue up to the stop time
-            while (!messageQueue.Empty()) {
-                auto message{messageQueue.Pop()};
+            drainMessages.clear();
+            for (auto &ring : drainRings) {
+                size_t position{ring->head.load(std::memory_order_relaxed)};
+                ring->drainTail = ring->tail.load(std::memory_order_acquire);
+                ring->drainThreadName = ring->threadName.data();
+
+                while (position != ring->drainTail) {
+                    size_t offset{position & LogRing::Mask};
+                    if (AsyncLogger::LogRingSize - offset < sizeof(LogRing::RecordHeader)) {
+                        position += AsyncLogger::LogRingSize - offset;
+                        continue;
+                    }
+
+                    auto &header{*reinterpret_cast<LogRing::RecordHeader *>(ring->buffer.data() + offset)};
+                    auto arguments{ring->buffer.data() + offset + sizeof(LogRing::RecordHeader)};
+                    if (header.isThreadName)
+                        // The name remains in the ring until the head is advanced past it, so messages can reference it directly
+                        ring->drainThreadName = std::string_view{reinterpret_cast<const char *>(arguments), header.argumentsSize};
+                    else if (header.format)
+                        drainMessages.push_back(LogMessage{
+                            header.level,
+                            header.time,
+                            header.function,
+                            std::string_view{header.format, header.formatLength},
+                            std::span<const u8>{arguments, header.argumentsSize},
+                            ring->drainThreadName
+                        });
+
+                    position += header.size;
+                }
+            }
+
+            // Records are only ordered within a ring so they need to be merged by time across all rings
+            std::stable_sort(drainMessages.begin(), drainMessages.end(), [](const LogMessage &a, const LogMessage &b) {
+                return a.time < b.time;
+            });
+
+            for (const auto &message : drainMessages)
                 Write(message);
 
-                if (message.time > stopTime)
-                    break;
+            for (auto &ring : drainRings) {
+                // Any rename must be copied out of the ring before the head is advanced past it
+                if (ring->drainThreadName.data() != ring->threadName.data()) {
+                    auto length{std::min(ring->drainThreadName.size(), MaxThreadNameLength - 1)};
+                    std::copy_n(ring->drainThreadName.begin(), length, ring->threadName.begin());
+                    std::fill(ring->threadName.begin() + static_cast<ptrdiff_t>(length), ring->threadName.end(), '\0');
+                }
+                ring->drainThreadName = {};
+                ring->head.store(ring->drainTail, std::memory_order_release);
+            }
+
+            bool orphanedRings{std::any_of(drainRings.begin(), drainRings.end(), [](const auto &ring) { return ring->orphaned.load(std::memory_order_acquire); })};
+            drainRings.clear();
+
+            if (orphanedRings) {
+                std::scoped_lock lock{ringMutex};
+                std::erase_if(rings, [](const auto &ring) {
+                    return ring->orphaned.load(std::memory_order_acquire) && ring->head.load(std::memory_order_relaxed) == ring->tail.load(std::memory_order_acquire);
+                });
+            }
+
+            return !drainMessages.empty();
+        }
+
+        /**
+         * @return The ring of the calling thread, it's created and registered if it doesn't exist yet
+         */
+        LogRing &GetThreadRing() {
+            size_t currentGeneration{generation.load(std::memory_order_acquire)};
+            if (!threadContext.ring || threadContext.generation != currentGeneration) [[unlikely]] {
+                auto ring{std::make_shared<LogRing>()};
+                ring->threadName = threadContext.threadName; // This is published to the writer thread when the ring is registered
+                if (threadContext.ring)
+                    threadContext.ring->orphaned.store(true, std::memory_order_release);
+
+                {
+                    std::scoped_lock lock{ringMutex};
+                    rings.push_back(ring);
+                }
+
+                threadContext.ring = std::move(ring);
+                threadContext.generation = currentGeneration;
+            }
+
+            return *threadContext.ring;
+        }
+
+        /**
+         * @brief Reserves space for a record in the supplied ring which must be owned by the calling thread
+         * @param record The header of the record, its size is filled in here
+         * @return A pointer to where the arguments of the record should be written or nullptr if the logger isn't running
+         */
+        u8 *Reserve(LogRing &ring, LogRing::RecordHeader record) {
+            size_t size{util::AlignUp(sizeof(LogRing::RecordHeader) + record.argumentsSize, alignof(LogRing::RecordHeader))};
+            size_t tail{ring.tail.load(std::memory_order_relaxed)};
+            size_t offset{tail & LogRing::Mask};
+            size_t padding{offset + size > AsyncLogger::LogRingSize ? AsyncLogger::LogRingSize - offset : 0};
+
+            // The writer thread is behind if there's not enough space in the ring, this should only happen when a large amount of logs are pushed in a burst
+            while (AsyncLogger::LogRingSize - (tail - ring.head.load(std::memory_order_acquire)) < padding + size) {
+                if (!running.load(std::memory_order_acquire)) [[unlikely]]
+                    return nullptr;
+                std::this_thread::yield();
+            }
+
+            if (padding) {
+                if (padding >= sizeof(LogRing::RecordHeader))
+                    *reinterpret_cast<LogRing::RecordHeader *>(ring.buffer.data() + offset) = LogRing::RecordHeader{.size = static_cast<u32>(padding)};
+                tail += padding;
+                offset = 0;
             }
+
+            auto header{reinterpret_cast<LogRing::RecordHeader *>(ring.buffer.data() + offset)};
+            record.size = static_cast<u32>(size);
+            *header = record;
+            ring.reservedTail = tail + size;
+
+            return reinterpret_cast<u8 *>(header + 1);
+        }
+
+        u8 *ReserveRecord(LogLevel level, const char *function, std::string_view format, size_t argumentsSize) {
+            return Reserve(GetThreadRing(), LogRing::RecordHeader{
+                .level = level,
+                .time = clock::now(),
+                .function = function,
+                .format = format.data(),
+                .formatLength = static_cast<u32>(format.size()),
+                .argumentsSize = static_cast<u32>(argumentsSize),
+            });
+        }
+
+        void CommitRecord() {
+            auto &ring{*threadContext.ring};
+            ring.tail.store(ring.reservedTail, std::memory_order_release);
+            WakeWriter();
         }
 
         /**
-         * @brief Pushes a log message into the queue
+         * @brief Updates the thread name of the calling thread, if it has a ring then a record renaming the thread is pushed so only later records use the new name
+         * @note The ring isn't created here as many threads never log anything
          */
-        void Push(LogMessage &&message) {
-            messageQueue.Push(std::move(message));
+        void UpdateTag() {
+            pthread_getname_np(pthread_self(), threadContext.threadName.data(), MaxThreadNameLength);
+            if (!threadContext.ring)
+                return;
+
+            std::string_view name{threadContext.threadName.data()};
+            auto pointer{Reserve(GetThreadRing(), LogRing::RecordHeader{
+                .isThreadName = true,
+                .time = clock::now(),
+                .argumentsSize = static_cast<u32>(name.size()),
+            })};
+            if (!pointer) [[unlikely]]
+                return;
+
+            std::memcpy(pointer, name.data(), name.size());
+            CommitRecord();
         }
 
         /**
@@ -153,17 +385,30 @@ namespace skyline {
         /**
          * @brief Writes a message to the log file and logcat
          */
-        void Write(LogMessage &message) {
+        void Write(const LogMessage &message) {
+            if (binary) {
+                // Logcat is only used for important messages in binary mode to avoid formatting every message
+                if (message.level >= LogLevel::Warning)
+                    WriteAndroid(message, FormatMessage(message));
+                WriteBinary(message);
+            } else {
+                auto str{FormatMessage(message)};
+                WriteAndroid(message, str);
+                WriteFile(message, str);
+            }
+        }
+
+      private:
+        static std::string FormatMessage(const LogMessage &message) {
+            auto str{logger::FormatLogMessage(message.format, message.arguments)};
+
             // Prefix the function name to the message
             if (message.function)
-                message.str = fmt::format(FMT_COMPILE("{}: {}"), message.function, message.str);
-
-            WriteAndroid(message);
-            WriteFile(message);
+                return fmt::format(FMT_COMPILE("{}: {}"), message.function, str);
+            return str;
         }
 
-      private:
-        void WriteAndroid(const LogMessage &message) {
+        void WriteAndroid(const LogMessage &message, const std::string &str) {
             constexpr std::array<int, 5> androidLevel{
                 ANDROID_LOG_VERBOSE,
                 ANDROID_LOG_DEBUG,
@@ -172,36 +417,75 @@ namespace skyline {
                 ANDROID_LOG_ERROR,
             }; // The LogLevel as Android NDK log level
 
-            __android_log_write(androidLevel[static_cast<u32>(message.level)], message.threadContext->GetLogTag().data(), message.str.c_str());
+            std::array<char, PrefixLength + MaxThreadNameLength> tag{};
+            fmt::format_to_n(tag.data(), tag.size() - 1, FMT_COMPILE("emu-cpp-{}"), message.threadName);
+            __android_log_write(androidLevel[static_cast<u32>(message.level)], tag.data(), str.c_str());
         }
 
-        void WriteFile(const LogMessage &message) {
-            constexpr std::array<const char *, 5> levelTag{
-                "VERBOSE",
-                "DEBUG",
-                "INFO",
-                "WARNING",
-                "ERROR",
+        void WriteFile(const LogMessage &message, const std::string &str) {
+            std::scoped_lock lock{fileMutex};
+
+            logFile << logger::FormatLogFileLine(message.level, duration_cast<microseconds>(message.time - start).count(), message.threadName, str);
+            logFile.flush();
+        }
+
+        /**
+         * @brief Writes a string entry to the binary log file
+         * @note The file mutex must be locked when calling this
+         */
+        u32 WriteBinaryString(std::string_view string) {
+            logger::BinaryLogStringEntry entry{
+                .id = nextStringId++,
+                .length = static_cast<u32>(string.size()),
             };
+            logFile.put(static_cast<char>(logger::BinaryLogEntryType::String));
+            logFile.write(reinterpret_cast<const char *>(&entry), sizeof(entry));
+            logFile.write(string.data(), static_cast<std::streamsize>(string.size()));
+            return entry.id;
+        }
 
+        /**
+         * @return The ID of the supplied static string in the binary log file, it's written out if it hasn't been used before
+         * @note The file mutex must be locked when calling this
+         */
+        u32 InternString(std::string_view string) {
+            auto it{internedStrings.find(string.data())};
+            if (it != internedStrings.end())
+                return it->second;
+
+            return internedStrings.emplace(string.data(), WriteBinaryString(string)).first->second;
+        }
+
+        void WriteBinary(const LogMessage &message) {
             std::scoped_lock lock{fileMutex};
 
-            // LEVEL__ | ______TIME | ____THREAD_____ | MESSAGE
-            logFile << fmt::format(
-                "{:7} | {:>10} | {:^15} | {}\n",
-                levelTag[static_cast<u32>(message.level)],
-                duration_cast<microseconds>(message.time - start).count(),
-                message.threadContext->GetThreadName().data(),
-                message.str
-            );
-            logFile.flush();
+            std::string threadName{message.threadName};
+            auto threadNameIt{internedThreadNames.find(threadName)};
+            if (threadNameIt == internedThreadNames.end())
+                threadNameIt = internedThreadNames.emplace(threadName, WriteBinaryString(threadName)).first;
+
+            logger::BinaryLogMessageEntry entry{
+                .level = static_cast<u8>(message.level),
+                .time = duration_cast<microseconds>(message.time - start).count(),
+                .threadNameId = threadNameIt->second,
+                .functionId = message.function ? InternString(message.function) : logger::BinaryLogStringEntry::NullId,
+                .formatId = InternString(message.format),
+                .argumentsSize = static_cast<u32>(message.arguments.size()),
+            };
+            logFile.put(static_cast<char>(logger::BinaryLogEntryType::Message));
+            logFile.write(reinterpret_cast<const char *>(&entry), sizeof(entry));
+            logFile.write(reinterpret_cast<const char *>(message.arguments.data()), static_cast<std::streamsize>(message.arguments.size()));
+
+            // Errors are flushed immediately as they're likely to be followed by a crash
+            if (message.level >= LogLevel::Error)
+                logFile.flush();
         }
     };
 
     AsyncLogger::Impl impl{};
 
-    void AsyncLogger::Initialize(LogLevel level, const std::filesystem::path &path) {
-        std::construct_at(&impl, level, path);
+    void AsyncLogger::Initialize(LogLevel level, const std::filesystem::path &path, bool binary) {
+        std::construct_at(&impl, level, path, binary);
         UpdateTag(); // Update the tag for the calling thread
     }
 
@@ -211,31 +495,47 @@ namespace skyline {
     }
 
     void AsyncLogger::UpdateTag() {
-        pthread_getname_np(pthread_self(), threadContext.GetThreadName().data(), MaxThreadNameLength);
+        impl.UpdateTag();
     }
 
     bool AsyncLogger::CheckLogLevel(LogLevel level) {
         return impl.CheckLogLevel(level);
     }
 
+    u8 *AsyncLogger::ReserveRecord(LogLevel level, const char *function, std::string_view format, size_t argumentsSize) {
+        return impl.ReserveRecord(level, function, format, argumentsSize);
+    }
+
+    void AsyncLogger::CommitRecord() {
+        impl.CommitRecord();
+    }
+
     void AsyncLogger::LogAsync(LogLevel level, std::string &&str, const char *function) {
-        impl.Push(LogMessage{
-            level,
-            function,
-            std::move(str),
-            clock::now(),
-            &threadContext
-        });
+        size_t argumentsSize{logger::GetLogArgumentSize(str)};
+        if (argumentsSize > MaxDeferredArgumentsSize) [[unlikely]] {
+            LogSync(level, std::move(str), function);
+            return;
+        }
+
+        u8 *pointer{ReserveRecord(level, function, "{}", argumentsSize)};
+        if (!pointer) [[unlikely]]
+            return;
+
+        logger::EncodeLogArgument(pointer, str);
+        CommitRecord();
     }
 
     void AsyncLogger::LogSync(LogLevel level, std::string &&str, const char *function) {
-        auto message = LogMessage{
+        std::vector<u8> arguments(logger::GetLogArgumentSize(str));
+        logger::EncodeLogArgument(arguments.data(), str);
+
+        impl.Write(LogMessage{
             level,
-            function,
-            std::move(str),
             clock::now(),
-            &threadContext
-        };
-        impl.Write(message);
+            function,
+            "{}",
+            arguments,
+            threadContext.threadName.data()
+        });
     }
 }
@@ -6,34 +6,32 @@
 #include <string>
 #include <filesystem>
 #include <common/format.h>
+#include "log_record.h"
 
 namespace skyline {
     /**
      * @brief The public interface of the logger. The logger writes logs into a log file and logcat using Android Log APIs.
      * The Initialize function must be called before using the logger and the Finalize function should be called before the program exits
      * to ensure proper flushing of all logs.
-     * @details This is an Asnychronous logger, it pushes all logs into a queue and a background thread writes them out.
+     * @details This is an Asnychronous logger, every thread pushes its logs into its own lock-free ring and a background thread writes them out.
+     * Messages with only trivially serializable arguments aren't formatted by the calling thread, the format string and arguments are copied into the ring and formatted by the writer thread instead.
+     * The writer thread can also write a binary log file which skips formatting entirely, it can be expanded offline with the log decoder tool.
      */
     class AsyncLogger {
       public:
         class Impl;
 
-        enum class LogLevel {
-            Verbose,
-            Debug,
-            Info,
-            Warning,
-            Error,
-            Disabled, // A special log level that disables all logging, must be the last log level
-        };
+        using LogLevel = logger::LogLevel;
 
-        constexpr static size_t LogQueueSize{1024}; //!< The size of the log message queue
+        constexpr static size_t LogRingSize{0x40000}; //!< The size of the log record ring of each thread in bytes, this must be a power of two
+        constexpr static size_t MaxDeferredArgumentsSize{LogRingSize / 8}; //!< The maximum size of the serialized arguments of a single record, larger messages are written synchronously
 
         /**
          * @brief Initializes the logger with the given log level and file path
          * @details This starts the writer thread
+         * @param binary If the log file should be written in the binary log format rather than as text, only warnings and errors are written to logcat in this mode
          */
-        static void Initialize(LogLevel level, const std::filesystem::path &path);
+        static void Initialize(LogLevel level, const std::filesystem::path &path, bool binary = false);
 
         /**
          * @brief Finalizes the logger and flushes all pending logs
@@ -66,25 +64,61 @@ namespace skyline {
          */
         static void LogSync(LogLevel level, std::string &&str, const char *function = nullptr);
 
+        /**
+         * @brief Writes a log message to the log file and logcat asynchronously, the arguments are only formatted on the writer thread if they can all be serialized
+         * @param function The name of the function that pushed this message, nullptr if no function should be prepended
+         * @note The format string must have static storage duration as only a pointer to it is stored
+         */
+        template<typename... Args>
+        static void Log(LogLevel level, const char *function, fmt::format_string<Args...> format, Args &&...args);
+
       private:
         AsyncLogger() = default;
+
+        /**
+         * @brief Reserves space for a record in the log ring of the calling thread, CommitRecord must be called after the arguments have been written
+         * @return A pointer to where the serialized arguments should be written or nullptr if the record should be dropped as the logger isn't running
+         */
+        static u8 *ReserveRecord(LogLevel level, const char *function, std::string_view format, size_t argumentsSize);
+
+        /**
+         * @brief Makes the last reserved record of the calling thread visible to the writer thread
+         */
+        static void CommitRecord();
     };
+
+    template<typename... Args>
+    void AsyncLogger::Log(LogLevel level, const char *function, fmt::format_string<Args...> format, Args &&...args) {
+        if constexpr ((logger::IsDeferrableLogArgument<Args> && ...)) {
+            size_t argumentsSize{(logger::GetLogArgumentSize(args) + ... + 0)};
+            if (argumentsSize <= MaxDeferredArgumentsSize) [[likely]] {
+                fmt::string_view formatView{format};
+                u8 *pointer{ReserveRecord(level, function, std::string_view{formatView.data(), formatView.size()}, argumentsSize)};
+                if (!pointer) [[unlikely]]
+                    return;
+
+                ((pointer = logger::EncodeLogArgument(pointer, args)), ...);
+                CommitRecord();
+                return;
+            }
+        }
+
+        LogAsync(level, fmt::format(format, std::forward<Args>(args)...), function);
+    }
 }
 
 #define LOG_WRITE(level, ...)                                                               \
         do {                                                                                \
             if (!skyline::AsyncLogger::CheckLogLevel(level))                                \
                 break;                                                                      \
-            std::string _str = fmt::format(__VA_ARGS__);                                    \
-            skyline::AsyncLogger::LogAsync(level, std::move(_str), __builtin_FUNCTION());   \
+            skyline::AsyncLogger::Log(level, __builtin_FUNCTION(), __VA_ARGS__);            \
         } while (0)
 
 #define LOGNF_WRITE(level, ...)                                                             \
         do {                                                                                \
             if (!skyline::AsyncLogger::CheckLogLevel(level))                                \
                 break;                                                                      \
-            std::string _str = fmt::format(__VA_ARGS__);                                    \
-            skyline::AsyncLogger::LogAsync(level, std::move(_str), nullptr);                \
+            skyline::AsyncLogger::Log(level, nullptr, __VA_ARGS__);                         \
         } while (0)
 
 /**
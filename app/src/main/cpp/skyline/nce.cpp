@@ -2,6 +2,8 @@
 // Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
 
 #include <fstream>
+#include <future>
+#include <thread>
 #include <cxxabi.h>
 #include <linux/elf.h>
 #include "common/signal.h"
@@ -90,7 +92,7 @@ namespace skyline::nce {
 
     void NCE::HookHandler(HookId hookId, ThreadContext *ctx) {
         const auto &state{*ctx->state};
-        auto hookedSymbol{state.nce->hookedSymbols[hookId.index]};
+        const auto &hookedSymbol{state.nce->hookedSymbols[hookId.index]};
         try {
             std::visit(VariantVisitor{
                 [&](const hle::OverrideHook &hook) {
@@ -333,45 +335,82 @@ namespace skyline::nce {
     constexpr u32 CntvctEl0{0x5F02};        // ID of CNTVCT_EL0 in MRS
     constexpr u32 TegraX1Freq{19200000};    // The clock frequency of the Tegra X1 (19.2 MHz)
 
-    NCE::PatchData NCE::GetPatchData(const std::vector<u8> &text) {
-        size_t size{guest::SaveCtxSize + guest::LoadCtxSize + TrampolineSize};
-        std::vector<size_t> offsets;
+    constexpr size_t PatchScanChunkPages{0x40}; //!< The minimum amount of pages of .text that are scanned for patches by a single thread
 
+    NCE::PatchData NCE::GetPatchData(const std::vector<u8> &text) {
         bool rescaleClock{util::ClockFrequency != TegraX1Freq};
 
-        auto start{reinterpret_cast<const u32 *>(text.data())}, end{reinterpret_cast<const u32 *>(text.data() + text.size())};
-        for (const u32 *instruction{start}; instruction < end; instruction++) {
-            auto svc{*reinterpret_cast<const instructions::Svc *>(instruction)};
-            auto mrs{*reinterpret_cast<const instructions::Mrs *>(instruction)};
-            auto msr{*reinterpret_cast<const instructions::Msr *>(instruction)};
-            auto instructionOffset{static_cast<size_t>(instruction - start)};
+        auto start{reinterpret_cast<const u32 *>(text.data())};
 
-            if (svc.Verify()) {
-                size += 7;
-                offsets.push_back(instructionOffset);
-            } else if (mrs.Verify()) {
-                if (mrs.srcReg == TpidrroEl0 || mrs.srcReg == TpidrEl0) {
-                    size += ((mrs.destReg != registers::X0) ? 6 : 3);
+        // Scans a range of .text for instructions that need to be patched and returns the size of the patch section required for them in instructions
+        auto scanRange{[&](const u32 *rangeStart, const u32 *rangeEnd, std::vector<size_t> &offsets) {
+            size_t size{};
+            for (const u32 *instruction{rangeStart}; instruction < rangeEnd; instruction++) {
+                auto svc{*reinterpret_cast<const instructions::Svc *>(instruction)};
+                auto mrs{*reinterpret_cast<const instructions::Mrs *>(instruction)};
+                auto msr{*reinterpret_cast<const instructions::Msr *>(instruction)};
+                auto instructionOffset{static_cast<size_t>(instruction - start)};
+
+                if (svc.Verify()) {
+                    size += 7;
                     offsets.push_back(instructionOffset);
-                } else {
-                    if (rescaleClock) {
-                        if (mrs.srcReg == CntpctEl0) {
-                            size += RescaleClockSize + 3;
-                            offsets.push_back(instructionOffset);
-                        } else if (mrs.srcReg == CntfrqEl0) {
-                            size += 3;
+                } else if (mrs.Verify()) {
+                    if (mrs.srcReg == TpidrroEl0 || mrs.srcReg == TpidrEl0) {
+                        size += ((mrs.destReg != registers::X0) ? 6 : 3);
+                        offsets.push_back(instructionOffset);
+                    } else {
+                        if (rescaleClock) {
+                            if (mrs.srcReg == CntpctEl0) {
+                                size += RescaleClockSize + 3;
+                                offsets.push_back(instructionOffset);
+                            } else if (mrs.srcReg == CntfrqEl0) {
+                                size += 3;
+                                offsets.push_back(instructionOffset);
+                            }
+                        } else if (mrs.srcReg == CntpctEl0) {
                             offsets.push_back(instructionOffset);
                         }
-                    } else if (mrs.srcReg == CntpctEl0) {
-                        offsets.push_back(instructionOffset);
                     }
+                } else if (msr.Verify() && msr.destReg == TpidrEl0) {
+                    size += 6;
+                    offsets.push_back(instructionOffset);
                 }
-            } else if (msr.Verify() && msr.destReg == TpidrEl0) {
-                size += 6;
-                offsets.push_back(instructionOffset);
             }
+            return size;
+        }};
+
+        // Large .text sections are split into page-aligned chunks which are scanned concurrently, the offsets of every chunk are then concatenated in order
+        size_t threadCount{std::max<size_t>(std::thread::hardware_concurrency(), 1)};
+        size_t chunkSize{std::max(util::AlignUp(util::DivideCeil(text.size(), threadCount), constant::PageSize), PatchScanChunkPages * constant::PageSize)};
+        size_t chunkCount{util::DivideCeil(text.size(), chunkSize)};
+
+        std::vector<std::vector<size_t>> chunkOffsets(chunkCount);
+        std::vector<std::future<size_t>> chunkPatchSizes;
+        chunkPatchSizes.reserve(chunkCount);
+        for (size_t chunk{}; chunk < chunkCount; chunk++) {
+            auto chunkStart{start + (chunk * chunkSize / sizeof(u32))};
+            auto chunkEnd{start + (std::min((chunk + 1) * chunkSize, text.size()) / sizeof(u32))};
+            chunkPatchSizes.emplace_back(std::async(chunk + 1 == chunkCount ? std::launch::deferred : std::launch::async, scanRange, chunkStart, chunkEnd, std::ref(chunkOffsets[chunk])));
         }
-        return {util::AlignUp(size * sizeof(u32), constant::PageSize), offsets};
+
+        size_t size{guest::SaveCtxSize + guest::LoadCtxSize + TrampolineSize};
+        for (auto &chunkPatchSize : chunkPatchSizes)
+            size += chunkPatchSize.get();
+
+        std::vector<size_t> offsets;
+        if (chunkCount == 1) {
+            offsets = std::move(chunkOffsets.front());
+        } else {
+            size_t offsetCount{};
+            for (const auto &chunk : chunkOffsets)
+                offsetCount += chunk.size();
+
+            offsets.reserve(offsetCount);
+            for (const auto &chunk : chunkOffsets)
+                offsets.insert(offsets.end(), chunk.begin(), chunk.end());
+        }
+
+        return {util::AlignUp(size * sizeof(u32), constant::PageSize), std::move(offsets)};
     }
 
     void NCE::PatchCode(std::vector<u8> &text, u32 *patch, size_t patchSize, const std::vector<size_t> &offsets, size_t textOffset) {
@@ -528,7 +567,6 @@ namespace skyline::nce {
         hook += guest::LoadCtxSize;
 
         u64 hookIndex{static_cast<u64>(hookedSymbols.size())};
-        hookedSymbols.reserve(entries.size());
         for (const auto &entry : entries) {
             auto startOffset{[&] { return static_cast<size_t>(start - hook); }};
             auto endOffset{[&] { return static_cast<size_t>(end - hook); }};
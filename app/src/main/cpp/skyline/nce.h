@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <deque>
 #include "common.h"
 #include "hle/symbol_hooks.h"
 
@@ -14,7 +15,7 @@ namespace skyline::nce {
       private:
         const DeviceState &state;
 
-        std::vector<hle::HookedSymbol> hookedSymbols; //!< The list of symbols that are hooked, these have a specific ordering that is hardcoded into the hooked functions
+        std::deque<hle::HookedSymbol> hookedSymbols; //!< The list of symbols that are hooked, these have a specific ordering that is hardcoded into the hooked functions, a deque is used so references remain valid while later executables append to it
 
         static void SvcHandler(u16 svcId, ThreadContext *ctx);
 
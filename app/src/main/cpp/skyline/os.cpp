@@ -6,6 +6,7 @@
 #include "nce/guest.h"
 #include "kernel/types/KProcess.h"
 #include "vfs/os_backing.h"
+#include "vfs/cached_backing.h"
 #include "loader/nro.h"
 #include "loader/nso.h"
 #include "loader/nca.h"
@@ -51,6 +52,9 @@ namespace skyline::kernel {
             }
         }();
 
+        if (state.loader->romFs && *state.settings->romFsCacheSize)
+            state.loader->romFs = std::make_shared<vfs::CachedBacking>(state.loader->romFs, static_cast<size_t>(*state.settings->romFsCacheSize) * 1024 * 1024);
+
         state.gpu->Initialise();
 
         auto &process{state.process};
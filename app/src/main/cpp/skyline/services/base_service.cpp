@@ -20,16 +20,16 @@ namespace skyline::service {
     }
 
     Result service::BaseService::HandleRequest(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {
-        ServiceFunctionDescriptor function;
         u32 functionId{request.isTipc ? static_cast<u32>(request.header->type) : request.payload->value};
-
-        try {
-            function = GetServiceFunction(functionId, request.isTipc);
-            LOGDNF("Service: {}", function.name);
-        } catch (const std::out_of_range &) {
+        auto lookup{GetServiceFunction(functionId, request.isTipc)};
+        if (!lookup) {
             LOGW("Cannot find {0} function in service '{1}': 0x{2:X} ({2})", request.isTipc ? "TIPC" : "HIPC", GetName(), static_cast<u32>(functionId));
             return {};
         }
+
+        auto function{*lookup};
+        response.functionName = function.name;
+        LOGDNF("Service: {}", function.name);
         TRACE_EVENT("service", perfetto::StaticString{function.name});
         try {
             return function(session, request, response);
@@ -4,27 +4,29 @@
 #pragma once
 
 #include <kernel/ipc.h>
+#include "service_function_table.h"
 
-constexpr static skyline::u32 TipcFunctionIdFlag{1U << 31}; //!< Flag applied to the stored service function ID to differentiate between TIPC and HIPC functions
 #define SERVICE_STRINGIFY(string) #string
-#define SFUNC(id, Class, Function) std::pair<u32, std::pair<Result(Class::*)(type::KSession &, ipc::IpcRequest &, ipc::IpcResponse &), const char*>>{id, {&Class::Function, SERVICE_STRINGIFY(Class::Function)}}
-#define SFUNC_TIPC(id, Class, Function) std::pair<u32, std::pair<Result(Class::*)(type::KSession &, ipc::IpcRequest &, ipc::IpcResponse &), const char*>>{TipcFunctionIdFlag | id, {&Class::Function, SERVICE_STRINGIFY(Class::Function)}}
-#define SFUNC_BASE(id, Class, BaseClass, Function) std::pair<u32, std::pair<Result(Class::*)(type::KSession &, ipc::IpcRequest &, ipc::IpcResponse &), const char*>>{id, {&Class::CallBaseFunction<BaseClass, decltype(&BaseClass::Function), &BaseClass::Function>, SERVICE_STRINGIFY(Class::Function)}}
-#define SERVICE_DECL_AUTO(name, value) decltype(value) name = value
+#define SFUNC(id, Class, Function) ServiceFunctionEntry<Class>{id, &Class::Function, SERVICE_STRINGIFY(Class::Function)}
+#define SFUNC_TIPC(id, Class, Function) ServiceFunctionEntry<Class>{TipcFunctionIdFlag | id, &Class::Function, SERVICE_STRINGIFY(Class::Function)}
+#define SFUNC_BASE(id, Class, BaseClass, Function) ServiceFunctionEntry<Class>{id, &Class::CallBaseFunction<BaseClass, decltype(&BaseClass::Function), &BaseClass::Function>, SERVICE_STRINGIFY(Class::Function)}
 #define SERVICE_DECL(...)                                                                                      \
 private:                                                                                                       \
 template<typename BaseClass, typename BaseFunctionType, BaseFunctionType BaseFunction>                         \
 Result CallBaseFunction(type::KSession &session, ipc::IpcRequest &request, ipc::IpcResponse &response) {       \
     return (static_cast<BaseClass *>(this)->*BaseFunction)(session, request, response);                        \
 }                                                                                                              \
-SERVICE_DECL_AUTO(functions, frozen::make_unordered_map({__VA_ARGS__}));                                       \
 protected:                                                                                                     \
-ServiceFunctionDescriptor GetServiceFunction(u32 id, bool isTipc) override {                                   \
-    auto& function{functions.at((isTipc ? TipcFunctionIdFlag : 0U) | id)};                                     \
+std::optional<ServiceFunctionDescriptor> GetServiceFunction(u32 id, bool isTipc) override {                    \
+    static constexpr std::array entries{__VA_ARGS__};                                                          \
+    static constexpr ServiceFunctionTable<typename decltype(entries)::value_type, entries.size(), GetDirectServiceFunctionCount(entries)> functions{entries}; \
+    auto function{functions.Find((isTipc ? TipcFunctionIdFlag : 0U) | id)};                                   \
+    if (!function)                                                                                             \
+        return std::nullopt;                                                                                   \
     return ServiceFunctionDescriptor{                                                                          \
         reinterpret_cast<DerivedService*>(this),                                                               \
-        reinterpret_cast<decltype(ServiceFunctionDescriptor::function)>(function.first),                       \
-        function.second                                                                                        \
+        reinterpret_cast<decltype(ServiceFunctionDescriptor::function)>(function->function),                   \
+        function->name                                                                                         \
     };                                                                                                         \
 }
 #define SRVREG(class, ...) std::make_shared<class>(state, manager, ##__VA_ARGS__)
@@ -39,6 +41,16 @@ namespace skyline::service {
 
     class ServiceManager;
 
+    /**
+     * @brief A single HLE service function as declared with SFUNC in SERVICE_DECL
+     */
+    template<typename Class>
+    struct ServiceFunctionEntry {
+        u32 id; //!< The command ID of the function, TIPC functions have TipcFunctionIdFlag set
+        Result (Class::*function)(type::KSession &, ipc::IpcRequest &, ipc::IpcResponse &);
+        const char *name; //!< A pointer to a static string in the format "Class::Function"
+    };
+
     /**
      * @brief The base class for the HOS service interfaces hosted by sysmodules
      */
@@ -73,8 +85,11 @@ namespace skyline::service {
          */
         virtual ~BaseService() = default;
 
-        virtual ServiceFunctionDescriptor GetServiceFunction(u32 id, bool isTipc) {
-            throw std::out_of_range("GetServiceFunction not implemented");
+        /**
+         * @return The HLE implementation of the function with the supplied command ID, std::nullopt if there's none
+         */
+        virtual std::optional<ServiceFunctionDescriptor> GetServiceFunction(u32 id, bool isTipc) {
+            return std::nullopt;
         }
 
         /**
@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2023 Strato Team and Contributors (https://github.com/strato-emu/)
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <stdexcept>
+#include <common/base.h>
+
+constexpr static skyline::u32 TipcFunctionIdFlag{1U << 31}; //!< Flag applied to the stored service function ID to differentiate between TIPC and HIPC functions
+
+namespace skyline::service {
+    constexpr u32 MaxDirectServiceFunctionId{0x1000}; //!< HIPC command IDs below this are looked up by directly indexing a table, the few services with larger IDs fall back to a binary search for those
+
+    /**
+     * @return The amount of slots required in the direct lookup table for the supplied functions
+     */
+    template<typename Entry, size_t EntryCount>
+    constexpr size_t GetDirectServiceFunctionCount(const std::array<Entry, EntryCount> &entries) {
+        size_t count{};
+        for (const auto &entry : entries)
+            if (entry.id < MaxDirectServiceFunctionId)
+                count = std::max<size_t>(count, entry.id + 1);
+        return count;
+    }
+
+    /**
+     * @brief A compile-time lookup table from command IDs to the HLE functions of a service
+     * @note Dispatching an IPC request is on the hot path of every svcSendSyncRequest, so the common case of a small HIPC command ID is a single array index
+     */
+    template<typename Entry, size_t EntryCount, size_t DirectCount>
+    class ServiceFunctionTable {
+      private:
+        static_assert(EntryCount < std::numeric_limits<u8>::max(), "Direct lookup table indices are stored as u8");
+
+        std::array<Entry, EntryCount> entries{}; //!< All functions sorted by their ID, this is binary searched for any IDs that aren't in the direct table
+        std::array<u8, DirectCount> directIndices{}; //!< One more than the index into `entries` for each HIPC command ID, 0 if there's no such function
+
+      public:
+        constexpr ServiceFunctionTable(const std::array<Entry, EntryCount> &unsortedEntries) : entries{unsortedEntries} {
+            for (size_t index{1}; index < EntryCount; index++)
+                for (size_t sortIndex{index}; sortIndex > 0 && entries[sortIndex - 1].id > entries[sortIndex].id; sortIndex--)
+                    std::swap(entries[sortIndex - 1], entries[sortIndex]);
+
+            for (size_t index{}; index < EntryCount; index++) {
+                if (index > 0 && entries[index - 1].id == entries[index].id)
+                    throw std::logic_error("Duplicate service function ID"); // The table is always constant evaluated so this fails compilation rather than throwing at runtime
+                if (entries[index].id < DirectCount)
+                    directIndices[entries[index].id] = static_cast<u8>(index + 1);
+            }
+        }
+
+        /**
+         * @return A pointer to the function with the supplied ID or nullptr if there's no such function
+         */
+        constexpr const Entry *Find(u32 id) const {
+            if (id < DirectCount) {
+                u8 index{directIndices[id]};
+                return index ? &entries[index - 1] : nullptr;
+            }
+
+            auto it{std::lower_bound(entries.begin(), entries.end(), id, [](const Entry &entry, u32 id) { return entry.id < id; })};
+            return (it != entries.end() && it->id == id) ? &*it : nullptr;
+        }
+    };
+}
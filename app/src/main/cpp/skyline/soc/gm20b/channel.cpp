@@ -1,11 +1,15 @@
 // SPDX-License-Identifier: MPL-2.0
 // Copyright © 2021 Skyline Team and Contributors (https://github.com/skyline-emu/)
 
+#include <common/trace.h>
 #include "channel.h"
 
 namespace skyline::soc::gm20b {
+    static std::atomic<u32> nextChannelId{};
+
     ChannelContext::ChannelContext(const DeviceState &state, std::shared_ptr<AddressSpaceContext> pAsCtx, size_t numEntries)
-        : asCtx{std::move(pAsCtx)},
+        : id{nextChannelId++},
+          asCtx{std::move(pAsCtx)},
           executor{state},
           maxwell3D{state, *this, macroState},
           fermi2D{state, *this, macroState},
@@ -18,4 +22,32 @@ namespace skyline::soc::gm20b {
             channelSequenceNumber++;
         });
     }
+
+    ChannelContext::~ChannelContext() {
+        if (lockStatistics.acquisitions)
+            LOGI("Channel {} acquired the channel lock {} times ({} contended), waited {}ms and held it for {}ms", id, lockStatistics.acquisitions, lockStatistics.contendedAcquisitions, lockStatistics.waitTime / constant::NsInMillisecond, lockStatistics.holdTime / constant::NsInMillisecond);
+    }
+
+    void ChannelContext::Lock() {
+        if (!globalChannelLock.try_lock()) {
+            TRACE_EVENT("gpu", "ChannelContext::Lock Wait", "channel", id);
+            auto waitStart{util::GetTimeNs()};
+            globalChannelLock.lock();
+
+            lockStatistics.contendedAcquisitions++;
+            lockStatistics.waitTime += static_cast<u64>(util::GetTimeNs() - waitStart);
+        }
+
+        locked = true;
+        lockStatistics.acquisitions++;
+        lockTimestamp = util::GetTimeNs();
+        executor.LockPreserve();
+    }
+
+    void ChannelContext::Unlock() {
+        executor.UnlockPreserve();
+        lockStatistics.holdTime += static_cast<u64>(util::GetTimeNs() - lockTimestamp);
+        locked = false;
+        globalChannelLock.unlock();
+    }
 }
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <common/ticket_lock.h>
 #include <gpu/interconnect/command_executor.h>
 #include "macro/macro_state.h"
 #include "engines/engine.h"
@@ -21,6 +22,19 @@ namespace skyline::soc::gm20b {
      * @note We omit parts of components related to external access such as the grhost, all accesses to the external components are done directly
      */
     struct ChannelContext {
+        /**
+         * @brief Timing information for the global channel lock, this measures how much channels are serialized on each other
+         */
+        struct LockStatistics {
+            u64 acquisitions; //!< The amount of times the lock was acquired
+            u64 contendedAcquisitions; //!< The amount of times the lock was held by another channel when trying to acquire it
+            u64 waitTime; //!< The total time spent waiting on other channels to release the lock in nanoseconds
+            u64 holdTime; //!< The total time the lock was held by this channel in nanoseconds
+        };
+
+        static constexpr i64 LockStarvationThreshold{constant::NsInMillisecond * 8}; //!< The time after which the lock is handed to a waiting channel even if this channel has recorded work that needs to be submitted first
+
+        u32 id; //!< A unique identifier for the channel, used to tell channels apart in traces and logs
         std::shared_ptr<AddressSpaceContext> asCtx;
         gpu::interconnect::CommandExecutor executor;
         MacroState macroState;
@@ -30,19 +44,41 @@ namespace skyline::soc::gm20b {
         engine::KeplerCompute keplerCompute;
         engine::Inline2Memory inline2Memory;
         ChannelGpfifo gpfifo;
-        std::mutex &globalChannelLock;
+        TicketLock &globalChannelLock;
+        bool locked{}; //!< If this channel currently holds the global channel lock
         size_t channelSequenceNumber{};
+        LockStatistics lockStatistics{};
+        i64 lockTimestamp{}; //!< The time at which the global channel lock was last acquired by this channel
 
         ChannelContext(const DeviceState &state, std::shared_ptr<AddressSpaceContext> asCtx, size_t numEntries);
 
-        void Lock() {
-            globalChannelLock.lock();
-            executor.LockPreserve();
+        ~ChannelContext();
+
+        /**
+         * @brief Acquires the global channel lock, this must be held while accessing any GPU state that is shared with other channels
+         */
+        void Lock();
+
+        /**
+         * @brief Releases the global channel lock
+         * @note Any recorded work must be submitted beforehand as it keeps resources locked that other channels might wait on
+         */
+        void Unlock();
+
+        /**
+         * @brief Acquires the global channel lock if this channel doesn't hold it already
+         * @note Methods that only touch the registers of this channel's engines don't need the lock, this is called lazily by anything that accesses shared state
+         */
+        void EnsureLocked() {
+            if (!locked)
+                Lock();
         }
 
-        void Unlock() {
-            executor.UnlockPreserve();
-            globalChannelLock.unlock();
+        /**
+         * @return If the global channel lock should be handed to another channel that is waiting on it, this is done once there's no recorded work left to submit or after this channel has held it for too long
+         */
+        bool ShouldYieldLock() const {
+            return locked && globalChannelLock.GetWaiterCount() && (!executor.HasPendingNodes() || util::GetTimeNs() - lockTimestamp > LockStarvationThreshold);
         }
     };
 }
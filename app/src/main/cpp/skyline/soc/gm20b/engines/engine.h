@@ -67,6 +67,37 @@ namespace skyline::soc::gm20b::engine {
 
     constexpr u32 EngineMethodsEnd{0xE00}; //!< All methods above this are passed to the MME on supported engines
 
+    /**
+     * @return The amount of consecutive methods starting at the supplied method, up to the supplied count, which aren't marked in the side effect table
+     */
+    template<size_t MethodCount>
+    size_t CountPlainMethods(const std::array<bool, MethodCount> &sideEffectMethods, u32 method, size_t maxCount) {
+        size_t count{};
+        maxCount = std::min<size_t>(maxCount, MethodCount - std::min<size_t>(method, MethodCount));
+        while (count < maxCount && !sideEffectMethods[method + count])
+            count++;
+        return count;
+    }
+
+    /**
+     * @brief Writes a run of arguments to consecutive registers as HandleMethod would for methods without any side effects, registers are written and marked dirty in a single pass over the run
+     * @param shadowRegisters The shadow RAM to write the arguments to when method tracking is enabled, nullptr otherwise
+     * @note Only registers which were changed by the write are marked dirty
+     */
+    template<typename DirtyManagerType>
+    void WriteRegisterRun(u32 *registers, u32 *shadowRegisters, DirtyManagerType &dirtyManager, u32 method, span<const u32> arguments) {
+        if (shadowRegisters)
+            std::copy(arguments.begin(), arguments.end(), shadowRegisters + method);
+
+        for (u32 argument : arguments) {
+            if (registers[method] != argument) {
+                registers[method] = argument;
+                dirtyManager.MarkDirty(method);
+            }
+            method++;
+        }
+    }
+
     /**
      * @brief Returns current time in GPU ticks
      */
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <soc/host1x/syncpoint.h>
 #include "engine.h"
 
 namespace skyline::soc::gm20b {
@@ -114,6 +114,52 @@ namespace skyline::soc::gm20b::engine::maxwell3d {
         InitializeRegisters();
     }
 
+    /**
+     * @brief A table of all methods that require handling beyond writing their register and marking it as dirty, these are always dispatched through HandleMethod
+     */
+    static constexpr std::array<bool, EngineMethodsEnd> SideEffectMethods{[] {
+        using Registers = Maxwell3D::Registers;
+        std::array<bool, EngineMethodsEnd> methods{};
+
+        methods[ENGINE_STRUCT_OFFSET(mme, shadowRamControl)] = true;
+        methods[ENGINE_STRUCT_OFFSET(mme, instructionRamLoad)] = true;
+        methods[ENGINE_STRUCT_OFFSET(mme, startAddressRamLoad)] = true;
+        methods[ENGINE_STRUCT_OFFSET(i2m, launchDma)] = true;
+        methods[ENGINE_STRUCT_OFFSET(i2m, loadInlineData)] = true;
+        methods[ENGINE_OFFSET(clearReportValue)] = true;
+        methods[ENGINE_OFFSET(syncpointAction)] = true;
+        methods[ENGINE_OFFSET(clearSurface)] = true;
+        methods[ENGINE_OFFSET(begin)] = true;
+        methods[ENGINE_OFFSET(end)] = true;
+        methods[ENGINE_STRUCT_OFFSET(drawVertexArray, count)] = true;
+        methods[ENGINE_OFFSET(drawVertexArrayBeginEndInstanceFirst)] = true;
+        methods[ENGINE_OFFSET(drawVertexArrayBeginEndInstanceSubsequent)] = true;
+        methods[ENGINE_STRUCT_OFFSET(drawInlineIndex4X8, index0)] = true;
+        methods[ENGINE_STRUCT_OFFSET(drawInlineIndex2X16, even)] = true;
+        methods[ENGINE_STRUCT_OFFSET(drawZeroIndex, count)] = true;
+        methods[ENGINE_STRUCT_OFFSET(drawAuto, byteCount)] = true;
+        methods[ENGINE_OFFSET(drawInlineIndex)] = true;
+        methods[ENGINE_STRUCT_OFFSET(drawIndexBuffer, count)] = true;
+        methods[ENGINE_OFFSET(drawIndexBuffer32BeginEndInstanceFirst)] = true;
+        methods[ENGINE_OFFSET(drawIndexBuffer16BeginEndInstanceFirst)] = true;
+        methods[ENGINE_OFFSET(drawIndexBuffer8BeginEndInstanceFirst)] = true;
+        methods[ENGINE_OFFSET(drawIndexBuffer32BeginEndInstanceSubsequent)] = true;
+        methods[ENGINE_OFFSET(drawIndexBuffer16BeginEndInstanceSubsequent)] = true;
+        methods[ENGINE_OFFSET(drawIndexBuffer8BeginEndInstanceSubsequent)] = true;
+        methods[ENGINE_STRUCT_OFFSET(semaphore, info)] = true;
+        methods[ENGINE_ARRAY_OFFSET(firmwareCall, 4)] = true;
+        methods[ENGINE_OFFSET(invalidateSamplerCacheAll)] = true;
+        methods[ENGINE_OFFSET(invalidateTextureHeaderCacheAll)] = true;
+
+        for (u32 index{}; index < 16; index++)
+            methods[ENGINE_STRUCT_ARRAY_OFFSET(loadConstantBuffer, data, index)] = true;
+
+        for (u32 stage{}; stage < type::ShaderStageCount; stage++)
+            methods[ENGINE_ARRAY_STRUCT_OFFSET(bindGroups, stage, constantBuffer)] = true;
+
+        return methods;
+    }()};
+
     __attribute__((always_inline)) void Maxwell3D::FlushDeferredDraw() {
         if (batchEnableState.drawActive) {
             batchEnableState.drawActive = false;
@@ -124,6 +170,10 @@ namespace skyline::soc::gm20b::engine::maxwell3d {
     }
 
     __attribute__((always_inline)) void Maxwell3D::HandleMethod(u32 method, u32 argument) {
+        // Plain register writes only touch state private to this channel, anything else may reach shared GPU state through the interconnect
+        if (SideEffectMethods[method] || batchEnableState.raw)
+            channelCtx.EnsureLocked();
+
         if (method == ENGINE_STRUCT_OFFSET(mme, shadowRamControl)) [[unlikely]] {
             shadowRegisters.raw[method] = registers.raw[method] = argument;
             return;
@@ -488,6 +538,7 @@ namespace skyline::soc::gm20b::engine::maxwell3d {
     }
 
     void Maxwell3D::FlushEngineState() {
+        channelCtx.EnsureLocked();
         FlushDeferredDraw();
 
         if (batchEnableState.constantBufferActive) {
@@ -508,6 +559,7 @@ namespace skyline::soc::gm20b::engine::maxwell3d {
     void Maxwell3D::CallMethodBatchNonInc(u32 method, span<u32> arguments) {
         switch (method) {
             case ENGINE_STRUCT_OFFSET(i2m, loadInlineData):
+                channelCtx.EnsureLocked();
                 i2m.LoadInlineData(*registers.i2m, arguments);
                 return;
             default:
@@ -518,6 +570,57 @@ namespace skyline::soc::gm20b::engine::maxwell3d {
             HandleMethod(method, argument);
     }
 
+    void Maxwell3D::CallMethodBatchInc(u32 method, span<u32> arguments) {
+        constexpr u32 LoadConstantBufferDataStart{ENGINE_STRUCT_ARRAY_OFFSET(loadConstantBuffer, data, 0)};
+        constexpr u32 LoadConstantBufferDataEnd{LoadConstantBufferDataStart + 16};
+
+        while (!arguments.empty()) {
+            auto shadowRamControl{shadowRegisters.mme->shadowRamControl};
+            bool trackShadow{shadowRamControl == type::MmeShadowRamControl::MethodTrack || shadowRamControl == type::MmeShadowRamControl::MethodTrackWithFilter};
+
+            // Replayed writes and deferred draws depend on the exact sequence of methods so they can't be batched
+            if (shadowRamControl == type::MmeShadowRamControl::MethodReplay || batchEnableState.drawActive) [[unlikely]] {
+                HandleMethod(method++, arguments.front());
+                arguments = arguments.subspan(1);
+                continue;
+            }
+
+            if (method >= LoadConstantBufferDataStart && method < LoadConstantBufferDataEnd) {
+                // The first write of a constant buffer update needs to go through HandleMethod to begin the batch
+                if (!batchEnableState.constantBufferActive) {
+                    HandleMethod(method++, arguments.front());
+                    arguments = arguments.subspan(1);
+                    continue;
+                }
+
+                // Any further writes within the data registers are appended to the active batch in one go
+                auto run{arguments.first(std::min<size_t>(arguments.size(), LoadConstantBufferDataEnd - method))};
+                batchLoadConstantBuffer.buffer.insert(batchLoadConstantBuffer.buffer.end(), run.begin(), run.end());
+                registers.loadConstantBuffer->offset += static_cast<u32>(run.size() * sizeof(u32));
+                std::copy(run.begin(), run.end(), registers.raw.begin() + method);
+                if (trackShadow)
+                    std::copy(run.begin(), run.end(), shadowRegisters.raw.begin() + method);
+
+                method += static_cast<u32>(run.size());
+                arguments = arguments.subspan(run.size());
+                continue;
+            }
+
+            // Any method other than a constant buffer data write needs to flush the active batch first, HandleMethod takes care of that
+            if (batchEnableState.constantBufferActive || SideEffectMethods[method]) {
+                HandleMethod(method++, arguments.front());
+                arguments = arguments.subspan(1);
+                continue;
+            }
+
+            auto count{CountPlainMethods(SideEffectMethods, method, arguments.size())};
+            WriteRegisterRun(registers.raw.data(), trackShadow ? shadowRegisters.raw.data() : nullptr, dirtyManager, method, arguments.first(count));
+
+            method += static_cast<u32>(count);
+            arguments = arguments.subspan(count);
+        }
+    }
+
     void Maxwell3D::CallMethodFromMacro(u32 method, u32 argument) {
         HandleMethod(method, argument);
     }
@@ -480,6 +480,12 @@ namespace skyline::soc::gm20b::engine::maxwell3d {
 
         void CallMethodBatchNonInc(u32 method, span<u32> arguments);
 
+        /**
+         * @brief Calls a run of consecutive methods starting at the supplied method, runs of plain register writes are written directly to the register file with a single dirty tracking pass
+         * @note This is functionally identical to calling HandleMethod for each argument with an incrementing method
+         */
+        void CallMethodBatchInc(u32 method, span<u32> arguments);
+
         void CallMethodFromMacro(u32 method, u32 argument) override;
 
         u32 ReadMethodFromMacro(u32 method) override;
@@ -43,8 +43,6 @@ namespace skyline::soc::gm20b::engine {
                 return;
             }
 
-            channelCtx.executor.Submit();
-
             if (registers.launchDma->srcMemoryLayout == registers.launchDma->dstMemoryLayout) [[unlikely]] {
                 // Pitch to Pitch copy
                 if (registers.launchDma->srcMemoryLayout == Registers::LaunchDma::MemoryLayout::Pitch) [[likely]] {
@@ -119,7 +117,18 @@ namespace skyline::soc::gm20b::engine {
             channelCtx.asCtx->gmmu.Write(u64{*registers.offsetOut}, dst, dstSize);
     }
 
+    bool MaxwellDma::CanCopyBlockLinearOnGpu(const TranslatedAddressRange &srcMappings, const TranslatedAddressRange &dstMappings) {
+        if (srcMappings.size() != 1 || dstMappings.size() != 1)
+            return false;
+
+        // The compute shader reads and writes in parallel so overlapping copies must be done on the CPU
+        auto src{srcMappings.front()}, dst{dstMappings.front()};
+        return src.data() + src.size() <= dst.data() || dst.data() + dst.size() <= src.data();
+    }
+
     void MaxwellDma::CopyPitchToPitch() {
+        channelCtx.executor.Submit();
+
         auto srcMappings{channelCtx.asCtx->gmmu.TranslateRange(*registers.offsetIn, *registers.pitchIn * *registers.lineCount)};
         auto dstMappings{channelCtx.asCtx->gmmu.TranslateRange(*registers.offsetOut, *registers.pitchOut * *registers.lineCount)};
 
@@ -184,9 +193,27 @@ namespace skyline::soc::gm20b::engine {
 
         LOGD("{}x{}x{}@0x{:X} -> {}x{}x{}@0x{:X}", srcDimensions.width, srcDimensions.height, srcDimensions.depth, srcLayerAddress, dstDimensions.width, dstDimensions.height, dstDimensions.depth, u64{*registers.offsetOut});
 
+        if (CanCopyBlockLinearOnGpu(srcMappings, dstMappings)) [[likely]] {
+            interconnect.CopyBlockLinear(dstMappings.front(), srcMappings.front(), {
+                .pitch = *registers.pitchOut,
+                .lineLength = static_cast<u32>(dstDimensions.width),
+                .lineCount = static_cast<u32>(dstDimensions.height),
+                .depth = static_cast<u32>(dstDimensions.depth),
+                .blockLinearWidth = static_cast<u32>(util::AlignUp(srcDimensions.width, 64)),
+                .blockLinearHeight = static_cast<u32>(srcDimensions.height),
+                .gobBlockHeight = static_cast<u32>(registers.srcSurface->blockSize.Height()),
+                .gobBlockDepth = static_cast<u32>(registers.srcSurface->blockSize.Depth()),
+                .originX = registers.srcSurface->origin.x,
+                .originY = registers.srcSurface->origin.y
+            }, true);
+            return;
+        }
+
+        channelCtx.executor.Submit();
+
         if (srcMappings.size() != 1 || dstMappings.size() != 1) [[unlikely]]
             HandleSplitCopy(srcMappings, dstMappings, srcLayerStride, dstSize, copyFunc);
-        else [[likely]]
+        else
             copyFunc(srcMappings.front().data(), dstMappings.front().data());
     }
 
@@ -231,9 +258,27 @@ namespace skyline::soc::gm20b::engine {
             }
         }};
 
+        if (CanCopyBlockLinearOnGpu(srcMappings, dstMappings)) [[likely]] {
+            interconnect.CopyBlockLinear(dstMappings.front(), srcMappings.front(), {
+                .pitch = *registers.pitchIn,
+                .lineLength = static_cast<u32>(srcDimensions.width),
+                .lineCount = static_cast<u32>(srcDimensions.height),
+                .depth = static_cast<u32>(srcDimensions.depth),
+                .blockLinearWidth = static_cast<u32>(util::AlignUp(dstDimensions.width, 64)),
+                .blockLinearHeight = static_cast<u32>(dstDimensions.height),
+                .gobBlockHeight = static_cast<u32>(registers.dstSurface->blockSize.Height()),
+                .gobBlockDepth = static_cast<u32>(registers.dstSurface->blockSize.Depth()),
+                .originX = registers.dstSurface->origin.x,
+                .originY = registers.dstSurface->origin.y
+            }, false);
+            return;
+        }
+
+        channelCtx.executor.Submit();
+
         if (srcMappings.size() != 1 || dstMappings.size() != 1) [[unlikely]]
             HandleSplitCopy(srcMappings, dstMappings, srcSize, dstLayerStride, copyFunc);
-        else [[likely]]
+        else
             copyFunc(srcMappings.front().data(), dstMappings.front().data());
     }
 
@@ -31,6 +31,11 @@ namespace skyline::soc::gm20b::engine {
 
         void HandleSplitCopy(TranslatedAddressRange srcMappings, TranslatedAddressRange dstMappings, size_t srcSize, size_t dstSize, auto copyCallback);
 
+        /**
+         * @return If a block-linear copy between the supplied mappings can be performed on the GPU
+         */
+        bool CanCopyBlockLinearOnGpu(const TranslatedAddressRange &srcMappings, const TranslatedAddressRange &dstMappings);
+
         void CopyPitchToPitch();
 
         void CopyBlockLinearToPitch();
@@ -3,106 +3,62 @@
 
 #include <gpu.h>
 #include <common/signal.h>
+#include <common/trace.h>
 #include <common/settings.h>
 #include <loader/loader.h>
 #include <kernel/types/KProcess.h>
 #include <soc.h>
 #include <os.h>
 #include "channel.h"
+#include "gpfifo_capture.h"
 #include "macro/macro_state.h"
 
 namespace skyline::soc::gm20b {
     /**
-     * @brief A single pushbuffer method header that describes a compressed method sequence
-     * @url https://github.com/NVIDIA/open-gpu-doc/blob/ab27fc22db5de0d02a4cabe08e555663b62db4d4/manuals/volta/gv100/dev_ram.ref.txt#L850
-     * @url https://github.com/NVIDIA/open-gpu-doc/blob/ab27fc22db5de0d02a4cabe08e555663b62db4d4/classes/host/clb06f.h#L179
+     * @return The directory that GPFIFO captures of the current title are stored in
      */
-    union PushBufferMethodHeader {
-        u32 raw;
-
-        enum class TertOp : u8 {
-            Grp0IncMethod = 0,
-            Grp0SetSubDevMask = 1,
-            Grp0StoreSubDevMask = 2,
-            Grp0UseSubDevMask = 3,
-            Grp2NonIncMethod = 0,
-        };
-
-        enum class SecOp : u8 {
-            Grp0UseTert = 0,
-            IncMethod = 1,
-            Grp2UseTert = 2,
-            NonIncMethod = 3,
-            ImmdDataMethod = 4,
-            OneInc = 5,
-            Reserved6 = 6,
-            EndPbSegment = 7,
-        };
-
-        u16 methodAddress : 12;
-        struct {
-            u8 _pad0_ : 4;
-            u16 subDeviceMask : 12;
-        };
-
-        struct {
-            u16 _pad1_ : 13;
-            SubchannelId methodSubChannel : 3;
-            union {
-                TertOp tertOp : 3;
-                u16 methodCount : 13;
-                u16 immdData : 13;
-            };
-        };
-
-        struct {
-            u32 _pad2_ : 29;
-            SecOp secOp : 3;
-        };
-
-        /**
-         * @brief Checks if a method is 'pure' i.e. does not touch macro or GPFIFO methods
-         */
-        bool Pure() const {
-            u32 size{[&]() -> u32  {
-                switch (secOp) {
-                    case SecOp::NonIncMethod:
-                    case SecOp::ImmdDataMethod:
-                        return 0;
-                    case SecOp::OneInc:
-                        return 1;
-                    default:
-                        return methodCount;
-                }
-            }()};
+    static std::string GetCaptureDirectory(const DeviceState &state) {
+        return fmt::format("{}gpfifo_captures/{}/", state.os->publicAppFilesPath, state.loader->nacp->GetSaveDataOwnerId());
+    }
 
-            u32 end{static_cast<u32>(methodAddress + size)};
-            return end < engine::EngineMethodsEnd && methodAddress >= engine::GPFIFO::RegisterCount;
-        }
-    };
-    static_assert(sizeof(PushBufferMethodHeader) == sizeof(u32));
+    /**
+     * @return A writer for a new capture file if GPFIFO capture is enabled, otherwise nullptr
+     */
+    static std::unique_ptr<GpfifoCaptureWriter> CreateCaptureWriter(const DeviceState &state) {
+        if (!*state.settings->gpfifoCapture)
+            return nullptr;
+
+        auto path{fmt::format("{}{}.bin", GetCaptureDirectory(state), util::GetTimeNs())};
+        LOGI("Capturing GPFIFO to: {}", path);
+        return std::make_unique<GpfifoCaptureWriter>(path);
+    }
 
     ChannelGpfifo::ChannelGpfifo(const DeviceState &state, ChannelContext &channelCtx, size_t numEntries) :
         state(state),
         gpfifoEngine(state.soc->host1x.syncpoints, channelCtx),
         channelCtx(channelCtx),
         gpEntries(numEntries),
+        capture(CreateCaptureWriter(state)),
         thread(std::thread(&ChannelGpfifo::Run, this)) {}
 
     void ChannelGpfifo::SendFull(u32 method, GpfifoArgument argument, SubchannelId subChannel, bool lastCall) {
         if (method < engine::GPFIFO::RegisterCount) {
+            channelCtx.EnsureLocked();
             gpfifoEngine.CallMethod(method, *argument);
         } else if (method < engine::EngineMethodsEnd) { [[likely]]
             SendPure(method, *argument, subChannel);
         } else {
             switch (subChannel) {
                 case SubchannelId::ThreeD:
+                    // Macros mostly write registers so they're executed without the channel lock, the engine acquires it for any methods that need it
                     skipDirtyFlushes = channelCtx.maxwell3D.HandleMacroCall(method - engine::EngineMethodsEnd, argument, lastCall,
-                                                                            [&executor = channelCtx.executor] {
-                                                                                executor.Submit({}, true);
+                                                                            [&channelCtx = channelCtx] {
+                                                                                channelCtx.EnsureLocked();
+                                                                                channelCtx.executor.Submit({}, true);
                                                                             });
                     break;
                 case SubchannelId::TwoD:
+                    channelCtx.EnsureLocked();
                     skipDirtyFlushes = channelCtx.fermi2D.HandleMacroCall(method - engine::EngineMethodsEnd, argument, lastCall,
                                                                           [&executor = channelCtx.executor] {
                                                                               executor.Submit({}, true);
@@ -121,6 +77,9 @@ namespace skyline::soc::gm20b {
             return;
         }
 
+        // Engines other than 3D see little traffic and almost every method touches shared state so they always run under the channel lock
+        channelCtx.EnsureLocked();
+
         switch (subChannel) {
             case SubchannelId::ThreeD:
                 channelCtx.maxwell3D.CallMethod(method, argument);
@@ -143,6 +102,9 @@ namespace skyline::soc::gm20b {
     }
 
     void ChannelGpfifo::SendPureBatchNonInc(u32 method, span<u32> arguments, SubchannelId subChannel) {
+        if (subChannel != SubchannelId::ThreeD)
+            channelCtx.EnsureLocked();
+
         switch (subChannel) {
             case SubchannelId::ThreeD:
                 channelCtx.maxwell3D.CallMethodBatchNonInc(method, arguments);
@@ -162,8 +124,26 @@ namespace skyline::soc::gm20b {
         }
     }
 
+    void ChannelGpfifo::SendPureBatchInc(u32 method, span<u32> arguments, SubchannelId subChannel) {
+        if (subChannel == SubchannelId::ThreeD) [[likely]] {
+            channelCtx.maxwell3D.CallMethodBatchInc(method, arguments);
+            return;
+        }
+
+        // Other engines don't have enough register traffic to benefit from batching
+        for (u32 argument : arguments)
+            SendPure(method++, argument, subChannel);
+    }
+
+    void ChannelGpfifo::FlushEngineState() {
+        channelCtx.maxwell3D.FlushEngineState();
+    }
+
     void ChannelGpfifo::Process(GpEntry gpEntry) {
         if (!gpEntry.size) {
+            if (capture) [[unlikely]]
+                capture->Record(gpEntry, {});
+
             // This is a GPFIFO control entry, all control entries have a zero length and contain no pushbuffers
             switch (gpEntry.opcode) {
                 case GpEntry::Opcode::Nop:
@@ -176,195 +156,58 @@ namespace skyline::soc::gm20b {
 
         auto pushBufferMappedRanges{channelCtx.asCtx->gmmu.TranslateRange(gpEntry.Address(), gpEntry.size * sizeof(u32))};
 
-        bool pushBufferCopied{}; //!< Set by the below lambda in order to track if the pushbuffer is a copy of guest memory or not
-        auto pushBuffer{[&]() -> span<u32> {
-            if (pushBufferMappedRanges.size() == 1) {
-                return pushBufferMappedRanges.front().cast<u32>();
-            } else {
-                // Create an intermediate copy of pushbuffer data if it's split across multiple mappings
-                pushBufferData.resize(gpEntry.size);
-                channelCtx.asCtx->gmmu.Read<u32>(pushBufferData, gpEntry.Address());
-                pushBufferCopied = true;
-                return span(pushBufferData);
-            }
-        }()};
-
         bool pushbufferDirty{false};
 
         for (auto range : pushBufferMappedRanges) {
-            if (channelCtx.executor.usageTracker.dirtyIntervals.Intersect(range)) {
-                if (skipDirtyFlushes)
+            if (IsPushBufferDirty(range)) {
+                if (skipDirtyFlushes) {
                     pushbufferDirty = true;
-                else
+                } else {
+                    channelCtx.EnsureLocked();
                     channelCtx.executor.Submit({}, true);
+                }
             }
         }
 
-        // There will be at least one entry here
-        auto entry{pushBuffer.begin()};
-
-        auto getArgument{[&](){
-            return GpfifoArgument{pushBufferCopied ? *entry : 0, pushBufferCopied ? nullptr : entry.base(), pushbufferDirty};
-        }};
-
-        // Executes the current split method, returning once execution is finished or the current GpEntry has reached its end
-        auto resumeSplitMethod{[&](){
-            switch (resumeState.state) {
-                case MethodResumeState::State::Inc:
-                    while (entry != pushBuffer.end() && resumeState.remaining) {
-                        SendFull(resumeState.address++, getArgument(), resumeState.subChannel, --resumeState.remaining == 0);
-                        entry++;
-                    }
+        if (capture) [[unlikely]] {
+            // The pushbuffer is replayed in place, so every mapping it's read from needs to exist in the replay's address space
+            for (u64 address{gpEntry.Address()}, end{address + gpEntry.size * sizeof(u32)}; address < end;) {
+                auto [mapping, offset]{channelCtx.asCtx->gmmu.LookupBlock(address)};
+                if (mapping.size() <= offset)
+                    break; // The rest of the pushbuffer is unmapped
 
-                    break;
-                case MethodResumeState::State::OneInc:
-                    SendFull(resumeState.address++, getArgument(), resumeState.subChannel, --resumeState.remaining == 0);
-                    entry++;
-
-                    // After the first increment OneInc methods work the same as a NonInc method, this is needed so they can resume correctly if they are broken up by multiple GpEntries
-                    resumeState.state = MethodResumeState::State::NonInc;
-                    [[fallthrough]];
-                case MethodResumeState::State::NonInc:
-                    while (entry != pushBuffer.end() && resumeState.remaining) {
-                        SendFull(resumeState.address, getArgument(), resumeState.subChannel, --resumeState.remaining == 0);
-                        entry++;
-                    }
-
-                    break;
+                capture->RecordMapping(address - offset, mapping.size());
+                address += mapping.size() - offset;
             }
-        }};
-
-        // We've a method from a previous GpEntry that needs resuming
-        if (resumeState.remaining)
-            resumeSplitMethod();
 
-        // Process more methods if the entries are still not all used up after handling resuming
-        for (; entry != pushBuffer.end(); entry++) {
-            if (entry >= pushBuffer.end()) [[unlikely]]
-                throw exception("GPFIFO buffer overflow!"); // This should never happen
-
-            // Entries containing all zeroes is a NOP, skip over them
-            for (; *entry == 0; entry++)
-                if (entry == std::prev(pushBuffer.end()))
-                    return;
+            if (pushBufferMappedRanges.size() == 1) {
+                capture->Record(gpEntry, pushBufferMappedRanges.front().cast<u32>());
+            } else {
+                pushBufferData.resize(gpEntry.size);
+                channelCtx.asCtx->gmmu.Read<u32>(pushBufferData, gpEntry.Address());
+                capture->Record(gpEntry, pushBufferData);
+            }
+        }
 
-            PushBufferMethodHeader methodHeader{.raw = *entry};
-
-            // Needed in order to check for methods split across multiple GpEntries
-            ssize_t remainingEntries{std::distance(entry, pushBuffer.end()) - 1};
-
-            // Handles storing state and initial execution for methods that are split across multiple GpEntries
-            auto startSplitMethod{[&](auto methodState) {
-                resumeState = {
-                    .remaining = methodHeader.methodCount,
-                    .address = methodHeader.methodAddress,
-                    .subChannel = methodHeader.methodSubChannel,
-                    .state = methodState
-                };
-
-                // Skip over method header as `resumeSplitMethod` doesn't expect it to be there
-                entry++;
-
-                resumeSplitMethod();
-            }};
-
-            /**
-             * @brief Handles execution of a specific method type as specified by the State template parameter
-             */
-            auto dispatchCalls{[&]<MethodResumeState::State State> () {
-                /**
-                 * @brief Gets the offset to apply to the method address for a given dispatch loop index
-                 */
-                auto methodOffset{[] (u32 i) -> u32 {
-                    if constexpr(State == MethodResumeState::State::Inc)
-                        return i;
-                    else if constexpr (State == MethodResumeState::State::OneInc)
-                        return i ? 1 : 0;
-                    else
-                        return 0;
-                }};
-
-                constexpr u32 BatchCutoff{4}; //!< Cutoff needed to send method calls in a batch which is espcially important for UBO updates. This helps to avoid the extra overhead batching for small packets.
-                // TODO: Only batch for specific target methods like UBO updates, since normal dispatch is generally cheaper
-
-                if (remainingEntries >= methodHeader.methodCount) { [[likely]]
-                    if (methodHeader.Pure()) [[likely]] {
-                        if constexpr (State == MethodResumeState::State::NonInc) {
-                            // For pure noninc methods we can send all method calls as a span in one go
-                            if (methodHeader.methodCount > BatchCutoff) [[unlikely]] {
-                                SendPureBatchNonInc(methodHeader.methodAddress, span(&(*++entry), methodHeader.methodCount), methodHeader.methodSubChannel);
-
-                                entry += methodHeader.methodCount - 1;
-                                return false;
-                            }
-                        } else if constexpr (State == MethodResumeState::State::OneInc) {
-                            // For pure oneinc methods we can send the initial method then send the rest as a span in one go
-                            if (methodHeader.methodCount > (BatchCutoff + 1)) [[unlikely]] {
-                                SendPure(methodHeader.methodAddress, *++entry, methodHeader.methodSubChannel);
-                                SendPureBatchNonInc(methodHeader.methodAddress + 1, span((++entry).base(), methodHeader.methodCount - 1), methodHeader.methodSubChannel);
-
-                                entry += methodHeader.methodCount - 2;
-                                return false;
-                            }
-                        }
-
-                        #pragma unroll(2)
-                        for (u32 i{}; i < methodHeader.methodCount; i++)
-                            SendPure(methodHeader.methodAddress + methodOffset(i), *++entry, methodHeader.methodSubChannel);
-                    } else {
-                        // Slow path for methods that touch GPFIFO or macros
-                        for (u32 i{}; i < methodHeader.methodCount; i++) {
-                            entry++;
-                            SendFull(methodHeader.methodAddress + methodOffset(i), getArgument(), methodHeader.methodSubChannel, i == methodHeader.methodCount - 1);
-                        }
-                    }
-                } else {
-                    startSplitMethod(State);
-                    return true;
-                }
+        // Each mapping is processed in place, mappings are page aligned so they always contain a whole number of words
+        for (auto range : pushBufferMappedRanges)
+            if (pushBufferParser.Process(range.cast<u32>(), false, pushbufferDirty))
+                break;
+    }
 
-                return false;
-            }};
-
-            /**
-             * @brief Handles execution of a single method
-             * @return If the this was the final method in the current GpEntry
-             */
-            auto processMethod{[&] () -> bool {
-                if (methodHeader.secOp == PushBufferMethodHeader::SecOp::IncMethod)  [[likely]] {
-                    return dispatchCalls.operator()<MethodResumeState::State::Inc>();
-                } else if (methodHeader.secOp == PushBufferMethodHeader::SecOp::OneInc) [[likely]] {
-                    return dispatchCalls.operator()<MethodResumeState::State::OneInc>();
-                } else if (methodHeader.secOp == PushBufferMethodHeader::SecOp::ImmdDataMethod) {
-                    if (methodHeader.Pure())
-                        SendPure(methodHeader.methodAddress, methodHeader.immdData, methodHeader.methodSubChannel);
-                    else
-                        SendFull(methodHeader.methodAddress, GpfifoArgument{methodHeader.immdData}, methodHeader.methodSubChannel, true);
-
-                    return false;
-                } else if (methodHeader.secOp == PushBufferMethodHeader::SecOp::NonIncMethod) [[unlikely]] {
-                    return dispatchCalls.operator()<MethodResumeState::State::NonInc>();
-                } else if (methodHeader.secOp == PushBufferMethodHeader::SecOp::EndPbSegment) [[unlikely]] {
-                    return true;
-                } else if (methodHeader.secOp == PushBufferMethodHeader::SecOp::Grp0UseTert) {
-                    if (methodHeader.tertOp == PushBufferMethodHeader::TertOp::Grp0SetSubDevMask)
-                        return false;
-
-                    throw exception("Unsupported pushbuffer method TertOp: {}", static_cast<u8>(methodHeader.tertOp));
-                } else {
-                    throw exception("Unsupported pushbuffer method SecOp: {}", static_cast<u8>(methodHeader.secOp));
-                }
-            }};
+    bool ChannelGpfifo::IsPushBufferDirty(span<u8> range) {
+        auto &dirtyIntervals{channelCtx.executor.usageTracker.dirtyIntervals};
+        if (dirtyIntervals.GetGeneration() == cleanIntervalGeneration && cleanInterval.contains(range))
+            return false;
 
-            bool hitEnd{[&]() {
-                if (methodHeader.methodSubChannel != SubchannelId::ThreeD) [[unlikely]]
-                    channelCtx.maxwell3D.FlushEngineState(); // Flush the 3D engine state when doing any calls to other engines
-                return processMethod();
-            }()};
+        auto result{dirtyIntervals.Query(range.data())};
+        if (result.enclosed || (result.size && static_cast<size_t>(result.size) < range.size()))
+            return true;
 
-            if (hitEnd)
-                break;
-        }
+        // Cache the entire gap up to the next dirty interval (or the end of the address space if there is none) so following pushbuffers can skip the search
+        cleanIntervalGeneration = dirtyIntervals.GetGeneration();
+        cleanInterval = span<u8>{range.data(), result.size ? static_cast<size_t>(result.size) : std::numeric_limits<uintptr_t>::max() - reinterpret_cast<uintptr_t>(range.data())};
+        return false;
     }
 
     void ChannelGpfifo::Run() {
@@ -373,24 +216,24 @@ namespace skyline::soc::gm20b {
         AsyncLogger::UpdateTag();
 
         try {
-            bool channelLocked{};
-
-            gpEntries.Process([this, &channelLocked](GpEntry gpEntry) {
+            // The channel lock is acquired lazily by anything touching shared state during processing and kept across GpEntries until it's handed off or there's nothing left to process
+            gpEntries.Process([this](GpEntry gpEntry) {
                 LOGD("Processing pushbuffer: 0x{:X}, Size: 0x{:X}", gpEntry.Address(), +gpEntry.size);
 
-                if (!channelLocked) {
-                    channelCtx.Lock();
-                    channelLocked = true;
-                }
-
                 Process(gpEntry);
-            }, [this, &channelLocked]() {
+
+                // Hand the lock to any channel that's waiting on it once our recorded work can be submitted without splitting a batch, or if it has been waiting for too long
+                if (channelCtx.ShouldYieldLock()) {
+                    TRACE_EVENT("gpu", "ChannelContext::YieldLock", "channel", channelCtx.id);
+                    channelCtx.executor.Submit();
+                    channelCtx.Unlock();
+                }
+            }, [this]() {
                 // If we run out of GpEntries to process ensure we submit any remaining GPU work before waiting for more to arrive
                 LOGD("Finished processing pushbuffer batch");
-                if (channelLocked) {
+                if (channelCtx.locked) {
                     channelCtx.executor.Submit();
                     channelCtx.Unlock();
-                    channelLocked = false;
                 }
             });
         } catch (const signal::SignalException &e) {
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2023 Strato Team and Contributors (https://github.com/strato-emu/)
+
+#include <filesystem>
+#include "gpfifo_capture.h"
+
+namespace skyline::soc::gm20b {
+    GpfifoCaptureWriter::GpfifoCaptureWriter(const std::string &path) {
+        std::filesystem::create_directories(std::filesystem::path{path}.parent_path());
+        stream.open(path, std::ios::binary | std::ios::trunc);
+        if (stream.fail())
+            throw exception("Failed to create GPFIFO capture file: {}", path);
+
+        GpfifoCaptureFileHeader header{};
+        stream.write(reinterpret_cast<const char *>(&header), sizeof(GpfifoCaptureFileHeader));
+    }
+
+    void GpfifoCaptureWriter::Record(GpEntry gpEntry, span<u32> pushBuffer) {
+        GpfifoCaptureRecordHeader header{
+            .type = GpfifoCaptureRecordHeader::Type::GpEntry,
+            .wordCount = static_cast<u32>(pushBuffer.size()),
+            .value = util::BitCast<u64>(gpEntry),
+        };
+        stream.write(reinterpret_cast<const char *>(&header), sizeof(GpfifoCaptureRecordHeader));
+        stream.write(reinterpret_cast<const char *>(pushBuffer.data()), static_cast<std::streamsize>(pushBuffer.size_bytes()));
+    }
+
+    void GpfifoCaptureWriter::RecordMapping(u64 gpuAddress, u64 size) {
+        auto [it, inserted]{recordedMappings.try_emplace(gpuAddress, size)};
+        if (!inserted) {
+            if (it->second == size)
+                return;
+            it->second = size;
+        }
+
+        GpfifoCaptureRecordHeader header{
+            .type = GpfifoCaptureRecordHeader::Type::Mapping,
+            .value = gpuAddress,
+            .size = size,
+        };
+        stream.write(reinterpret_cast<const char *>(&header), sizeof(GpfifoCaptureRecordHeader));
+    }
+
+    GpfifoCaptureReader::GpfifoCaptureReader(const std::string &path) {
+        std::ifstream stream{path, std::ios::binary};
+        if (stream.fail())
+            throw exception("Failed to open GPFIFO capture file: {}", path);
+
+        GpfifoCaptureFileHeader fileHeader{};
+        stream.read(reinterpret_cast<char *>(&fileHeader), sizeof(GpfifoCaptureFileHeader));
+        if (stream.fail() || fileHeader.magic != GpfifoCaptureFileHeader::Magic || fileHeader.version != GpfifoCaptureFileHeader::Version)
+            throw exception("Invalid GPFIFO capture file: {}", path);
+
+        std::vector<Mapping> mappings;
+        while (stream.peek() != EOF) {
+            GpfifoCaptureRecordHeader header{};
+            stream.read(reinterpret_cast<char *>(&header), sizeof(GpfifoCaptureRecordHeader));
+            if (stream.fail())
+                throw exception("Truncated GPFIFO capture record header: {}", entries.size());
+
+            if (header.type == GpfifoCaptureRecordHeader::Type::Mapping) {
+                mappings.push_back(Mapping{header.value, header.size});
+                continue;
+            } else if (header.type != GpfifoCaptureRecordHeader::Type::GpEntry) {
+                throw exception("Invalid GPFIFO capture record type: {}", static_cast<u32>(header.type));
+            }
+
+            std::vector<u32> pushBuffer(header.wordCount);
+            stream.read(reinterpret_cast<char *>(pushBuffer.data()), static_cast<std::streamsize>(pushBuffer.size() * sizeof(u32)));
+            if (stream.fail())
+                throw exception("Truncated GPFIFO capture entry pushbuffer: {}", entries.size());
+
+            wordCount += pushBuffer.size();
+            entries.push_back(Entry{util::BitCast<GpEntry>(header.value), std::move(pushBuffer), std::move(mappings)});
+            mappings.clear();
+        }
+    }
+}
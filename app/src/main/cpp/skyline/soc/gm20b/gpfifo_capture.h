@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2023 Strato Team and Contributors (https://github.com/strato-emu/)
+
+#pragma once
+
+#include <fstream>
+#include "pushbuffer.h"
+
+namespace skyline::soc::gm20b {
+    /**
+     * @brief The header at the start of a GPFIFO capture file, followed by a sequence of records each starting with a GpfifoCaptureRecordHeader
+     */
+    struct GpfifoCaptureFileHeader {
+        static constexpr u32 Magic{util::MakeMagic<u32>("GPFC")}; //!< The magic value used to identify a GPFIFO capture file
+        static constexpr u32 Version{2}; //!< The version of the GPFIFO capture file format, MUST be incremented for any format changes
+
+        u32 magic{Magic};
+        u32 version{Version};
+    };
+
+    struct GpfifoCaptureRecordHeader {
+        enum class Type : u32 {
+            GpEntry = 0, //!< A GpEntry followed by `wordCount` words of its pushbuffer
+            Mapping = 1, //!< A GMMU mapping which a following GpEntry is read from, there's no data following this record
+        } type;
+        u32 wordCount; //!< The amount of pushbuffer words following the header, this is zero for control entries and mappings
+        u64 value; //!< The raw GpEntry as submitted by the guest or the GPU VA of the mapping
+        u64 size; //!< The size of the mapping in bytes, this is zero for GpEntry records
+    };
+    static_assert(sizeof(GpfifoCaptureRecordHeader) == 0x18);
+
+    /**
+     * @brief Records all GpEntries processed by a channel alongside a copy of their pushbuffer contents and the GMMU mappings they are in, this allows the GPU frontend to be replayed without the guest
+     * @note The contents of the mappings aren't captured beyond the pushbuffers in them, the replay tool maps zero-filled memory in their place
+     */
+    class GpfifoCaptureWriter {
+      private:
+        std::ofstream stream;
+        std::map<u64, u64> recordedMappings; //!< A map from the GPU VA of all mappings in the capture to their size, these are only recorded again if they change
+
+      public:
+        GpfifoCaptureWriter(const std::string &path);
+
+        /**
+         * @brief Appends a GpEntry with the contents of its pushbuffer to the capture
+         */
+        void Record(GpEntry gpEntry, span<u32> pushBuffer);
+
+        /**
+         * @brief Appends a GMMU mapping to the capture if it wasn't already recorded with the same size
+         * @note This must be called for all mappings a GpEntry's pushbuffer is in prior to recording the GpEntry
+         */
+        void RecordMapping(u64 gpuAddress, u64 size);
+    };
+
+    /**
+     * @brief Loads an entire GPFIFO capture into memory so it can be replayed without any I/O
+     */
+    class GpfifoCaptureReader {
+      public:
+        struct Mapping {
+            u64 gpuAddress;
+            u64 size;
+        };
+
+        struct Entry {
+            GpEntry gpEntry;
+            std::vector<u32> pushBuffer;
+            std::vector<Mapping> mappings; //!< The mappings which were recorded prior to this entry and after the previous one
+        };
+
+        std::vector<Entry> entries;
+        size_t wordCount{}; //!< The total amount of pushbuffer words in all entries
+
+        /**
+         * @note An exception will be thrown if the capture is invalid or truncated
+         */
+        GpfifoCaptureReader(const std::string &path);
+    };
+}
@@ -0,0 +1,345 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2023 Strato Team and Contributors (https://github.com/strato-emu/)
+
+#include <common/utils.h>
+#include "soc/gm20b/engines/engine.h"
+#include "macro_decoded_interpreter.h"
+
+namespace skyline::soc::gm20b::engine {
+    struct MacroDecodedInterpreter::Handlers {
+        using AssignmentOperation = Opcode::AssignmentOperation;
+        using AluOperation = Opcode::AluOperation;
+
+        static void Send(Context &ctx, u32 argument) {
+            ctx.engine->CallMethodFromMacro(ctx.methodAddress.address, argument);
+            ctx.methodAddress.address += ctx.methodAddress.increment;
+        }
+
+        template<AssignmentOperation Operation>
+        static void Assign(Context &ctx, u8 reg, u32 result) {
+            if constexpr (Operation == AssignmentOperation::IgnoreAndFetch) {
+                ctx.registers[reg] = *ctx.argument++;
+            } else if constexpr (Operation == AssignmentOperation::Move) {
+                ctx.registers[reg] = result;
+            } else if constexpr (Operation == AssignmentOperation::MoveAndSetMethod) {
+                ctx.registers[reg] = result;
+                ctx.methodAddress.raw = result;
+            } else if constexpr (Operation == AssignmentOperation::FetchAndSend) {
+                ctx.registers[reg] = *ctx.argument++;
+                Send(ctx, result);
+            } else if constexpr (Operation == AssignmentOperation::MoveAndSend) {
+                ctx.registers[reg] = result;
+                Send(ctx, result);
+            } else if constexpr (Operation == AssignmentOperation::FetchAndSetMethod) {
+                ctx.registers[reg] = *ctx.argument++;
+                ctx.methodAddress.raw = result;
+            } else if constexpr (Operation == AssignmentOperation::MoveAndSetMethodThenFetchAndSend) {
+                ctx.registers[reg] = result;
+                ctx.methodAddress.raw = result;
+                Send(ctx, *ctx.argument++);
+            } else if constexpr (Operation == AssignmentOperation::MoveAndSetMethodThenSendHigh) {
+                ctx.registers[reg] = result;
+                ctx.methodAddress.raw = result;
+                Send(ctx, ctx.methodAddress.increment);
+            }
+        }
+
+        template<AluOperation Operation>
+        static u32 Alu(Context &ctx, u32 srcA, u32 srcB) {
+            if constexpr (Operation == AluOperation::Add) {
+                u64 result{static_cast<u64>(srcA) + srcB};
+                ctx.carryFlag = result >> 32;
+                return static_cast<u32>(result);
+            } else if constexpr (Operation == AluOperation::AddWithCarry) {
+                u64 result{static_cast<u64>(srcA) + srcB + ctx.carryFlag};
+                ctx.carryFlag = result >> 32;
+                return static_cast<u32>(result);
+            } else if constexpr (Operation == AluOperation::Subtract) {
+                u64 result{static_cast<u64>(srcA) - srcB};
+                ctx.carryFlag = result & 0xFFFFFFFF;
+                return static_cast<u32>(result);
+            } else if constexpr (Operation == AluOperation::SubtractWithBorrow) {
+                u64 result{static_cast<u64>(srcA) - srcB - !ctx.carryFlag};
+                ctx.carryFlag = result & 0xFFFFFFFF;
+                return static_cast<u32>(result);
+            } else if constexpr (Operation == AluOperation::BitwiseXor) {
+                return srcA ^ srcB;
+            } else if constexpr (Operation == AluOperation::BitwiseOr) {
+                return srcA | srcB;
+            } else if constexpr (Operation == AluOperation::BitwiseAnd) {
+                return srcA & srcB;
+            } else if constexpr (Operation == AluOperation::BitwiseAndNot) {
+                return srcA & ~srcB;
+            } else if constexpr (Operation == AluOperation::BitwiseNand) {
+                return ~(srcA & srcB);
+            }
+        }
+
+        template<AluOperation AluOp>
+        struct AluRegister {
+            template<AssignmentOperation AssignOp>
+            struct Assigning {
+                static void Execute(Context &ctx, const Instruction &instruction) {
+                    u32 result{Alu<AluOp>(ctx, ctx.registers[instruction.srcA], ctx.registers[instruction.srcB])};
+                    Assign<AssignOp>(ctx, instruction.dest, result);
+                }
+            };
+        };
+
+        template<AssignmentOperation AssignOp>
+        struct AddImmediate {
+            static void Execute(Context &ctx, const Instruction &instruction) {
+                Assign<AssignOp>(ctx, instruction.dest, static_cast<u32>(static_cast<i32>(ctx.registers[instruction.srcA]) + instruction.immediate));
+            }
+        };
+
+        template<AssignmentOperation AssignOp>
+        struct BitfieldReplace {
+            static void Execute(Context &ctx, const Instruction &instruction) {
+                u32 src{(ctx.registers[instruction.srcB] >> instruction.srcBit) & instruction.mask};
+                u32 dest{ctx.registers[instruction.srcA] & ~(instruction.mask << instruction.destBit)};
+                Assign<AssignOp>(ctx, instruction.dest, dest | (src << instruction.destBit));
+            }
+        };
+
+        template<AssignmentOperation AssignOp>
+        struct BitfieldExtractShiftLeftImmediate {
+            static void Execute(Context &ctx, const Instruction &instruction) {
+                u32 src{ctx.registers[instruction.srcB]};
+                u32 dest{ctx.registers[instruction.srcA]};
+                Assign<AssignOp>(ctx, instruction.dest, ((src >> dest) & instruction.mask) << instruction.destBit);
+            }
+        };
+
+        template<AssignmentOperation AssignOp>
+        struct BitfieldExtractShiftLeftRegister {
+            static void Execute(Context &ctx, const Instruction &instruction) {
+                u32 src{ctx.registers[instruction.srcB]};
+                u32 dest{ctx.registers[instruction.srcA]};
+                Assign<AssignOp>(ctx, instruction.dest, ((src >> instruction.srcBit) & instruction.mask) << dest);
+            }
+        };
+
+        template<AssignmentOperation AssignOp>
+        struct ReadImmediate {
+            static void Execute(Context &ctx, const Instruction &instruction) {
+                u32 result{ctx.engine->ReadMethodFromMacro(static_cast<u32>(static_cast<i32>(ctx.registers[instruction.srcA]) + instruction.immediate))};
+                Assign<AssignOp>(ctx, instruction.dest, result);
+            }
+        };
+
+        static void BranchInDelaySlot(Context &, const Instruction &) {
+            throw exception("Cannot branch while inside a delay slot");
+        }
+
+        static void UnknownOperation(Context &, const Instruction &instruction) {
+            throw exception("Unknown MME opcode encountered: 0x{:08X}", instruction.raw);
+        }
+
+        /**
+         * @return The handler for the supplied operation template specialised for the supplied assignment operation
+         */
+        template<template<AssignmentOperation> typename Operation>
+        static Handler SelectAssignment(AssignmentOperation assignment) {
+            switch (assignment) {
+                case AssignmentOperation::IgnoreAndFetch:
+                    return &Operation<AssignmentOperation::IgnoreAndFetch>::Execute;
+                case AssignmentOperation::Move:
+                    return &Operation<AssignmentOperation::Move>::Execute;
+                case AssignmentOperation::MoveAndSetMethod:
+                    return &Operation<AssignmentOperation::MoveAndSetMethod>::Execute;
+                case AssignmentOperation::FetchAndSend:
+                    return &Operation<AssignmentOperation::FetchAndSend>::Execute;
+                case AssignmentOperation::MoveAndSend:
+                    return &Operation<AssignmentOperation::MoveAndSend>::Execute;
+                case AssignmentOperation::FetchAndSetMethod:
+                    return &Operation<AssignmentOperation::FetchAndSetMethod>::Execute;
+                case AssignmentOperation::MoveAndSetMethodThenFetchAndSend:
+                    return &Operation<AssignmentOperation::MoveAndSetMethodThenFetchAndSend>::Execute;
+                case AssignmentOperation::MoveAndSetMethodThenSendHigh:
+                    return &Operation<AssignmentOperation::MoveAndSetMethodThenSendHigh>::Execute;
+            }
+        }
+
+        static Handler SelectAlu(AluOperation alu, AssignmentOperation assignment) {
+            #define ALU_CASE(operation) \
+                case AluOperation::operation: \
+                    return SelectAssignment<AluRegister<AluOperation::operation>::template Assigning>(assignment);
+
+            switch (alu) {
+                ALU_CASE(Add)
+                ALU_CASE(AddWithCarry)
+                ALU_CASE(Subtract)
+                ALU_CASE(SubtractWithBorrow)
+                ALU_CASE(BitwiseXor)
+                ALU_CASE(BitwiseOr)
+                ALU_CASE(BitwiseAnd)
+                ALU_CASE(BitwiseAndNot)
+                ALU_CASE(BitwiseNand)
+                default:
+                    return &UnknownOperation;
+            }
+
+            #undef ALU_CASE
+        }
+    };
+
+    MacroDecodedInterpreter::MacroDecodedInterpreter(span<u32> macroCode) : macroCode{macroCode} {}
+
+    MacroDecodedInterpreter::Instruction MacroDecodedInterpreter::Translate(Opcode opcode) {
+        Instruction instruction{
+            .dest = opcode.dest == 0 ? SinkRegister : opcode.dest,
+            .srcA = opcode.srcA,
+            .srcB = opcode.srcB,
+            .srcBit = opcode.bitfield.srcBit,
+            .destBit = opcode.bitfield.destBit,
+            .mask = opcode.bitfield.GetMask(),
+            .immediate = opcode.immediate,
+            .exit = static_cast<bool>(opcode.exit),
+            .raw = opcode.raw,
+        };
+
+        auto assignment{opcode.assignmentOperation};
+        switch (opcode.operation) {
+            case Opcode::Operation::AluRegister:
+                instruction.handler = Handlers::SelectAlu(opcode.aluOperation, assignment);
+                break;
+
+            case Opcode::Operation::AddImmediate:
+                instruction.handler = Handlers::SelectAssignment<Handlers::AddImmediate>(assignment);
+                break;
+
+            case Opcode::Operation::BitfieldReplace:
+                instruction.handler = Handlers::SelectAssignment<Handlers::BitfieldReplace>(assignment);
+                break;
+
+            case Opcode::Operation::BitfieldExtractShiftLeftImmediate:
+                instruction.handler = Handlers::SelectAssignment<Handlers::BitfieldExtractShiftLeftImmediate>(assignment);
+                break;
+
+            case Opcode::Operation::BitfieldExtractShiftLeftRegister:
+                instruction.handler = Handlers::SelectAssignment<Handlers::BitfieldExtractShiftLeftRegister>(assignment);
+                break;
+
+            case Opcode::Operation::ReadImmediate:
+                instruction.handler = Handlers::SelectAssignment<Handlers::ReadImmediate>(assignment);
+                break;
+
+            case Opcode::Operation::Branch:
+                instruction.handler = &Handlers::BranchInDelaySlot;
+                instruction.branch = true;
+                instruction.branchIfZero = opcode.branchCondition == Opcode::BranchCondition::Zero;
+                instruction.noDelay = opcode.noDelay;
+                break;
+
+            default:
+                instruction.handler = &Handlers::UnknownOperation;
+                break;
+        }
+
+        return instruction;
+    }
+
+    std::shared_ptr<MacroDecodedInterpreter::Program> MacroDecodedInterpreter::Decode(size_t offset) {
+        if (offset >= macroCode.size())
+            return nullptr;
+
+        // Discover all instructions reachable from the entrypoint, macros don't have an explicit size so control flow needs to be followed to determine it
+        std::vector<bool> visited(macroCode.size());
+        std::vector<size_t> pending{offset};
+        size_t begin{offset}, end{offset + 1};
+
+        auto reach{[&](i64 index, bool followFlow) {
+            if (index < 0 || static_cast<size_t>(index) >= macroCode.size())
+                return false;
+
+            begin = std::min(begin, static_cast<size_t>(index));
+            end = std::max(end, static_cast<size_t>(index) + 1);
+            if (followFlow && !visited[static_cast<size_t>(index)]) {
+                visited[static_cast<size_t>(index)] = true;
+                pending.push_back(static_cast<size_t>(index));
+            }
+            return true;
+        }};
+
+        visited[offset] = true;
+        while (!pending.empty()) {
+            size_t index{pending.back()};
+            pending.pop_back();
+
+            Opcode opcode{.raw = macroCode[index]};
+            auto next{static_cast<i64>(index) + 1};
+            if (opcode.operation == Opcode::Operation::Branch) {
+                // A branch might be taken or fall through (or exit if it isn't taken), the following instruction is required in all cases as a delay slot or the fallthrough
+                if (!reach(static_cast<i64>(index) + opcode.immediate, true) || !reach(next, !opcode.exit))
+                    return nullptr;
+            } else if (opcode.exit) {
+                // Exits have a delay slot that is executed without following its control flow
+                if (!reach(next, false))
+                    return nullptr;
+            } else if (!reach(next, true)) {
+                return nullptr;
+            }
+        }
+
+        auto code{macroCode.subspan(begin, end - begin)};
+        u64 hash{XXH64(code.data(), code.size_bytes(), offset - begin)};
+
+        auto &program{programs[hash]};
+        if (program && program->entry == offset - begin && std::equal(program->code.begin(), program->code.end(), code.begin(), code.end()))
+            return program;
+
+        if (programs.size() > MaxCachedPrograms) {
+            programs.clear();
+            return Decode(offset);
+        }
+
+        program = std::make_shared<Program>();
+        program->code.assign(code.begin(), code.end());
+        program->entry = static_cast<u32>(offset - begin);
+        program->instructions.reserve(code.size());
+        for (size_t index{}; index < code.size(); index++) {
+            Opcode opcode{.raw = code[index]};
+            auto &instruction{program->instructions.emplace_back(Translate(opcode))};
+            if (instruction.branch)
+                instruction.target = static_cast<u32>(static_cast<i64>(index) + opcode.immediate);
+        }
+
+        return program;
+    }
+
+    void MacroDecodedInterpreter::Execute(const Program &program, span<u32> args, MacroEngineBase *targetEngine) {
+        Context ctx{
+            .engine = targetEngine,
+            .argument = args.data(),
+        };
+
+        // The first argument is stored in register 1
+        ctx.registers[1] = *ctx.argument++;
+
+        const Instruction *instructions{program.instructions.data()};
+        u32 index{program.entry};
+        while (true) {
+            const auto &instruction{instructions[index]};
+            if (instruction.branch) {
+                u32 value{ctx.registers[instruction.srcA]};
+                if ((value == 0) == instruction.branchIfZero) {
+                    if (!instruction.noDelay)
+                        ExecuteDelaySlot(ctx, instructions[index + 1]);
+
+                    index = instruction.target;
+                    continue;
+                }
+            } else {
+                instruction.handler(ctx, instruction);
+            }
+
+            if (instruction.exit) {
+                ExecuteDelaySlot(ctx, instructions[index + 1]);
+                return;
+            }
+
+            index++;
+        }
+    }
+}
@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2023 Strato Team and Contributors (https://github.com/strato-emu/)
+
+#pragma once
+
+#include <common.h>
+#include "macro_interpreter.h"
+
+namespace skyline::soc::gm20b::engine {
+    /**
+     * @brief The MacroDecodedInterpreter class decodes macros ahead of time into a sequence of instructions with handlers specialised for their operation, this avoids decoding every opcode and its bitfields on every invocation as done by the MacroInterpreter
+     * @note No host code is emitted, the handlers are ordinary functions selected at decode time
+     * @note Decoded programs are position-independent and cached by the hash of their code, so re-uploads of identical macros don't need to be decoded again
+     * @note The MacroInterpreter is the reference implementation, any macro that cannot be decoded will fall back to it
+     */
+    class MacroDecodedInterpreter {
+      private:
+        using Opcode = MacroInterpreter::Opcode;
+        using MethodAddress = MacroInterpreter::MethodAddress;
+
+        static constexpr u8 SinkRegister{8}; //!< Writes to register 0 are redirected to this register at decode time so they don't need to be checked for at runtime
+
+        /**
+         * @brief The state of a single macro execution
+         */
+        struct Context {
+            MacroEngineBase *engine;
+            std::array<u32, 9> registers; //!< The 8 GPRs followed by the sink register
+            const u32 *argument;
+            MethodAddress methodAddress;
+            bool carryFlag;
+        };
+
+        struct Instruction;
+
+        /**
+         * @brief A handler which performs the operation and assignment of a single instruction
+         */
+        using Handler = void (*)(Context &ctx, const Instruction &instruction);
+
+        struct Instruction {
+            Handler handler; //!< Performs the operation of the instruction, for branches this throws as they can only be executed in a delay slot
+            u8 dest;
+            u8 srcA;
+            u8 srcB;
+            u8 srcBit;
+            u8 destBit;
+            u32 mask; //!< The bitfield mask of the instruction
+            i32 immediate;
+            bool branch;
+            bool branchIfZero;
+            bool noDelay;
+            bool exit;
+            u32 target; //!< The index of the branch target instruction in the program
+            u32 raw; //!< The undecoded opcode, this is only used for error reporting
+        };
+
+      public:
+        /**
+         * @brief A decoded macro with all instructions reachable from its entrypoint
+         */
+        struct Program {
+            std::vector<u32> code; //!< A copy of the code the program was decoded from, used to verify cache lookups
+            std::vector<Instruction> instructions;
+            u32 entry; //!< The index of the first instruction to execute in the program
+        };
+
+      private:
+        span<u32> macroCode; //!< Span pointing to the global macro code memory
+        std::unordered_map<u64, std::shared_ptr<Program>> programs; //!< A map from the hash of a macro's code to its decoded program
+
+        struct Handlers; //!< The specialised handlers for all operations, defined in the implementation
+
+        /**
+         * @brief Translates a single opcode into an instruction with a specialised handler
+         */
+        static Instruction Translate(Opcode opcode);
+
+        /**
+         * @brief Executes an instruction in a delay slot, this doesn't handle any control flow
+         */
+        static void ExecuteDelaySlot(Context &ctx, const Instruction &instruction) {
+            instruction.handler(ctx, instruction);
+        }
+
+      public:
+        static constexpr size_t MaxCachedPrograms{0x400}; //!< The maximum amount of programs that will be cached before the cache is cleared
+
+        MacroDecodedInterpreter(span<u32> macroCode);
+
+        /**
+         * @brief Decodes the macro at the supplied offset or looks up an existing decoded program for identical code
+         * @return The decoded program or nullptr if the macro cannot be decoded and should be interpreted instead
+         */
+        std::shared_ptr<Program> Decode(size_t offset);
+
+        /**
+         * @brief Executes a decoded macro with the given arguments targeting the specified engine
+         */
+        void Execute(const Program &program, span<u32> args, MacroEngineBase *targetEngine);
+    };
+}
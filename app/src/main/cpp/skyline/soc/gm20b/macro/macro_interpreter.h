@@ -13,6 +13,8 @@ namespace skyline::soc::gm20b::engine {
      */
     class MacroInterpreter {
       private:
+        friend class MacroDecodedInterpreter;
+
         #pragma pack(push, 1)
         union Opcode {
             u32 raw;
@@ -87,6 +87,7 @@ namespace skyline::soc::gm20b {
 
         if (invalidatePending) {
             macroHleFunctions.fill({});
+            macroPrograms.fill({});
             invalidatePending = false;
         }
 
@@ -105,6 +106,16 @@ namespace skyline::soc::gm20b {
 
         argumentStorage.resize(args.size());
         std::transform(args.begin(), args.end(), argumentStorage.begin(), [](GpfifoArgument arg) { return *arg; });
-        macroInterpreter.Execute(offset, argumentStorage, targetEngine);
+
+        auto &programEntry{macroPrograms[position]};
+        if (!programEntry.valid) {
+            programEntry.program = macroDecodedInterpreter.Decode(offset);
+            programEntry.valid = true;
+        }
+
+        if (programEntry.program)
+            macroDecodedInterpreter.Execute(*programEntry.program, argumentStorage, targetEngine);
+        else
+            macroInterpreter.Execute(offset, argumentStorage, targetEngine);
     }
 }
@@ -5,6 +5,7 @@
 
 #include <common.h>
 #include "macro_interpreter.h"
+#include "macro_decoded_interpreter.h"
 
 namespace skyline::soc::gm20b {
     /**
@@ -37,23 +38,30 @@ namespace skyline::soc::gm20b {
             bool valid;
         };
 
-        engine::MacroInterpreter macroInterpreter; //!< The macro interpreter for handling 3D/2D macros
+        struct MacroProgramEntry {
+            std::shared_ptr<engine::MacroDecodedInterpreter::Program> program; //!< The decoded program, this is nullptr if the macro couldn't be decoded
+            bool valid;
+        };
+
+        engine::MacroInterpreter macroInterpreter; //!< The macro interpreter for handling 3D/2D macros, used as a fallback for macros that cannot be decoded
+        engine::MacroDecodedInterpreter macroDecodedInterpreter; //!< The interpreter for executing pre-decoded 3D/2D macros
         std::array<u32, 0x2000> macroCode{}; //!< Stores GPU macros, writes to it will wraparound on overflow
         std::array<size_t, 0x80> macroPositions{}; //!< The positions of each individual macro in macro code memory, there can be a maximum of 0x80 macros at any one time
         std::array<MacroHleEntry, 0x80> macroHleFunctions{}; //!< The HLE functions for each macro position, used to optionally override the interpreter
+        std::array<MacroProgramEntry, 0x80> macroPrograms{}; //!< The decoded programs for each macro position
         std::vector<u32> argumentStorage; //!< Storage for the macro arguments during execution using the interpreter
 
         bool invalidatePending{};
 
-        MacroState() : macroInterpreter{macroCode} {}
+        MacroState() : macroInterpreter{macroCode}, macroDecodedInterpreter{macroCode} {}
 
         /**
-         * @brief Invalidates the HLE function cache
+         * @brief Invalidates the HLE function and decoded program caches
          */
         void Invalidate();
 
         /**
-         * @brief Executes a macro at a given position, this can either be a HLE function or the interpreter
+         * @brief Executes a macro at a given position, this can either be a HLE function, a decoded program or the interpreter
          */
         void Execute(u32 position, span<GpfifoArgument> args, engine::MacroEngineBase *targetEngine, const std::function<void(void)> &flushCallback);
     };
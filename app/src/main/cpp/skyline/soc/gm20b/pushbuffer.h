@@ -0,0 +1,389 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
+
+#pragma once
+
+#include <soc/gm20b/macro/macro_state.h>
+#include "engines/gpfifo.h"
+
+namespace skyline::soc::gm20b {
+    /**
+     * @brief Mapping of subchannel names to their corresponding subchannel IDs
+     */
+    enum class SubchannelId : u8 {
+        ThreeD = 0,
+        Compute = 1,
+        Inline2Mem = 2,
+        TwoD = 3,
+        Copy = 4,
+        Software0 = 5,
+        Software1 = 6,
+        Software2 = 7,
+    };
+
+    /**
+     * @brief A GPFIFO entry as submitted through 'SubmitGpfifo'
+     * @url https://nvidia.github.io/open-gpu-doc/manuals/volta/gv100/dev_pbdma.ref.txt
+     * @url https://github.com/NVIDIA/open-gpu-doc/blob/ab27fc22db5de0d02a4cabe08e555663b62db4d4/classes/host/clb06f.h#L155
+     */
+    struct GpEntry {
+        enum class Fetch : u8 {
+            Unconditional = 0,
+            Conditional = 1,
+        };
+
+        union {
+            u32 entry0{};
+
+            struct {
+                Fetch fetch : 1;
+                u8 _pad_ : 1;
+                u32 get : 30;
+            };
+        };
+
+        enum class Opcode : u8 {
+            Nop = 0,
+            Illegal = 1,
+            Crc = 2,
+            PbCrc = 3,
+        };
+
+        enum class Priv : u8 {
+            User = 0,
+            Kernel = 1,
+        };
+
+        enum class Level : u8 {
+            Main = 0,
+            Subroutine = 1,
+        };
+
+        enum class Sync : u8 {
+            Proceed = 0,
+            Wait = 1,
+        };
+
+        union {
+            u32 entry1{};
+
+            struct {
+                union {
+                    u8 getHi;
+                    Opcode opcode;
+                };
+
+                Priv priv : 1;
+                Level level : 1;
+                u32 size : 21;
+                Sync sync : 1;
+            };
+        };
+
+        constexpr GpEntry(u64 gpuAddress, u32 pSize) {
+            getHi = static_cast<u8>(gpuAddress >> 32);
+            get = static_cast<u32>(gpuAddress >> 2);
+            size = pSize;
+        }
+
+        constexpr u64 Address() const {
+            return (static_cast<u64>(getHi) << 32) | (static_cast<u64>(get) << 2);
+        }
+    };
+    static_assert(sizeof(GpEntry) == sizeof(u64));
+
+    /**
+     * @brief A single pushbuffer method header that describes a compressed method sequence
+     * @url https://github.com/NVIDIA/open-gpu-doc/blob/ab27fc22db5de0d02a4cabe08e555663b62db4d4/manuals/volta/gv100/dev_ram.ref.txt#L850
+     * @url https://github.com/NVIDIA/open-gpu-doc/blob/ab27fc22db5de0d02a4cabe08e555663b62db4d4/classes/host/clb06f.h#L179
+     */
+    union PushBufferMethodHeader {
+        u32 raw;
+
+        enum class TertOp : u8 {
+            Grp0IncMethod = 0,
+            Grp0SetSubDevMask = 1,
+            Grp0StoreSubDevMask = 2,
+            Grp0UseSubDevMask = 3,
+            Grp2NonIncMethod = 0,
+        };
+
+        enum class SecOp : u8 {
+            Grp0UseTert = 0,
+            IncMethod = 1,
+            Grp2UseTert = 2,
+            NonIncMethod = 3,
+            ImmdDataMethod = 4,
+            OneInc = 5,
+            Reserved6 = 6,
+            EndPbSegment = 7,
+        };
+
+        u16 methodAddress : 12;
+        struct {
+            u8 _pad0_ : 4;
+            u16 subDeviceMask : 12;
+        };
+
+        struct {
+            u16 _pad1_ : 13;
+            SubchannelId methodSubChannel : 3;
+            union {
+                TertOp tertOp : 3;
+                u16 methodCount : 13;
+                u16 immdData : 13;
+            };
+        };
+
+        struct {
+            u32 _pad2_ : 29;
+            SecOp secOp : 3;
+        };
+
+        /**
+         * @brief Checks if a method is 'pure' i.e. does not touch macro or GPFIFO methods
+         */
+        bool Pure() const {
+            u32 size{[&]() -> u32  {
+                switch (secOp) {
+                    case SecOp::NonIncMethod:
+                    case SecOp::ImmdDataMethod:
+                        return 0;
+                    case SecOp::OneInc:
+                        return 1;
+                    default:
+                        return methodCount;
+                }
+            }()};
+
+            u32 end{static_cast<u32>(methodAddress + size)};
+            return end < engine::EngineMethodsEnd && methodAddress >= engine::GPFIFO::RegisterCount;
+        }
+    };
+    static_assert(sizeof(PushBufferMethodHeader) == sizeof(u32));
+
+    /**
+     * @brief Holds the required state in order to resume a method started in one pushbuffer in the next one
+     * @note This is needed as games (especially OpenGL ones) can split method entries over multiple GpEntries
+     */
+    struct MethodResumeState {
+        u32 remaining; //!< The number of entries left to handle until the method is finished
+        u32 address; //!< The method address in the GPU block specified by `subchannel` that is the target of the command
+        SubchannelId subChannel;
+
+        /**
+         * @brief This is a simplified version of the full method type enum
+         */
+        enum class State : u8 {
+            NonInc,
+            Inc,
+            OneInc //!< Will be switched to NonInc after the first call
+        } state; //!< The type of method to resume
+    };
+
+    /**
+     * @brief Parses the methods in pushbuffers and dispatches them, this holds the state of methods which are split across pushbuffers
+     * @tparam Dispatcher The type which the methods are dispatched to, this must implement SendFull, SendPure, SendPureBatchNonInc, SendPureBatchInc and FlushEngineState with the same semantics as ChannelGpfifo
+     * @note This is separate from ChannelGpfifo so that pushbuffers can be parsed without a channel, such as when replaying a capture offline
+     */
+    template<typename Dispatcher>
+    class PushBufferParser {
+      private:
+        Dispatcher &dispatcher;
+        MethodResumeState resumeState{};
+
+      public:
+        PushBufferParser(Dispatcher &dispatcher) : dispatcher{dispatcher} {}
+
+        /**
+         * @brief Processes the methods in a pushbuffer that has already been fetched from guest memory
+         * @param pushBufferCopied If the pushbuffer is a copy of guest memory rather than a direct mapping of it
+         * @param pushBufferDirty If the pushbuffer was GPU dirty when it was fetched
+         * @return If an end of pushbuffer segment method was encountered and any following pushbuffer contents should be ignored
+         */
+        bool Process(span<u32> pushBuffer, bool pushBufferCopied, bool pushBufferDirty) {
+            // There will be at least one entry here
+            auto entry{pushBuffer.begin()};
+
+            auto getArgument{[&](){
+                return GpfifoArgument{pushBufferCopied ? *entry : 0, pushBufferCopied ? nullptr : entry.base(), pushBufferDirty};
+            }};
+
+            // Executes the current split method, returning once execution is finished or the current GpEntry has reached its end
+            auto resumeSplitMethod{[&](){
+                switch (resumeState.state) {
+                    case MethodResumeState::State::Inc:
+                        while (entry != pushBuffer.end() && resumeState.remaining) {
+                            dispatcher.SendFull(resumeState.address++, getArgument(), resumeState.subChannel, --resumeState.remaining == 0);
+                            entry++;
+                        }
+
+                        break;
+                    case MethodResumeState::State::OneInc:
+                        // The header can be the last word of a pushbuffer, the first argument is then in the next one and the state must stay as OneInc till it's sent
+                        if (entry == pushBuffer.end())
+                            break;
+
+                        dispatcher.SendFull(resumeState.address++, getArgument(), resumeState.subChannel, --resumeState.remaining == 0);
+                        entry++;
+
+                        // After the first increment OneInc methods work the same as a NonInc method, this is needed so they can resume correctly if they are broken up by multiple GpEntries
+                        resumeState.state = MethodResumeState::State::NonInc;
+                        [[fallthrough]];
+                    case MethodResumeState::State::NonInc:
+                        while (entry != pushBuffer.end() && resumeState.remaining) {
+                            dispatcher.SendFull(resumeState.address, getArgument(), resumeState.subChannel, --resumeState.remaining == 0);
+                            entry++;
+                        }
+
+                        break;
+                }
+            }};
+
+            bool hitSegmentEnd{}; //!< If an EndPbSegment method was encountered
+
+            // We've a method from a previous GpEntry that needs resuming
+            if (resumeState.remaining)
+                resumeSplitMethod();
+
+            // Process more methods if the entries are still not all used up after handling resuming
+            for (; entry != pushBuffer.end(); entry++) {
+                if (entry >= pushBuffer.end()) [[unlikely]]
+                    throw exception("GPFIFO buffer overflow!"); // This should never happen
+
+                // Entries containing all zeroes is a NOP, skip over them
+                for (; *entry == 0; entry++)
+                    if (entry == std::prev(pushBuffer.end()))
+                        return false;
+
+                PushBufferMethodHeader methodHeader{.raw = *entry};
+
+                // Needed in order to check for methods split across multiple GpEntries
+                ssize_t remainingEntries{std::distance(entry, pushBuffer.end()) - 1};
+
+                // Handles storing state and initial execution for methods that are split across multiple GpEntries
+                auto startSplitMethod{[&](auto methodState) {
+                    resumeState = {
+                        .remaining = methodHeader.methodCount,
+                        .address = methodHeader.methodAddress,
+                        .subChannel = methodHeader.methodSubChannel,
+                        .state = methodState
+                    };
+
+                    // Skip over method header as `resumeSplitMethod` doesn't expect it to be there
+                    entry++;
+
+                    resumeSplitMethod();
+                }};
+
+                /**
+                 * @brief Handles execution of a specific method type as specified by the State template parameter
+                 */
+                auto dispatchCalls{[&]<MethodResumeState::State State> () {
+                    /**
+                     * @brief Gets the offset to apply to the method address for a given dispatch loop index
+                     */
+                    auto methodOffset{[] (u32 i) -> u32 {
+                        if constexpr(State == MethodResumeState::State::Inc)
+                            return i;
+                        else if constexpr (State == MethodResumeState::State::OneInc)
+                            return i ? 1 : 0;
+                        else
+                            return 0;
+                    }};
+
+                    constexpr u32 BatchCutoff{4}; //!< Cutoff needed to send method calls in a batch which is espcially important for UBO updates. This helps to avoid the extra overhead batching for small packets.
+                    // TODO: Only batch for specific target methods like UBO updates, since normal dispatch is generally cheaper
+
+                    if (remainingEntries >= methodHeader.methodCount) { [[likely]]
+                        if (methodHeader.Pure()) [[likely]] {
+                            if constexpr (State == MethodResumeState::State::Inc) {
+                                // For pure inc methods we can send all method calls as a span in one go, runs of register writes are then handled without per-method dispatch
+                                if (methodHeader.methodCount > BatchCutoff) {
+                                    dispatcher.SendPureBatchInc(methodHeader.methodAddress, span(&(*++entry), methodHeader.methodCount), methodHeader.methodSubChannel);
+
+                                    entry += methodHeader.methodCount - 1;
+                                    return false;
+                                }
+                            } else if constexpr (State == MethodResumeState::State::NonInc) {
+                                // For pure noninc methods we can send all method calls as a span in one go
+                                if (methodHeader.methodCount > BatchCutoff) [[unlikely]] {
+                                    dispatcher.SendPureBatchNonInc(methodHeader.methodAddress, span(&(*++entry), methodHeader.methodCount), methodHeader.methodSubChannel);
+
+                                    entry += methodHeader.methodCount - 1;
+                                    return false;
+                                }
+                            } else if constexpr (State == MethodResumeState::State::OneInc) {
+                                // For pure oneinc methods we can send the initial method then send the rest as a span in one go
+                                if (methodHeader.methodCount > (BatchCutoff + 1)) [[unlikely]] {
+                                    dispatcher.SendPure(methodHeader.methodAddress, *++entry, methodHeader.methodSubChannel);
+                                    dispatcher.SendPureBatchNonInc(methodHeader.methodAddress + 1, span((++entry).base(), methodHeader.methodCount - 1), methodHeader.methodSubChannel);
+
+                                    entry += methodHeader.methodCount - 2;
+                                    return false;
+                                }
+                            }
+
+                            #pragma unroll(2)
+                            for (u32 i{}; i < methodHeader.methodCount; i++)
+                                dispatcher.SendPure(methodHeader.methodAddress + methodOffset(i), *++entry, methodHeader.methodSubChannel);
+                        } else {
+                            // Slow path for methods that touch GPFIFO or macros
+                            for (u32 i{}; i < methodHeader.methodCount; i++) {
+                                entry++;
+                                dispatcher.SendFull(methodHeader.methodAddress + methodOffset(i), getArgument(), methodHeader.methodSubChannel, i == methodHeader.methodCount - 1);
+                            }
+                        }
+                    } else {
+                        startSplitMethod(State);
+                        return true;
+                    }
+
+                    return false;
+                }};
+
+                /**
+                 * @brief Handles execution of a single method
+                 * @return If the this was the final method in the current GpEntry
+                 */
+                auto processMethod{[&] () -> bool {
+                    if (methodHeader.secOp == PushBufferMethodHeader::SecOp::IncMethod)  [[likely]] {
+                        return dispatchCalls.template operator()<MethodResumeState::State::Inc>();
+                    } else if (methodHeader.secOp == PushBufferMethodHeader::SecOp::OneInc) [[likely]] {
+                        return dispatchCalls.template operator()<MethodResumeState::State::OneInc>();
+                    } else if (methodHeader.secOp == PushBufferMethodHeader::SecOp::ImmdDataMethod) {
+                        if (methodHeader.Pure())
+                            dispatcher.SendPure(methodHeader.methodAddress, methodHeader.immdData, methodHeader.methodSubChannel);
+                        else
+                            dispatcher.SendFull(methodHeader.methodAddress, GpfifoArgument{methodHeader.immdData}, methodHeader.methodSubChannel, true);
+
+                        return false;
+                    } else if (methodHeader.secOp == PushBufferMethodHeader::SecOp::NonIncMethod) [[unlikely]] {
+                        return dispatchCalls.template operator()<MethodResumeState::State::NonInc>();
+                    } else if (methodHeader.secOp == PushBufferMethodHeader::SecOp::EndPbSegment) [[unlikely]] {
+                        hitSegmentEnd = true;
+                        return true;
+                    } else if (methodHeader.secOp == PushBufferMethodHeader::SecOp::Grp0UseTert) {
+                        if (methodHeader.tertOp == PushBufferMethodHeader::TertOp::Grp0SetSubDevMask)
+                            return false;
+
+                        throw exception("Unsupported pushbuffer method TertOp: {}", static_cast<u8>(methodHeader.tertOp));
+                    } else {
+                        throw exception("Unsupported pushbuffer method SecOp: {}", static_cast<u8>(methodHeader.secOp));
+                    }
+                }};
+
+                bool hitEnd{[&]() {
+                    if (methodHeader.methodSubChannel != SubchannelId::ThreeD) [[unlikely]]
+                        dispatcher.FlushEngineState(); // Flush the 3D engine state when doing any calls to other engines
+                    return processMethod();
+                }()};
+
+                if (hitEnd)
+                    break;
+            }
+
+            return hitSegmentEnd;
+        }
+    };
+}
@@ -2,9 +2,77 @@
 // Copyright © 2020 Skyline Team and Contributors (https://github.com/skyline-emu/)
 // Copyright © 2020 Ryujinx Team and Contributors (https://github.com/Ryujinx/)
 
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 #include "syncpoint.h"
 
 namespace skyline::soc::host1x {
+    void Syncpoint::SiftHeapEntry(size_t index) {
+        auto entry{std::move(waiters[index])};
+
+        // Sift up towards the root while the parent has a larger threshold
+        while (index > 0) {
+            size_t parent{(index - 1) / 2};
+            if (waiters[parent].threshold <= entry.threshold)
+                break;
+
+            waiters[index] = std::move(waiters[parent]);
+            waiters[index].waiter->heapIndex = index;
+            index = parent;
+        }
+
+        // Sift down towards the leaves while any child has a smaller threshold
+        while (true) {
+            size_t child{index * 2 + 1};
+            if (child >= waiters.size())
+                break;
+            if (child + 1 < waiters.size() && waiters[child + 1].threshold < waiters[child].threshold)
+                child++;
+            if (entry.threshold <= waiters[child].threshold)
+                break;
+
+            waiters[index] = std::move(waiters[child]);
+            waiters[index].waiter->heapIndex = index;
+            index = child;
+        }
+
+        waiters[index] = std::move(entry);
+        waiters[index].waiter->heapIndex = index;
+    }
+
+    void Syncpoint::PushWaiter(Waiter *waiter, std::shared_ptr<Waiter> owner) {
+        waiters.push_back(HeapEntry{waiter->threshold, waiter, std::move(owner)});
+        SiftHeapEntry(waiters.size() - 1);
+        minimumThreshold.store(waiters.front().threshold);
+    }
+
+    Syncpoint::HeapEntry Syncpoint::RemoveWaiter(size_t index) {
+        auto entry{std::move(waiters[index])};
+        entry.waiter->heapIndex = Waiter::InvalidHeapIndex;
+
+        if (index != waiters.size() - 1) {
+            waiters[index] = std::move(waiters.back());
+            waiters.pop_back();
+            SiftHeapEntry(index);
+        } else {
+            waiters.pop_back();
+        }
+
+        minimumThreshold.store(waiters.empty() ? std::numeric_limits<u32>::max() : waiters.front().threshold);
+        return entry;
+    }
+
+    void Syncpoint::SignalWaiter(Waiter &waiter) {
+        if (waiter.callback) {
+            waiter.callback();
+        } else {
+            // The waiter may return as soon as it observes the store, a wake on its futex after that is harmless as it's only an address
+            waiter.signalled.store(1, std::memory_order_release);
+            syscall(SYS_futex, &waiter.signalled, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+        }
+    }
+
     Syncpoint::WaiterHandle Syncpoint::RegisterWaiter(u32 threshold, const std::function<void()> &callback) {
         if (value.load(std::memory_order_acquire) >= threshold) {
             // (Fast path) We don't need to wait on the mutex and can just get away with atomics
@@ -12,50 +80,43 @@ namespace skyline::soc::host1x {
             return {};
         }
 
+        auto waiter{std::make_shared<Waiter>(threshold, callback)};
+
         std::scoped_lock lock(mutex);
-        if (value.load(std::memory_order_acquire) >= threshold) {
+        PushWaiter(waiter.get(), waiter);
+
+        // The minimum threshold must be published before rechecking the value, otherwise an increment could skip the heap without us observing its value
+        if (value.load() >= threshold) {
+            RemoveWaiter(waiter->heapIndex);
             callback();
             return {};
         }
 
-        auto it{waiters.begin()};
-        while (it != waiters.end() && threshold >= it->threshold)
-            it++;
-        return waiters.emplace(it, threshold, callback);
+        return waiter;
     }
 
-    void Syncpoint::DeregisterWaiter(WaiterHandle waiter) {
+    void Syncpoint::DeregisterWaiter(const WaiterHandle &waiter) {
+        if (!waiter)
+            return;
+
         std::scoped_lock lock(mutex);
-        // We want to ensure the iterator still exists prior to erasing it
-        // Otherwise, if an invalid iterator was passed in then it could lead to UB
-        // It is important to avoid UB in that case since the deregister isn't called from a locked context
-        for (auto it{waiters.begin()}; it != waiters.end(); it++) {
-            if (it == waiter) {
-                waiters.erase(it);
-                return;
-            }
-        }
+        // The waiter won't be in the heap anymore if it has already been signalled
+        if (waiter->heapIndex != Waiter::InvalidHeapIndex)
+            RemoveWaiter(waiter->heapIndex);
     }
 
     u32 Syncpoint::Increment() {
-        auto readValue{value.fetch_add(1, std::memory_order_acq_rel) + 1}; // We don't want to constantly do redundant atomic loads
+        auto readValue{value.fetch_add(1) + 1}; // We don't want to constantly do redundant atomic loads
 
-        std::scoped_lock lock(mutex);
-        bool signalCondition{};
-        auto it{waiters.begin()};
-        while (it != waiters.end() && readValue >= it->threshold) {
-            auto &waiter{*it};
-            if (waiter.callback)
-                waiter.callback();
-            else
-                signalCondition = true;
-            it++;
-        }
-
-        waiters.erase(waiters.begin(), it);
+        // (Fast path) No waiters can be satisfied by this increment so there's no need to lock the mutex
+        if (readValue < minimumThreshold.load())
+            return readValue;
 
-        if (signalCondition)
-            incrementCondition.notify_all();
+        std::scoped_lock lock(mutex);
+        // A concurrent increment may have already signalled the waiters we observed, the latest value is used so none are left behind
+        u32 currentValue{value.load(std::memory_order_acquire)};
+        while (!waiters.empty() && currentValue >= waiters.front().threshold)
+            SignalWaiter(*RemoveWaiter(0).waiter);
 
         return readValue;
     }
@@ -63,20 +124,44 @@ namespace skyline::soc::host1x {
     bool Syncpoint::Wait(u32 threshold, std::chrono::steady_clock::duration timeout) {
         if (value.load(std::memory_order_acquire) >= threshold)
             // (Fast Path) We don't need to wait on the mutex and can just get away with atomics
-            return {};
+            return true;
 
-        std::unique_lock lock(mutex);
-        auto it{waiters.begin()};
-        while (it != waiters.end() && threshold >= it->threshold)
-            it++;
-        waiters.emplace(it, threshold, nullptr);
+        Waiter waiter{threshold};
+        {
+            std::scoped_lock lock(mutex);
+            PushWaiter(&waiter);
 
-        if (timeout == std::chrono::steady_clock::duration::max()) {
-            incrementCondition.wait(lock, [&] { return value.load(std::memory_order_relaxed) >= threshold; });
-            return true;
-        } else {
-            return incrementCondition.wait_for(lock, timeout, [&] { return value.load(std::memory_order_relaxed) >= threshold; });
+            if (value.load() >= threshold) {
+                RemoveWaiter(waiter.heapIndex);
+                return true;
+            }
+        }
+
+        bool infinite{timeout == std::chrono::steady_clock::duration::max()};
+        auto deadline{infinite ? std::chrono::steady_clock::time_point::max() : std::chrono::steady_clock::now() + timeout};
+        while (!waiter.signalled.load(std::memory_order_acquire)) {
+            timespec *timeoutSpec{};
+            timespec remainingSpec{};
+            if (!infinite) {
+                auto remaining{deadline - std::chrono::steady_clock::now()};
+                if (remaining <= std::chrono::steady_clock::duration::zero()) {
+                    std::scoped_lock lock(mutex);
+                    // The waiter is only removed from the heap under the mutex prior to being signalled, so it's either still in the heap or has been signalled
+                    if (waiter.heapIndex != Waiter::InvalidHeapIndex) {
+                        RemoveWaiter(waiter.heapIndex);
+                        return false;
+                    }
+                    return true;
+                }
+
+                auto remainingNs{std::chrono::duration_cast<std::chrono::nanoseconds>(remaining).count()};
+                remainingSpec = {.tv_sec = static_cast<time_t>(remainingNs / constant::NsInSecond), .tv_nsec = static_cast<long>(remainingNs % constant::NsInSecond)};
+                timeoutSpec = &remainingSpec;
+            }
+
+            syscall(SYS_futex, &waiter.signalled, FUTEX_WAIT_PRIVATE, 0, timeoutSpec, nullptr, 0);
         }
+
+        return true;
     }
 }
-
@@ -16,26 +16,63 @@ namespace skyline::soc::host1x {
       private:
         std::atomic<u32> value{}; //!< An atomically-incrementing counter at the core of a syncpoint
 
-        std::mutex mutex; //!< Synchronizes insertions and deletions of waiters alongside locking the increment condition
-        std::condition_variable incrementCondition; //!< Signalled on thresholds for waiters which are tied to Wait(...)
-
+        /**
+         * @brief A single waiter on the syncpoint, these are stored intrusively in a min-heap ordered by their threshold
+         */
         struct Waiter {
+            static constexpr size_t InvalidHeapIndex{std::numeric_limits<size_t>::max()};
+
             u32 threshold; //!< The syncpoint value to wait on to be reached
-            std::function<void()> callback; //!< The callback to do after the wait has ended, refers to cvar signal when nullptr
+            size_t heapIndex{InvalidHeapIndex}; //!< The index of the waiter in the heap, InvalidHeapIndex if it isn't in the heap
+            std::function<void()> callback; //!< The callback to do after the wait has ended, the futex is woken instead when this is empty
+            std::atomic<u32> signalled{}; //!< A futex word for blocking waiters that is set to 1 once the threshold has been reached
+
+            Waiter(u32 threshold, std::function<void()> callback = {}) : threshold{threshold}, callback{std::move(callback)} {}
+        };
 
-            Waiter(u32 threshold, std::function<void()> callback) : threshold(threshold), callback(std::move(callback)) {}
+        struct HeapEntry {
+            u32 threshold; //!< A copy of the waiter's threshold to avoid dereferencing the waiter while sifting
+            Waiter *waiter;
+            std::shared_ptr<Waiter> owner; //!< Keeps callback waiters alive while they're in the heap, this is nullptr for blocking waiters which are on the stack of the waiting thread
         };
-        std::list<Waiter> waiters; //!< A linked list of all waiters, it's sorted in ascending order by threshold
+
+        std::mutex mutex; //!< Synchronizes all accesses to the heap, callbacks are called with this locked
+        std::vector<HeapEntry> waiters; //!< A binary min-heap of all waiters ordered by threshold
+        std::atomic<u32> minimumThreshold{std::numeric_limits<u32>::max()}; //!< The threshold of the waiter at the top of the heap, this allows Increment to skip locking when no waiters are satisfied
+
+        /**
+         * @brief Moves the heap entry at the supplied index into its correct position in the heap
+         */
+        void SiftHeapEntry(size_t index);
+
+        /**
+         * @brief Inserts a waiter into the heap and updates the minimum threshold
+         * @note The mutex must be locked when calling this
+         */
+        void PushWaiter(Waiter *waiter, std::shared_ptr<Waiter> owner = {});
+
+        /**
+         * @brief Removes the waiter at the supplied index from the heap and updates the minimum threshold
+         * @return The removed entry, callback waiters are kept alive by it until it's destroyed
+         * @note The mutex must be locked when calling this
+         */
+        HeapEntry RemoveWaiter(size_t index);
+
+        /**
+         * @brief Signals the supplied waiter which must have been removed from the heap already
+         * @note The mutex must be locked when calling this
+         */
+        static void SignalWaiter(Waiter &waiter);
 
       public:
         /**
          * @return The value of the syncpoint, retrieved in an atomically safe manner
          */
-        constexpr u32 Load() {
+        u32 Load() {
             return value.load(std::memory_order_acquire);
         }
 
-        using WaiterHandle = decltype(waiters)::iterator; //!< Aliasing an iterator to a Waiter as an opaque handle
+        using WaiterHandle = std::shared_ptr<Waiter>; //!< An opaque handle to a registered waiter, this is only used to deregister it
 
         /**
          * @brief Registers a new waiter with a callback that will be called when the syncpoint reaches the target threshold
@@ -45,9 +82,9 @@ namespace skyline::soc::host1x {
         WaiterHandle RegisterWaiter(u32 threshold, const std::function<void()> &callback);
 
         /**
-         * @note If the supplied handle is invalid then the function will do nothing
+         * @note If the supplied handle is invalid or the waiter has already been signalled then the function will do nothing
          */
-        void DeregisterWaiter(WaiterHandle waiter);
+        void DeregisterWaiter(const WaiterHandle &waiter);
 
         /**
          * @return The new value of the syncpoint after the increment
@@ -58,6 +95,7 @@ namespace skyline::soc::host1x {
          * @brief Waits for the syncpoint to reach given threshold
          * @return If the wait was successful (true) or timed out (false)
          * @note Guaranteed to succeed when 'steady_clock::duration::max()' is used
+         * @note The waiting thread sleeps on its own futex so it's only woken by the increment that satisfies it
          */
         bool Wait(u32 threshold, std::chrono::steady_clock::duration timeout);
     };
@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2023 Strato Team and Contributors (https://github.com/strato-emu/)
+
+#include <common/trace.h>
+#include "cached_backing.h"
+
+namespace skyline::vfs {
+    CachedBacking::CachedBacking(std::shared_ptr<Backing> pBacking, size_t cacheSize) : Backing({true, false, false}, pBacking->size), backing(std::move(pBacking)), maxBlockCount(std::max<size_t>(cacheSize / BlockSize, 1)) {
+        if (!backing->mode.read)
+            throw exception("Cannot cache a backing that is not readable");
+    }
+
+    CachedBacking::~CachedBacking() {
+        if (readAhead.valid())
+            readAhead.wait();
+    }
+
+    void CachedBacking::InsertBlock(size_t index, span<u8> data) {
+        auto it{blockMap.find(index)};
+        if (it != blockMap.end()) {
+            // Another thread might have filled the same block concurrently, the data is identical so we just need to update its recency
+            blocks.splice(blocks.begin(), blocks, it->second);
+            return;
+        }
+
+        if (blockMap.size() >= maxBlockCount) {
+            // Recycle the storage of the least recently used block rather than allocating a new one
+            auto &lru{blocks.back()};
+            blockMap.erase(lru.index);
+            blocks.splice(blocks.begin(), blocks, std::prev(blocks.end()));
+            lru.index = index;
+            lru.data.assign(data.begin(), data.end());
+        } else {
+            blocks.emplace_front(Block{index, std::vector<u8>(data.begin(), data.end())});
+        }
+
+        blockMap.emplace(index, blocks.begin());
+    }
+
+    std::vector<u8> CachedBacking::FillBlocks(size_t startIndex, size_t count) {
+        size_t offset{startIndex * BlockSize};
+        std::vector<u8> data(std::min(count * BlockSize, size - offset));
+        if (backing->ReadUnchecked(data, offset) != data.size())
+            return {};
+        statistics.bytesRead += data.size();
+
+        std::scoped_lock lock{mutex};
+        for (size_t blockOffset{}; blockOffset < data.size(); blockOffset += BlockSize)
+            InsertBlock(startIndex + (blockOffset / BlockSize), span<u8>{data}.subspan(blockOffset, std::min(BlockSize, data.size() - blockOffset)));
+
+        return data;
+    }
+
+    void CachedBacking::QueueReadAhead(size_t startIndex) {
+        if (readAhead.valid() && readAhead.wait_for(std::chrono::seconds{}) != std::future_status::ready)
+            return;
+
+        size_t endIndex{std::min(startIndex + ReadAheadBlockCount, util::DivideCeil(size, BlockSize))};
+        while (startIndex < endIndex && blockMap.contains(startIndex))
+            startIndex++; // Skip over any blocks that are already cached
+        if (startIndex == endIndex)
+            return;
+
+        readAhead = std::async(std::launch::async, [this, startIndex, count = endIndex - startIndex]() {
+            if (!FillBlocks(startIndex, count).empty())
+                statistics.readAheadBlocks += count;
+        });
+    }
+
+    void CachedBacking::TraceStatistics() {
+        TRACE_COUNTER("vfs", "Cache Hits", statistics.hits.load(std::memory_order_relaxed));
+        TRACE_COUNTER("vfs", "Cache Misses", statistics.misses.load(std::memory_order_relaxed));
+        TRACE_COUNTER("vfs", "Cache Read-Ahead Blocks", statistics.readAheadBlocks.load(std::memory_order_relaxed));
+        TRACE_COUNTER("vfs", "Cache Bytes Read", statistics.bytesRead.load(std::memory_order_relaxed));
+        TRACE_COUNTER("vfs", "Cache Bytes Served", statistics.bytesServed.load(std::memory_order_relaxed));
+    }
+
+    size_t CachedBacking::ReadImpl(span<u8> output, size_t offset) {
+        if (output.empty() || offset >= size)
+            return 0;
+
+        size_t endOffset{std::min(offset + output.size(), size)};
+        size_t startIndex{offset / BlockSize}, endIndex{util::DivideCeil(endOffset, BlockSize)};
+
+        if (endIndex - startIndex > maxBlockCount / 2) {
+            // Reads which would evict a large part of the cache bypass it entirely as they're unlikely to be repeated soon
+            size_t read{backing->ReadUnchecked(output.first(endOffset - offset), offset)};
+            statistics.misses += endIndex - startIndex;
+            statistics.bytesRead += read;
+            statistics.bytesServed += read;
+            return read;
+        }
+
+        size_t copied{};
+        auto copyBlock{[&](size_t index, span<u8> data) {
+            size_t blockOffset{index == startIndex ? offset % BlockSize : 0};
+            size_t amount{std::min(data.size() - blockOffset, endOffset - offset - copied)};
+            std::memcpy(output.data() + copied, data.data() + blockOffset, amount);
+            copied += amount;
+        }};
+
+        size_t index{startIndex};
+        while (index < endIndex) {
+            size_t missEndIndex;
+            {
+                std::scoped_lock lock{mutex};
+                for (; index < endIndex; index++) {
+                    auto it{blockMap.find(index)};
+                    if (it == blockMap.end())
+                        break;
+
+                    blocks.splice(blocks.begin(), blocks, it->second);
+                    copyBlock(index, it->second->data);
+                    statistics.hits++;
+                }
+
+                if (index == endIndex)
+                    break;
+
+                // Coalesce all consecutive uncached blocks into a single read from the backing
+                missEndIndex = index + 1;
+                while (missEndIndex < endIndex && !blockMap.contains(missEndIndex))
+                    missEndIndex++;
+            }
+
+            auto data{FillBlocks(index, missEndIndex - index)};
+            if (data.empty())
+                break;
+            statistics.misses += missEndIndex - index;
+
+            for (size_t blockOffset{}; blockOffset < data.size(); blockOffset += BlockSize, index++)
+                copyBlock(index, span<u8>{data}.subspan(blockOffset, std::min(BlockSize, data.size() - blockOffset)));
+        }
+
+        {
+            std::scoped_lock lock{mutex};
+            sequentialReadCount = (offset == nextSequentialOffset) ? sequentialReadCount + 1 : 0;
+            nextSequentialOffset = endOffset;
+            if (sequentialReadCount >= SequentialReadThreshold)
+                QueueReadAhead(endOffset / BlockSize);
+        }
+
+        statistics.bytesServed += copied;
+        TraceStatistics();
+        return copied;
+    }
+}
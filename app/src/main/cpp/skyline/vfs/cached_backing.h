@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: MPL-2.0
+// Copyright © 2023 Strato Team and Contributors (https://github.com/strato-emu/)
+
+#pragma once
+
+#include <future>
+#include <list>
+#include "backing.h"
+
+namespace skyline::vfs {
+    /**
+     * @brief A read-only backing which caches aligned blocks of an underlying backing in memory with LRU eviction
+     * @note This is intended to sit on top of backings with an expensive read path such as CtrEncryptedBacking, so repeated reads of the same data don't need to hit the file and be decrypted again
+     * @note Sequential access is detected and the following blocks are read ahead asynchronously
+     */
+    class CachedBacking : public Backing {
+      public:
+        static constexpr size_t BlockSize{0x4000}; //!< The size of a single cached block, this is a multiple of the AES block size so blocks can always be decrypted independently
+        static constexpr size_t ReadAheadBlockCount{8}; //!< The amount of blocks that are read ahead of a sequential read
+        static constexpr size_t SequentialReadThreshold{2}; //!< The amount of consecutive sequential reads before read-ahead is triggered
+
+        /**
+         * @brief Counters for the effectiveness of the cache, these are updated atomically and can be read at any time
+         */
+        struct Statistics {
+            std::atomic<u64> hits; //!< The amount of blocks that were served from the cache
+            std::atomic<u64> misses; //!< The amount of blocks that had to be read from the underlying backing
+            std::atomic<u64> readAheadBlocks; //!< The amount of blocks that were read ahead asynchronously
+            std::atomic<u64> bytesRead; //!< The amount of bytes that were read from the underlying backing
+            std::atomic<u64> bytesServed; //!< The amount of bytes that were returned from this backing
+        };
+
+      private:
+        /**
+         * @brief A single cached block of the underlying backing
+         */
+        struct Block {
+            size_t index; //!< The index of the block in the backing
+            std::vector<u8> data; //!< The data of the block, this is only shorter than BlockSize for the final block of the backing
+        };
+
+        std::shared_ptr<Backing> backing;
+        size_t maxBlockCount; //!< The maximum amount of blocks that can be cached at once
+        std::mutex mutex; //!< Synchronizes all accesses to the cache and sequential read state
+        std::list<Block> blocks; //!< All cached blocks, ordered from most to least recently used
+        std::unordered_map<size_t, std::list<Block>::iterator> blockMap; //!< A map from a block index to the cached block
+
+        size_t nextSequentialOffset{}; //!< The offset directly after the end of the last read
+        size_t sequentialReadCount{}; //!< The amount of consecutive reads which started at `nextSequentialOffset`
+        std::future<void> readAhead; //!< The current asynchronous read-ahead, only one can be in flight at a time
+
+        Statistics statistics{};
+
+        /**
+         * @brief Inserts a block into the cache as the most recently used block and evicts the least recently used blocks if the cache is full
+         * @note The mutex must be locked when calling this
+         */
+        void InsertBlock(size_t index, span<u8> data);
+
+        /**
+         * @brief Reads the supplied range of blocks from the underlying backing and inserts them into the cache
+         * @return The data read from the backing, this is shorter than the range if the end of the backing was reached and empty if the read failed
+         */
+        std::vector<u8> FillBlocks(size_t startIndex, size_t count);
+
+        /**
+         * @brief Asynchronously reads ahead the blocks following the supplied block if there's no read-ahead in flight already
+         * @note The mutex must be locked when calling this
+         */
+        void QueueReadAhead(size_t startIndex);
+
+        /**
+         * @brief Emits the current statistics as trace counters
+         */
+        void TraceStatistics();
+
+      protected:
+        size_t ReadImpl(span<u8> output, size_t offset) override;
+
+      public:
+        /**
+         * @param cacheSize The maximum amount of memory in bytes that will be used for cached blocks
+         */
+        CachedBacking(std::shared_ptr<Backing> backing, size_t cacheSize);
+
+        ~CachedBacking();
+
+        const Statistics &GetStatistics() const {
+            return statistics;
+        }
+    };
+}
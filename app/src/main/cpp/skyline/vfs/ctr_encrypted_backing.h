@@ -10,20 +10,15 @@
 namespace skyline::vfs {
     /**
      * @brief A backing for decrypting AES-CTR data
+     * @note Reads don't require any synchronization as the counter of every block is derived from its offset
      */
     class CtrEncryptedBacking : public Backing {
       private:
-        crypto::KeyStore::Key128 ctr;
+        crypto::KeyStore::Key128 ctr; //!< The initial counter, the lower 8 bytes are a big-endian block counter which is zero at the start of the file
         crypto::AesCipher cipher;
         std::shared_ptr<Backing> backing;
-        std::mutex mutex; //!< Synchronize all AES-CTR cipher state modifications
         size_t baseOffset; //!< The offset of the backing into the file is used to calculate the IV
 
-        /**
-         * @brief Calculates IV based on the offset
-         */
-        void UpdateCtr(u64 offset);
-
       protected:
         size_t ReadImpl(span<u8> output, size_t offset) override;
 
@@ -30,6 +30,7 @@ class EmulationSettings private constructor(context : Context, prefName : String
     var systemLanguage by sharedPreferences(context, 1, prefName = prefName)
     var systemRegion by sharedPreferences(context, -1, prefName = prefName)
     var isInternetEnabled by sharedPreferences(context, false, prefName = prefName)
+    var romFsCacheSize by sharedPreferences(context, 64, prefName = prefName)
 
     // Audio
     var isAudioOutputDisabled by sharedPreferences(context, false, prefName = prefName)
@@ -49,19 +50,26 @@ class EmulationSettings private constructor(context : Context, prefName : String
     var disableFrameThrottling by sharedPreferences(context, false, prefName = prefName)
     var executorSlotCountScale by sharedPreferences(context, 6, prefName = prefName)
     var executorFlushThreshold by sharedPreferences(context, 256, prefName = prefName)
+    var executorRecordThreadCount by sharedPreferences(context, 1, prefName = prefName)
+    var megaBufferMaxSize by sharedPreferences(context, 250, prefName = prefName)
     var useDirectMemoryImport by sharedPreferences(context, false, prefName = prefName)
     var forceMaxGpuClocks by sharedPreferences(context, false, prefName = prefName)
     var freeGuestTextureMemory by sharedPreferences(context, true, prefName = prefName)
+    var pipelineCacheThreadCount by sharedPreferences(context, 0, prefName = prefName)
+    var asyncPipelineCompilation by sharedPreferences(context, false, prefName = prefName)
     var disableShaderCache by sharedPreferences(context, false, prefName = prefName)
 
     // Hacks
     var enableFastGpuReadbackHack by sharedPreferences(context, false, prefName = prefName)
     var enableFastReadbackWrites by sharedPreferences(context, false, prefName = prefName)
     var disableSubgroupShuffle by sharedPreferences(context, false, prefName = prefName)
+    var enableLibcHooks by sharedPreferences(context, false, prefName = prefName)
 
     // Debug
     var logLevel by sharedPreferences(context, 2, prefName = prefName) // Info by default
+    var binaryLogging by sharedPreferences(context, false, prefName = prefName)
     var validationLayer by sharedPreferences(context, false, prefName = prefName)
+    var gpfifoCapture by sharedPreferences(context, false, prefName = prefName)
 
     /**
      * Copies all settings from the global settings to this instance.
@@ -77,6 +77,8 @@ class GameSettingsFragment : PreferenceFragmentCompat() {
         prefToRemove?.parent?.removePreference(prefToRemove)
         prefToRemove = findPreference<Preference>("log_level")
         prefToRemove?.parent?.removePreference(prefToRemove)
+        prefToRemove = findPreference<Preference>("binary_logging")
+        prefToRemove?.parent?.removePreference(prefToRemove)
 
         // TODO: remove this once we have more settings under the debug category
         // Avoid showing the debug category if no settings under it are visible
@@ -23,6 +23,7 @@ data class NativeSettings(
     var systemLanguage : Int,
     var systemRegion : Int,
     var isInternetEnabled : Boolean,
+    var romFsCacheSize : Int,
 
     // Audio
     var isAudioOutputDisabled : Boolean,
@@ -34,19 +35,26 @@ data class NativeSettings(
     var disableFrameThrottling : Boolean,
     var executorSlotCountScale : Int,
     var executorFlushThreshold : Int,
+    var executorRecordThreadCount : Int,
+    var megaBufferMaxSize : Int,
     var useDirectMemoryImport : Boolean,
     var forceMaxGpuClocks : Boolean,
     var freeGuestTextureMemory : Boolean,
+    var pipelineCacheThreadCount : Int,
+    var asyncPipelineCompilation : Boolean,
     var disableShaderCache : Boolean,
 
     // Hacks
     var enableFastGpuReadbackHack : Boolean,
     var enableFastReadbackWrites : Boolean,
     var disableSubgroupShuffle : Boolean,
+    var enableLibcHooks : Boolean,
 
     // Debug
     var logLevel : Int,
-    var validationLayer : Boolean
+    var binaryLogging : Boolean,
+    var validationLayer : Boolean,
+    var gpfifoCapture : Boolean
 ) {
     constructor(context : Context, pref : EmulationSettings) : this(
         pref.isDocked,
@@ -55,6 +63,7 @@ data class NativeSettings(
         pref.systemLanguage,
         pref.systemRegion,
         pref.isInternetEnabled,
+        pref.romFsCacheSize,
         pref.isAudioOutputDisabled,
         if (pref.gpuDriver == EmulationSettings.SYSTEM_GPU_DRIVER) "" else pref.gpuDriver,
         if (pref.gpuDriver == EmulationSettings.SYSTEM_GPU_DRIVER) "" else GpuDriverHelper.getLibraryName(context, pref.gpuDriver),
@@ -62,15 +71,22 @@ data class NativeSettings(
         pref.disableFrameThrottling,
         pref.executorSlotCountScale,
         pref.executorFlushThreshold,
+        pref.executorRecordThreadCount,
+        pref.megaBufferMaxSize,
         pref.useDirectMemoryImport,
         pref.forceMaxGpuClocks,
         pref.freeGuestTextureMemory,
+        pref.pipelineCacheThreadCount,
+        pref.asyncPipelineCompilation,
         pref.disableShaderCache,
         pref.enableFastGpuReadbackHack,
         pref.enableFastReadbackWrites,
         pref.disableSubgroupShuffle,
+        pref.enableLibcHooks,
         pref.logLevel,
-        BuildConfig.BUILD_TYPE != "release" && pref.validationLayer
+        pref.binaryLogging,
+        BuildConfig.BUILD_TYPE != "release" && pref.validationLayer,
+        pref.gpfifoCapture
     )
 
     /**
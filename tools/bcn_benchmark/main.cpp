@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2023 Strato Team and Contributors (https://github.com/strato-emu/)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <gpu/texture/bc_decoder.h>
+
+namespace {
+    using Decoder = std::function<void(const uint8_t *, uint8_t *, size_t, size_t)>;
+
+    /**
+     * @brief A BCn format along with its optimized and reference decoders
+     */
+    struct Format {
+        const char *name;
+        size_t blockSize; //!< The size of a single encoded 4x4 block in bytes
+        size_t dstBpp; //!< The amount of bytes per pixel in the decoded image
+        Decoder decode;
+        Decoder decodeReference;
+    };
+
+    /**
+     * @brief Decodes the image repeatedly and returns the mean time taken for a single decode
+     */
+    std::chrono::nanoseconds Time(const Decoder &decoder, const std::vector<uint8_t> &src, std::vector<uint8_t> &dst, size_t width, size_t height, size_t iterations) {
+        auto start{std::chrono::steady_clock::now()};
+        for (size_t iteration{}; iteration < iterations; iteration++)
+            decoder(src.data(), dst.data(), width, height);
+        return (std::chrono::steady_clock::now() - start) / iterations;
+    }
+}
+
+/**
+ * @brief Decodes random BCn data with both the block kernels and the per-texel reference decoders, checks that their output is bit-exact and reports the throughput of both
+ */
+int main(int argc, char **argv) {
+    size_t iterations{argc > 1 ? std::strtoull(argv[1], nullptr, 0) : 20};
+    uint64_t seed{argc > 2 ? std::strtoull(argv[2], nullptr, 0) : std::random_device{}()};
+    std::cout << "Decoding " << iterations << " iterations with seed " << seed << "\n";
+
+    std::vector<Format> formats{
+        {"BC1", 8, 4, [](auto src, auto dst, auto width, auto height) { bcn::DecodeBc1(src, dst, width, height, true); }, [](auto src, auto dst, auto width, auto height) { bcn::reference::DecodeBc1(src, dst, width, height, true); }},
+        {"BC1 (No Alpha)", 8, 4, [](auto src, auto dst, auto width, auto height) { bcn::DecodeBc1(src, dst, width, height, false); }, [](auto src, auto dst, auto width, auto height) { bcn::reference::DecodeBc1(src, dst, width, height, false); }},
+        {"BC2", 16, 4, bcn::DecodeBc2, bcn::reference::DecodeBc2},
+        {"BC3", 16, 4, bcn::DecodeBc3, bcn::reference::DecodeBc3},
+        {"BC4 (Unsigned)", 8, 1, [](auto src, auto dst, auto width, auto height) { bcn::DecodeBc4(src, dst, width, height, false); }, [](auto src, auto dst, auto width, auto height) { bcn::reference::DecodeBc4(src, dst, width, height, false); }},
+        {"BC4 (Signed)", 8, 1, [](auto src, auto dst, auto width, auto height) { bcn::DecodeBc4(src, dst, width, height, true); }, [](auto src, auto dst, auto width, auto height) { bcn::reference::DecodeBc4(src, dst, width, height, true); }},
+        {"BC5 (Unsigned)", 16, 2, [](auto src, auto dst, auto width, auto height) { bcn::DecodeBc5(src, dst, width, height, false); }, [](auto src, auto dst, auto width, auto height) { bcn::reference::DecodeBc5(src, dst, width, height, false); }},
+        {"BC5 (Signed)", 16, 2, [](auto src, auto dst, auto width, auto height) { bcn::DecodeBc5(src, dst, width, height, true); }, [](auto src, auto dst, auto width, auto height) { bcn::reference::DecodeBc5(src, dst, width, height, true); }},
+        {"BC6H (Unsigned)", 16, 8, [](auto src, auto dst, auto width, auto height) { bcn::DecodeBc6(src, dst, width, height, false); }, [](auto src, auto dst, auto width, auto height) { bcn::reference::DecodeBc6(src, dst, width, height, false); }},
+        {"BC6H (Signed)", 16, 8, [](auto src, auto dst, auto width, auto height) { bcn::DecodeBc6(src, dst, width, height, true); }, [](auto src, auto dst, auto width, auto height) { bcn::reference::DecodeBc6(src, dst, width, height, true); }},
+        {"BC7", 16, 4, bcn::DecodeBc7, bcn::reference::DecodeBc7},
+    };
+
+    // The odd sizes check that partial blocks along the edges still take the per-texel path and don't overrun the image
+    constexpr std::pair<size_t, size_t> CheckSizes[]{{1, 1}, {3, 5}, {17, 9}, {64, 30}, {129, 67}};
+    constexpr size_t BenchmarkWidth{1024}, BenchmarkHeight{1024};
+
+    std::mt19937_64 generator{seed};
+    auto randomBlocks{[&](size_t width, size_t height, size_t blockSize) {
+        std::vector<uint8_t> data(((width + 3) / 4) * ((height + 3) / 4) * blockSize);
+        for (auto &byte : data)
+            byte = static_cast<uint8_t>(generator());
+        return data;
+    }};
+
+    size_t mismatchCount{};
+    for (const auto &format : formats) {
+        for (auto [width, height] : CheckSizes) {
+            auto src{randomBlocks(width, height, format.blockSize)};
+            // Both outputs are pre-filled with different values so any texel left unwritten by either decoder is caught
+            std::vector<uint8_t> dst(width * height * format.dstBpp, 0xAA), reference(width * height * format.dstBpp, 0x55);
+            format.decode(src.data(), dst.data(), width, height);
+            format.decodeReference(src.data(), reference.data(), width, height);
+
+            if (std::memcmp(dst.data(), reference.data(), dst.size()) != 0) {
+                mismatchCount++;
+                auto mismatch{std::mismatch(dst.begin(), dst.end(), reference.begin())};
+                size_t offset{static_cast<size_t>(mismatch.first - dst.begin())};
+                std::cerr << format.name << " mismatch in a " << width << "x" << height << " image at texel (" << (offset / format.dstBpp) % width << ", " << (offset / format.dstBpp) / width << ")\n";
+            }
+        }
+
+        auto src{randomBlocks(BenchmarkWidth, BenchmarkHeight, format.blockSize)};
+        std::vector<uint8_t> dst(BenchmarkWidth * BenchmarkHeight * format.dstBpp), reference(dst.size());
+        auto referenceTime{Time(format.decodeReference, src, reference, BenchmarkWidth, BenchmarkHeight, iterations)};
+        auto time{Time(format.decode, src, dst, BenchmarkWidth, BenchmarkHeight, iterations)};
+        if (dst != reference) {
+            mismatchCount++;
+            std::cerr << format.name << " mismatch in the benchmark image\n";
+        }
+
+        auto megatexelsPerSecond{[](std::chrono::nanoseconds time) { return (BenchmarkWidth * BenchmarkHeight * 1000.0) / static_cast<double>(time.count()); }};
+        std::cout << format.name << ": " << megatexelsPerSecond(time) << " MTexels/s (reference: " << megatexelsPerSecond(referenceTime) << " MTexels/s, " << static_cast<double>(referenceTime.count()) / static_cast<double>(time.count()) << "x)\n";
+    }
+
+    if (mismatchCount) {
+        std::cerr << mismatchCount << " images decoded differently from the reference decoders\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,250 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2023 Strato Team and Contributors (https://github.com/strato-emu/)
+
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+#include <common/ticket_lock.h>
+
+using namespace skyline;
+
+namespace {
+    constexpr i64 NsInMillisecond{1000000};
+    constexpr i64 LockStarvationThreshold{NsInMillisecond * 8}; //!< ChannelContext::LockStarvationThreshold
+    constexpr size_t ChannelCount{3};
+    constexpr size_t EntriesPerBatch{8}; //!< The amount of GpEntries submitted by the guest at once, the GPFIFO thread drains its queue after each batch
+    constexpr size_t MethodsPerEntry{64};
+    constexpr size_t WorkPerMethod{400}; //!< The amount of iterations of busy work that processing a single method takes
+    constexpr size_t SharedMethodPercentage{5}; //!< The percentage of methods that touch shared GPU state, such as draws or DMA
+
+    i64 GetTimeNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /**
+     * @return The CPU time consumed by all threads of the process
+     */
+    i64 GetCpuTimeNs() {
+        timespec time{};
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time);
+        return static_cast<i64>(time.tv_sec) * 1000000000 + time.tv_nsec;
+    }
+
+    /**
+     * @brief Burns CPU time in a way the compiler can't optimise out, this stands in for method processing
+     */
+    u64 Work(u64 state, size_t iterations) {
+        for (size_t iteration{}; iteration < iterations; iteration++) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+        }
+        return state;
+    }
+
+    /**
+     * @brief Checks that waiters acquire the lock in the order they started waiting and that they sleep rather than spin while doing so
+     * @return The amount of failed checks
+     */
+    size_t CheckHandoff() {
+        constexpr size_t WaiterCount{4};
+        constexpr auto HoldDuration{std::chrono::milliseconds(200)};
+        constexpr i64 MaxWaiterCpuTime{NsInMillisecond * 40}; //!< Generous to account for scheduling noise, a spinning waiter would use the entire hold duration
+
+        TicketLock lock;
+        std::vector<size_t> order;
+        std::vector<std::thread> waiters;
+        size_t errorCount{};
+
+        lock.lock();
+        for (size_t index{}; index < WaiterCount; index++) {
+            waiters.emplace_back([&lock, &order, index] {
+                lock.lock();
+                order.push_back(index);
+                lock.unlock();
+            });
+
+            while (lock.GetWaiterCount() != index + 1)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        auto cpuStart{GetCpuTimeNs()};
+        std::this_thread::sleep_for(HoldDuration);
+        auto waiterCpuTime{GetCpuTimeNs() - cpuStart};
+        lock.unlock();
+
+        for (auto &waiter : waiters)
+            waiter.join();
+
+        std::cout << "Waiters used " << static_cast<double>(waiterCpuTime) / NsInMillisecond << "ms of CPU time while the lock was held for " << HoldDuration.count() << "ms\n";
+        if (waiterCpuTime > MaxWaiterCpuTime) {
+            std::cerr << "Waiters consumed CPU time while blocked on the lock\n";
+            errorCount++;
+        }
+
+        for (size_t index{}; index < order.size(); index++) {
+            if (order[index] != index) {
+                std::cerr << "Waiter " << order[index] << " acquired the lock in position " << index << "\n";
+                errorCount++;
+            }
+        }
+
+        return errorCount;
+    }
+
+    enum class LockMode {
+        PerEntry, //!< The lock is acquired before processing a GpEntry, the behaviour before lazy acquisition
+        Lazy, //!< The lock is acquired by the first method touching shared state, as ChannelContext::EnsureLocked does
+    };
+
+    /**
+     * @brief GPU state that is shared between channels, any access to it must be done while holding the lock
+     */
+    struct SharedState {
+        TicketLock lock;
+        std::atomic<bool> owned{}; //!< Used to detect multiple channels holding the lock at once
+        size_t accesses{}; //!< Deliberately non-atomic, lost updates indicate a lack of mutual exclusion
+        std::atomic<size_t> exclusionViolations{};
+    };
+
+    /**
+     * @brief A channel which follows the locking policy of ChannelContext and ChannelGpfifo::Run
+     */
+    struct SimulatedChannel {
+        SharedState &shared;
+        std::mt19937_64 generator;
+        bool locked{};
+        bool pendingWork{}; //!< If shared state was accessed since the last submission, this requires a submission before the lock can be released
+        i64 lockTimestamp{};
+        size_t acquisitions{}, contendedAcquisitions{}, sharedAccesses{};
+        i64 waitTime{}, holdTime{};
+        u64 workState{1};
+
+        SimulatedChannel(SharedState &shared, u64 seed) : shared{shared}, generator{seed} {}
+
+        void Lock() {
+            if (!shared.lock.try_lock()) {
+                auto waitStart{GetTimeNs()};
+                shared.lock.lock();
+                contendedAcquisitions++;
+                waitTime += GetTimeNs() - waitStart;
+            }
+
+            if (shared.owned.exchange(true))
+                shared.exclusionViolations++;
+
+            locked = true;
+            acquisitions++;
+            lockTimestamp = GetTimeNs();
+        }
+
+        void Unlock() {
+            pendingWork = false; // The work is always submitted before unlocking
+            holdTime += GetTimeNs() - lockTimestamp;
+            locked = false;
+            shared.owned = false;
+            shared.lock.unlock();
+        }
+
+        void EnsureLocked() {
+            if (!locked)
+                Lock();
+        }
+
+        bool ShouldYieldLock() const {
+            return locked && shared.lock.GetWaiterCount() && (!pendingWork || GetTimeNs() - lockTimestamp > LockStarvationThreshold);
+        }
+
+        void Run(LockMode mode, size_t batchCount) {
+            for (size_t batch{}; batch < batchCount; batch++) {
+                for (size_t entry{}; entry < EntriesPerBatch; entry++) {
+                    if (mode == LockMode::PerEntry)
+                        EnsureLocked();
+
+                    for (size_t method{}; method < MethodsPerEntry; method++) {
+                        workState = Work(workState, WorkPerMethod);
+                        if (generator() % 100 < SharedMethodPercentage) {
+                            EnsureLocked();
+                            shared.accesses++;
+                            sharedAccesses++;
+                            pendingWork = true;
+                        }
+                    }
+
+                    if (ShouldYieldLock())
+                        Unlock();
+                }
+
+                if (locked)
+                    Unlock();
+            }
+        }
+    };
+
+    /**
+     * @brief Runs all channels concurrently with the supplied locking mode and reports the time taken along with the lock statistics of every channel
+     * @return The amount of failed checks
+     */
+    size_t Simulate(LockMode mode, size_t batchCount, u64 seed) {
+        SharedState shared;
+        std::vector<SimulatedChannel> channels;
+        for (size_t index{}; index < ChannelCount; index++)
+            channels.emplace_back(shared, seed + index);
+
+        auto start{GetTimeNs()};
+        std::vector<std::thread> threads;
+        for (auto &channel : channels)
+            threads.emplace_back(&SimulatedChannel::Run, &channel, mode, batchCount);
+        for (auto &thread : threads)
+            thread.join();
+        auto duration{GetTimeNs() - start};
+
+        size_t sharedAccesses{};
+        u64 workState{};
+        std::cout << (mode == LockMode::Lazy ? "Lazy" : "Per-entry") << " locking took " << static_cast<double>(duration) / NsInMillisecond << "ms\n";
+        for (size_t index{}; index < channels.size(); index++) {
+            const auto &channel{channels[index]};
+            std::cout << "  Channel " << index << ": " << channel.acquisitions << " acquisitions (" << channel.contendedAcquisitions << " contended), waited "
+                      << static_cast<double>(channel.waitTime) / NsInMillisecond << "ms, held " << static_cast<double>(channel.holdTime) / NsInMillisecond << "ms\n";
+            sharedAccesses += channel.sharedAccesses;
+            workState ^= channel.workState;
+        }
+
+        size_t errorCount{};
+        if (shared.accesses != sharedAccesses) {
+            std::cerr << "Shared state was accessed " << sharedAccesses << " times but recorded " << shared.accesses << " accesses\n";
+            errorCount++;
+        }
+
+        if (shared.exclusionViolations) {
+            std::cerr << "The lock was held by multiple channels at once " << shared.exclusionViolations << " times\n";
+            errorCount++;
+        }
+
+        return errorCount + (workState == 0); // The work state is checked so the busy work can't be optimised out
+    }
+}
+
+/**
+ * @brief Checks that the channel lock is handed off fairly without spinning and simulates channels processing GpEntries concurrently with lazy and per-entry acquisition of the lock
+ */
+int main(int argc, char **argv) {
+    size_t batchCount{argc > 1 ? std::strtoull(argv[1], nullptr, 0) : 200};
+    u64 seed{argc > 2 ? std::strtoull(argv[2], nullptr, 0) : std::random_device{}()};
+    std::cout << "Simulating " << ChannelCount << " channels processing " << batchCount << " batches each with seed " << seed << "\n";
+
+    size_t errorCount{CheckHandoff()};
+    errorCount += Simulate(LockMode::PerEntry, batchCount, seed);
+    errorCount += Simulate(LockMode::Lazy, batchCount, seed);
+
+    if (errorCount) {
+        std::cerr << errorCount << " checks failed\n";
+        return 1;
+    }
+
+    return 0;
+}
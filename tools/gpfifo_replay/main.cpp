@@ -0,0 +1,356 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2023 Strato Team and Contributors (https://github.com/strato-emu/)
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sys/mman.h>
+#include <common/dirty_tracking.h>
+#include <soc/gm20b/engines/maxwell/types.h>
+#include <soc/gm20b/gpfifo_capture.h>
+
+using namespace skyline;
+using namespace skyline::soc::gm20b;
+
+namespace {
+    /**
+     * @brief The GPU address space of a replay, every GMMU mapping in the capture is backed by zero-filled host memory and pushbuffers are written into it before they're processed
+     */
+    class ReplayAddressSpace {
+      private:
+        struct Mapping {
+            u8 *memory;
+            u64 size;
+
+            Mapping(u64 size) : memory{static_cast<u8 *>(mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0))}, size{size} {
+                if (memory == MAP_FAILED)
+                    throw exception("Failed to allocate 0x{:X} bytes for a replay mapping", size);
+            }
+
+            Mapping(const Mapping &) = delete;
+
+            ~Mapping() {
+                munmap(memory, size);
+            }
+        };
+
+        std::map<u64, std::unique_ptr<Mapping>> mappings; //!< A map from the GPU VA of mappings to their backing
+
+      public:
+        /**
+         * @brief Maps zero-filled memory at the supplied range, replacing any mappings overlapping it
+         */
+        void Map(u64 gpuAddress, u64 size) {
+            auto it{mappings.lower_bound(gpuAddress)};
+            if (it != mappings.begin() && std::prev(it)->first + std::prev(it)->second->size > gpuAddress)
+                it--;
+            while (it != mappings.end() && it->first < gpuAddress + size)
+                it = mappings.erase(it);
+
+            mappings.emplace(gpuAddress, std::make_unique<Mapping>(size));
+        }
+
+        /**
+         * @return The host memory backing the supplied range, split at mapping boundaries as GMMU::TranslateRange would
+         */
+        std::vector<span<u8>> TranslateRange(u64 gpuAddress, u64 size) {
+            std::vector<span<u8>> ranges;
+            while (size) {
+                auto it{mappings.upper_bound(gpuAddress)};
+                if (it == mappings.begin() || std::prev(it)->first + std::prev(it)->second->size <= gpuAddress)
+                    throw exception("Pushbuffer at 0x{:X} isn't in any captured mapping", gpuAddress);
+
+                auto &mapping{*std::prev(it)};
+                u64 offset{gpuAddress - mapping.first}, rangeSize{std::min(size, mapping.second->size - offset)};
+                ranges.emplace_back(mapping.second->memory + offset, rangeSize);
+                gpuAddress += rangeSize;
+                size -= rangeSize;
+            }
+            return ranges;
+        }
+    };
+
+    /**
+     * @brief A headless engine with the register state machine of Maxwell3D::HandleMethod: shadow RAM, dirty tracking and macro uploads, draws are counted rather than executed
+     */
+    class ReplayEngine : public engine::MacroEngineBase {
+      private:
+        static constexpr u32 InstructionRamPointer{0x45}, InstructionRamLoad{0x46}, StartAddressRamPointer{0x47}, StartAddressRamLoad{0x48}, ShadowRamControl{0x49}; //!< The offsets of Maxwell3D::Registers::MME
+        static constexpr size_t DirtyBlockSize{0x20}; //!< The size of the register blocks which are each bound to a dirty handle, this approximates the bindings of the 3D interconnect
+
+        static constexpr std::array<bool, engine::EngineMethodsEnd> SideEffectMethods{[] {
+            std::array<bool, engine::EngineMethodsEnd> methods{};
+            for (u32 method{InstructionRamPointer}; method <= ShadowRamControl; method++)
+                methods[method] = true;
+            return methods;
+        }()};
+
+        using DirtyManager = dirty::Manager<engine::EngineMethodsEnd * sizeof(u32), sizeof(u32)>;
+
+        std::array<u32, engine::EngineMethodsEnd> registers{};
+        std::array<u32, engine::EngineMethodsEnd> shadowRegisters{};
+        std::array<bool, engine::EngineMethodsEnd / DirtyBlockSize> dirty{};
+        std::unique_ptr<DirtyManager> dirtyManager{std::make_unique<DirtyManager>(registers)};
+
+        engine::maxwell3d::type::MmeShadowRamControl GetShadowRamControl() const {
+            return static_cast<engine::maxwell3d::type::MmeShadowRamControl>(shadowRegisters[ShadowRamControl]);
+        }
+
+      public:
+        size_t drawCount{};
+
+        ReplayEngine(MacroState &macroState) : MacroEngineBase{macroState} {
+            // The last block isn't bound as the dirty manager doesn't allow bindings which end at the end of the managed resource
+            for (size_t block{}; block < dirty.size() - 1; block++)
+                dirtyManager->Bind(dirty::Handle{&dirty[block]}, reinterpret_cast<uintptr_t>(&registers[block * DirtyBlockSize]), DirtyBlockSize * sizeof(u32));
+        }
+
+        void CallMethod(u32 method, u32 argument) {
+            if (method == ShadowRamControl) [[unlikely]] {
+                shadowRegisters[method] = registers[method] = argument;
+                return;
+            }
+
+            auto shadowRamControl{GetShadowRamControl()};
+            if (shadowRamControl == engine::maxwell3d::type::MmeShadowRamControl::MethodTrack || shadowRamControl == engine::maxwell3d::type::MmeShadowRamControl::MethodTrackWithFilter) [[unlikely]]
+                shadowRegisters[method] = argument;
+            else if (shadowRamControl == engine::maxwell3d::type::MmeShadowRamControl::MethodReplay) [[unlikely]]
+                argument = shadowRegisters[method];
+
+            bool redundant{registers[method] == argument};
+            registers[method] = argument;
+            if (!redundant)
+                dirtyManager->MarkDirty(method);
+
+            if (method == InstructionRamLoad) {
+                macroState.macroCode[registers[InstructionRamPointer]++ % macroState.macroCode.size()] = argument;
+                registers[InstructionRamPointer] %= macroState.macroCode.size();
+                macroState.Invalidate();
+            } else if (method == StartAddressRamLoad) {
+                macroState.macroPositions[registers[StartAddressRamPointer]++ % macroState.macroPositions.size()] = argument;
+                macroState.Invalidate();
+            }
+        }
+
+        /**
+         * @brief The equivalent of Maxwell3D::CallMethodBatchInc outside of constant buffer updates and deferred draws
+         */
+        void CallMethodBatchInc(u32 method, span<u32> arguments) {
+            while (!arguments.empty()) {
+                auto shadowRamControl{GetShadowRamControl()};
+                if (shadowRamControl == engine::maxwell3d::type::MmeShadowRamControl::MethodReplay || SideEffectMethods[method]) {
+                    CallMethod(method++, arguments.front());
+                    arguments = arguments.subspan(1);
+                    continue;
+                }
+
+                bool trackShadow{shadowRamControl == engine::maxwell3d::type::MmeShadowRamControl::MethodTrack || shadowRamControl == engine::maxwell3d::type::MmeShadowRamControl::MethodTrackWithFilter};
+                auto count{engine::CountPlainMethods(SideEffectMethods, method, arguments.size())};
+                engine::WriteRegisterRun(registers.data(), trackShadow ? shadowRegisters.data() : nullptr, *dirtyManager, method, arguments.first(count));
+
+                method += static_cast<u32>(count);
+                arguments = arguments.subspan(count);
+            }
+        }
+
+        void CallMethodFromMacro(u32 method, u32 argument) override {
+            CallMethod(method % engine::EngineMethodsEnd, argument);
+        }
+
+        u32 ReadMethodFromMacro(u32 method) override {
+            return registers[method % engine::EngineMethodsEnd];
+        }
+
+        void DrawInstanced(u32, u32, u32, u32, u32) override {
+            drawCount++;
+        }
+
+        void DrawIndexedInstanced(u32, u32, u32, u32, u32, u32) override {
+            drawCount++;
+        }
+
+        void DrawIndexedIndirect(u32, span<u8>, u32 count, u32) override {
+            drawCount += count;
+        }
+    };
+
+    constexpr size_t SubchannelCount{8};
+    constexpr std::array<const char *, SubchannelCount + 1> EngineNames{"3D", "Compute", "Inline2Memory", "2D", "Copy", "Software0", "Software1", "Software2", "GPFIFO"};
+
+    struct EngineStatistics {
+        size_t methodCount;
+        std::chrono::nanoseconds time;
+    };
+
+    /**
+     * @brief The equivalent of ChannelGpfifo for a replay, methods are dispatched to headless engines and the time spent in each engine can optionally be measured
+     * @note GPFIFO engine methods (semaphores, syncpoints and such) are only counted as they depend on the host1x
+     */
+    class ReplayChannel {
+      private:
+        std::unique_ptr<MacroState> macroState{std::make_unique<MacroState>()};
+        std::array<std::unique_ptr<ReplayEngine>, SubchannelCount> engines;
+        PushBufferParser<ReplayChannel> pushBufferParser{*this};
+        friend PushBufferParser<ReplayChannel>;
+        bool measureEngines;
+
+        static constexpr size_t GpfifoStatisticsIndex{SubchannelCount};
+
+        /**
+         * @brief Runs the supplied function and attributes the methods and time spent in it to the supplied engine
+         */
+        template<typename Function>
+        void Dispatch(size_t engineIndex, size_t methodCount, Function &&function) {
+            auto &engineStatistics{statistics[engineIndex]};
+            engineStatistics.methodCount += methodCount;
+            if (!measureEngines) {
+                function();
+                return;
+            }
+
+            auto start{std::chrono::steady_clock::now()};
+            function();
+            engineStatistics.time += std::chrono::steady_clock::now() - start;
+        }
+
+        ReplayEngine &Engine(SubchannelId subChannel) {
+            return *engines[static_cast<size_t>(subChannel)];
+        }
+
+        void SendFull(u32 method, GpfifoArgument argument, SubchannelId subChannel, bool lastCall) {
+            if (method < engine::GPFIFO::RegisterCount) {
+                Dispatch(GpfifoStatisticsIndex, 1, [] {});
+            } else if (method < engine::EngineMethodsEnd) {
+                Dispatch(static_cast<size_t>(subChannel), 1, [&] { Engine(subChannel).CallMethod(method, *argument); });
+            } else if (subChannel == SubchannelId::ThreeD || subChannel == SubchannelId::TwoD) {
+                static const std::function<void(void)> flushCallback{[] {}};
+                Dispatch(static_cast<size_t>(subChannel), 1, [&] { Engine(subChannel).HandleMacroCall(method - engine::EngineMethodsEnd, argument, lastCall, flushCallback); });
+            }
+        }
+
+        void SendPure(u32 method, u32 argument, SubchannelId subChannel) {
+            Dispatch(static_cast<size_t>(subChannel), 1, [&] { Engine(subChannel).CallMethod(method, argument); });
+        }
+
+        void SendPureBatchNonInc(u32 method, span<u32> arguments, SubchannelId subChannel) {
+            Dispatch(static_cast<size_t>(subChannel), arguments.size(), [&] {
+                for (u32 argument : arguments)
+                    Engine(subChannel).CallMethod(method, argument);
+            });
+        }
+
+        void SendPureBatchInc(u32 method, span<u32> arguments, SubchannelId subChannel) {
+            Dispatch(static_cast<size_t>(subChannel), arguments.size(), [&] {
+                if (subChannel == SubchannelId::ThreeD) {
+                    Engine(subChannel).CallMethodBatchInc(method, arguments);
+                } else {
+                    for (u32 argument : arguments)
+                        Engine(subChannel).CallMethod(method++, argument);
+                }
+            });
+        }
+
+        void FlushEngineState() {}
+
+      public:
+        std::array<EngineStatistics, SubchannelCount + 1> statistics{};
+
+        ReplayChannel(bool measureEngines) : measureEngines{measureEngines} {
+            for (auto &engine : engines)
+                engine = std::make_unique<ReplayEngine>(*macroState);
+        }
+
+        /**
+         * @brief Processes a pushbuffer in place from the supplied ranges of the replay's address space, the same as ChannelGpfifo::Process
+         */
+        void Process(const std::vector<span<u8>> &ranges) {
+            for (auto range : ranges)
+                if (pushBufferParser.Process(range.cast<u32>(), false, false))
+                    break;
+        }
+
+        size_t DrawCount() const {
+            size_t drawCount{};
+            for (const auto &engine : engines)
+                drawCount += engine->drawCount;
+            return drawCount;
+        }
+    };
+
+    /**
+     * @brief Replays an entire capture on a new channel and address space
+     * @return The time spent processing pushbuffers, this excludes setting up mappings and writing pushbuffers into them
+     */
+    std::chrono::nanoseconds Replay(const GpfifoCaptureReader &capture, ReplayChannel &channel) {
+        ReplayAddressSpace addressSpace;
+        std::chrono::nanoseconds time{};
+        for (const auto &entry : capture.entries) {
+            for (const auto &mapping : entry.mappings)
+                addressSpace.Map(mapping.gpuAddress, mapping.size);
+
+            if (entry.pushBuffer.empty())
+                continue; // Control entries have no effect beyond being logged
+
+            auto ranges{addressSpace.TranslateRange(entry.gpEntry.Address(), entry.pushBuffer.size() * sizeof(u32))};
+            auto words{reinterpret_cast<const u8 *>(entry.pushBuffer.data())};
+            for (auto range : ranges) {
+                std::memcpy(range.data(), words, range.size());
+                words += range.size();
+            }
+
+            auto start{std::chrono::steady_clock::now()};
+            channel.Process(ranges);
+            time += std::chrono::steady_clock::now() - start;
+        }
+        return time;
+    }
+}
+
+/**
+ * @brief Replays a GPFIFO capture through the pushbuffer parser, macros and headless engines, reporting the throughput of the GPU frontend and the time spent in each engine
+ */
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <capture> [iterations]\n";
+        return 1;
+    }
+
+    size_t iterations{argc > 2 ? std::strtoull(argv[2], nullptr, 0) : 5};
+
+    try {
+        GpfifoCaptureReader capture{argv[1]};
+        std::cout << "Loaded " << capture.entries.size() << " GpEntries with " << capture.wordCount << " pushbuffer words\n";
+
+        // The throughput is measured without timing each engine call as that adds a significant amount of overhead to every method, the fastest iteration is reported
+        std::chrono::nanoseconds bestTime{std::chrono::nanoseconds::max()};
+        size_t methodCount{}, drawCount{};
+        for (size_t iteration{}; iteration < iterations; iteration++) {
+            ReplayChannel channel{false};
+            bestTime = std::min(bestTime, Replay(capture, channel));
+
+            methodCount = 0;
+            for (const auto &engineStatistics : channel.statistics)
+                methodCount += engineStatistics.methodCount;
+            drawCount = channel.DrawCount();
+        }
+
+        double seconds{std::chrono::duration<double>(bestTime).count()};
+        std::cout << "Dispatched " << methodCount << " methods with " << drawCount << " draws in " << seconds * 1000 << "ms: " << static_cast<double>(methodCount) / seconds << " methods/s, "
+                  << static_cast<double>(capture.wordCount) / seconds << " words/s\n";
+
+        ReplayChannel channel{true};
+        auto totalTime{Replay(capture, channel)};
+        for (size_t index{}; index < EngineNames.size(); index++) {
+            const auto &engineStatistics{channel.statistics[index]};
+            if (engineStatistics.methodCount)
+                std::cout << EngineNames[index] << ": " << engineStatistics.methodCount << " methods, " << std::chrono::duration<double, std::milli>(engineStatistics.time).count() << "ms ("
+                          << 100.0 * static_cast<double>(engineStatistics.time.count()) / static_cast<double>(totalTime.count()) << "% of the measured replay)\n";
+        }
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,13 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2023 Strato Team and Contributors (https://github.com/strato-emu/)
+
+#include <common/exception.h>
+
+namespace skyline {
+    /**
+     * @note The emulator walks AArch64 frame records to collect these, host tools have no use for stack traces so none are collected
+     */
+    std::vector<void *> exception::GetStackFrames() {
+        return {};
+    }
+}
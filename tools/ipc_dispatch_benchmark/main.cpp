@@ -0,0 +1,434 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2023 Strato Team and Contributors (https://github.com/strato-emu/)
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <frozen/unordered_map.h>
+#include <common.h>
+#include <services/service_function_table.h>
+
+using namespace skyline;
+using namespace skyline::service;
+
+namespace {
+    constexpr size_t TlsIpcSize{0x100}; //!< constant::TlsIpcSize
+    constexpr size_t PayloadOffset{0x10}; //!< The offset of the payload header in a HIPC message without handles or buffers, the command header is followed by padding up to this
+    constexpr u32 RequestMagic{0x49434653}; //!< "SFCI"
+    constexpr u32 ResponseMagic{0x4F434653}; //!< "SFCO"
+
+    using TlsBuffer = std::array<u8, TlsIpcSize>;
+
+    /**
+     * @brief The subset of ipc::PayloadHeader that's relevant to dispatching
+     */
+    struct PayloadHeader {
+        u32 magic;
+        u32 version;
+        u32 value; //!< The command ID in requests and the result in responses
+        u32 token;
+    };
+
+    /**
+     * @brief A HIPC request read from a TLS buffer as ipc::IpcRequest does for requests without handles or buffers
+     */
+    struct Request {
+        u32 commandId;
+        const u8 *argument; //!< The next argument to be popped from the payload
+
+        explicit Request(const TlsBuffer &tls) {
+            PayloadHeader header;
+            std::memcpy(&header, tls.data() + PayloadOffset, sizeof(PayloadHeader));
+            commandId = header.value;
+            argument = tls.data() + PayloadOffset + sizeof(PayloadHeader);
+        }
+
+        template<typename ValueType>
+        ValueType Pop() {
+            ValueType value;
+            std::memcpy(&value, argument, sizeof(ValueType));
+            argument += sizeof(ValueType);
+            return value;
+        }
+    };
+
+    /**
+     * @brief A response with an inline payload bounded by the space in TLS, this is equivalent to ipc::IpcResponse
+     */
+    struct InlineResponse {
+        std::array<u8, TlsIpcSize - PayloadOffset - sizeof(PayloadHeader)> payload;
+        size_t payloadSize{};
+        Result errorCode{};
+
+        template<typename ValueType>
+        void Push(const ValueType &value) {
+            if (payloadSize + sizeof(ValueType) > payload.size())
+                throw exception("IPC response payload overflow: 0x{:X} + 0x{:X} bytes", payloadSize, sizeof(ValueType));
+            std::memcpy(payload.data() + payloadSize, &value, sizeof(ValueType));
+            payloadSize += sizeof(ValueType);
+        }
+
+        span<const u8> GetPayload() const {
+            return span(payload).first(payloadSize);
+        }
+    };
+
+    /**
+     * @brief A response which grows its payload on the heap, this is equivalent to ipc::IpcResponse prior to it using an inline payload
+     */
+    struct VectorResponse {
+        std::vector<u8> payload;
+        Result errorCode{};
+
+        template<typename ValueType>
+        void Push(const ValueType &value) {
+            payload.resize(payload.size() + sizeof(ValueType));
+            std::memcpy(payload.data() + payload.size() - sizeof(ValueType), &value, sizeof(ValueType));
+        }
+
+        span<const u8> GetPayload() const {
+            return payload;
+        }
+    };
+
+    /**
+     * @brief Serializes a response into TLS as ipc::IpcResponse::WriteResponse does for responses without handles or domain objects
+     */
+    template<typename Response>
+    void WriteResponse(const Response &response, TlsBuffer &tls) {
+        auto payload{response.GetPayload()};
+        if (PayloadOffset + sizeof(PayloadHeader) + payload.size() > tls.size())
+            throw exception("IPC response doesn't fit into TLS: 0x{:X} byte payload", payload.size());
+
+        tls.fill(0);
+        u32 rawSize{static_cast<u32>((sizeof(PayloadHeader) + PayloadOffset + payload.size() + sizeof(u32) - 1) / sizeof(u32))};
+        std::memcpy(tls.data() + sizeof(u32), &rawSize, sizeof(u32));
+
+        PayloadHeader header{ResponseMagic, 1, response.errorCode, 0};
+        std::memcpy(tls.data() + PayloadOffset, &header, sizeof(PayloadHeader));
+        std::memcpy(tls.data() + PayloadOffset + sizeof(PayloadHeader), payload.data(), payload.size());
+    }
+
+    /**
+     * @brief A service whose commands all share one handler which consumes and produces a fixed amount of words, this stands in for the HLE handlers which are mostly trivial
+     */
+    template<typename Response>
+    struct SyntheticService {
+        u32 state{1};
+
+        template<size_t ArgumentWords, size_t ResultWords>
+        Result Handle(Request &request, Response &response) {
+            for (size_t index{}; index < ArgumentWords; index++)
+                state = state * 31 + request.Pop<u32>();
+            for (size_t index{}; index < ResultWords; index++)
+                response.template Push<u32>(state + static_cast<u32>(index));
+            return {};
+        }
+
+        /**
+         * @brief The same as ServiceFunctionEntry but with the synthetic handler signature
+         */
+        struct Entry {
+            u32 id;
+            Result (SyntheticService::*function)(Request &, Response &);
+            const char *name;
+        };
+    };
+
+    #define COMMAND(id, name, argumentWords, resultWords) typename Service::Entry{id, &Service::template Handle<argumentWords, resultWords>, #name}
+
+    /**
+     * @brief The commands of IHidServer with their IDs as declared in its SERVICE_DECL
+     */
+    template<typename Response>
+    struct HidServer {
+        using Service = SyntheticService<Response>;
+        static constexpr std::array Entries{
+            COMMAND(0x0, CreateAppletResource, 2, 0), COMMAND(0x1, ActivateDebugPad, 2, 0), COMMAND(0xB, ActivateTouchScreen, 2, 0),
+            COMMAND(0x15, ActivateMouse, 2, 0), COMMAND(0x1F, ActivateKeyboard, 2, 0), COMMAND(0x42, StartSixAxisSensor, 3, 0),
+            COMMAND(0x43, StopSixAxisSensor, 3, 0), COMMAND(0x4F, SetGyroscopeZeroDriftMode, 4, 0), COMMAND(0x50, GetGyroscopeZeroDriftMode, 3, 1),
+            COMMAND(0x51, ResetGyroscopeZeroDriftMode, 3, 0), COMMAND(0x52, IsSixAxisSensorAtRest, 3, 1), COMMAND(0x64, SetSupportedNpadStyleSet, 3, 0),
+            COMMAND(0x65, GetSupportedNpadStyleSet, 2, 1), COMMAND(0x66, SetSupportedNpadIdType, 2, 0), COMMAND(0x67, ActivateNpad, 2, 0),
+            COMMAND(0x68, DeactivateNpad, 2, 0), COMMAND(0x6A, AcquireNpadStyleSetUpdateEventHandle, 4, 0), COMMAND(0x6C, GetPlayerLedPattern, 1, 2),
+            COMMAND(0x6D, ActivateNpadWithRevision, 3, 0), COMMAND(0x78, SetNpadJoyHoldType, 4, 0), COMMAND(0x79, GetNpadJoyHoldType, 2, 2),
+            COMMAND(0x7A, SetNpadJoyAssignmentModeSingleByDefault, 3, 0), COMMAND(0x7B, SetNpadJoyAssignmentModeSingle, 5, 0), COMMAND(0x7C, SetNpadJoyAssignmentModeDual, 3, 0),
+            COMMAND(0x7E, StartLrAssignmentMode, 2, 0), COMMAND(0x7F, StopLrAssignmentMode, 2, 0), COMMAND(0x80, SetNpadHandheldActivationMode, 4, 0),
+            COMMAND(0x81, GetNpadHandheldActivationMode, 2, 2), COMMAND(0xC8, GetVibrationDeviceInfo, 1, 2), COMMAND(0xC9, SendVibrationValue, 8, 0),
+            COMMAND(0xCB, CreateActiveVibrationDeviceList, 0, 0), COMMAND(0xCD, IsVibrationPermitted, 0, 1), COMMAND(0xCE, SendVibrationValues, 2, 0),
+            COMMAND(0xD3, IsVibrationDeviceMounted, 3, 1), COMMAND(0x12C, ActivateConsoleSixAxisSensor, 2, 0), COMMAND(0x132, InitializeSevenSixAxisSensor, 2, 0),
+            COMMAND(0x136, ResetSevenSixAxisSensorTimestamp, 2, 0), COMMAND(0x20D, SetPalmaBoostMode, 1, 0),
+        };
+    };
+
+    /**
+     * @brief The commands of INvDrvServices, Ioctl is declared under three IDs so it's split into its variants here
+     */
+    template<typename Response>
+    struct NvDrvServices {
+        using Service = SyntheticService<Response>;
+        static constexpr std::array Entries{
+            COMMAND(0x0, Open, 0, 2), COMMAND(0x1, Ioctl, 2, 1), COMMAND(0x2, Close, 1, 1), COMMAND(0x3, Initialize, 1, 1),
+            COMMAND(0x4, QueryEvent, 2, 1), COMMAND(0x6, GetStatus, 0, 4), COMMAND(0x8, SetAruid, 2, 1), COMMAND(0x9, DumpStatus, 0, 0),
+            COMMAND(0xB, Ioctl2, 2, 1), COMMAND(0xC, Ioctl3, 2, 1), COMMAND(0xD, SetGraphicsFirmwareMemoryMarginEnabled, 1, 0),
+        };
+    };
+
+    /**
+     * @brief The commands of IAudioRenderer, RequestUpdate is declared under two IDs so it's split into its variants here
+     */
+    template<typename Response>
+    struct AudioRenderer {
+        using Service = SyntheticService<Response>;
+        static constexpr std::array Entries{
+            COMMAND(0x0, GetSampleRate, 0, 1), COMMAND(0x1, GetSampleCount, 0, 1), COMMAND(0x2, GetMixBufferCount, 0, 1),
+            COMMAND(0x3, GetState, 0, 1), COMMAND(0x4, RequestUpdate, 0, 0), COMMAND(0x5, Start, 0, 0),
+            COMMAND(0x6, Stop, 0, 0), COMMAND(0x7, QuerySystemEvent, 0, 0), COMMAND(0x8, SetRenderingTimeLimit, 1, 0),
+            COMMAND(0x9, GetRenderingTimeLimit, 0, 1), COMMAND(0xA, RequestUpdateAuto, 0, 0), COMMAND(0xC, SetVoiceDropParameter, 1, 1),
+            COMMAND(0xD, GetVoiceDropParameter, 0, 1),
+        };
+    };
+
+    /**
+     * @brief The commands of IFriendService, most of its IDs are above MaxDirectServiceFunctionId so this covers the binary search in ServiceFunctionTable
+     */
+    template<typename Response>
+    struct FriendService {
+        using Service = SyntheticService<Response>;
+        static constexpr std::array Entries{
+            COMMAND(0x0, GetCompletionEvent, 0, 0), COMMAND(0x2775, GetFriendList, 6, 1), COMMAND(0x2788, CheckFriendListAvailability, 4, 1),
+            COMMAND(0x28A0, GetBlockedUserListIds, 5, 1), COMMAND(0x2968, DeclareOpenOnlinePlaySession, 4, 0), COMMAND(0x2969, DeclareCloseOnlinePlaySession, 4, 0),
+            COMMAND(0x2972, UpdateUserPresence, 6, 0), COMMAND(0x29CC, GetPlayHistoryRegistrationKey, 5, 0),
+        };
+    };
+
+    #undef COMMAND
+
+    /**
+     * @brief Dispatches requests through ServiceFunctionTable as SERVICE_DECL does
+     */
+    template<template<typename> typename Declaration, typename Response>
+    struct TableDispatcher {
+        static constexpr auto &Entries{Declaration<Response>::Entries};
+        static constexpr ServiceFunctionTable<typename SyntheticService<Response>::Entry, Entries.size(), GetDirectServiceFunctionCount(Entries)> Functions{Entries};
+
+        SyntheticService<Response> service;
+        size_t missingCount{};
+
+        static const char *Lookup(u32 id) {
+            auto function{Functions.Find(id)};
+            return function ? function->name : nullptr;
+        }
+
+        Result Dispatch(Request &request, Response &response) {
+            auto function{Functions.Find(request.commandId)};
+            if (!function) {
+                missingCount++;
+                return {};
+            }
+            return (service.*function->function)(request, response);
+        }
+    };
+
+    /**
+     * @brief Dispatches requests through a frozen::unordered_map which throws on missing commands, this is equivalent to SERVICE_DECL prior to ServiceFunctionTable
+     */
+    template<template<typename> typename Declaration, typename Response>
+    struct HashMapDispatcher {
+        using Entry = typename SyntheticService<Response>::Entry;
+        static constexpr auto &Entries{Declaration<Response>::Entries};
+
+        static constexpr auto MakeItems() {
+            std::array<std::pair<u32, std::pair<decltype(Entry::function), const char *>>, Entries.size()> items{};
+            for (size_t index{}; index < Entries.size(); index++)
+                items[index] = {Entries[index].id, {Entries[index].function, Entries[index].name}};
+            return items;
+        }
+
+        static constexpr auto Items{MakeItems()};
+        static constexpr auto Functions{frozen::make_unordered_map(Items)};
+
+        SyntheticService<Response> service;
+        size_t missingCount{};
+
+        static const char *Lookup(u32 id) {
+            auto it{Functions.find(id)};
+            return it != Functions.end() ? it->second.second : nullptr;
+        }
+
+        Result Dispatch(Request &request, Response &response) {
+            try {
+                auto &function{Functions.at(request.commandId)};
+                return (service.*function.first)(request, response);
+            } catch (const std::out_of_range &) {
+                missingCount++;
+                return {};
+            }
+        }
+    };
+
+    /**
+     * @brief A synthetic client session to each of the services, requests are processed as ServiceManager::SyncRequestHandler does
+     */
+    template<template<template<typename> typename, typename> typename Dispatcher, typename Response>
+    struct Session {
+        Dispatcher<HidServer, Response> hid;
+        Dispatcher<NvDrvServices, Response> nvdrv;
+        Dispatcher<AudioRenderer, Response> audio;
+
+        /**
+         * @brief Handles the request in TLS and replaces it with the response
+         */
+        void SendSyncRequest(size_t serviceIndex, TlsBuffer &tls) {
+            Request request{tls};
+            Response response{};
+            switch (serviceIndex) {
+                case 0:
+                    response.errorCode = hid.Dispatch(request, response);
+                    break;
+                case 1:
+                    response.errorCode = nvdrv.Dispatch(request, response);
+                    break;
+                default:
+                    response.errorCode = audio.Dispatch(request, response);
+                    break;
+            }
+            WriteResponse(response, tls);
+        }
+
+        size_t GetMissingCount() const {
+            return hid.missingCount + nvdrv.missingCount + audio.missingCount;
+        }
+    };
+
+    /**
+     * @brief A request from the synthetic workload, the TLS buffer is copied before sending it as the response overwrites it
+     */
+    struct Message {
+        size_t serviceIndex;
+        TlsBuffer tls;
+    };
+
+    template<typename Entries>
+    Message MakeMessage(std::mt19937_64 &generator, size_t serviceIndex, const Entries &entries) {
+        Message message{serviceIndex, {}};
+
+        // A small fraction of requests are for commands that aren't implemented, games regularly hit these
+        u32 commandId{generator() % 64 == 0 ? static_cast<u32>(0x400 + generator() % 0x2000) : entries[generator() % entries.size()].id};
+        PayloadHeader header{RequestMagic, 0, commandId, 0};
+        std::memcpy(message.tls.data() + PayloadOffset, &header, sizeof(PayloadHeader));
+        for (size_t offset{PayloadOffset + sizeof(PayloadHeader)}; offset < message.tls.size(); offset++)
+            message.tls[offset] = static_cast<u8>(generator());
+        return message;
+    }
+
+    /**
+     * @brief Generates a mix of requests weighted towards the services that are called every frame
+     */
+    std::vector<Message> GenerateWorkload(std::mt19937_64 &generator, size_t count) {
+        std::vector<Message> messages;
+        messages.reserve(count);
+        for (size_t index{}; index < count; index++) {
+            auto roll{generator() % 100};
+            if (roll < 50)
+                messages.push_back(MakeMessage(generator, 1, NvDrvServices<InlineResponse>::Entries));
+            else if (roll < 80)
+                messages.push_back(MakeMessage(generator, 2, AudioRenderer<InlineResponse>::Entries));
+            else
+                messages.push_back(MakeMessage(generator, 0, HidServer<InlineResponse>::Entries));
+        }
+        return messages;
+    }
+
+    /**
+     * @brief Checks that the table resolves every HIPC and TIPC command ID in range to the same function as the hash map
+     * @return The amount of IDs which resolved differently
+     */
+    template<template<typename> typename Declaration>
+    size_t CheckLookup(const char *name) {
+        using Table = TableDispatcher<Declaration, InlineResponse>;
+        using HashMap = HashMapDispatcher<Declaration, InlineResponse>;
+
+        size_t mismatchCount{};
+        for (u32 flag : {0U, TipcFunctionIdFlag}) {
+            for (u32 id{}; id < MaxDirectServiceFunctionId * 3; id++) {
+                if (Table::Lookup(flag | id) != HashMap::Lookup(flag | id) && mismatchCount++ < 10)
+                    std::cerr << name << " command 0x" << std::hex << (flag | id) << std::dec << " resolved to a different function\n";
+            }
+        }
+        return mismatchCount;
+    }
+
+    /**
+     * @brief Sends every message through the session
+     * @param hashes If supplied, a hash of each response is collected into it, this is done outside of timing runs as hashing takes longer than dispatching
+     */
+    template<typename SessionType>
+    std::chrono::nanoseconds Run(SessionType &session, const std::vector<Message> &messages, std::vector<u64> *hashes) {
+        if (hashes)
+            hashes->resize(messages.size());
+
+        TlsBuffer tls;
+        auto start{std::chrono::steady_clock::now()};
+        for (size_t index{}; index < messages.size(); index++) {
+            tls = messages[index].tls;
+            session.SendSyncRequest(messages[index].serviceIndex, tls);
+
+            if (hashes) {
+                u64 hash{14695981039346656037ULL};
+                for (u8 byte : tls)
+                    hash = (hash ^ byte) * 1099511628211ULL;
+                (*hashes)[index] = hash;
+            }
+        }
+        return std::chrono::steady_clock::now() - start;
+    }
+}
+
+/**
+ * @brief Checks that command lookup through ServiceFunctionTable matches the prior hash map dispatch, then pumps a mix of hid, nvdrv and audio requests through a synthetic session with both and reports the time per request
+ */
+int main(int argc, char **argv) {
+    size_t requestCount{argc > 1 ? std::strtoull(argv[1], nullptr, 0) : 2000000};
+    u64 seed{argc > 2 ? std::strtoull(argv[2], nullptr, 0) : std::random_device{}()};
+    std::cout << "Sending " << requestCount << " requests with seed " << seed << "\n";
+
+    size_t errorCount{CheckLookup<HidServer>("IHidServer") + CheckLookup<NvDrvServices>("INvDrvServices") + CheckLookup<AudioRenderer>("IAudioRenderer") + CheckLookup<FriendService>("IFriendService")};
+
+    std::mt19937_64 generator{seed};
+    auto messages{GenerateWorkload(generator, requestCount)};
+
+    Session<HashMapDispatcher, VectorResponse> hashMapSession;
+    Session<TableDispatcher, InlineResponse> tableSession;
+    std::vector<u64> hashMapHashes, tableHashes;
+    Run(hashMapSession, messages, &hashMapHashes);
+    Run(tableSession, messages, &tableHashes);
+
+    Session<HashMapDispatcher, VectorResponse> hashMapTimingSession;
+    Session<TableDispatcher, InlineResponse> tableTimingSession;
+    auto hashMapTime{Run(hashMapTimingSession, messages, nullptr)};
+    auto tableTime{Run(tableTimingSession, messages, nullptr)};
+
+    for (size_t index{}; index < messages.size(); index++) {
+        if (hashMapHashes[index] != tableHashes[index] && errorCount++ < 10)
+            std::cerr << "Responses to request " << index << " differ\n";
+    }
+
+    if (hashMapSession.GetMissingCount() != tableSession.GetMissingCount()) {
+        std::cerr << "Missing commands differ: " << hashMapSession.GetMissingCount() << " with the hash map, " << tableSession.GetMissingCount() << " with the table\n";
+        errorCount++;
+    }
+
+    auto perRequest{[&](std::chrono::nanoseconds time) { return static_cast<double>(time.count()) / static_cast<double>(messages.size()); }};
+    std::cout << "Hash map with heap payload: " << perRequest(hashMapTime) << "ns/request, table with inline payload: " << perRequest(tableTime) << "ns/request ("
+              << tableSession.GetMissingCount() << " requests for missing commands)\n";
+
+    if (errorCount) {
+        std::cerr << errorCount << " checks failed\n";
+        return 1;
+    }
+
+    return 0;
+}
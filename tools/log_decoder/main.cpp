@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2023 Strato Team and Contributors (https://github.com/strato-emu/)
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include <logger/log_record.h>
+
+using namespace skyline;
+
+/**
+ * @brief Expands a binary log file written by the emulator into the same text format as regular log files
+ */
+int main(int argc, char **argv) {
+    if (argc < 2 || argc > 3) {
+        std::cerr << "Usage: " << argv[0] << " <binary log> [output text log]\n";
+        return 1;
+    }
+
+    std::ifstream input{argv[1], std::ios::binary};
+    if (!input) {
+        std::cerr << "Failed to open the binary log: " << argv[1] << "\n";
+        return 1;
+    }
+
+    std::ofstream outputFile;
+    if (argc == 3)
+        outputFile.open(argv[2], std::ios::trunc);
+    std::ostream &output{argc == 3 ? outputFile : std::cout};
+
+    logger::BinaryLogFileHeader header{};
+    input.read(reinterpret_cast<char *>(&header), sizeof(header));
+    if (!input || header.magic != logger::BinaryLogFileHeader::Magic) {
+        std::cerr << "The supplied file is not a binary log\n";
+        return 1;
+    }
+    if (header.version != logger::BinaryLogFileHeader::Version) {
+        std::cerr << "Unsupported binary log version: " << header.version << " (expected " << logger::BinaryLogFileHeader::Version << ")\n";
+        return 1;
+    }
+
+    std::vector<std::string> strings;
+    std::vector<u8> arguments;
+    size_t messageCount{};
+
+    auto getString{[&strings](u32 id) -> std::string_view {
+        return id < strings.size() ? std::string_view{strings[id]} : std::string_view{"<unknown>"};
+    }};
+
+    int type;
+    while ((type = input.get()) != EOF) {
+        switch (static_cast<logger::BinaryLogEntryType>(type)) {
+            case logger::BinaryLogEntryType::String: {
+                logger::BinaryLogStringEntry entry{};
+                input.read(reinterpret_cast<char *>(&entry), sizeof(entry));
+                if (!input || entry.id != strings.size()) {
+                    input.setstate(std::ios::failbit);
+                    break;
+                }
+
+                std::string string(entry.length, '\0');
+                input.read(string.data(), static_cast<std::streamsize>(entry.length));
+                strings.emplace_back(std::move(string));
+                break;
+            }
+
+            case logger::BinaryLogEntryType::Message: {
+                logger::BinaryLogMessageEntry entry{};
+                input.read(reinterpret_cast<char *>(&entry), sizeof(entry));
+                if (!input || entry.level >= static_cast<u8>(logger::LogLevel::Disabled)) {
+                    input.setstate(std::ios::failbit);
+                    break;
+                }
+
+                arguments.resize(entry.argumentsSize);
+                input.read(reinterpret_cast<char *>(arguments.data()), static_cast<std::streamsize>(arguments.size()));
+                if (!input)
+                    break;
+
+                auto message{logger::FormatLogMessage(getString(entry.formatId), arguments)};
+                if (entry.functionId != logger::BinaryLogStringEntry::NullId)
+                    message = fmt::format("{}: {}", getString(entry.functionId), message);
+
+                output << logger::FormatLogFileLine(static_cast<logger::LogLevel>(entry.level), entry.time, getString(entry.threadNameId), message);
+                messageCount++;
+                break;
+            }
+
+            default:
+                input.setstate(std::ios::failbit);
+                break;
+        }
+
+        if (!input) {
+            // The log may have been cut off if the emulator crashed, everything prior to this point is still valid
+            std::cerr << "Stopped at a truncated or corrupted entry after " << messageCount << " messages\n";
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,195 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2023 Strato Team and Contributors (https://github.com/strato-emu/)
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <soc/gm20b/engines/engine.h>
+
+using namespace skyline;
+using namespace skyline::soc::gm20b;
+
+namespace {
+    /**
+     * @brief Opcode field values as defined by MacroInterpreter::Opcode
+     */
+    namespace op {
+        constexpr u32 AluRegister{0}, AddImmediate{1}, BitfieldReplace{2}, BitfieldExtractShiftLeftImmediate{3}, BitfieldExtractShiftLeftRegister{4}, ReadImmediate{5}, Branch{7};
+        constexpr std::array<u32, 7> Operations{AluRegister, AddImmediate, BitfieldReplace, BitfieldExtractShiftLeftImmediate, BitfieldExtractShiftLeftRegister, ReadImmediate, Branch};
+        constexpr std::array<u32, 9> AluOperations{0, 1, 2, 3, 8, 9, 10, 11, 12};
+
+        constexpr u32 Move{1}, MoveAndSetMethod{2}, MoveAndSend{4};
+
+        constexpr u32 ExitBit{1U << 7};
+
+        constexpr u32 EncodeImmediate(u32 operation, u32 assignment, u32 dest, u32 srcA, i32 immediate, bool exit = false) {
+            return operation | (assignment << 4) | (exit ? ExitBit : 0) | (dest << 8) | (srcA << 11) | (static_cast<u32>(immediate) << 14);
+        }
+
+        constexpr u32 EncodeBranch(bool nonZero, bool noDelay, u32 srcA, i32 immediate) {
+            return Branch | (static_cast<u32>(nonZero) << 4) | (static_cast<u32>(noDelay) << 5) | (srcA << 11) | (static_cast<u32>(immediate) << 14);
+        }
+    }
+
+    /**
+     * @brief An engine which records every method call made by a macro into a register file that macros can also read back
+     */
+    struct RecordingEngine : engine::MacroEngineBase {
+        std::array<u32, engine::EngineMethodsEnd> registers;
+        std::vector<std::pair<u32, u32>> calls;
+
+        RecordingEngine(MacroState &macroState, u64 seed) : MacroEngineBase{macroState} {
+            std::mt19937 generator{static_cast<u32>(seed)};
+            for (auto &value : registers)
+                value = generator();
+        }
+
+        void CallMethodFromMacro(u32 method, u32 argument) override {
+            calls.emplace_back(method, argument);
+            registers[method % registers.size()] = argument;
+        }
+
+        u32 ReadMethodFromMacro(u32 method) override {
+            return registers[method % registers.size()];
+        }
+    };
+
+    /**
+     * @brief The observable result of running a macro on an engine
+     */
+    struct Outcome {
+        std::vector<std::pair<u32, u32>> calls;
+        std::array<u32, engine::EngineMethodsEnd> registers;
+        std::optional<std::string> error;
+
+        bool operator==(const Outcome &) const = default;
+    };
+
+    /**
+     * @brief Generates a random macro which only branches forward so it always terminates, it ends with an exit and its delay slot
+     */
+    std::vector<u32> GenerateMacro(std::mt19937 &generator, size_t length) {
+        std::vector<u32> code(length);
+        auto pick{[&](const auto &values) { return values[generator() % values.size()]; }};
+
+        size_t exitIndex{length - 2};
+        for (size_t index{}; index < length; index++) {
+            bool delaySlot{index > 0 && (code[index - 1] & 0x7) == op::Branch}; // Branching isn't allowed inside a delay slot
+            bool branchable{index < exitIndex - 1 && !delaySlot};
+
+            u32 operation;
+            do {
+                operation = pick(op::Operations);
+            } while (operation == op::Branch && !branchable);
+
+            u32 raw{(static_cast<u32>(generator()) & ~0xFU & ~op::ExitBit) | operation};
+            if (operation == op::AluRegister) {
+                raw = (raw & ~(0x1FU << 17)) | (pick(op::AluOperations) << 17);
+            } else if (operation == op::Branch) {
+                auto immediate{static_cast<i32>(1 + generator() % (exitIndex - index))};
+                raw = (raw & 0x3FFF) | (static_cast<u32>(immediate) << 14);
+            }
+
+            if (index == exitIndex)
+                raw |= op::ExitBit;
+            code[index] = raw;
+        }
+
+        return code;
+    }
+
+    /**
+     * @brief Runs a macro on a freshly seeded engine, only the execution itself is added to the supplied time
+     */
+    template<typename Function>
+    Outcome Run(MacroState &macroState, u64 seed, std::chrono::nanoseconds &time, Function &&execute) {
+        RecordingEngine engine{macroState, seed};
+        Outcome outcome{};
+        auto start{std::chrono::steady_clock::now()};
+        try {
+            execute(engine);
+        } catch (const std::exception &e) {
+            outcome.error = e.what();
+        }
+        time += std::chrono::steady_clock::now() - start;
+        outcome.calls = std::move(engine.calls);
+        outcome.registers = engine.registers;
+        return outcome;
+    }
+}
+
+/**
+ * @brief Runs random and hand-written macros through both the MacroInterpreter and the MacroDecodedInterpreter and checks that they make identical method calls
+ */
+int main(int argc, char **argv) {
+    size_t iterations{argc > 1 ? std::strtoull(argv[1], nullptr, 0) : 100000};
+    u64 seed{argc > 2 ? std::strtoull(argv[2], nullptr, 0) : std::random_device{}()};
+    std::cout << "Testing " << iterations << " macros with seed " << seed << "\n";
+
+    auto macroState{std::make_unique<MacroState>()};
+    std::mt19937 generator{static_cast<u32>(seed)};
+
+    std::chrono::nanoseconds interpreterTime{}, decodedTime{};
+    size_t callCount{}, mismatchCount{};
+
+    auto check{[&](span<const u32> code, size_t offset, std::vector<u32> arguments, u64 engineSeed) {
+        std::copy(code.begin(), code.end(), macroState->macroCode.begin() + static_cast<ptrdiff_t>(offset));
+        macroState->Invalidate();
+
+        auto expected{Run(*macroState, engineSeed, interpreterTime, [&](RecordingEngine &engine) {
+            macroState->macroInterpreter.Execute(offset, arguments, &engine);
+        })};
+
+        auto program{macroState->macroDecodedInterpreter.Decode(offset)};
+        auto actual{Run(*macroState, engineSeed, decodedTime, [&](RecordingEngine &engine) {
+            if (!program)
+                throw exception("Failed to decode the macro");
+            macroState->macroDecodedInterpreter.Execute(*program, arguments, &engine);
+        })};
+
+        callCount += expected.calls.size();
+
+        if (expected != actual) {
+            if (mismatchCount++ < 10) {
+                std::cerr << "Mismatch at offset 0x" << std::hex << offset << " (" << expected.calls.size() << " vs " << actual.calls.size() << " calls, error: '"
+                          << expected.error.value_or("none") << "' vs '" << actual.error.value_or("none") << "'), code:";
+                for (u32 word : code)
+                    std::cerr << " " << word;
+                std::cerr << std::dec << "\n";
+            }
+        }
+    }};
+
+    // A counted loop exercises backward branches, which random macros don't generate
+    constexpr std::array<u32, 6> LoopMacro{
+        op::EncodeImmediate(op::AddImmediate, op::MoveAndSetMethod, 2, 0, 0x100 | (1 << 12)),
+        op::EncodeImmediate(op::AddImmediate, op::MoveAndSend, 1, 1, -1),
+        op::EncodeBranch(true, false, 1, -1),
+        op::EncodeImmediate(op::AddImmediate, op::Move, 4, 4, 1),
+        op::EncodeImmediate(op::AddImmediate, op::MoveAndSend, 0, 4, 0, true),
+        op::EncodeImmediate(op::AddImmediate, op::Move, 0, 0, 0),
+    };
+    check(LoopMacro, 0, {0x400}, seed);
+
+    for (size_t iteration{}; iteration < iterations; iteration++) {
+        size_t length{3 + generator() % 61};
+        auto code{GenerateMacro(generator, length)};
+        size_t offset{generator() % (macroState->macroCode.size() - length)};
+
+        std::vector<u32> arguments(length * 2);
+        for (auto &argument : arguments)
+            argument = generator();
+
+        check(code, offset, std::move(arguments), generator());
+    }
+
+    std::cout << "Made " << callCount << " method calls, interpreter: " << interpreterTime.count() / 1000000.0 << "ms, decoded interpreter: " << decodedTime.count() / 1000000.0 << "ms\n";
+    if (mismatchCount) {
+        std::cerr << mismatchCount << " macros behaved differently\n";
+        return 1;
+    }
+
+    return 0;
+}
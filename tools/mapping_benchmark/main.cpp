@@ -0,0 +1,271 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2023 Strato Team and Contributors (https://github.com/strato-emu/)
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <list>
+#include <map>
+#include <random>
+#include <common.h>
+#include <common/mapping_table.h>
+
+using namespace skyline;
+
+namespace {
+    constexpr size_t WindowBase{0x100000000}, WindowSize{1ULL << 32}; //!< The region of the AS which all mappings are in
+
+    /**
+     * @brief A lookup of a range in a trace, this corresponds to the first mapping of a FindOrCreate call or the range of a buffer lookup
+     */
+    struct Lookup {
+        size_t address;
+        size_t size;
+
+        span<u8> Span() const {
+            return span<u8>{reinterpret_cast<u8 *>(address), size};
+        }
+    };
+
+    /**
+     * @brief Generates a trace where most lookups are for ranges which were looked up earlier or are within them, as a game repeatedly binding the same textures and buffers would do
+     * @param alignment The alignment of the start of all ranges
+     */
+    std::vector<Lookup> GenerateTrace(std::mt19937_64 &generator, size_t count, size_t alignment, size_t maxSize) {
+        std::vector<Lookup> trace;
+        trace.reserve(count);
+        for (size_t index{}; index < count; index++) {
+            if (!trace.empty() && generator() % 8 != 0) {
+                auto previous{trace[generator() % trace.size()]};
+                if (generator() % 4 == 0) {
+                    // A view or sub-range of a previous lookup
+                    size_t offset{util::AlignDown(generator() % previous.size, alignment)};
+                    previous.address += offset;
+                    previous.size = std::max<size_t>((previous.size - offset) / (1 + generator() % 4), 1);
+                }
+                trace.push_back(previous);
+            } else {
+                size_t size{alignment + generator() % maxSize};
+                trace.push_back(Lookup{
+                    .address = WindowBase + util::AlignDown(generator() % (WindowSize - size), alignment),
+                    .size = size,
+                });
+            }
+        }
+        return trace;
+    }
+
+    /**
+     * @brief A stand-in for TextureManager::TextureMapping, the shared pointer stands in for the texture which had to be moved when the sorted vector was shifted
+     */
+    struct TextureMapping : span<u8> {
+        std::shared_ptr<size_t> texture;
+        size_t sequence;
+
+        TextureMapping(span<u8> mapping, size_t sequence) : span<u8>{mapping}, texture{std::make_shared<size_t>(sequence)}, sequence{sequence} {}
+    };
+
+    /**
+     * @brief The index of texture mappings used by TextureManager, a list of mappings and a mapping table over them
+     */
+    struct TextureTableIndex {
+        std::list<TextureMapping> textures;
+        MappingTable<TextureMapping, 16> mappingTable;
+        size_t nextSequence{};
+
+        void FindCandidates(span<u8> guestMapping, std::vector<size_t> &output) {
+            boost::container::small_vector<TextureMapping *, 8> candidates{};
+            mappingTable.FindContaining(guestMapping, candidates);
+            std::sort(candidates.begin(), candidates.end(), [](const TextureMapping *a, const TextureMapping *b) {
+                return a->end() == b->end() ? a->sequence > b->sequence : a->end() > b->end();
+            });
+
+            for (auto *candidate : candidates)
+                output.push_back(candidate->sequence);
+        }
+
+        void Insert(span<u8> guestMapping) {
+            mappingTable.Insert(&textures.emplace_back(guestMapping, nextSequence++));
+        }
+    };
+
+    /**
+     * @brief The sorted vector of texture mappings which TextureManager used prior to the mapping table
+     */
+    struct TextureVectorIndex {
+        std::vector<TextureMapping> textures;
+        size_t nextSequence{};
+
+        void FindCandidates(span<u8> guestMapping, std::vector<size_t> &output) {
+            // The lower bound that FindOrCreate previously searched for always resolved to the end of the vector, so every mapping ending after the start of the guest mapping was walked
+            auto hostMapping{textures.end()};
+            while (hostMapping != textures.begin() && (--hostMapping)->end() > guestMapping.begin())
+                if (hostMapping->contains(guestMapping))
+                    output.push_back(hostMapping->sequence);
+        }
+
+        void Insert(span<u8> guestMapping) {
+            auto mappingEnd{std::upper_bound(textures.begin(), textures.end(), guestMapping, [](const auto &value, const auto &element) {
+                return value.end() < element.end();
+            })};
+            textures.emplace(mappingEnd, guestMapping, nextSequence++);
+        }
+    };
+
+    /**
+     * @brief A stand-in for a Buffer with only its guest mapping
+     */
+    struct Buffer {
+        span<u8> guest;
+    };
+
+    /**
+     * @brief The map of buffers used by BufferManager, keyed by the start of each buffer
+     */
+    struct BufferMapIndex {
+        std::map<u8 *, std::shared_ptr<Buffer>> bufferMappings;
+
+        void Lookup(span<u8> range, std::vector<std::shared_ptr<Buffer>> &overlaps) {
+            auto entryIt{bufferMappings.lower_bound(range.end().base())};
+            while (entryIt != bufferMappings.begin() && (--entryIt)->second->guest.end() > range.begin())
+                overlaps.emplace_back(entryIt->second);
+        }
+
+        void Insert(std::shared_ptr<Buffer> buffer) {
+            bufferMappings.emplace(buffer->guest.begin().base(), std::move(buffer));
+        }
+
+        void Delete(const std::shared_ptr<Buffer> &buffer) {
+            bufferMappings.erase(buffer->guest.begin().base());
+        }
+    };
+
+    /**
+     * @brief The sorted vector of buffers which BufferManager used prior to the map
+     */
+    struct BufferVectorIndex {
+        std::vector<std::shared_ptr<Buffer>> bufferMappings;
+
+        static bool BufferLessThan(const std::shared_ptr<Buffer> &it, u8 *pointer) {
+            return it->guest.begin().base() < pointer;
+        }
+
+        void Lookup(span<u8> range, std::vector<std::shared_ptr<Buffer>> &overlaps) {
+            auto entryIt{std::lower_bound(bufferMappings.begin(), bufferMappings.end(), range.end().base(), BufferLessThan)};
+            while (entryIt != bufferMappings.begin() && (*--entryIt)->guest.begin() <= range.end())
+                if ((*entryIt)->guest.end() > range.begin())
+                    overlaps.emplace_back(*entryIt);
+        }
+
+        void Insert(std::shared_ptr<Buffer> buffer) {
+            auto bufferEnd{buffer->guest.end().base()};
+            bufferMappings.insert(std::lower_bound(bufferMappings.begin(), bufferMappings.end(), bufferEnd, BufferLessThan), std::move(buffer));
+        }
+
+        void Delete(const std::shared_ptr<Buffer> &buffer) {
+            bufferMappings.erase(std::find(bufferMappings.begin(), bufferMappings.end(), buffer));
+        }
+    };
+
+    /**
+     * @brief Replays a trace of FindOrCreate calls, a texture is created for any lookup without a containing mapping
+     * @return The time taken along with the candidates of every lookup in the order they were checked in
+     */
+    template<typename Index>
+    std::pair<std::chrono::nanoseconds, std::vector<std::vector<size_t>>> ReplayTextures(const std::vector<Lookup> &trace, bool record) {
+        Index index;
+        std::vector<std::vector<size_t>> candidates(record ? trace.size() : 0);
+        std::vector<size_t> lookupCandidates;
+        auto start{std::chrono::steady_clock::now()};
+        for (size_t operation{}; operation < trace.size(); operation++) {
+            lookupCandidates.clear();
+            index.FindCandidates(trace[operation].Span(), lookupCandidates);
+            if (lookupCandidates.empty())
+                index.Insert(trace[operation].Span());
+            if (record)
+                candidates[operation] = lookupCandidates;
+        }
+        return {std::chrono::steady_clock::now() - start, std::move(candidates)};
+    }
+
+    /**
+     * @brief Replays a trace of buffer lookups, any lookup which isn't entirely within a single buffer creates a new buffer that replaces all overlapping buffers as BufferManager does
+     * @return The time taken along with the start addresses of the overlapping buffers of every lookup
+     */
+    template<typename Index>
+    std::pair<std::chrono::nanoseconds, std::vector<std::vector<u8 *>>> ReplayBuffers(const std::vector<Lookup> &trace, bool record) {
+        Index index;
+        std::vector<std::vector<u8 *>> results(record ? trace.size() : 0);
+        std::vector<std::shared_ptr<Buffer>> overlaps;
+        auto start{std::chrono::steady_clock::now()};
+        for (size_t operation{}; operation < trace.size(); operation++) {
+            auto range{trace[operation].Span()};
+            overlaps.clear();
+            index.Lookup(range, overlaps);
+
+            if (record) {
+                for (const auto &overlap : overlaps)
+                    results[operation].push_back(overlap->guest.data());
+                std::sort(results[operation].begin(), results[operation].end());
+            }
+
+            if (overlaps.size() == 1 && overlaps.front()->guest.contains(range))
+                continue;
+
+            auto lowest{range.begin().base()}, highest{range.end().base()};
+            for (const auto &overlap : overlaps) {
+                lowest = std::min(lowest, overlap->guest.begin().base());
+                highest = std::max(highest, overlap->guest.end().base());
+                index.Delete(overlap);
+            }
+            index.Insert(std::make_shared<Buffer>(Buffer{span<u8>{lowest, highest}}));
+        }
+        return {std::chrono::steady_clock::now() - start, std::move(results)};
+    }
+}
+
+/**
+ * @brief Replays synthetic texture and buffer lookup traces against the current indices of the texture and buffer managers and the sorted vectors they replaced, checks that both return the same results and reports the time taken by each
+ */
+int main(int argc, char **argv) {
+    size_t lookupCount{argc > 1 ? std::strtoull(argv[1], nullptr, 0) : 200000};
+    u64 seed{argc > 2 ? std::strtoull(argv[2], nullptr, 0) : std::random_device{}()};
+    std::cout << "Replaying " << lookupCount << " lookups with seed " << seed << "\n";
+
+    std::mt19937_64 generator{seed};
+    size_t mismatchCount{};
+
+    auto textureTrace{GenerateTrace(generator, lookupCount, 0x200, 0x400000)};
+    {
+        auto [tableTime, tableCandidates]{ReplayTextures<TextureTableIndex>(textureTrace, true)};
+        auto [vectorTime, vectorCandidates]{ReplayTextures<TextureVectorIndex>(textureTrace, true)};
+        for (size_t operation{}; operation < textureTrace.size(); operation++)
+            if (tableCandidates[operation] != vectorCandidates[operation] && mismatchCount++ < 10)
+                std::cerr << "Texture lookup " << operation << " returned " << tableCandidates[operation].size() << " candidates instead of " << vectorCandidates[operation].size() << " or in a different order\n";
+
+        // The timed replays don't record the candidates as that would dominate the time taken
+        tableTime = ReplayTextures<TextureTableIndex>(textureTrace, false).first;
+        vectorTime = ReplayTextures<TextureVectorIndex>(textureTrace, false).first;
+        std::cout << "Textures: mapping table " << static_cast<double>(tableTime.count()) / static_cast<double>(lookupCount) << "ns/lookup, sorted vector " << static_cast<double>(vectorTime.count()) / static_cast<double>(lookupCount) << "ns/lookup\n";
+    }
+
+    auto bufferTrace{GenerateTrace(generator, lookupCount, 0x10, 0x10000)};
+    {
+        auto [mapTime, mapResults]{ReplayBuffers<BufferMapIndex>(bufferTrace, true)};
+        auto [vectorTime, vectorResults]{ReplayBuffers<BufferVectorIndex>(bufferTrace, true)};
+        for (size_t operation{}; operation < bufferTrace.size(); operation++)
+            if (mapResults[operation] != vectorResults[operation] && mismatchCount++ < 10)
+                std::cerr << "Buffer lookup " << operation << " returned " << mapResults[operation].size() << " overlaps instead of " << vectorResults[operation].size() << "\n";
+
+        mapTime = ReplayBuffers<BufferMapIndex>(bufferTrace, false).first;
+        vectorTime = ReplayBuffers<BufferVectorIndex>(bufferTrace, false).first;
+        std::cout << "Buffers: map " << static_cast<double>(mapTime.count()) / static_cast<double>(lookupCount) << "ns/lookup, sorted vector " << static_cast<double>(vectorTime.count()) / static_cast<double>(lookupCount) << "ns/lookup\n";
+    }
+
+    if (mismatchCount) {
+        std::cerr << mismatchCount << " lookups differed between the current and previous indices\n";
+        return 1;
+    }
+
+    return 0;
+}
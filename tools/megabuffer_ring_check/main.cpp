@@ -0,0 +1,181 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2023 Strato Team and Contributors (https://github.com/strato-emu/)
+
+#include <cstdlib>
+#include <iostream>
+#include <list>
+#include <random>
+#include <gpu/megabuffer_ring.h>
+
+using namespace skyline;
+using namespace skyline::gpu;
+
+namespace {
+    /**
+     * @brief A stand-in for FenceCycle which is signalled by the simulation, waiting on it signals it immediately as the GPU would eventually
+     */
+    struct SimulatedCycle {
+        bool submitted{};
+        bool signalled{};
+        size_t waitCount{};
+
+        bool Poll(bool) {
+            return signalled;
+        }
+
+        bool IsSubmitted() {
+            return submitted;
+        }
+
+        void Wait() {
+            if (!submitted)
+                throw exception("Waited on a cycle that wasn't submitted");
+            waitCount++;
+            signalled = true;
+        }
+    };
+
+    using Ring = MegaBufferRing<SimulatedCycle>;
+
+    constexpr u64 RingSize{64 * PAGE_SIZE}; //!< A scaled down MegaBufferChunkSize so the simulation regularly wraps around and hits the size limit
+    constexpr size_t MaxRings{4};
+
+    struct Allocation {
+        Ring *ring;
+        u64 offset;
+        u64 size;
+        std::shared_ptr<SimulatedCycle> cycle;
+    };
+
+    /**
+     * @brief The allocation policy of MegaBufferAllocator::Allocate with rings in place of chunks
+     */
+    struct SimulatedAllocator {
+        std::list<Ring> rings;
+        std::list<Ring>::iterator activeRing{rings.emplace(rings.end(), RingSize)};
+        u64 allocationSequence{};
+        size_t stalls{};
+
+        u64 TryAllocate(std::list<Ring>::iterator ring, const std::shared_ptr<SimulatedCycle> &cycle, u64 size, bool pageAlign) {
+            auto offset{ring->Reserve(cycle, allocationSequence, size, pageAlign)};
+            if (offset)
+                activeRing = ring;
+            return offset;
+        }
+
+        std::pair<Ring *, u64> Allocate(const std::shared_ptr<SimulatedCycle> &cycle, u64 size, bool pageAlign, bool &exceededLimit) {
+            auto offset{TryAllocate(activeRing, cycle, size, pageAlign)};
+            if (!offset) {
+                for (auto ring{rings.begin()}; ring != rings.end(); ring++) {
+                    ring->Reclaim();
+                    if (!offset)
+                        offset = TryAllocate(ring, cycle, size, pageAlign);
+                }
+            }
+
+            if (!offset && rings.size() >= MaxRings) {
+                bool stalled{};
+                while (!offset) {
+                    auto ring{FindOldestWaitableRing(rings.begin(), rings.end(), cycle)};
+                    if (ring == rings.end())
+                        break;
+
+                    stalled = true;
+                    ring->ReclaimOldest(cycle);
+                    offset = TryAllocate(ring, cycle, size, pageAlign);
+                }
+
+                if (stalled)
+                    stalls++;
+            }
+
+            if (!offset) {
+                offset = TryAllocate(rings.emplace(rings.end(), RingSize), cycle, size, pageAlign);
+                exceededLimit = rings.size() > MaxRings;
+            }
+
+            allocationSequence++;
+            return {&*activeRing, offset};
+        }
+    };
+}
+
+/**
+ * @brief Simulates frames of megabuffer allocations with cycles that retire in order, checking that live allocations never overlap and that the size limit is only exceeded when nothing could be waited on
+ */
+int main(int argc, char **argv) {
+    size_t frames{argc > 1 ? std::strtoull(argv[1], nullptr, 0) : 20000};
+    u64 seed{argc > 2 ? std::strtoull(argv[2], nullptr, 0) : std::random_device{}()};
+    std::cout << "Simulating " << frames << " frames with seed " << seed << "\n";
+
+    std::mt19937_64 generator{seed};
+    SimulatedAllocator allocator;
+    std::deque<std::shared_ptr<SimulatedCycle>> inFlight; //!< Submitted cycles which haven't been signalled, in submission order
+    std::vector<Allocation> live; //!< All allocations whose cycles haven't been signalled
+    size_t errorCount{}, allocationCount{}, limitExceeded{}, waitedCycles{};
+
+    auto error{[&](const std::string &message) {
+        if (errorCount++ < 10)
+            std::cerr << message << "\n";
+    }};
+
+    for (size_t frame{}; frame < frames; frame++) {
+        auto cycle{std::make_shared<SimulatedCycle>()};
+
+        // Most frames use a small part of the limit, some use more than the limit by themselves
+        size_t count{generator() % 64 == 0 ? 200 + generator() % 200 : generator() % 40};
+        for (size_t index{}; index < count; index++) {
+            u64 size{generator() % 8 == 0 ? 0 : 1 + generator() % (RingSize / 8)};
+            bool pageAlign{generator() % 4 == 0};
+
+            bool exceededLimit{};
+            auto [ring, offset]{allocator.Allocate(cycle, size, pageAlign, exceededLimit)};
+            allocationCount++;
+
+            std::erase_if(live, [](const Allocation &allocation) { return allocation.cycle->signalled; });
+
+            if (exceededLimit) {
+                limitExceeded++;
+                for (const auto &allocation : live)
+                    if (allocation.cycle != cycle)
+                        error("Exceeded the size limit in frame " + std::to_string(frame) + " while a submitted cycle could be waited on");
+            }
+
+            if (!offset || (size && (offset < PAGE_SIZE || offset + size > RingSize))) {
+                error("Invalid allocation at 0x" + std::to_string(offset) + " with size 0x" + std::to_string(size));
+                continue;
+            }
+
+            if (!size)
+                continue;
+
+            if (pageAlign && offset % PAGE_SIZE)
+                error("Page aligned allocation at unaligned offset " + std::to_string(offset));
+
+            for (const auto &allocation : live)
+                if (allocation.ring == ring && offset < allocation.offset + allocation.size && allocation.offset < offset + size)
+                    error("Allocation at " + std::to_string(offset) + " overlaps a live allocation at " + std::to_string(allocation.offset) + " in frame " + std::to_string(frame));
+
+            live.push_back(Allocation{ring, offset, size, cycle});
+        }
+
+        cycle->submitted = true;
+        inFlight.push_back(cycle);
+
+        // The GPU retires cycles in order and is usually a few frames behind
+        while (!inFlight.empty() && (inFlight.front()->signalled || inFlight.size() > 3 || generator() % 3 == 0)) {
+            waitedCycles += inFlight.front()->waitCount ? 1 : 0;
+            inFlight.front()->signalled = true;
+            inFlight.pop_front();
+        }
+    }
+
+    std::cout << allocationCount << " allocations, " << allocator.rings.size() << " rings, " << allocator.stalls << " stalls, " << waitedCycles << " cycles waited on, limit exceeded " << limitExceeded << " times\n";
+
+    if (errorCount) {
+        std::cerr << errorCount << " errors\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,159 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2023 Strato Team and Contributors (https://github.com/strato-emu/)
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <common/dirty_tracking.h>
+#include <soc/gm20b/engines/engine.h>
+
+using namespace skyline;
+using namespace skyline::soc::gm20b;
+
+namespace {
+    using RegisterFile = std::array<u32, engine::EngineMethodsEnd>;
+    using DirtyManager = dirty::Manager<engine::EngineMethodsEnd * sizeof(u32), sizeof(u32)>; //!< The same as gpu::interconnect::DirtyManager
+
+    constexpr u32 GpfifoRegisterCount{0x40}; //!< engine::GPFIFO::RegisterCount, methods below this are never sent to engines
+    constexpr size_t HandleCount{512}; //!< The amount of dirty handles bound to random register ranges, this is roughly the amount the 3D interconnect binds
+
+    /**
+     * @brief A register file along with its shadow RAM and dirty state in the same layout as Maxwell3D
+     */
+    struct Engine {
+        RegisterFile registers{};
+        RegisterFile shadowRegisters{};
+        std::array<bool, HandleCount> dirty{};
+        std::unique_ptr<DirtyManager> dirtyManager{std::make_unique<DirtyManager>(registers)};
+        const std::array<bool, engine::EngineMethodsEnd> &sideEffectMethods;
+        size_t sideEffectCalls{};
+
+        Engine(std::mt19937_64 &generator, const std::array<bool, engine::EngineMethodsEnd> &sideEffectMethods) : sideEffectMethods{sideEffectMethods} {
+            for (size_t handle{}; handle < HandleCount; handle++) {
+                size_t size{1 + generator() % 16};
+                size_t offset{generator() % (engine::EngineMethodsEnd - size - 1)};
+                dirtyManager->Bind(dirty::Handle{&dirty[handle]}, reinterpret_cast<uintptr_t>(&registers[offset]), size * sizeof(u32));
+            }
+        }
+
+        /**
+         * @brief The path taken by Maxwell3D::HandleMethod for a single method with shadow RAM tracking optionally enabled
+         */
+        void HandleMethod(u32 method, u32 argument, bool trackShadow) {
+            if (trackShadow)
+                shadowRegisters[method] = argument;
+
+            bool redundant{registers[method] == argument};
+            registers[method] = argument;
+            if (!redundant)
+                dirtyManager->MarkDirty(method);
+
+            if (sideEffectMethods[method])
+                sideEffectCalls++;
+        }
+
+        /**
+         * @brief The path taken by Maxwell3D::CallMethodBatchInc for runs outside of constant buffer updates
+         */
+        void CallMethodBatchInc(u32 method, span<const u32> arguments, bool trackShadow) {
+            while (!arguments.empty()) {
+                if (sideEffectMethods[method]) {
+                    HandleMethod(method++, arguments.front(), trackShadow);
+                    arguments = arguments.subspan(1);
+                    continue;
+                }
+
+                auto count{engine::CountPlainMethods(sideEffectMethods, method, arguments.size())};
+                engine::WriteRegisterRun(registers.data(), trackShadow ? shadowRegisters.data() : nullptr, *dirtyManager, method, arguments.first(count));
+
+                method += static_cast<u32>(count);
+                arguments = arguments.subspan(count);
+            }
+        }
+
+        bool operator==(const Engine &other) const {
+            return registers == other.registers && shadowRegisters == other.shadowRegisters && dirty == other.dirty && sideEffectCalls == other.sideEffectCalls;
+        }
+    };
+
+    /**
+     * @brief An incrementing method from a pushbuffer, the arguments are a mix of values which are already in the register and new ones as games frequently rewrite the same state
+     */
+    struct Method {
+        u32 method;
+        bool trackShadow;
+        std::vector<u32> arguments;
+    };
+
+    std::vector<Method> GenerateTrace(std::mt19937_64 &generator, size_t count) {
+        std::vector<Method> trace(count);
+        for (auto &method : trace) {
+            size_t length{5 + generator() % 60};
+            method.method = static_cast<u32>(GpfifoRegisterCount + generator() % (engine::EngineMethodsEnd - GpfifoRegisterCount - length));
+            method.trackShadow = generator() % 16 == 0;
+            method.arguments.resize(length);
+            for (auto &argument : method.arguments)
+                argument = static_cast<u32>(generator() % 4);
+        }
+        return trace;
+    }
+}
+
+/**
+ * @brief Replays random incrementing methods through the batched register writes and through per-method writes, checks that the resulting registers, shadow RAM and dirty state are identical and reports the time taken by each
+ */
+int main(int argc, char **argv) {
+    size_t methodCount{argc > 1 ? std::strtoull(argv[1], nullptr, 0) : 200000};
+    u64 seed{argc > 2 ? std::strtoull(argv[2], nullptr, 0) : std::random_device{}()};
+    std::cout << "Replaying " << methodCount << " incrementing methods with seed " << seed << "\n";
+
+    std::mt19937_64 generator{seed};
+
+    // Side effect methods are sparse, most incrementing runs are register blocks or constant buffer uploads which never touch them
+    std::array<bool, engine::EngineMethodsEnd> sideEffectMethods{};
+    for (size_t index{}; index < 64; index++)
+        sideEffectMethods[generator() % sideEffectMethods.size()] = true;
+
+    auto trace{GenerateTrace(generator, methodCount)};
+    size_t argumentCount{}, mismatchCount{};
+    for (const auto &method : trace)
+        argumentCount += method.arguments.size();
+
+    std::mt19937_64 bindGenerator{seed};
+    Engine reference{bindGenerator, sideEffectMethods};
+    bindGenerator.seed(seed);
+    Engine batched{bindGenerator, sideEffectMethods};
+
+    std::chrono::nanoseconds referenceTime{}, batchedTime{};
+    constexpr size_t CheckInterval{64}; //!< The amount of methods after which the state is compared and the dirty flags are cleared, as the interconnect would on a draw
+    for (size_t offset{}; offset < trace.size(); offset += CheckInterval) {
+        auto chunk{span(trace).subspan(offset, std::min(CheckInterval, trace.size() - offset))};
+
+        auto start{std::chrono::steady_clock::now()};
+        for (const auto &method : chunk)
+            for (u32 index{}; index < method.arguments.size(); index++)
+                reference.HandleMethod(method.method + index, method.arguments[index], method.trackShadow);
+        referenceTime += std::chrono::steady_clock::now() - start;
+
+        start = std::chrono::steady_clock::now();
+        for (const auto &method : chunk)
+            batched.CallMethodBatchInc(method.method, method.arguments, method.trackShadow);
+        batchedTime += std::chrono::steady_clock::now() - start;
+
+        if (!(reference == batched) && mismatchCount++ < 10)
+            std::cerr << "State differs after methods " << offset << " to " << offset + chunk.size() << "\n";
+
+        reference.dirty = {};
+        batched.dirty = {};
+    }
+
+    std::cout << "Wrote " << argumentCount << " registers, per-method: " << static_cast<double>(referenceTime.count()) / static_cast<double>(argumentCount) << "ns/register, batched: "
+              << static_cast<double>(batchedTime.count()) / static_cast<double>(argumentCount) << "ns/register\n";
+    if (mismatchCount) {
+        std::cerr << mismatchCount << " checks found differing state\n";
+        return 1;
+    }
+
+    return 0;
+}
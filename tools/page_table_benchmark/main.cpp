@@ -0,0 +1,226 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2023 Strato Team and Contributors (https://github.com/strato-emu/)
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <shared_mutex>
+#include <kernel/memory.h>
+
+using namespace skyline;
+using namespace skyline::kernel;
+
+namespace {
+    constexpr size_t L2EntryGranularity{21}; //!< The L2 granularity used by MemoryManager
+    using PageTable = SegmentTable<PageDescriptor, constant::AddressSpaceSize, constant::PageSizeBits, L2EntryGranularity>;
+
+    constexpr size_t WindowBase{0x7100000000}; //!< The base of the region which is mapped into, this is 2 MiB aligned like the guest address space
+    constexpr size_t WindowSize{1ULL << 32};
+    constexpr size_t WindowPages{WindowSize / constant::PageSize};
+
+    /**
+     * @brief A single operation in a trace, these mirror the operations done on the VMM by svcMapMemory (and any other mapping SVC) and by QueryMemory or IPC buffer validation
+     */
+    struct Operation {
+        enum class Type {
+            Map,
+            Lookup,
+        } type;
+        size_t address;
+        size_t size; //!< The size of the mapping, this is only valid for Map
+        ChunkDescriptor chunk; //!< The attributes of the mapping, this is only valid for Map
+    };
+
+    /**
+     * @brief A chunk map and lock equivalent to what MemoryManager used for every lookup before it had a page table
+     * @note Compatible chunks aren't merged here as the lookup cost only depends on the amount of chunks in the map
+     */
+    struct ChunkMap {
+        std::map<size_t, ChunkDescriptor> chunks;
+        std::shared_mutex mutex;
+
+        ChunkMap() {
+            chunks[0] = ChunkDescriptor{.state = memory::states::Unmapped, .size = constant::AddressSpaceSize};
+        }
+
+        void Map(size_t base, const ChunkDescriptor &chunk) {
+            std::unique_lock lock{mutex};
+
+            size_t end{base + chunk.size};
+            auto split{[&](size_t address) {
+                auto it{std::prev(chunks.upper_bound(address))};
+                if (it->first != address) {
+                    auto tail{it->second};
+                    tail.size = it->first + it->second.size - address;
+                    it->second.size = address - it->first;
+                    chunks.emplace_hint(std::next(it), address, tail);
+                }
+            }};
+            split(base);
+            split(end);
+
+            chunks.erase(chunks.find(base), chunks.lower_bound(end));
+            chunks.emplace(base, chunk);
+        }
+
+        std::optional<PageDescriptor> Lookup(size_t address) {
+            std::shared_lock lock{mutex};
+
+            auto chunk{std::prev(chunks.upper_bound(address))};
+            return PageDescriptor{
+                .stateValue = chunk->second.state.value,
+                .permissionValue = chunk->second.permission.raw,
+                .attributesValue = chunk->second.attributes.value,
+            };
+        }
+    };
+
+    PageDescriptor ToPageDescriptor(const ChunkDescriptor &chunk) {
+        return PageDescriptor{
+            .stateValue = chunk.state.value,
+            .permissionValue = chunk.permission.raw,
+            .attributesValue = chunk.attributes.value,
+        };
+    }
+
+    bool operator==(const PageDescriptor &lhs, const PageDescriptor &rhs) {
+        return lhs.stateValue == rhs.stateValue && lhs.permissionValue == rhs.permissionValue && lhs.attributesValue == rhs.attributesValue;
+    }
+
+    /**
+     * @brief Generates a trace of mappings of varying sizes and alignments interleaved with lookups, most mappings are small and unaligned to L2 entries like heap and IPC buffer mappings
+     */
+    std::vector<Operation> GenerateTrace(std::mt19937_64 &generator, size_t mapCount, size_t lookupsPerMap) {
+        constexpr std::array<memory::MemoryState, 6> States{memory::states::Heap, memory::states::Stack, memory::states::Ipc, memory::states::CodeMutable, memory::states::SharedMemory, memory::states::Unmapped};
+        constexpr std::array<size_t, 4> SizeClasses{16, 512, 2048, 32768}; //!< The maximum amount of pages in a mapping of each class, these straddle the 512 pages of an L2 entry
+
+        std::vector<Operation> trace;
+        trace.reserve(mapCount * (lookupsPerMap + 1));
+        for (size_t map{}; map < mapCount; map++) {
+            size_t pages{1 + generator() % SizeClasses[generator() % SizeClasses.size()]};
+            size_t page{generator() % (WindowPages - pages)};
+            trace.push_back(Operation{
+                .type = Operation::Type::Map,
+                .address = WindowBase + page * constant::PageSize,
+                .size = pages * constant::PageSize,
+                .chunk = ChunkDescriptor{
+                    .permission = memory::Permission{(generator() & 1) != 0, (generator() & 1) != 0, (generator() & 1) != 0},
+                    .attributes = memory::MemoryAttribute{static_cast<u8>(generator() & 0xF)},
+                    .state = States[generator() % States.size()],
+                    .size = pages * constant::PageSize,
+                },
+            });
+
+            for (size_t lookup{}; lookup < lookupsPerMap; lookup++)
+                trace.push_back(Operation{
+                    .type = Operation::Type::Lookup,
+                    .address = WindowBase + (generator() % WindowSize),
+                });
+        }
+
+        return trace;
+    }
+}
+
+/**
+ * @brief Replays a synthetic trace of mappings and lookups on both the chunk map and the page table, checks that the page table agrees with a flat per-page model of the window after every operation and reports the time taken by each
+ */
+int main(int argc, char **argv) {
+    size_t mapCount{argc > 1 ? std::strtoull(argv[1], nullptr, 0) : 20000};
+    size_t lookupsPerMap{argc > 2 ? std::strtoull(argv[2], nullptr, 0) : 50};
+    u64 seed{argc > 3 ? std::strtoull(argv[3], nullptr, 0) : std::random_device{}()};
+    std::cout << "Replaying " << mapCount << " mappings with " << lookupsPerMap << " lookups each, seed " << seed << "\n";
+
+    std::mt19937_64 generator{seed};
+    auto trace{GenerateTrace(generator, mapCount, lookupsPerMap)};
+
+    // Every lookup is checked against a flat model with an entry for every page in the window
+    size_t mismatchCount{};
+    {
+        std::vector<PageDescriptor> model(WindowPages);
+        PageTable pageTable;
+        ChunkMap chunkMap;
+        auto check{[&](size_t address, const char *structure, const PageDescriptor &actual) {
+            const auto &expected{model[(address - WindowBase) / constant::PageSize]};
+            if (!(actual == expected) && mismatchCount++ < 10)
+                std::cerr << structure << " mismatch at 0x" << std::hex << address << ": state 0x" << actual.stateValue << " instead of 0x" << expected.stateValue << std::dec << "\n";
+        }};
+
+        for (const auto &operation : trace) {
+            if (operation.type == Operation::Type::Map) {
+                std::fill_n(model.begin() + static_cast<ptrdiff_t>((operation.address - WindowBase) / constant::PageSize), operation.size / constant::PageSize, ToPageDescriptor(operation.chunk));
+                pageTable.Set(operation.address, operation.address + operation.size, ToPageDescriptor(operation.chunk));
+                chunkMap.Map(operation.address, operation.chunk);
+            } else {
+                check(operation.address, "Page table", pageTable[operation.address]);
+                check(operation.address, "Chunk map", *chunkMap.Lookup(operation.address));
+            }
+        }
+
+        for (size_t page{}; page < WindowPages; page++)
+            check(WindowBase + page * constant::PageSize, "Page table", pageTable[WindowBase + page * constant::PageSize]);
+    }
+
+    auto replay{[&](auto &&map, auto &&lookup) {
+        std::chrono::nanoseconds mapTime{}, lookupTime{};
+        u64 checksum{};
+        auto start{std::chrono::steady_clock::now()};
+        for (const auto &operation : trace) {
+            if (operation.type == Operation::Type::Map) {
+                auto lookupEnd{std::chrono::steady_clock::now()};
+                lookupTime += lookupEnd - start;
+                map(operation);
+                start = std::chrono::steady_clock::now();
+                mapTime += start - lookupEnd;
+            } else {
+                checksum += lookup(operation.address).stateValue;
+            }
+        }
+        lookupTime += std::chrono::steady_clock::now() - start;
+        return std::make_tuple(mapTime, lookupTime, checksum);
+    }};
+
+    auto chunkMap{std::make_unique<ChunkMap>()};
+    auto [mapMapTime, mapLookupTime, mapChecksum]{replay([&](const Operation &operation) { chunkMap->Map(operation.address, operation.chunk); },
+                                                          [&](size_t address) { return *chunkMap->Lookup(address); })};
+
+    // The page table is read the same way as MemoryManager::GetPageDescriptor, without any lock but validated with a sequence counter
+    PageTable pageTable;
+    std::atomic<u32> sequence{};
+    auto [tableMapTime, tableLookupTime, tableChecksum]{replay([&](const Operation &operation) {
+        sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        pageTable.Set(operation.address, operation.address + operation.size, ToPageDescriptor(operation.chunk));
+        sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }, [&](size_t address) {
+        PageDescriptor descriptor;
+        u32 value;
+        do {
+            value = sequence.load(std::memory_order_acquire);
+            descriptor = pageTable[address];
+            std::atomic_thread_fence(std::memory_order_acquire);
+        } while ((value & 1) || value != sequence.load(std::memory_order_relaxed));
+        return descriptor;
+    })};
+
+    if (mapChecksum != tableChecksum) {
+        std::cerr << "The chunk map and page table returned different states during the timed replay\n";
+        mismatchCount++;
+    }
+
+    size_t lookupCount{mapCount * lookupsPerMap};
+    auto report{[&](const char *name, std::chrono::nanoseconds mapTime, std::chrono::nanoseconds lookupTime) {
+        std::cout << name << ": " << static_cast<double>(mapTime.count()) / static_cast<double>(mapCount) << "ns/map, " << static_cast<double>(lookupTime.count()) / static_cast<double>(lookupCount) << "ns/lookup\n";
+    }};
+    std::cout << "Chunk map has " << chunkMap->chunks.size() << " chunks\n";
+    report("Chunk map", mapMapTime, mapLookupTime);
+    report("Page table", tableMapTime, tableLookupTime);
+
+    if (mismatchCount) {
+        std::cerr << mismatchCount << " lookups returned the wrong attributes\n";
+        return 1;
+    }
+
+    return 0;
+}
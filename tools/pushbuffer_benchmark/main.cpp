@@ -0,0 +1,296 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2023 Strato Team and Contributors (https://github.com/strato-emu/)
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <soc/gm20b/pushbuffer.h>
+
+using namespace skyline;
+using namespace skyline::soc::gm20b;
+
+namespace {
+    constexpr u32 GuardWord{0xDEADBEEF}; //!< The word placed after every range of a split pushbuffer, reading it means the parser read past the end of a range
+
+    /**
+     * @brief A single method call as seen by an engine, batches are flattened into these so the way a pushbuffer was split doesn't affect them
+     */
+    struct Call {
+        u32 method;
+        u32 argument;
+        SubchannelId subChannel;
+
+        bool operator==(const Call &) const = default;
+    };
+
+    /**
+     * @brief A dispatcher which records every method call it receives
+     */
+    struct RecordingDispatcher {
+        std::vector<Call> calls;
+        size_t flushCount{};
+
+        void SendFull(u32 method, GpfifoArgument argument, SubchannelId subChannel, bool) {
+            calls.push_back(Call{method, *argument, subChannel});
+        }
+
+        void SendPure(u32 method, u32 argument, SubchannelId subChannel) {
+            calls.push_back(Call{method, argument, subChannel});
+        }
+
+        void SendPureBatchNonInc(u32 method, span<u32> arguments, SubchannelId subChannel) {
+            for (u32 argument : arguments)
+                calls.push_back(Call{method, argument, subChannel});
+        }
+
+        void SendPureBatchInc(u32 method, span<u32> arguments, SubchannelId subChannel) {
+            for (u32 argument : arguments)
+                calls.push_back(Call{method++, argument, subChannel});
+        }
+
+        void FlushEngineState() {
+            flushCount++;
+        }
+    };
+
+    /**
+     * @brief A dispatcher which only hashes the method calls it receives, this keeps the cost of dispatch low so the parser dominates the timing
+     */
+    struct HashingDispatcher {
+        u64 hash{};
+
+        void Mix(u32 method, u32 argument) {
+            hash = (hash ^ ((static_cast<u64>(method) << 32) | argument)) * 0x100000001B3;
+        }
+
+        void SendFull(u32 method, GpfifoArgument argument, SubchannelId, bool) {
+            Mix(method, *argument);
+        }
+
+        void SendPure(u32 method, u32 argument, SubchannelId) {
+            Mix(method, argument);
+        }
+
+        void SendPureBatchNonInc(u32 method, span<u32> arguments, SubchannelId) {
+            for (u32 argument : arguments)
+                Mix(method, argument);
+        }
+
+        void SendPureBatchInc(u32 method, span<u32> arguments, SubchannelId) {
+            for (u32 argument : arguments)
+                Mix(method++, argument);
+        }
+
+        void FlushEngineState() {}
+    };
+
+    u32 MakeHeader(PushBufferMethodHeader::SecOp secOp, SubchannelId subChannel, u32 method, u32 count) {
+        return (static_cast<u32>(secOp) << 29) | (count << 16) | (static_cast<u32>(subChannel) << 13) | method;
+    }
+
+    /**
+     * @brief Generates a random pushbuffer containing every method type, including ones which touch GPFIFO and macro methods and ones large enough to be batched
+     * @param segmentEnd If an EndPbSegment method followed by garbage should be placed in the middle of the pushbuffer
+     */
+    std::vector<u32> GeneratePushBuffer(std::mt19937_64 &generator, size_t methodCount, bool segmentEnd) {
+        constexpr std::array<SubchannelId, 3> SubChannels{SubchannelId::ThreeD, SubchannelId::ThreeD, SubchannelId::TwoD};
+        std::vector<u32> words;
+
+        auto randomMethod{[&](u32 count) -> u32 {
+            switch (generator() % 8) {
+                case 0:
+                    return static_cast<u32>(generator() % engine::GPFIFO::RegisterCount);
+                case 1:
+                    return engine::EngineMethodsEnd + static_cast<u32>(generator() % 0x100);
+                default:
+                    return engine::GPFIFO::RegisterCount + static_cast<u32>(generator() % (engine::EngineMethodsEnd - engine::GPFIFO::RegisterCount - count));
+            }
+        }};
+
+        size_t segmentEndIndex{segmentEnd ? generator() % methodCount : methodCount};
+        for (size_t index{}; index < methodCount; index++) {
+            if (index == segmentEndIndex) {
+                words.push_back(MakeHeader(PushBufferMethodHeader::SecOp::EndPbSegment, SubchannelId::ThreeD, 0, 0));
+                for (size_t garbage{}; garbage < 16; garbage++)
+                    words.push_back(static_cast<u32>(generator()));
+                break;
+            }
+
+            auto subChannel{SubChannels[generator() % SubChannels.size()]};
+            u32 count{generator() % 16 == 0 ? static_cast<u32>(1 + generator() % 512) : static_cast<u32>(1 + generator() % 12)};
+            u32 method{randomMethod(count)};
+
+            switch (generator() % 6) {
+                case 0:
+                    words.push_back(0); // NOP
+                    break;
+                case 1:
+                    words.push_back(MakeHeader(PushBufferMethodHeader::SecOp::ImmdDataMethod, subChannel, method, static_cast<u32>(generator() % 0x2000)));
+                    continue;
+                case 2:
+                    words.push_back(MakeHeader(PushBufferMethodHeader::SecOp::NonIncMethod, subChannel, method, count));
+                    break;
+                case 3:
+                    words.push_back(MakeHeader(PushBufferMethodHeader::SecOp::OneInc, subChannel, method, count));
+                    break;
+                default:
+                    words.push_back(MakeHeader(PushBufferMethodHeader::SecOp::IncMethod, subChannel, method, count));
+                    break;
+            }
+
+            if (words.back() != 0)
+                for (u32 argument{}; argument < count; argument++)
+                    words.push_back(static_cast<u32>(generator()) | 1); // Arguments are never zero so they can't be mistaken for NOPs after a misparse
+        }
+
+        return words;
+    }
+
+    /**
+     * @brief A pushbuffer split into ranges at the supplied offsets, each range is followed by a guard word as mappings aren't contiguous in host memory
+     */
+    struct SplitPushBuffer {
+        std::vector<u32> storage;
+        std::vector<span<u32>> ranges;
+
+        SplitPushBuffer(span<const u32> words, std::vector<size_t> splits) {
+            splits.push_back(words.size());
+            storage.reserve(words.size() + splits.size());
+
+            std::vector<std::pair<size_t, size_t>> rangeOffsets;
+            size_t start{};
+            for (size_t split : splits) {
+                rangeOffsets.emplace_back(storage.size(), split - start);
+                storage.insert(storage.end(), words.begin() + static_cast<ptrdiff_t>(start), words.begin() + static_cast<ptrdiff_t>(split));
+                storage.push_back(GuardWord);
+                start = split;
+            }
+
+            for (auto [offset, size] : rangeOffsets)
+                ranges.emplace_back(storage.data() + offset, size);
+        }
+    };
+
+    /**
+     * @brief Parses every range of a pushbuffer in place, the same as ChannelGpfifo::Process
+     */
+    template<typename Dispatcher>
+    void ParseInPlace(Dispatcher &dispatcher, const std::vector<span<u32>> &ranges) {
+        PushBufferParser<Dispatcher> parser{dispatcher};
+        for (auto range : ranges)
+            if (parser.Process(range, false, false))
+                break;
+    }
+
+    /**
+     * @brief Gathers every range of a pushbuffer into a contiguous copy and parses that, this is how pushbuffers spanning multiple mappings used to be handled
+     */
+    template<typename Dispatcher>
+    void ParseCopy(Dispatcher &dispatcher, const std::vector<span<u32>> &ranges, std::vector<u32> &copy) {
+        copy.clear();
+        for (auto range : ranges)
+            copy.insert(copy.end(), range.begin(), range.end());
+
+        PushBufferParser<Dispatcher> parser{dispatcher};
+        parser.Process(copy, true, false);
+    }
+}
+
+/**
+ * @brief Checks that pushbuffers split into multiple ranges at arbitrary word boundaries dispatch the same methods as when they're contiguous, then times in place parsing of split pushbuffers against gathering them into a copy
+ */
+int main(int argc, char **argv) {
+    size_t iterations{argc > 1 ? std::strtoull(argv[1], nullptr, 0) : 2000};
+    u64 seed{argc > 2 ? std::strtoull(argv[2], nullptr, 0) : std::random_device{}()};
+    std::cout << "Checking " << iterations << " pushbuffers with seed " << seed << "\n";
+
+    std::mt19937_64 generator{seed};
+    size_t mismatchCount{}, checkCount{};
+
+    auto check{[&](span<const u32> words, const std::vector<size_t> &splits) {
+        RecordingDispatcher expected;
+        std::vector<u32> contiguous(words.begin(), words.end());
+        PushBufferParser<RecordingDispatcher>{expected}.Process(contiguous, false, false);
+
+        RecordingDispatcher actual;
+        SplitPushBuffer split{words, splits};
+        std::optional<std::string> error;
+        try {
+            ParseInPlace(actual, split.ranges);
+        } catch (const std::exception &e) {
+            error = e.what(); // A misparse can end up on garbage which isn't a valid method header
+        }
+
+        checkCount++;
+        if (error || expected.calls != actual.calls || expected.flushCount != actual.flushCount) {
+            if (mismatchCount++ < 10) {
+                auto firstMismatch{std::mismatch(expected.calls.begin(), expected.calls.end(), actual.calls.begin(), actual.calls.end())};
+                std::cerr << "Mismatch with " << words.size() << " words split at";
+                for (size_t offset : splits)
+                    std::cerr << " " << offset;
+                std::cerr << ": " << expected.calls.size() << " vs " << actual.calls.size() << " calls, first difference at call " << std::distance(expected.calls.begin(), firstMismatch.first) << ", error: '" << error.value_or("none") << "'\n";
+            }
+        }
+    }};
+
+    for (size_t iteration{}; iteration < iterations; iteration++) {
+        // Small pushbuffers are split into two at every possible word so a method header, or any of its arguments, ends up at the end of a range
+        auto small{GeneratePushBuffer(generator, 1 + generator() % 8, false)};
+        for (size_t offset{1}; offset < small.size(); offset++)
+            check(small, {offset});
+
+        // Larger ones are split into several ranges at random offsets, including empty ranges
+        auto large{GeneratePushBuffer(generator, 16 + generator() % 64, generator() % 4 == 0)};
+        std::vector<size_t> splits(1 + generator() % 8);
+        for (auto &offset : splits)
+            offset = generator() % (large.size() + 1);
+        std::sort(splits.begin(), splits.end());
+        check(large, splits);
+    }
+
+    std::cout << "Checked " << checkCount << " splits\n";
+
+    // Pushbuffers from deferred renderers can be hundreds of KiB, they're split into page sized ranges as their mappings would be
+    constexpr size_t PageWords{PAGE_SIZE / sizeof(u32)};
+    auto words{GeneratePushBuffer(generator, 20000, false)};
+    std::vector<size_t> pageSplits;
+    for (size_t offset{PageWords}; offset < words.size(); offset += PageWords)
+        pageSplits.push_back(offset);
+    SplitPushBuffer split{words, pageSplits};
+
+    constexpr size_t TimingIterations{200};
+    std::chrono::nanoseconds inPlaceTime{std::chrono::nanoseconds::max()}, copyTime{std::chrono::nanoseconds::max()};
+    std::vector<u32> copy;
+    u64 inPlaceHash{}, copyHash{};
+    for (size_t iteration{}; iteration < TimingIterations; iteration++) {
+        HashingDispatcher inPlace, copied;
+
+        auto start{std::chrono::steady_clock::now()};
+        ParseInPlace(inPlace, split.ranges);
+        inPlaceTime = std::min(inPlaceTime, std::chrono::steady_clock::now() - start);
+
+        start = std::chrono::steady_clock::now();
+        ParseCopy(copied, split.ranges, copy);
+        copyTime = std::min(copyTime, std::chrono::steady_clock::now() - start);
+
+        inPlaceHash = inPlace.hash;
+        copyHash = copied.hash;
+    }
+
+    std::cout << words.size() << " words in " << split.ranges.size() << " ranges, in place: " << std::chrono::duration<double, std::micro>(inPlaceTime).count() << "us, copy: "
+              << std::chrono::duration<double, std::micro>(copyTime).count() << "us\n";
+
+    if (inPlaceHash != copyHash) {
+        std::cerr << "Parsing in place dispatched different methods to parsing a copy\n";
+        return 1;
+    }
+
+    if (mismatchCount) {
+        std::cerr << mismatchCount << " split pushbuffers dispatched different methods\n";
+        return 1;
+    }
+
+    return 0;
+}
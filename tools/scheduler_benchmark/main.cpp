@@ -0,0 +1,184 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2023 Strato Team and Contributors (https://github.com/strato-emu/)
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <list>
+#include <random>
+#include <thread>
+#include <common/spin_lock.h>
+#include <kernel/thread_queue.h>
+
+using namespace skyline;
+using namespace skyline::kernel;
+
+namespace {
+    constexpr size_t CoreCount{4};
+    constexpr i8 MinPriority{28}, MaxPriority{59}; //!< The range of priorities used by application threads
+
+    /**
+     * @brief A stand-in for KThread with only what the run queues require
+     */
+    struct Thread {
+        u32 id;
+        i8 priority;
+        ThreadQueueNode<Thread> queueNode{};
+    };
+
+    /**
+     * @brief A run queue using a sorted list of threads, this is equivalent to what the scheduler used prior to ThreadQueue
+     */
+    struct ListQueue {
+        std::list<std::shared_ptr<Thread>> threads;
+
+        static bool IsHigherPriority(i8 priority, const std::shared_ptr<Thread> &thread) {
+            return priority < thread->priority;
+        }
+
+        void PushBack(const std::shared_ptr<Thread> &thread) {
+            threads.insert(std::upper_bound(threads.begin(), threads.end(), thread->priority, IsHigherPriority), thread);
+        }
+
+        void Remove(const std::shared_ptr<Thread> &thread) {
+            threads.erase(std::find(threads.begin(), threads.end(), thread));
+        }
+    };
+
+    /**
+     * @brief Applies random insertions, removals and rotations to a ThreadQueue and a sorted list, checking that both yield threads in the same order after every operation
+     * @return The amount of operations after which the queues differed
+     */
+    size_t CheckOrder(std::mt19937_64 &generator, size_t operations) {
+        std::vector<std::shared_ptr<Thread>> threads(64);
+        for (u32 id{}; id < threads.size(); id++)
+            threads[id] = std::make_shared<Thread>(Thread{.id = id});
+
+        ThreadQueue<Thread> queue;
+        ListQueue list;
+        size_t mismatchCount{};
+        for (size_t operation{}; operation < operations; operation++) {
+            auto &thread{threads[generator() % threads.size()]};
+            if (queue.Contains(thread.get())) {
+                bool rotate{queue.Front() == thread.get() && (generator() & 1)};
+                queue.Remove(thread.get());
+                list.Remove(thread);
+                if (rotate) {
+                    // A rotation reinserts the running thread at the back of its own priority, potentially with a new priority
+                    if (generator() & 1)
+                        thread->priority = static_cast<i8>(MinPriority + generator() % (MaxPriority - MinPriority + 1));
+                    queue.PushBack(thread.get(), thread->priority);
+                    list.PushBack(thread);
+                }
+            } else {
+                thread->priority = static_cast<i8>(MinPriority + generator() % (MaxPriority - MinPriority + 1));
+                queue.PushBack(thread.get(), thread->priority);
+                list.PushBack(thread);
+            }
+
+            auto listIt{list.threads.begin()};
+            for (auto queued{queue.Front()}; queued || listIt != list.threads.end(); queued = queue.Next(queued), listIt++) {
+                if (!queued || listIt == list.threads.end() || queued != listIt->get()) {
+                    mismatchCount++;
+                    break;
+                }
+                if (queued->queueNode.priority != queued->priority) {
+                    std::cerr << "T" << queued->id << " is at level " << static_cast<int>(queued->queueNode.priority) << " with priority " << static_cast<int>(queued->priority) << "\n";
+                    mismatchCount++;
+                    break;
+                }
+            }
+        }
+
+        return mismatchCount;
+    }
+
+    /**
+     * @brief Runs a host thread per guest thread which repeatedly yields on its core by removing itself and reinserting itself at the back of its priority, this is what every cooperative yield or rotation does to the run queue
+     * @return The amount of yields done per second across all threads
+     */
+    template<typename Core, typename Yield>
+    double Stress(size_t threadCount, size_t yieldsPerThread, Yield &&yield) {
+        std::array<Core, CoreCount> cores{};
+        std::vector<std::shared_ptr<Thread>> threads(threadCount);
+        std::mt19937 generator{1};
+        for (u32 id{}; id < threadCount; id++) {
+            threads[id] = std::make_shared<Thread>(Thread{.id = id, .priority = static_cast<i8>(MinPriority + generator() % (MaxPriority - MinPriority + 1))});
+            cores[id % CoreCount].Insert(threads[id]);
+        }
+
+        std::atomic<bool> start{};
+        std::vector<std::thread> hostThreads;
+        hostThreads.reserve(threadCount);
+        for (size_t index{}; index < threadCount; index++)
+            hostThreads.emplace_back([&, index]() {
+                while (!start.load(std::memory_order_acquire))
+                    std::this_thread::yield();
+                auto &core{cores[index % CoreCount]};
+                for (size_t iteration{}; iteration < yieldsPerThread; iteration++)
+                    yield(core, threads[index]);
+            });
+
+        auto startTime{std::chrono::steady_clock::now()};
+        start.store(true, std::memory_order_release);
+        for (auto &hostThread : hostThreads)
+            hostThread.join();
+        std::chrono::duration<double> time{std::chrono::steady_clock::now() - startTime};
+
+        return static_cast<double>(threadCount * yieldsPerThread) / time.count();
+    }
+
+    struct ThreadQueueCore {
+        SpinLock mutex;
+        ThreadQueue<Thread> queue;
+        Thread *front; //!< The front of the queue after the last yield, this is read to mirror waking the next thread
+
+        void Insert(const std::shared_ptr<Thread> &thread) {
+            queue.PushBack(thread.get(), thread->priority);
+        }
+    };
+
+    struct ListCore {
+        SpinLock mutex;
+        ListQueue queue;
+        Thread *front;
+
+        void Insert(const std::shared_ptr<Thread> &thread) {
+            queue.PushBack(thread);
+        }
+    };
+}
+
+/**
+ * @brief Checks the ordering of ThreadQueue against a sorted list and compares the throughput of yields on both with many threads contending on every core
+ */
+int main(int argc, char **argv) {
+    size_t yieldsPerThread{argc > 1 ? std::strtoull(argv[1], nullptr, 0) : 20000};
+    u64 seed{argc > 2 ? std::strtoull(argv[2], nullptr, 0) : std::random_device{}()};
+    std::cout << "Running " << yieldsPerThread << " yields per thread, seed " << seed << "\n";
+
+    std::mt19937_64 generator{seed};
+    size_t mismatchCount{CheckOrder(generator, 1000000)};
+    if (mismatchCount)
+        std::cerr << "ThreadQueue differed from the sorted list after " << mismatchCount << " operations\n";
+
+    for (size_t threadCount : {4, 16, 64, 256}) {
+        double queueRate{Stress<ThreadQueueCore>(threadCount, yieldsPerThread, [](ThreadQueueCore &core, const std::shared_ptr<Thread> &thread) {
+            std::scoped_lock lock{core.mutex};
+            core.queue.Remove(thread.get());
+            core.queue.PushBack(thread.get(), thread->priority);
+            core.front = core.queue.Front();
+        })};
+
+        double listRate{Stress<ListCore>(threadCount, yieldsPerThread, [](ListCore &core, const std::shared_ptr<Thread> &thread) {
+            std::scoped_lock lock{core.mutex};
+            core.queue.Remove(thread);
+            core.queue.PushBack(thread);
+            core.front = core.queue.threads.front().get();
+        })};
+
+        std::cout << threadCount << " threads: ThreadQueue " << queueRate / 1000000.0 << "M yields/s, sorted list " << listRate / 1000000.0 << "M yields/s\n";
+    }
+
+    return mismatchCount ? 1 : 0;
+}
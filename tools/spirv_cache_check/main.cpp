@@ -0,0 +1,169 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright © 2023 Strato Team and Contributors (https://github.com/strato-emu/)
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <gpu/spirv_cache_manager.h>
+
+using namespace skyline;
+using namespace skyline::gpu;
+
+namespace {
+    constexpr u64 HostHash{0x5350564348454B}; //!< An arbitrary host hash which all caches are created with unless stated otherwise
+
+    using Entries = std::map<u64, SpirvCacheManager::Entry>;
+
+    /**
+     * @brief Generates entries with random keys, SPIR-V words and bindings, the sizes roughly match those of real shaders
+     */
+    Entries GenerateEntries(std::mt19937_64 &generator, size_t count) {
+        Entries entries;
+        while (entries.size() < count) {
+            std::vector<u32> spirv(64 + generator() % 4096);
+            for (auto &word : spirv)
+                word = static_cast<u32>(generator());
+
+            entries.try_emplace(generator(), SpirvCacheManager::Entry{
+                .spirv = std::move(spirv),
+                .bindings = {
+                    .unified = static_cast<u32>(generator() % 32),
+                    .uniform_buffer = static_cast<u32>(generator() % 16),
+                    .storage_buffer = static_cast<u32>(generator() % 16),
+                    .texture = static_cast<u32>(generator() % 32),
+                    .image = static_cast<u32>(generator() % 8),
+                },
+            });
+        }
+        return entries;
+    }
+
+    bool operator==(const Shader::Backend::Bindings &lhs, const Shader::Backend::Bindings &rhs) {
+        return std::memcmp(&lhs, &rhs, sizeof(Shader::Backend::Bindings)) == 0;
+    }
+
+    /**
+     * @return The amount of entries in the supplied range which aren't in the cache or differ from the expected contents
+     */
+    size_t CountMissing(SpirvCacheManager &cache, Entries::const_iterator begin, Entries::const_iterator end) {
+        size_t missing{};
+        for (auto it{begin}; it != end; it++) {
+            auto entry{cache.Lookup(it->first)};
+            if (!entry || entry->spirv != it->second.spirv || !(entry->bindings == it->second.bindings))
+                missing++;
+        }
+        return missing;
+    }
+
+    size_t CountPresent(SpirvCacheManager &cache, Entries::const_iterator begin, Entries::const_iterator end) {
+        return static_cast<size_t>(std::distance(begin, end)) - CountMissing(cache, begin, end);
+    }
+}
+
+/**
+ * @brief Writes random entries to a SPIR-V cache and checks that they're all loaded back, that truncated or corrupted files only lose the damaged entries onwards and that caches from other host state are discarded
+ */
+int main(int argc, char **argv) {
+    size_t entryCount{argc > 1 ? std::strtoull(argv[1], nullptr, 0) : 2000};
+    u64 seed{argc > 2 ? std::strtoull(argv[2], nullptr, 0) : std::random_device{}()};
+    std::cout << "Checking " << entryCount << " entries with seed " << seed << "\n";
+
+    auto directory{std::filesystem::temp_directory_path() / ("spirv_cache_check_" + std::to_string(seed))};
+    std::filesystem::remove_all(directory);
+    auto path{(directory / "cache").string()};
+
+    std::mt19937_64 generator{seed};
+    auto entries{GenerateEntries(generator, entryCount)};
+
+    size_t failureCount{};
+    auto expect{[&](bool condition, const char *message) {
+        if (!condition) {
+            std::cerr << "Failed: " << message << "\n";
+            failureCount++;
+        }
+    }};
+
+    // Inserting the same key twice must not write a second copy of the entry
+    {
+        SpirvCacheManager cache{path, HostHash};
+        for (const auto &[key, entry] : entries) {
+            auto spirv{entry.spirv};
+            cache.Insert(key, spirv, entry.bindings);
+            cache.Insert(key, spirv, entry.bindings);
+        }
+        expect(CountMissing(cache, entries.begin(), entries.end()) == 0, "All inserted entries can be looked up");
+    }
+    auto fileSize{std::filesystem::file_size(path)};
+
+    std::chrono::nanoseconds loadTime{}, lookupTime{};
+    {
+        auto start{std::chrono::steady_clock::now()};
+        SpirvCacheManager cache{path, HostHash};
+        loadTime = std::chrono::steady_clock::now() - start;
+
+        start = std::chrono::steady_clock::now();
+        expect(CountMissing(cache, entries.begin(), entries.end()) == 0, "All entries are loaded from the cache file");
+        lookupTime = std::chrono::steady_clock::now() - start;
+    }
+    expect(std::filesystem::file_size(path) == fileSize, "Loading a valid cache file doesn't modify it");
+
+    // Truncating the file in the middle of an entry must only lose that entry and any after it, the file must then be usable for appending again
+    {
+        std::filesystem::resize_file(path, fileSize - 3);
+        {
+            SpirvCacheManager cache{path, HostHash};
+            expect(CountPresent(cache, entries.begin(), entries.end()) == entries.size() - 1, "Only the truncated entry is lost");
+
+            auto last{std::prev(entries.end())};
+            auto spirv{last->second.spirv};
+            cache.Insert(last->first, spirv, last->second.bindings);
+        }
+        SpirvCacheManager cache{path, HostHash};
+        expect(CountMissing(cache, entries.begin(), entries.end()) == 0, "Entries appended after truncation are loaded");
+        expect(std::filesystem::file_size(path) == fileSize, "The truncated entry is rewritten in place");
+    }
+
+    // Flipping a bit in the SPIR-V of an entry must be detected by its hash, the file is truncated at the corrupted entry
+    {
+        size_t offset{fileSize / 2};
+        {
+            std::fstream stream{path, std::ios::binary | std::ios::in | std::ios::out};
+            stream.seekg(static_cast<std::streamoff>(offset));
+            char byte{};
+            stream.read(&byte, 1);
+            byte = static_cast<char>(byte ^ 0x10);
+            stream.seekp(static_cast<std::streamoff>(offset));
+            stream.write(&byte, 1);
+        }
+
+        SpirvCacheManager cache{path, HostHash};
+        auto present{CountPresent(cache, entries.begin(), entries.end())};
+        expect(present > 0 && present < entries.size(), "Entries before a corrupted entry are kept and later ones are dropped");
+        expect(std::filesystem::file_size(path) <= offset, "The file is truncated at the corrupted entry");
+    }
+
+    // A cache created with different host state must be discarded entirely
+    {
+        {
+            SpirvCacheManager cache{path, HostHash ^ 1};
+            expect(CountPresent(cache, entries.begin(), entries.end()) == 0, "A cache from different host state is discarded");
+        }
+        SpirvCacheManager cache{path, HostHash};
+        expect(CountPresent(cache, entries.begin(), entries.end()) == 0, "The discarded cache isn't used by the original host state either");
+    }
+
+    std::filesystem::remove_all(directory);
+
+    std::cout << "Cache file: " << fileSize / 1024 << "KiB, load: " << static_cast<double>(loadTime.count()) / 1000000.0 << "ms, lookups: " << static_cast<double>(lookupTime.count()) / static_cast<double>(entries.size()) << "ns/entry\n";
+    if (failureCount) {
+        std::cerr << failureCount << " checks failed\n";
+        return 1;
+    }
+
+    return 0;
+}